@@ -147,6 +147,9 @@ namespace dd4hep {
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key, bool alert) const;
 
+    /// Access an existing extension object by its slot index (see ObjectExtensions::slot)
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const;
+
     /// Extend the sensitive detector element with an arbitrary structure accessible by the type
     template <typename IFACE, typename CONCRETE> IFACE* addExtension(CONCRETE* c)  const {
       return (IFACE*) this->addExtension(detail::typeHash64<IFACE>(),
@@ -155,7 +158,7 @@ namespace dd4hep {
 
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension() const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>());
+      return (IFACE*) this->extension(ObjectExtensions::slot<IFACE>(),detail::typeHash64<IFACE>(),true);
     }
   };
 
@@ -354,6 +357,9 @@ namespace dd4hep {
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key, bool alert) const;
 
+    /// Access an existing extension object by its slot index (see ObjectExtensions::slot)
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const;
+
     /// Extend the detector element with an arbitrary structure accessible by the type
     template <typename IFACE, typename CONCRETE> IFACE* addExtension(CONCRETE* c) const {
       CallbackSequence::checkTypes(typeid(IFACE), typeid(CONCRETE), dynamic_cast<IFACE*>(c));
@@ -361,11 +367,11 @@ namespace dd4hep {
     }
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension() const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>(),true);
+      return (IFACE*) this->extension(ObjectExtensions::slot<IFACE>(),detail::typeHash64<IFACE>(),true);
     }
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension(bool alert) const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>(),alert);
+      return (IFACE*) this->extension(ObjectExtensions::slot<IFACE>(),detail::typeHash64<IFACE>(),alert);
     }
     /// Extend the detector element with an arbitrary callback
     template <typename Q, typename T>
@@ -0,0 +1,183 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_HISTOGRAMACCUMULATOR_H
+#define DD4HEP_HISTOGRAMACCUMULATOR_H
+
+// C/C++ include files
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Per-thread accumulation of histograms with fixed bins
+  /**
+   *  Monitoring histograms filled from concurrently running event
+   *  workers. Every thread fills its own bin array without locking.
+   *  The bin arrays are added to a ROOT histogram (TH1 or TH2) with
+   *  the same binning by merge(), e.g. at the end of the run.
+   *
+   *  The bin numbering, the statistics and the number of entries follow
+   *  TH1::Fill: the result of merge() is identical to filling the
+   *  histogram directly.
+   *
+   *  merge() may not run concurrently to fill().
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP
+   */
+  class HistogramAccumulator  {
+  public:
+    /// Maximum number of concurrent threads with private bin arrays. Further threads share one locked array
+    static constexpr std::size_t MAX_THREADS = 256;
+
+    /// Fixed bin axis
+    struct Axis  {
+      int    nbins { 1 };
+      double min   { 0e0 };
+      double max   { 1e0 };
+      /// Bin number as in TAxis::FindFixBin: 0 is the underflow, nbins+1 the overflow bin
+      int bin(double x)  const  {
+        if ( x < min ) return 0;
+        if ( !(x < max) ) return nbins + 1;
+        return 1 + int(nbins * (x - min) / (max - min));
+      }
+    };
+
+    /// Bin contents and statistics of one thread
+    struct Bins  {
+      std::vector<double> sumw, sumw2;
+      /// Statistics in the order of TH1::GetStats: sumw, sumw2, sumwx, sumwx2, sumwy, sumwy2, sumwxy
+      double stats[7]     { 0e0, 0e0, 0e0, 0e0, 0e0, 0e0, 0e0 };
+      double entries      { 0e0 };
+      bool   weighted     { false };
+      /// Initializing constructor
+      Bins(std::size_t size) : sumw(size, 0e0), sumw2(size, 0e0)  { }
+      /// Add entry to bin
+      void add(int bin, double w)  {
+        sumw[bin]  += w;
+        sumw2[bin] += w*w;
+        weighted   |= (w != 1e0);
+        entries    += 1e0;
+      }
+    };
+
+  protected:
+    /// Axis definitions
+    Axis  m_x, m_y;
+    /// Histogram dimension
+    int   m_dimension { 1 };
+    /// Number of bins including underflow and overflow bins
+    std::size_t m_size { 0 };
+    /// Bin arrays indexed by thread index
+    std::array<std::atomic<Bins*>, MAX_THREADS> m_slots {};
+    /// Bin array shared by all threads beyond MAX_THREADS
+    Bins  m_shared;
+    /// Lock to create bin arrays and to fill the shared array
+    std::mutex m_lock;
+
+    /// Bin array of a thread: create it on first access
+    Bins& bins(std::size_t index)  {
+      Bins* b = m_slots[index].load(std::memory_order_acquire);
+      return b ? *b : create(index);
+    }
+    /// Create the bin array of a thread
+    Bins& create(std::size_t index);
+    /// Sum and reset all bin arrays
+    Bins collect();
+
+  public:
+    /// Initializing constructor for 1D histograms
+    HistogramAccumulator(int nbin_x, double min_x, double max_x);
+    /// Initializing constructor for 2D histograms
+    HistogramAccumulator(int nbin_x, double min_x, double max_x, int nbin_y, double min_y, double max_y);
+    /// No copy constructor
+    HistogramAccumulator(const HistogramAccumulator& copy) = delete;
+    /// No assignment
+    HistogramAccumulator& operator=(const HistogramAccumulator& copy) = delete;
+    /// Default destructor
+    ~HistogramAccumulator();
+
+    /// Index of the calling thread. The smallest index not used by another running thread
+    /** Indices are returned when a thread exits, threads started one after the other
+     *  reuse the bin arrays of their predecessors and never exceed MAX_THREADS.
+     */
+    static std::size_t threadIndex();
+    /// Histogram dimension
+    int dimension()  const   {  return m_dimension;  }
+
+    /// Add 1D histogram entry with weight
+    void fill(double x, double w = 1e0)  {
+      int bin = m_x.bin(x);
+      std::size_t index = threadIndex();
+      std::unique_lock<std::mutex> lock(m_lock, std::defer_lock);
+      if ( index >= MAX_THREADS ) lock.lock();
+      Bins& b = index < MAX_THREADS ? bins(index) : m_shared;
+      b.add(bin, w);
+      if ( bin > 0 && bin <= m_x.nbins )  {
+        b.stats[0] += w;
+        b.stats[1] += w*w;
+        b.stats[2] += w*x;
+        b.stats[3] += w*x*x;
+      }
+    }
+    /// Add 2D histogram entry with weight (no default weight: fill(x, w) is the 1D call)
+    void fill(double x, double y, double w)  {
+      int bin_x = m_x.bin(x), bin_y = m_y.bin(y);
+      std::size_t index = threadIndex();
+      std::unique_lock<std::mutex> lock(m_lock, std::defer_lock);
+      if ( index >= MAX_THREADS ) lock.lock();
+      Bins& b = index < MAX_THREADS ? bins(index) : m_shared;
+      b.add(bin_x + (m_x.nbins + 2) * bin_y, w);
+      if ( bin_x > 0 && bin_x <= m_x.nbins && bin_y > 0 && bin_y <= m_y.nbins )  {
+        b.stats[0] += w;
+        b.stats[1] += w*w;
+        b.stats[2] += w*x;
+        b.stats[3] += w*x*x;
+        b.stats[4] += w*y;
+        b.stats[5] += w*y*y;
+        b.stats[6] += w*x*y;
+      }
+    }
+
+    /// Add the accumulated entries to the histogram and reset the bin arrays
+    /** HIST is TH1 or any derived class with the binning of the accumulator.
+     *  Must not be called while other threads fill the accumulator.
+     */
+    template <typename HIST> void merge(HIST* hist);
+  };
+
+  /// Add the accumulated entries to the histogram and reset the bin arrays
+  template <typename HIST> void HistogramAccumulator::merge(HIST* hist)   {
+    Bins total = this->collect();
+    if ( total.entries <= 0e0 ) return;
+    // Statistics must be taken before the bin contents change
+    double stats[16] = { 0e0 };
+    double entries = hist->GetEntries();
+    hist->GetStats(stats);
+    if ( total.weighted && hist->GetSumw2N() == 0 ) hist->Sumw2();
+    for( std::size_t i = 0; i < m_size; ++i )   {
+      if ( total.sumw2[i] == 0e0 ) continue;
+      hist->AddBinContent(int(i), total.sumw[i]);
+      if ( hist->GetSumw2N() > 0 ) hist->GetSumw2()->fArray[i] += total.sumw2[i];
+    }
+    for( int i = 0; i < (m_dimension == 1 ? 4 : 7); ++i )
+      stats[i] += total.stats[i];
+    hist->PutStats(stats);
+    hist->SetEntries(entries + total.entries);
+  }
+}      // End namespace dd4hep
+#endif // DD4HEP_HISTOGRAMACCUMULATOR_H
@@ -18,6 +18,8 @@
 
 // C/C++ include files
 #include <map>
+#include <vector>
+#include <cstddef>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -26,14 +28,29 @@ namespace dd4hep {
   /**
    *  Usage by inheritance of the client supporting the functionality
    *
+   *  Besides the map keyed by the type hash, which owns the extension entries,
+   *  every extension is also reachable through a dense slot index. Slots are
+   *  assigned process wide to each extension type at first use. The first
+   *  NUM_INLINE_SLOTS slots are stored inline, others in an overflow vector.
+   *  Typed lookups (see slot<T>()) hence avoid the map search.
+   *
    *  \author  M.Frank
    *  \version 1.0
    *  \ingroup DD4HEP_CORE
    */
   class ObjectExtensions   {
   public:
+    enum { NUM_INLINE_SLOTS = 8 };
     /// The extensions object
     std::map<unsigned long long int, ExtensionEntry*>    extensions;   //!
+    /// Flat lookup table of the extensions indexed by slot (not owning)
+    ExtensionEntry*              inline_slots[NUM_INLINE_SLOTS] { };  //!
+    /// Overflow lookup table for slots beyond NUM_INLINE_SLOTS (not owning)
+    std::vector<ExtensionEntry*> overflow_slots;                       //!
+
+  private:
+    /// Update the flat lookup table for a given extension key
+    void setSlot(unsigned long long int key, ExtensionEntry* entry);
 
   public:
     /// Default constructor
@@ -60,6 +77,24 @@ namespace dd4hep {
     void* extension(unsigned long long int key, bool alert) const;
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key) const;
+    /// Access an existing extension object by its slot index. The key is only used for error reporting
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const  {
+      const ExtensionEntry* e = nullptr;
+      if ( slot < NUM_INLINE_SLOTS )
+        e = inline_slots[slot];
+      else if ( slot - NUM_INLINE_SLOTS < overflow_slots.size() )
+        e = overflow_slots[slot - NUM_INLINE_SLOTS];
+      if ( e ) return e->object();
+      return alert ? this->extension(key, true) : nullptr;
+    }
+
+    /// Access the slot index of an extension key. Assigns a new slot at first call
+    static std::size_t slot(unsigned long long int key);
+    /// Access the slot index of an extension type
+    template <typename T> static std::size_t slot()  {
+      static const std::size_t s = slot(detail::typeHash64<T>());
+      return s;
+    }
   };
 
 } /* End namespace dd4hep        */
@@ -65,6 +65,14 @@ namespace dd4hep {
 
       /// Set minimum print level
       static int setMinimumPrintLevel(int level);
+      /// Enable or disable the process wide cache of parsed documents. Returns the old value
+      /** The cache is also enabled by the environment variable DD4HEP_XML_CACHE.
+       *  Documents loaded by file name without URI reader are parsed once and
+       *  then copied. Files are checked for modifications at each load.
+       */
+      static bool enableCache(bool value);
+      /// Release all documents of the process wide document cache
+      static void clearCache();
       /// System ID of a given XML entity
       static std::string system_path(Handle_t base);
       /// System ID of a new XML entity in the same directory as base
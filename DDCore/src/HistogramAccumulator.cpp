@@ -0,0 +1,117 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/HistogramAccumulator.h>
+#include <DD4hep/Printout.h>
+
+// C/C++ include files
+#include <set>
+
+using namespace dd4hep;
+
+/// Initializing constructor for 1D histograms
+HistogramAccumulator::HistogramAccumulator(int nbin_x, double min_x, double max_x)
+  : m_x{nbin_x, min_x, max_x}, m_y{}, m_dimension(1),
+    m_size(nbin_x + 2), m_shared(m_size)
+{
+  if ( nbin_x <= 0 || !(min_x < max_x) )  {
+    except("HistogramAccumulator","+++ Invalid binning: %d bins in [%g, %g]", nbin_x, min_x, max_x);
+  }
+}
+
+/// Initializing constructor for 2D histograms
+HistogramAccumulator::HistogramAccumulator(int nbin_x, double min_x, double max_x,
+                                           int nbin_y, double min_y, double max_y)
+  : m_x{nbin_x, min_x, max_x}, m_y{nbin_y, min_y, max_y}, m_dimension(2),
+    m_size(std::size_t(nbin_x + 2) * std::size_t(nbin_y + 2)), m_shared(m_size)
+{
+  if ( nbin_x <= 0 || !(min_x < max_x) || nbin_y <= 0 || !(min_y < max_y) )  {
+    except("HistogramAccumulator","+++ Invalid binning: %d x %d bins in [%g, %g] x [%g, %g]",
+           nbin_x, nbin_y, min_x, max_x, min_y, max_y);
+  }
+}
+
+/// Default destructor
+HistogramAccumulator::~HistogramAccumulator()   {
+  for( auto& slot : m_slots )
+    delete slot.load();
+}
+
+namespace  {
+  /// Pool of thread indices: the indices of terminated threads are handed out again
+  struct ThreadIndices  {
+    std::mutex            lock;
+    std::set<std::size_t> unused;
+    std::size_t           next { 0 };
+    /// Smallest free index
+    std::size_t acquire()   {
+      std::lock_guard<std::mutex> guard(lock);
+      if ( unused.empty() ) return next++;
+      std::size_t index = *unused.begin();
+      unused.erase(unused.begin());
+      return index;
+    }
+    /// Return the index of a terminating thread
+    void release(std::size_t index)   {
+      std::lock_guard<std::mutex> guard(lock);
+      unused.insert(index);
+    }
+    static ThreadIndices& instance()   {
+      static ThreadIndices s_indices;
+      return s_indices;
+    }
+  };
+  /// Thread local holder of the thread index. Returns the index when the thread exits
+  struct ThreadIndex  {
+    std::size_t value;
+    ThreadIndex() : value(ThreadIndices::instance().acquire())  {  }
+    ~ThreadIndex()  {  ThreadIndices::instance().release(value);  }
+  };
+}
+
+/// Index of the calling thread
+std::size_t HistogramAccumulator::threadIndex()   {
+  static thread_local ThreadIndex index;
+  return index.value;
+}
+
+/// Create the bin array of a thread
+HistogramAccumulator::Bins& HistogramAccumulator::create(std::size_t index)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  Bins* b = new Bins(m_size);
+  m_slots[index].store(b, std::memory_order_release);
+  return *b;
+}
+
+/// Sum and reset all bin arrays
+HistogramAccumulator::Bins HistogramAccumulator::collect()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  Bins total(m_size);
+  auto add = [&total](Bins& b)   {
+    for( std::size_t i = 0; i < total.sumw.size(); ++i )   {
+      total.sumw[i]  += b.sumw[i];
+      total.sumw2[i] += b.sumw2[i];
+    }
+    for( std::size_t i = 0; i < 7; ++i )
+      total.stats[i] += b.stats[i];
+    total.entries  += b.entries;
+    total.weighted |= b.weighted;
+    b = Bins(total.sumw.size());
+  };
+  for( auto& slot : m_slots )   {
+    if ( Bins* b = slot.load(std::memory_order_acquire) ) add(*b);
+  }
+  add(m_shared);
+  return total;
+}
@@ -17,6 +17,10 @@
 #include <DD4hep/Primitives.h>
 #include <DD4hep/Printout.h>
 
+// C/C++ include files
+#include <mutex>
+#include <algorithm>
+
 using namespace dd4hep;
 
 namespace {
@@ -26,6 +30,30 @@ namespace {
   }
 }
 
+/// Access the slot index of an extension key. Assigns a new slot at first call
+std::size_t ObjectExtensions::slot(unsigned long long int key)   {
+  static std::mutex lock;
+  static std::map<unsigned long long int, std::size_t> slots;
+  std::lock_guard<std::mutex> guard(lock);
+  auto i = slots.emplace(key, slots.size());
+  return i.first->second;
+}
+
+/// Update the flat lookup table for a given extension key
+void ObjectExtensions::setSlot(unsigned long long int key, ExtensionEntry* entry)   {
+  std::size_t s = slot(key);
+  if ( s < NUM_INLINE_SLOTS )   {
+    inline_slots[s] = entry;
+    return;
+  }
+  s -= NUM_INLINE_SLOTS;
+  if ( s >= overflow_slots.size() )   {
+    if ( !entry ) return;
+    overflow_slots.resize(s+1, nullptr);
+  }
+  overflow_slots[s] = entry;
+}
+
 /// Default constructor
 ObjectExtensions::ObjectExtensions(const std::type_info& /* parent_type */)    {
   InstanceCount::increment(this);
@@ -40,7 +68,11 @@ ObjectExtensions::~ObjectExtensions()   {
 /// Move extensions to target object
 void ObjectExtensions::move(ObjectExtensions& source)   {
   extensions = source.extensions;
+  std::copy(source.inline_slots, source.inline_slots+NUM_INLINE_SLOTS, inline_slots);
+  overflow_slots = source.overflow_slots;
   source.extensions.clear();
+  std::fill(source.inline_slots, source.inline_slots+NUM_INLINE_SLOTS, nullptr);
+  source.overflow_slots.clear();
 }
 
 /// Internal object destructor: release extension object(s)
@@ -52,12 +84,16 @@ void ObjectExtensions::clear(bool destroy) {
     }
   }
   extensions.clear();
+  std::fill(inline_slots, inline_slots+NUM_INLINE_SLOTS, nullptr);
+  overflow_slots.clear();
 }
 
 /// Copy object extensions from another object
 void ObjectExtensions::copyFrom(const std::map<unsigned long long int,ExtensionEntry*>& ext, void* arg)  {
   for( const auto& i : ext )  {
-    extensions[i.first] = i.second->clone(arg);
+    ExtensionEntry* e = i.second->clone(arg);
+    extensions[i.first] = e;
+    setSlot(i.first, e);
   }
 }
 
@@ -68,6 +104,7 @@ void* ObjectExtensions::addExtension(unsigned long long int key, ExtensionEntry*
       auto j = extensions.find(key);
       if (j == extensions.end()) {
         extensions[key] = e;
+        setSlot(key, e);
         return e->object();
       }
       except("ObjectExtensions::addExtension","Object already has an extension of type: %s.",obj_type(e->object()).c_str());
@@ -88,6 +125,7 @@ void* ObjectExtensions::removeExtension(unsigned long long int key, bool destroy
     }
     delete (*j).second;
     extensions.erase(j);
+    setSlot(key, nullptr);
     return ptr;
   }
   except("ObjectExtensions::removeExtension","The object of type %016llX is not present.",key);
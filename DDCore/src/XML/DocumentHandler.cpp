@@ -15,9 +15,16 @@
 #include <XML/Printout.h>
 #include <XML/UriReader.h>
 #include <XML/DocumentHandler.h>
+#include <Parsers/Primitives.h>
 
 // C/C++ include files
+#include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <climits>
+#include <fstream>
+#include <iterator>
 #include <iostream>
 #include <stdexcept>
 #include <sys/types.h>
@@ -336,7 +343,7 @@ Document DocumentHandler::load(Handle_t base, const XMLCh* fname, UriReader* rea
 }
 
 /// Load XML file and parse it using URI resolver to read data.
-Document DocumentHandler::load(const std::string& fname, UriReader* reader) const   {
+static Document _load_document(const std::string& fname, UriReader* reader)   {
   auto fname_clean = _clean_fname(fname);
   std::string path;
   printout(DEBUG,"DocumentHandler","+++ Loading document URI: %s",fname_clean.c_str());
@@ -381,6 +388,16 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
   return (XmlDocument*)parser->adoptDocument();
 }
 
+/// Deep copy of a document including its system ID
+static XmlDocument* _clone_document(XmlDocument* doc)   {
+  DOMDocument* src  = (DOMDocument*)doc;
+  DOMDocument* copy = (DOMDocument*)src->cloneNode(true);
+  copy->setDocumentURI(src->getDocumentURI());
+  copy->setXmlStandalone(src->getXmlStandalone());
+  copy->setStrictErrorChecking(src->getStrictErrorChecking());
+  return (XmlDocument*)copy;
+}
+
 /// Parse a standalong XML string into a document.
 Document DocumentHandler::parse(const char* bytes, size_t length, const char* sys_id, UriReader* rdr) const {
   std::unique_ptr < XercesDOMParser > parser(make_parser(rdr));
@@ -482,7 +499,7 @@ std::string DocumentHandler::system_path(Handle_t base)   {
 }
 
 /// Load XML file and parse it using URI resolver to read data.
-Document DocumentHandler::load(const std::string& fname, UriReader* reader) const  {
+static Document _load_document(const std::string& fname, UriReader* reader)  {
   std::string clean = _clean_fname(fname);
   if ( reader )   {
     printout(WARNING,"DocumentHandler","+++ Loading document URI: %s %s",
@@ -523,6 +540,11 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
   return 0;
 }
 
+/// Deep copy of a document including its system ID
+static XmlDocument* _clone_document(XmlDocument* doc)   {
+  return (XmlDocument*)new TiXmlDocument(*(TiXmlDocument*)doc);
+}
+
 /// Load XML file and parse it using URI resolver to read data.
 Document DocumentHandler::load(Handle_t base, const XmlChar* fname, UriReader* reader) const  {
   std::string path = system_path(base, fname);
@@ -613,6 +635,140 @@ void dd4hep::xml::dump_tree(Document doc, std::ostream& os) {
 #endif
 
 
+namespace {
+
+  /// Process wide cache of parsed documents
+  /**
+   *  Documents are keyed by the resolved file name. A cached document is
+   *  reused if the file's modification time (in nanoseconds where the file
+   *  system provides it) and size did not change or, if they did, the
+   *  content hash is still the same. Clients always receive a
+   *  deep copy, which they own: the parsing is replaced by a DOM copy.
+   *  The cached documents live until clearCache() is called.
+   */
+  class DocumentCache  {
+  public:
+    struct entry_t  {
+      long long          mtime  { 0 };
+      long               size   { 0 };
+      unsigned long long hash   { 0 };
+      XmlDocument*       doc    { nullptr };
+    };
+    std::mutex                     lock;
+    std::map<std::string, entry_t> documents;
+    std::atomic<bool>              enabled { ::getenv("DD4HEP_XML_CACHE") != nullptr };
+
+    static DocumentCache& instance()   {
+      static DocumentCache* cache = new DocumentCache();  // Never deleted: parser may be gone at exit
+      return *cache;
+    }
+    /// Resolved file name: key of the cache
+    static std::string key(const std::string& fname)   {
+      std::string clean = _clean_fname(fname);
+      char resolved[PATH_MAX];
+      if ( ::realpath(clean.c_str(), resolved) ) return resolved;
+      return clean;
+    }
+    /// Content hash of a file. Returns false if the file cannot be read
+    static bool content_hash(const std::string& path, unsigned long long& hash)   {
+      std::ifstream in(path, std::ios::binary);
+      std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      if ( !in.good() && !in.eof() ) return false;
+      hash = dd4hep::detail::hash64(data.c_str(), data.length());
+      return true;
+    }
+    /// Release all cached documents
+    void clear()   {
+      std::lock_guard<std::mutex> guard(lock);
+      for( auto& d : documents )   {
+        DocumentHolder holder(d.second.doc);
+      }
+      documents.clear();
+    }
+    /// Deep copy of a cached document. The lock must be held
+    static Document copy(const std::string& path, const entry_t& e)   {
+      printout(DEBUG,"DocumentHandler","+++ Document %s taken from the document cache.", path.c_str());
+      return _clone_document(e.doc);
+    }
+    /// Load a document from the cache or parse it and add it to the cache
+    /**
+     *  File status, content hash, parsing and the copy of newly parsed
+     *  documents are done outside the lock. Only the map access and the
+     *  copy of cached documents are serialized.
+     */
+    Document load(const std::string& fname)   {
+      std::string path = key(fname);
+      struct stat st;
+      if ( ::stat(path.c_str(), &st) != 0 )   {
+        return _load_document(fname, nullptr);
+      }
+#if defined(__APPLE__)
+      const long long mtime = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+      const long long mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+      const long size = st.st_size;
+      unsigned long long cached_hash = 0;
+      bool have_entry = false;
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        auto i = documents.find(path);
+        if ( i != documents.end() )   {
+          if ( i->second.mtime == mtime && i->second.size == size )   {
+            return copy(path, i->second);
+          }
+          have_entry  = true;
+          cached_hash = i->second.hash;
+        }
+      }
+      unsigned long long hash = 0;
+      bool have_hash = content_hash(path, hash);
+      if ( have_entry && have_hash && hash == cached_hash )   {
+        std::lock_guard<std::mutex> guard(lock);
+        auto i = documents.find(path);
+        if ( i != documents.end() && i->second.hash == hash )   {
+          i->second.mtime = mtime;
+          i->second.size  = size;
+          return copy(path, i->second);
+        }
+      }
+      Document doc = _load_document(fname, nullptr);
+      if ( doc && have_hash )   {
+        entry_t e { mtime, size, hash, _clone_document((XmlDocument*)doc.ptr()) };
+        std::lock_guard<std::mutex> guard(lock);
+        auto i = documents.find(path);
+        if ( i != documents.end() )   {
+          DocumentHolder holder(i->second.doc);
+          i->second = e;
+        }
+        else   {
+          documents.emplace(path, e);
+        }
+      }
+      return doc;
+    }
+  };
+}
+
+/// Load XML file and parse it using URI resolver to read data.
+Document DocumentHandler::load(const std::string& fname, UriReader* reader) const   {
+  DocumentCache& cache = DocumentCache::instance();
+  if ( !reader && cache.enabled )   {
+    return cache.load(fname);
+  }
+  return _load_document(fname, reader);
+}
+
+/// Enable or disable the process wide cache of parsed documents
+bool DocumentHandler::enableCache(bool value)   {
+  return DocumentCache::instance().enabled.exchange(value);
+}
+
+/// Release all documents of the process wide document cache
+void DocumentHandler::clearCache()   {
+  DocumentCache::instance().clear();
+}
+
 /// Default constructor of a document handler using TiXml
 DocumentHandler::DocumentHandler() {}
 
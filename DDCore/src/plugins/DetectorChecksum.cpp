@@ -28,6 +28,7 @@
 #include <TClass.h>
 #include <TColor.h>
 #include <TGeoBoolNode.h>
+#include <TGeoMatrix.h>
 #include <TGeoSystemOfUnits.h>
 
 // C/C++ include files
@@ -37,6 +38,13 @@
 #include <iomanip>
 #include <cfloat>
 #include <cfenv>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <exception>
 
 using namespace dd4hep;
 using DetectorChecksum = dd4hep::detail::DetectorChecksum;
@@ -245,412 +253,433 @@ const DetectorChecksum::entry_t& DetectorChecksum::handleSolid(Solid solid) cons
   auto& geo = data().mapOfSolids;
   auto  iso = geo.find(solid);
   if ( iso == geo.end() )   {
-    const TGeoShape* shape = solid.ptr();
-    auto  log = logger();
-
-    if ( !shape )  {
-      log << "<shape type=\"INVALID\"></shape>)";
-      iso = geo.emplace(solid, make_entry(log)).first;
-      return iso->second;
+    auto ins = geo.emplace(solid, hashSolid(solid));
+    if ( !ins.second )   {
+      except("DetectorChecksum", "+++ FAILED to register shape: %s", solid.name());
     }
+    iso = ins.first;
+  }
+  return iso->second;
+}
 
-    // NOTE: We cannot use the name when creating the hash!
-    // The name is artificially assigned and contains the shape pointer.
-    // This causes havoc.
-    TClass*     cl  = shape->IsA();
-    std::string nam = "";//attr_name(solid);
-    if ( cl == TGeoBBox::Class() )   {
-      TGeoBBox* sh = (TGeoBBox*) shape;
-      log << "<box" << nam
-          << " lunit=\"" << m_len_unit_nam << "\""
-          << " x=\"" << 2.0*sh->GetDX()/m_len_unit << "\""
-          << " y=\"" << 2.0*sh->GetDY()/m_len_unit << "\""
-          << " z=\"" << 2.0*sh->GetDZ()/m_len_unit << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoHalfSpace::Class() ) {
-      TGeoHalfSpace* sh = (TGeoHalfSpace*)(const_cast<TGeoShape*>(shape));
-      const auto& pnt = sh->GetPoint();
-      const auto& nrm = sh->GetNorm();
-      log << "<halfspace" << nam
-          << " lunit=\"" << m_len_unit_nam << "\">" << newline
-          << " <point x=\""        << pnt[0]/m_len_unit << "\""
-          << " y=\""               << pnt[1]/m_len_unit << "\""
-          << " z=\""               << pnt[2]/m_len_unit << "\"/>" << newline
-          << " <normal x=\""       << nrm[0]/m_len_unit << "\""
-          << " y=\""               << nrm[1]/m_len_unit << "\""
-          << " z=\""               << nrm[2]/m_len_unit << "\"/>" << newline
-          << "</halfspace>";
-    }
-    else if ( cl == TGeoTube::Class() || cl == TGeoTubeSeg::Class() ) {
-      const TGeoTube* sh = (const TGeoTube*) shape;
-      log << "<tube" << nam
-          << " lunit=\""    << m_len_unit_nam           << "\""
-          << " aunit=\""    << m_ang_unit_nam           << "\""
-          << " rmin=\""     << check_null(sh->GetRmin()/m_len_unit) << "\""
-          << " rmax=\""     << check_null(sh->GetRmax()/m_len_unit) << "\""
-          << " dz=\""       << check_null(2*sh->GetDz()/m_len_unit) << "\""
-          << " startphi=\"" << 0.0                 << "\""
-          << " deltaphi=\"" << 360.0/m_ang_unit         << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoTubeSeg::Class() ) {
-      const TGeoTubeSeg* sh = (const TGeoTubeSeg*) shape;
-      log << "<tube" << nam
-          << " lunit=\""    << m_len_unit_nam             << "\""
-          << " aunit=\""    << m_ang_unit_nam             << "\""
-          << " rmin=\""     << check_null(sh->GetRmin()/m_len_unit) << "\""
-          << " rmax=\""     << check_null(sh->GetRmax()/m_len_unit) << "\""
-          << " dz=\""       << check_null(2*sh->GetDz()/m_len_unit) << "\""
-          << " startphi=\"" << sh->GetPhi1()/m_ang_unit   << "\""
-          << " deltaphi=\"" << (sh->GetPhi2() - sh->GetPhi1())/m_ang_unit << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoCtub::Class() ) {
-      const TGeoCtub* sh = (const TGeoCtub*) shape;
-      const Double_t* hi = sh->GetNhigh();
-      const Double_t* lo = sh->GetNlow();
-      log << "<cutTube" << nam
-          << " lunit=\""    << m_len_unit_nam             << "\""
-          << " aunit=\""    << m_ang_unit_nam             << "\""
-          << " rmin=\""     << sh->GetRmin()/m_len_unit   << "\""
-          << " rmax=\""     << sh->GetRmax()/m_len_unit   << "\""
-          << " dz=\""       << 2*sh->GetDz()/m_len_unit   << "\""
-          << " startphi=\"" << sh->GetPhi1()/m_ang_unit   << "\""
-          << " deltaphi=\"" << (sh->GetPhi2() - sh->GetPhi1())/m_ang_unit << "\""
-          << " lowX=\""     << lo[0]/m_len_unit           << "\""
-          << " lowY=\""     << lo[1]/m_len_unit           << "\""
-          << " lowZ=\""     << lo[2]/m_len_unit           << "\""
-          << " highX=\""    << hi[0]/m_len_unit           << "\""
-          << " highY=\""    << hi[1]/m_len_unit           << "\""
-          << " highZ=\""    << hi[2]/m_len_unit           << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoEltu::Class() ) {
-      const TGeoEltu* sh = (const TGeoEltu*) shape;
-      log << "<eltube" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " dx=\""     << sh->GetA()/m_len_unit      << "\""
-          << " dy=\""     << sh->GetB()/m_len_unit      << "\""
-          << " dz=\""     << sh->GetDz()/m_len_unit     << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoTrd1::Class() ) {
-      const TGeoTrd1* sh = (const TGeoTrd1*) shape;
-      log << "<trd" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " x1=\""     << 2*check_null(sh->GetDx1()/m_len_unit)  << "\""
-          << " x2=\""     << 2*check_null(sh->GetDx2()/m_len_unit)  << "\""
-          << " y1=\""     << 2*check_null(sh->GetDy()/m_len_unit)   << "\""
-          << " y2=\""     << 2*check_null(sh->GetDy()/m_len_unit)   << "\""
-          << " z=\""      << 2*check_null(sh->GetDz()/m_len_unit)   << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoTrd2::Class() ) {
-      const TGeoTrd2* sh = (const TGeoTrd2*) shape;
-      log << "<trd" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " x1=\""     << 2*check_null(sh->GetDx1()/m_len_unit)  << "\""
-          << " x2=\""     << 2*check_null(sh->GetDx2()/m_len_unit)  << "\""
-          << " y1=\""     << 2*check_null(sh->GetDy1()/m_len_unit)  << "\""
-          << " y2=\""     << 2*check_null(sh->GetDy2()/m_len_unit)  << "\""
-          << " z=\""      << 2*check_null(sh->GetDz()/m_len_unit)   << "\""
-          << "/>";
+/// Compute the hash entry of a solid
+DetectorChecksum::entry_t DetectorChecksum::hashSolid(Solid solid) const {
+  const TGeoShape* shape = solid.ptr();
+  auto  log = logger();
+
+  if ( !shape )  {
+    log << "<shape type=\"INVALID\"></shape>)";
+    return make_entry(log);
+  }
+
+  // NOTE: We cannot use the name when creating the hash!
+  // The name is artificially assigned and contains the shape pointer.
+  // This causes havoc.
+  TClass*     cl  = shape->IsA();
+  std::string nam = "";//attr_name(solid);
+  if ( cl == TGeoBBox::Class() )   {
+    TGeoBBox* sh = (TGeoBBox*) shape;
+    log << "<box" << nam
+        << " lunit=\"" << m_len_unit_nam << "\""
+        << " x=\"" << 2.0*sh->GetDX()/m_len_unit << "\""
+        << " y=\"" << 2.0*sh->GetDY()/m_len_unit << "\""
+        << " z=\"" << 2.0*sh->GetDZ()/m_len_unit << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoHalfSpace::Class() ) {
+    TGeoHalfSpace* sh = (TGeoHalfSpace*)(const_cast<TGeoShape*>(shape));
+    const auto& pnt = sh->GetPoint();
+    const auto& nrm = sh->GetNorm();
+    log << "<halfspace" << nam
+        << " lunit=\"" << m_len_unit_nam << "\">" << newline
+        << " <point x=\""        << pnt[0]/m_len_unit << "\""
+        << " y=\""               << pnt[1]/m_len_unit << "\""
+        << " z=\""               << pnt[2]/m_len_unit << "\"/>" << newline
+        << " <normal x=\""       << nrm[0]/m_len_unit << "\""
+        << " y=\""               << nrm[1]/m_len_unit << "\""
+        << " z=\""               << nrm[2]/m_len_unit << "\"/>" << newline
+        << "</halfspace>";
+  }
+  else if ( cl == TGeoTube::Class() || cl == TGeoTubeSeg::Class() ) {
+    const TGeoTube* sh = (const TGeoTube*) shape;
+    log << "<tube" << nam
+        << " lunit=\""    << m_len_unit_nam           << "\""
+        << " aunit=\""    << m_ang_unit_nam           << "\""
+        << " rmin=\""     << check_null(sh->GetRmin()/m_len_unit) << "\""
+        << " rmax=\""     << check_null(sh->GetRmax()/m_len_unit) << "\""
+        << " dz=\""       << check_null(2*sh->GetDz()/m_len_unit) << "\""
+        << " startphi=\"" << 0.0                 << "\""
+        << " deltaphi=\"" << 360.0/m_ang_unit         << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoTubeSeg::Class() ) {
+    const TGeoTubeSeg* sh = (const TGeoTubeSeg*) shape;
+    log << "<tube" << nam
+        << " lunit=\""    << m_len_unit_nam             << "\""
+        << " aunit=\""    << m_ang_unit_nam             << "\""
+        << " rmin=\""     << check_null(sh->GetRmin()/m_len_unit) << "\""
+        << " rmax=\""     << check_null(sh->GetRmax()/m_len_unit) << "\""
+        << " dz=\""       << check_null(2*sh->GetDz()/m_len_unit) << "\""
+        << " startphi=\"" << sh->GetPhi1()/m_ang_unit   << "\""
+        << " deltaphi=\"" << (sh->GetPhi2() - sh->GetPhi1())/m_ang_unit << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoCtub::Class() ) {
+    const TGeoCtub* sh = (const TGeoCtub*) shape;
+    const Double_t* hi = sh->GetNhigh();
+    const Double_t* lo = sh->GetNlow();
+    log << "<cutTube" << nam
+        << " lunit=\""    << m_len_unit_nam             << "\""
+        << " aunit=\""    << m_ang_unit_nam             << "\""
+        << " rmin=\""     << sh->GetRmin()/m_len_unit   << "\""
+        << " rmax=\""     << sh->GetRmax()/m_len_unit   << "\""
+        << " dz=\""       << 2*sh->GetDz()/m_len_unit   << "\""
+        << " startphi=\"" << sh->GetPhi1()/m_ang_unit   << "\""
+        << " deltaphi=\"" << (sh->GetPhi2() - sh->GetPhi1())/m_ang_unit << "\""
+        << " lowX=\""     << lo[0]/m_len_unit           << "\""
+        << " lowY=\""     << lo[1]/m_len_unit           << "\""
+        << " lowZ=\""     << lo[2]/m_len_unit           << "\""
+        << " highX=\""    << hi[0]/m_len_unit           << "\""
+        << " highY=\""    << hi[1]/m_len_unit           << "\""
+        << " highZ=\""    << hi[2]/m_len_unit           << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoEltu::Class() ) {
+    const TGeoEltu* sh = (const TGeoEltu*) shape;
+    log << "<eltube" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " dx=\""     << sh->GetA()/m_len_unit      << "\""
+        << " dy=\""     << sh->GetB()/m_len_unit      << "\""
+        << " dz=\""     << sh->GetDz()/m_len_unit     << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoTrd1::Class() ) {
+    const TGeoTrd1* sh = (const TGeoTrd1*) shape;
+    log << "<trd" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " x1=\""     << 2*check_null(sh->GetDx1()/m_len_unit)  << "\""
+        << " x2=\""     << 2*check_null(sh->GetDx2()/m_len_unit)  << "\""
+        << " y1=\""     << 2*check_null(sh->GetDy()/m_len_unit)   << "\""
+        << " y2=\""     << 2*check_null(sh->GetDy()/m_len_unit)   << "\""
+        << " z=\""      << 2*check_null(sh->GetDz()/m_len_unit)   << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoTrd2::Class() ) {
+    const TGeoTrd2* sh = (const TGeoTrd2*) shape;
+    log << "<trd" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " x1=\""     << 2*check_null(sh->GetDx1()/m_len_unit)  << "\""
+        << " x2=\""     << 2*check_null(sh->GetDx2()/m_len_unit)  << "\""
+        << " y1=\""     << 2*check_null(sh->GetDy1()/m_len_unit)  << "\""
+        << " y2=\""     << 2*check_null(sh->GetDy2()/m_len_unit)  << "\""
+        << " z=\""      << 2*check_null(sh->GetDz()/m_len_unit)   << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoTrap::Class() )   {
+    const TGeoTrap* sh = (const TGeoTrap*) shape;
+    log << "<trap" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " z=\""      << check_null(2*sh->GetDz()/m_len_unit)   << "\""
+        << " theta=\""  << check_null(sh->GetTheta()/m_ang_unit)  << "\""
+        << " phi=\""    << check_null(sh->GetPhi()/m_ang_unit)    << "\""
+        << " x1=\""     << check_null(2*sh->GetBl1()/m_len_unit)  << "\""
+        << " x2=\""     << check_null(2*sh->GetTl1()/m_len_unit)  << "\""
+        << " x3=\""     << check_null(2*sh->GetBl2()/m_len_unit)  << "\""
+        << " x4=\""     << check_null(2*sh->GetTl2()/m_len_unit)  << "\""
+        << " y1=\""     << check_null(2*sh->GetH1()/m_len_unit)   << "\""
+        << " y2=\""     << check_null(2*sh->GetH2()/m_len_unit)   << "\""
+        << " alpha1=\"" << check_null(sh->GetAlpha1()/m_ang_unit) << "\""
+        << " alpha2=\"" << check_null(sh->GetAlpha2()/m_ang_unit) << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoHype::Class() )   {
+    const TGeoHype* sh = (const TGeoHype*) shape;
+    log << "<hype" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " rmin=\""   << check_null(sh->GetRmin()/m_len_unit)   << "\""
+        << " rmax=\""   << check_null(sh->GetRmax()/m_len_unit)   << "\""
+        << " inst=\""   << check_null(sh->GetStIn()/m_ang_unit)   << "\""
+        << " outst=\""  << check_null(sh->GetStOut()/m_ang_unit)  << "\""
+        << " z=\""      << check_null(2*sh->GetDz()/m_len_unit)   << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoPgon::Class() )   {
+    const TGeoPgon* sh = (const TGeoPgon*) shape;
+    log << "<polyhedra" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
+        << " deltaphi=\"" << check_null(sh->GetDphi()/m_ang_unit) << "\""
+        << " numsides=\"" << sh->GetNedges()     << "\">" << newline;
+    for(int i=0, n=sh->GetNz(); i<n; ++i)  {
+      log << " <zplane z=\"" << check_null(sh->GetZ(i)/m_len_unit) 
+          << "\" rmin=\"" << check_null(sh->GetRmin(i)/m_len_unit) << "\""
+          << "\" rmax=\"" << check_null(sh->GetRmax(i)/m_len_unit) << "\"/>" << newline;
     }
-    else if ( cl == TGeoTrap::Class() )   {
-      const TGeoTrap* sh = (const TGeoTrap*) shape;
-      log << "<trap" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " z=\""      << check_null(2*sh->GetDz()/m_len_unit)   << "\""
-          << " theta=\""  << check_null(sh->GetTheta()/m_ang_unit)  << "\""
-          << " phi=\""    << check_null(sh->GetPhi()/m_ang_unit)    << "\""
-          << " x1=\""     << check_null(2*sh->GetBl1()/m_len_unit)  << "\""
-          << " x2=\""     << check_null(2*sh->GetTl1()/m_len_unit)  << "\""
-          << " x3=\""     << check_null(2*sh->GetBl2()/m_len_unit)  << "\""
-          << " x4=\""     << check_null(2*sh->GetTl2()/m_len_unit)  << "\""
-          << " y1=\""     << check_null(2*sh->GetH1()/m_len_unit)   << "\""
-          << " y2=\""     << check_null(2*sh->GetH2()/m_len_unit)   << "\""
-          << " alpha1=\"" << check_null(sh->GetAlpha1()/m_ang_unit) << "\""
-          << " alpha2=\"" << check_null(sh->GetAlpha2()/m_ang_unit) << "\""
-          << "/>";
+    log << "</polyhedra>";
+  }
+  else if ( cl == TGeoPcon::Class() )  {
+    const TGeoPcon* sh = (const TGeoPcon*) shape;
+    log << "<polycone" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
+        << " deltaphi=\"" << check_null(sh->GetDphi()/m_ang_unit) << "\">" << newline;
+    for(int i=0, n=sh->GetNz(); i<n; ++i)  {
+      log << " <zplane z=\"" << check_null(sh->GetZ(i)/m_len_unit) 
+          << "\" rmin=\"" << check_null(sh->GetRmin(i)/m_len_unit) << "\""
+          << "\" rmax=\"" << check_null(sh->GetRmax(i)/m_len_unit) << "\"/>" << newline;
     }
-    else if ( cl == TGeoHype::Class() )   {
-      const TGeoHype* sh = (const TGeoHype*) shape;
-      log << "<hype" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " rmin=\""   << check_null(sh->GetRmin()/m_len_unit)   << "\""
-          << " rmax=\""   << check_null(sh->GetRmax()/m_len_unit)   << "\""
-          << " inst=\""   << check_null(sh->GetStIn()/m_ang_unit)   << "\""
-          << " outst=\""  << check_null(sh->GetStOut()/m_ang_unit)  << "\""
-          << " z=\""      << check_null(2*sh->GetDz()/m_len_unit)   << "\""
-          << "/>";
+    log << "</polycone>";
+  }
+  else if ( cl == TGeoCone::Class() )  {
+    const TGeoCone* sh = (const TGeoCone*) shape;
+    log << "<cone" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " rmin1=\""  << check_null(sh->GetRmin1()/m_len_unit)  << "\""
+        << " rmin2=\""  << check_null(sh->GetRmin2()/m_len_unit)  << "\""
+        << " rmax1=\""  << check_null(sh->GetRmax1()/m_len_unit)  << "\""
+        << " rmax2=\""  << check_null(sh->GetRmax2()/m_len_unit)  << "\""
+        << " z=\""      << check_null(sh->GetDz()/m_len_unit)     << "\""
+        << " startphi=\"" << 0.0/m_ang_unit           << "\""
+        << " deltaphi=\"" << 360.0/m_ang_unit         << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoConeSeg::Class() )  {
+    const TGeoConeSeg* sh = (const TGeoConeSeg*) shape;
+    log << "<cone" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " rmin1=\""  << check_null(sh->GetRmin1()/m_len_unit)  << "\""
+        << " rmin2=\""  << check_null(sh->GetRmin2()/m_len_unit)  << "\""
+        << " rmax1=\""  << check_null(sh->GetRmax1()/m_len_unit)  << "\""
+        << " rmax2=\""  << check_null(sh->GetRmax2()/m_len_unit)  << "\""
+        << " z=\""      << check_null(sh->GetDz()/m_len_unit)     << "\""
+        << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
+        << " deltaphi=\"" << check_null((sh->GetPhi1()-sh->GetPhi1())/m_ang_unit) << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoParaboloid::Class() )  {
+    const TGeoParaboloid* sh = (const TGeoParaboloid*) shape;
+    log << "<paraboloid" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " rlo=\""    << sh->GetRlo()/m_len_unit    << "\""
+        << " rhi=\""    << sh->GetRhi()/m_len_unit    << "\""
+        << " z=\""      << sh->GetDz()/m_len_unit     << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoSphere::Class() )   {
+    const TGeoSphere* sh = (const TGeoSphere*) shape;
+    log << "<sphere" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " rmin=\""   << sh->GetRmin()/m_len_unit   << "\""
+        << " rmax=\""   << sh->GetRmax()/m_len_unit   << "\""
+        << " startphi=\""   << sh->GetPhi1()/m_ang_unit << "\""
+        << " deltaphi=\""   << (sh->GetPhi1()-sh->GetPhi1())/m_ang_unit << "\""
+        << " starttheta=\"" << sh->GetTheta1()/m_ang_unit << "\""
+        << " deltatheta=\"" << (sh->GetTheta1()-sh->GetTheta1())/m_ang_unit << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoTorus::Class() )   {
+    const TGeoTorus* sh = (const TGeoTorus*) shape;
+    log << "<torus" << nam
+        << " lunit=\""  << m_len_unit_nam             << "\""
+        << " aunit=\""  << m_ang_unit_nam             << "\""
+        << " rtor=\""   << sh->GetR()/m_len_unit      << "\""
+        << " rmin=\""   << sh->GetRmin()/m_len_unit   << "\""
+        << " rmax=\""   << sh->GetRmax()/m_len_unit   << "\""
+        << " startphi=\""   << sh->GetPhi1()/m_ang_unit << "\""
+        << " deltaphi=\""   << sh->GetDphi()/m_ang_unit << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoArb8::Class() )   {
+    TGeoArb8* sh = (TGeoArb8*) shape;
+    const Double_t* v = sh->GetVertices();
+    log << "<arb8" << nam
+        << " v1x=\""    << v[0]/m_len_unit            << "\""
+        << " v1y=\""    << v[1]/m_len_unit            << "\""
+        << " v2x=\""    << v[2]/m_len_unit            << "\""
+        << " v2y=\""    << v[3]/m_len_unit            << "\""
+        << " v3x=\""    << v[4]/m_len_unit            << "\""
+        << " v3y=\""    << v[5]/m_len_unit            << "\""
+        << " v4x=\""    << v[6]/m_len_unit            << "\""
+        << " v4y=\""    << v[7]/m_len_unit            << "\""
+        << " v5x=\""    << v[8]/m_len_unit            << "\""
+        << " v5y=\""    << v[9]/m_len_unit            << "\""
+        << " v6x=\""    << v[10]/m_len_unit           << "\""
+        << " v6y=\""    << v[11]/m_len_unit           << "\""
+        << " v7x=\""    << v[12]/m_len_unit           << "\""
+        << " v7y=\""    << v[13]/m_len_unit           << "\""
+        << " v8x=\""    << v[14]/m_len_unit           << "\""
+        << " v8y=\""    << v[15]/m_len_unit           << "\""
+        << " dz=\""     << sh->GetDz()/m_len_unit     << "\""
+        << "/>";
+  }
+  else if ( cl == TGeoXtru::Class() )   {
+    const TGeoXtru* sh = (const TGeoXtru*) shape;
+    log << "<xtru" << nam << ">" << newline;
+    for (int i = 0; i < sh->GetNvert(); i++) {
+      log << " <twoDimVertex x=\"" << sh->GetX(i)/m_len_unit << "\""
+          << "\" y=\"" << sh->GetY(i)/m_len_unit << "\"/>" << newline;
     }
-    else if ( cl == TGeoPgon::Class() )   {
-      const TGeoPgon* sh = (const TGeoPgon*) shape;
-      log << "<polyhedra" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
-          << " deltaphi=\"" << check_null(sh->GetDphi()/m_ang_unit) << "\""
-          << " numsides=\"" << sh->GetNedges()     << "\">" << newline;
-      for(int i=0, n=sh->GetNz(); i<n; ++i)  {
-        log << " <zplane z=\"" << check_null(sh->GetZ(i)/m_len_unit) 
-            << "\" rmin=\"" << check_null(sh->GetRmin(i)/m_len_unit) << "\""
-            << "\" rmax=\"" << check_null(sh->GetRmax(i)/m_len_unit) << "\"/>" << newline;
-      }
-      log << "</polyhedra>";
+    for (int i = 0; i < sh->GetNz(); i++) {
+      log << " <section zOrder=\"" << i << "\""
+          << " scalingFactor=\"" << sh->GetScale(i) << "\""
+          << " zPosition=\"" << sh->GetZ(i)/m_len_unit << "\""
+          << " xOffset=\""   << sh->GetXOffset(i)/m_len_unit << "\""
+          << " yOffset=\""   << sh->GetYOffset(i)/m_len_unit << "\"/>" << newline;
     }
-    else if ( cl == TGeoPcon::Class() )  {
-      const TGeoPcon* sh = (const TGeoPcon*) shape;
-      log << "<polycone" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
-          << " deltaphi=\"" << check_null(sh->GetDphi()/m_ang_unit) << "\">" << newline;
-      for(int i=0, n=sh->GetNz(); i<n; ++i)  {
-        log << " <zplane z=\"" << check_null(sh->GetZ(i)/m_len_unit) 
-            << "\" rmin=\"" << check_null(sh->GetRmin(i)/m_len_unit) << "\""
-            << "\" rmax=\"" << check_null(sh->GetRmax(i)/m_len_unit) << "\"/>" << newline;
+    log << "</xtru>";
+  }
+  else if (shape->IsA() == TGeoCompositeShape::Class() )   {
+    const TGeoCompositeShape* sh  = (const TGeoCompositeShape*)shape;
+    const TGeoBoolNode* boolean   = sh->GetBoolNode();
+    const TGeoShape*    left      = boolean->GetLeftShape();
+    const TGeoShape*    right     = boolean->GetRightShape();
+    const TGeoMatrix*   mat_left  = boolean->GetLeftMatrix();
+    const TGeoMatrix*   mat_right = boolean->GetRightMatrix();
+    std::string         str_oper;
+
+    TGeoBoolNode::EGeoBoolType oper = boolean->GetBooleanOperator();
+    if (oper == TGeoBoolNode::kGeoSubtraction)
+      str_oper = "subtraction";
+    else if (oper == TGeoBoolNode::kGeoUnion)
+      str_oper = "union";
+    else if (oper == TGeoBoolNode::kGeoIntersection)
+      str_oper = "intersection";
+
+    if ( left->IsA() == TGeoScaledShape::Class() && right->IsA() == TGeoBBox::Class() )   {
+      const auto* scaled = (TGeoScaledShape*)left;
+      const auto* sphere = (TGeoSphere*)scaled->GetShape();
+      const auto* box    = (TGeoBBox*)right;
+      if ( scaled->IsA() == TGeoSphere::Class() && oper == TGeoBoolNode::kGeoIntersection )   {
+        Double_t sx    = scaled->GetScale()->GetScale()[0];
+        Double_t sy    = scaled->GetScale()->GetScale()[1];
+        Double_t ax    = sx * sphere->GetRmax();
+        Double_t by    = sy * sphere->GetRmax();
+        Double_t cz    = sphere->GetRmax();
+        Double_t dz    = box->GetDZ();
+        Double_t zorig = box->GetOrigin()[2];
+        Double_t zcut2 = dz + zorig;
+        Double_t zcut1 = 2 * zorig - zcut2;
+        log << "<ellipsoid" << nam
+            << " lunit=\""  << m_len_unit_nam     << "\""
+            << " ax=\""     << ax/m_len_unit      << "\""
+            << " by=\""     << by/m_len_unit      << "\""
+            << " cz=\""     << cz/m_len_unit      << "\""
+            << " zcut1=\""  << zcut1/m_len_unit   << "\""
+            << " zcut2=\""  << zcut2/m_len_unit   << "\"/>";
+        iso = geo.emplace(solid, make_entry(log)).first;
+        return iso->second;
       }
-      log << "</polycone>";
-    }
-    else if ( cl == TGeoCone::Class() )  {
-      const TGeoCone* sh = (const TGeoCone*) shape;
-      log << "<cone" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " rmin1=\""  << check_null(sh->GetRmin1()/m_len_unit)  << "\""
-          << " rmin2=\""  << check_null(sh->GetRmin2()/m_len_unit)  << "\""
-          << " rmax1=\""  << check_null(sh->GetRmax1()/m_len_unit)  << "\""
-          << " rmax2=\""  << check_null(sh->GetRmax2()/m_len_unit)  << "\""
-          << " z=\""      << check_null(sh->GetDz()/m_len_unit)     << "\""
-          << " startphi=\"" << 0.0/m_ang_unit           << "\""
-          << " deltaphi=\"" << 360.0/m_ang_unit         << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoConeSeg::Class() )  {
-      const TGeoConeSeg* sh = (const TGeoConeSeg*) shape;
-      log << "<cone" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " rmin1=\""  << check_null(sh->GetRmin1()/m_len_unit)  << "\""
-          << " rmin2=\""  << check_null(sh->GetRmin2()/m_len_unit)  << "\""
-          << " rmax1=\""  << check_null(sh->GetRmax1()/m_len_unit)  << "\""
-          << " rmax2=\""  << check_null(sh->GetRmax2()/m_len_unit)  << "\""
-          << " z=\""      << check_null(sh->GetDz()/m_len_unit)     << "\""
-          << " startphi=\"" << check_null(sh->GetPhi1()/m_ang_unit) << "\""
-          << " deltaphi=\"" << check_null((sh->GetPhi1()-sh->GetPhi1())/m_ang_unit) << "\""
-          << "/>";
     }
-    else if ( cl == TGeoParaboloid::Class() )  {
-      const TGeoParaboloid* sh = (const TGeoParaboloid*) shape;
-      log << "<paraboloid" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " rlo=\""    << sh->GetRlo()/m_len_unit    << "\""
-          << " rhi=\""    << sh->GetRhi()/m_len_unit    << "\""
-          << " z=\""      << sh->GetDz()/m_len_unit     << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoSphere::Class() )   {
-      const TGeoSphere* sh = (const TGeoSphere*) shape;
-      log << "<sphere" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " rmin=\""   << sh->GetRmin()/m_len_unit   << "\""
-          << " rmax=\""   << sh->GetRmax()/m_len_unit   << "\""
-          << " startphi=\""   << sh->GetPhi1()/m_ang_unit << "\""
-          << " deltaphi=\""   << (sh->GetPhi1()-sh->GetPhi1())/m_ang_unit << "\""
-          << " starttheta=\"" << sh->GetTheta1()/m_ang_unit << "\""
-          << " deltatheta=\"" << (sh->GetTheta1()-sh->GetTheta1())/m_ang_unit << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoTorus::Class() )   {
-      const TGeoTorus* sh = (const TGeoTorus*) shape;
-      log << "<torus" << nam
-          << " lunit=\""  << m_len_unit_nam             << "\""
-          << " aunit=\""  << m_ang_unit_nam             << "\""
-          << " rtor=\""   << sh->GetR()/m_len_unit      << "\""
-          << " rmin=\""   << sh->GetRmin()/m_len_unit   << "\""
-          << " rmax=\""   << sh->GetRmax()/m_len_unit   << "\""
-          << " startphi=\""   << sh->GetPhi1()/m_ang_unit << "\""
-          << " deltaphi=\""   << sh->GetDphi()/m_ang_unit << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoArb8::Class() )   {
-      TGeoArb8* sh = (TGeoArb8*) shape;
-      const Double_t* v = sh->GetVertices();
-      log << "<arb8" << nam
-          << " v1x=\""    << v[0]/m_len_unit            << "\""
-          << " v1y=\""    << v[1]/m_len_unit            << "\""
-          << " v2x=\""    << v[2]/m_len_unit            << "\""
-          << " v2y=\""    << v[3]/m_len_unit            << "\""
-          << " v3x=\""    << v[4]/m_len_unit            << "\""
-          << " v3y=\""    << v[5]/m_len_unit            << "\""
-          << " v4x=\""    << v[6]/m_len_unit            << "\""
-          << " v4y=\""    << v[7]/m_len_unit            << "\""
-          << " v5x=\""    << v[8]/m_len_unit            << "\""
-          << " v5y=\""    << v[9]/m_len_unit            << "\""
-          << " v6x=\""    << v[10]/m_len_unit           << "\""
-          << " v6y=\""    << v[11]/m_len_unit           << "\""
-          << " v7x=\""    << v[12]/m_len_unit           << "\""
-          << " v7y=\""    << v[13]/m_len_unit           << "\""
-          << " v8x=\""    << v[14]/m_len_unit           << "\""
-          << " v8y=\""    << v[15]/m_len_unit           << "\""
-          << " dz=\""     << sh->GetDz()/m_len_unit     << "\""
-          << "/>";
-    }
-    else if ( cl == TGeoXtru::Class() )   {
-      const TGeoXtru* sh = (const TGeoXtru*) shape;
-      log << "<xtru" << nam << ">" << newline;
-      for (int i = 0; i < sh->GetNvert(); i++) {
-        log << " <twoDimVertex x=\"" << sh->GetX(i)/m_len_unit << "\""
-            << "\" y=\"" << sh->GetY(i)/m_len_unit << "\"/>" << newline;
-      }
-      for (int i = 0; i < sh->GetNz(); i++) {
-        log << " <section zOrder=\"" << i << "\""
-            << " scalingFactor=\"" << sh->GetScale(i) << "\""
-            << " zPosition=\"" << sh->GetZ(i)/m_len_unit << "\""
-            << " xOffset=\""   << sh->GetXOffset(i)/m_len_unit << "\""
-            << " yOffset=\""   << sh->GetYOffset(i)/m_len_unit << "\"/>" << newline;
+    // The name cannot be used. We hence use the full hash code
+    // for the left and right side shapes!
+    const entry_t&  ent_left  = handleSolid(Solid(left));
+    const entry_t&  ent_right = handleSolid(Solid(right));
+    const entry_t&  ent_pos_left = handlePosition(mat_left);
+    const entry_t&  ent_rot_left = handleRotation(mat_left);
+    const entry_t&  ent_pos_right = handlePosition(mat_right);
+    const entry_t&  ent_rot_right = handleRotation(mat_right);
+    log << "<" << str_oper << nam
+        << " lunit=\"" << m_len_unit_nam << "\""
+        << " aunit=\"" << m_ang_unit_nam << "\">" << newline
+        << " <first ref=\"" << (void*)ent_left.hash << "\""  << ">" << newline
+        << "  " << ent_pos_left.hash << newline
+        << "  " << ent_rot_left.hash << newline
+        << " </first>" << newline
+        << " <second ref=\"" << (void*)ent_right.hash << "\"" << ">" << newline
+        << "  " << ent_pos_right.hash << newline
+        << "  " << ent_rot_right.hash << newline
+        << " </second>" << newline
+        << "</" << str_oper << ">";
+  }
+  else if ( shape->IsA() == TGeoScaledShape::Class() )   {
+    const TGeoScaledShape* sh  = (TGeoScaledShape*)shape;
+    const TGeoShape*       org = sh->GetShape();
+    const double*          scl = sh->GetScale()->GetScale();
+    log << "<scaled_shape" << nam
+        << " sx=\"" << scl[0] << "\""
+        << " sy=\"" << scl[1] << "\""
+        << " sz=\"" << scl[2] << "\">" << newline
+        << "  " << handleSolid(Solid(org)).hash << newline
+        << "</scaled_shape>";
+  }
+  else if ( shape->IsA() == TGeoShapeAssembly::Class() )   {
+    log << "<shape_assembly " << nam << "\"/>";
+  }
+  else if ( shape->IsA() == TGeoTessellated::Class() )  {
+    if ( hash_meshes )   {
+      const TGeoTessellated* sh  = (TGeoTessellated*)shape;
+      log << "<define>" << newline;
+      if ( sh->IsClosedBody() == false ) {
+        except("DetectorChecksum","+++ TGeoTessellated volume is not closed: %s", solid.name());
       }
-      log << "</xtru>";
-    }
-    else if (shape->IsA() == TGeoCompositeShape::Class() )   {
-      const TGeoCompositeShape* sh  = (const TGeoCompositeShape*)shape;
-      const TGeoBoolNode* boolean   = sh->GetBoolNode();
-      const TGeoShape*    left      = boolean->GetLeftShape();
-      const TGeoShape*    right     = boolean->GetRightShape();
-      const TGeoMatrix*   mat_left  = boolean->GetLeftMatrix();
-      const TGeoMatrix*   mat_right = boolean->GetRightMatrix();
-      std::string         str_oper;
-
-      TGeoBoolNode::EGeoBoolType oper = boolean->GetBooleanOperator();
-      if (oper == TGeoBoolNode::kGeoSubtraction)
-        str_oper = "subtraction";
-      else if (oper == TGeoBoolNode::kGeoUnion)
-        str_oper = "union";
-      else if (oper == TGeoBoolNode::kGeoIntersection)
-        str_oper = "intersection";
-
-      if ( left->IsA() == TGeoScaledShape::Class() && right->IsA() == TGeoBBox::Class() )   {
-        const auto* scaled = (TGeoScaledShape*)left;
-        const auto* sphere = (TGeoSphere*)scaled->GetShape();
-        const auto* box    = (TGeoBBox*)right;
-        if ( scaled->IsA() == TGeoSphere::Class() && oper == TGeoBoolNode::kGeoIntersection )   {
-          Double_t sx    = scaled->GetScale()->GetScale()[0];
-          Double_t sy    = scaled->GetScale()->GetScale()[1];
-          Double_t ax    = sx * sphere->GetRmax();
-          Double_t by    = sy * sphere->GetRmax();
-          Double_t cz    = sphere->GetRmax();
-          Double_t dz    = box->GetDZ();
-          Double_t zorig = box->GetOrigin()[2];
-          Double_t zcut2 = dz + zorig;
-          Double_t zcut1 = 2 * zorig - zcut2;
-          log << "<ellipsoid" << nam
-              << " lunit=\""  << m_len_unit_nam     << "\""
-              << " ax=\""     << ax/m_len_unit      << "\""
-              << " by=\""     << by/m_len_unit      << "\""
-              << " cz=\""     << cz/m_len_unit      << "\""
-              << " zcut1=\""  << zcut1/m_len_unit   << "\""
-              << " zcut2=\""  << zcut2/m_len_unit   << "\"/>";
-          iso = geo.emplace(solid, make_entry(log)).first;
-          return iso->second;
+      // Note: "%.*f" gives the identical result as the fixed stream format, but
+      // formatting large meshes vertex by vertex through the stream is slow.
+      std::string vertices;
+      vertices.reserve(sh->GetNvertices() * (96 + newline.length()));
+      for (int ivertex = 0; ivertex < sh->GetNvertices(); ivertex++)  {
+        // Note: const_cast since TGeoTessellated::GetVertex not marked const in ROOT <= 6.28
+        const auto& vtx = const_cast<TGeoTessellated*>(sh)->GetVertex(ivertex);
+        char text[512];
+        const char* fmt = "<position name\"%s_v%d lunit=\"%s\" x=\"%.*f\" y=\"%.*f\" z=\"%.*f\"/>";
+        int len = std::snprintf(text, sizeof(text), fmt, nam.c_str(), ivertex, m_len_unit_nam.c_str(),
+                                precision, vtx.x()/m_len_unit, precision, vtx.y()/m_len_unit, precision, vtx.z()/m_len_unit);
+        if ( len < 0 || len >= int(sizeof(text)) )  {
+          std::stringstream vlog = logger();
+          vlog << "<position name\"" << nam << "_v" << ivertex
+               << " lunit=\"" << m_len_unit_nam << "\""
+               << " x=\"" << vtx.x()/m_len_unit << "\""
+               << " y=\"" << vtx.y()/m_len_unit << "\""
+               << " z=\"" << vtx.z()/m_len_unit << "\""
+               << "/>";
+          vertices += vlog.str();
         }
+        else  {
+          vertices.append(text, len);
+        }
+        vertices += newline;
       }
-      // The name cannot be used. We hence use the full hash code
-      // for the left and right side shapes!
-      const entry_t&  ent_left  = handleSolid(Solid(left));
-      const entry_t&  ent_right = handleSolid(Solid(right));
-      const entry_t&  ent_pos_left = handlePosition(mat_left);
-      const entry_t&  ent_rot_left = handleRotation(mat_left);
-      const entry_t&  ent_pos_right = handlePosition(mat_right);
-      const entry_t&  ent_rot_right = handleRotation(mat_right);
-      log << "<" << str_oper << nam
-          << " lunit=\"" << m_len_unit_nam << "\""
-          << " aunit=\"" << m_ang_unit_nam << "\">" << newline
-          << " <first ref=\"" << (void*)ent_left.hash << "\""  << ">" << newline
-          << "  " << ent_pos_left.hash << newline
-          << "  " << ent_rot_left.hash << newline
-          << " </first>" << newline
-          << " <second ref=\"" << (void*)ent_right.hash << "\"" << ">" << newline
-          << "  " << ent_pos_right.hash << newline
-          << "  " << ent_rot_right.hash << newline
-          << " </second>" << newline
-          << "</" << str_oper << ">";
-    }
-    else if ( shape->IsA() == TGeoScaledShape::Class() )   {
-      const TGeoScaledShape* sh  = (TGeoScaledShape*)shape;
-      const TGeoShape*       org = sh->GetShape();
-      const double*          scl = sh->GetScale()->GetScale();
-      log << "<scaled_shape" << nam
-          << " sx=\"" << scl[0] << "\""
-          << " sy=\"" << scl[1] << "\""
-          << " sz=\"" << scl[2] << "\">" << newline
-          << "  " << handleSolid(Solid(org)).hash << newline
-          << "</scaled_shape>";
-    }
-    else if ( shape->IsA() == TGeoShapeAssembly::Class() )   {
-      log << "<shape_assembly " << nam << "\"/>";
-    }
-    else if ( shape->IsA() == TGeoTessellated::Class() )  {
-      if ( hash_meshes )   {
-        const TGeoTessellated* sh  = (TGeoTessellated*)shape;
-        log << "<define>" << newline;
-        if ( sh->IsClosedBody() == false ) {
-          except("DetectorChecksum","+++ TGeoTessellated volume is not closed: %s", solid.name());
+      log << vertices;
+      log << "</define>" << newline;
+      log << "<tessellated name=\"" << nam << "\">" << newline;
+      for (int ifacet = 0; ifacet < sh->GetNfacets(); ifacet++)  {
+        // Note: const_cast since TGeoTessellated::GetFacet not marked const in ROOT <= 6.28
+        const auto& facet = const_cast<TGeoTessellated*>(sh)->GetFacet(ifacet);
+        if ( facet.GetNvert() == 3 ) {
+          log << "<triangular";
+        }
+        else if ( facet.GetNvert() == 4 ) {
+          log << "<quadrangular";
         }
-        for (int ivertex = 0; ivertex < sh->GetNvertices(); ivertex++)  {
-          // Note: const_cast since TGeoTessellated::GetVertex not marked const in ROOT <= 6.28
-          const auto& vtx = const_cast<TGeoTessellated*>(sh)->GetVertex(ivertex);
-          log << "<position name\"" << nam << "_v" << ivertex
-              << " lunit=\"" << m_len_unit_nam << "\""
-              << " x=\"" << vtx.x()/m_len_unit << "\""
-              << " y=\"" << vtx.y()/m_len_unit << "\""
-              << " z=\"" << vtx.z()/m_len_unit << "\""
-              << "/>" << newline;
+        else {
+          except("DetectorChecksum","+++ TGeoTessellated volume with unsupported number of vertices: %s", solid.name());
         }
-        log << "</define>" << newline;
-        log << "<tessellated name=\"" << nam << "\">" << newline;
-        for (int ifacet = 0; ifacet < sh->GetNfacets(); ifacet++)  {
-          // Note: const_cast since TGeoTessellated::GetFacet not marked const in ROOT <= 6.28
-          const auto& facet = const_cast<TGeoTessellated*>(sh)->GetFacet(ifacet);
-          if ( facet.GetNvert() == 3 ) {
-            log << "<triangular";
-          }
-          else if ( facet.GetNvert() == 4 ) {
-            log << "<quadrangular";
-          }
-          else {
-            except("DetectorChecksum","+++ TGeoTessellated volume with unsupported number of vertices: %s", solid.name());
-          }
-          for (int ivertex = 0; ivertex < facet.GetNvert(); ivertex++) {
+        for (int ivertex = 0; ivertex < facet.GetNvert(); ivertex++) {
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,31,1)
-            auto vertexIndex = facet[ivertex];
+          auto vertexIndex = facet[ivertex];
 #else
-            auto vertexIndex = facet.GetVertexIndex(ivertex);
+          auto vertexIndex = facet.GetVertexIndex(ivertex);
 #endif
-            log << " vertex" << ivertex + 1 << "=\"" << nam << "_v" << vertexIndex << "\"";
-          }
-          log << " type=\"ABSOLUTE\"/>" << newline;
+          log << " vertex" << ivertex + 1 << "=\"" << nam << "_v" << vertexIndex << "\"";
         }
-        log << "</tessellated>" << newline;
+        log << " type=\"ABSOLUTE\"/>" << newline;
       }
-      else {
-        log << "<tessellated></tessellated>" << newline;
-      }
-    }
-    else   {
-      except("DetectorChecksum","+++ Unknown shape: %s", solid.name());
+      log << "</tessellated>" << newline;
     }
-    auto ins = geo.emplace(solid, make_entry(log));
-    if ( !ins.second )   {
-      except("DetectorChecksum", "+++ FAILED to register shape: %s", solid.name());
+    else {
+      log << "<tessellated></tessellated>" << newline;
     }
-    iso = ins.first;
   }
-  return iso->second;
+  else   {
+    except("DetectorChecksum","+++ Unknown shape: %s", solid.name());
+  }
+  return make_entry(log);
 }
 
 /// Convert the Position into the corresponding Xml object(s).
@@ -917,7 +946,8 @@ const DetectorChecksum::entry_t& DetectorChecksum::handleDetElement(DetElement d
   if ( dit == geo.end() )   {
     std::stringstream log = logger();
     const auto& place = handlePlacement(det.placement());
-    const auto& par = det.parent().isValid() ? handleDetElement(det.parent()) : empty_entry;
+    /// Merkle mode: the tree structure enters through the subtree hashes, not the parent's code
+    const auto& par = det.parent().isValid() && !merkle ? handleDetElement(det.parent()) : empty_entry;
     log << "<detelement"
         << " name=\""          << det.name()        << "\""
         << " id=\""            << det.id()          << "\""
@@ -1085,9 +1115,11 @@ void DetectorChecksum::analyzeDetector(DetElement top)      {
   if (!top.isValid()) {
     throw std::runtime_error("Attempt to call analyzeDetector with an invalid geometry!");
   }
+  if ( m_dataPtr ) delete m_dataPtr;
   GeometryInfo& geo = *(m_dataPtr = new GeometryInfo);
   m_data->clear();
   handleHeader();
+  if ( num_threads > 1 ) hashSolids(top);
   collect_det_elements(top);
   for (const auto& fld : description.fields() )
     handleField(fld.second);
@@ -1204,8 +1236,8 @@ void DetectorChecksum::checksumDetElement(int lvl, DetElement det, hashes_t& has
         checksumDetElement(lvl+1, c.second, hashes, recursive);
     }
 
-    /// All done: Some debugging printout
-    if ( debug > 0 || lvl <= max_level )  {
+    /// All done: Some debugging printout (only meaningful for the full subtree)
+    if ( recursive && (debug > 0 || lvl <= max_level) )  {
       std::stringstream str;
       hash_t code = detail::hash64(&hashes[hash_idx_de], (hash_idx_ro-hash_idx_de)*sizeof(hash_t));
       str << "+++ " << std::setw(4) << std::left << lvl
@@ -1290,6 +1322,127 @@ void DetectorChecksum::checksumPlacement(PlacedVolume pv, hashes_t& hashes, bool
   except("DetectorChecksum","ERROR: Cannot checksum invalid PlacedVolume");
 }
 
+/// Merkle hash of a DetElement subtree
+DetectorChecksum::hash_t DetectorChecksum::checksumSubtree(int lvl, DetElement det)  const  {
+  auto& dat = data();
+  auto  it  = dat.mapOfSubtrees.find(det);
+  if ( it != dat.mapOfSubtrees.end() )   {
+    return it->second;
+  }
+  if ( dat.mapOfDetElements.find(det) == dat.mapOfDetElements.end() )   {
+    collect_det_elements(det);
+  }
+  hashes_t hashes;
+  checksumDetElement(lvl, det, hashes, false);
+  std::size_t num_own = hashes.size();
+  for ( const auto& c : det.children() )
+    hashes.push_back(checksumSubtree(lvl+1, c.second));
+  hash_t code = detail::hash64(&hashes[0], hashes.size()*sizeof(hash_t));
+  if ( debug > 0 || lvl <= max_level )  {
+    std::stringstream str;
+    str << "+++ " << std::setw(4) << std::left << lvl
+        << " " << std::setw(36) << std::left << det.name() << " subtree"
+        << " " << std::setfill('0') << std::setw(16) << std::hex << code
+        << "  (" << std::dec << num_own << " own codes, "
+        << det.children().size() << " children)";
+    std::cout << str.str() << std::endl;
+  }
+  dat.mapOfSubtrees.emplace(det, code);
+  return code;
+}
+
+/// Invalidate the cached hashes of a DetElement subtree
+void DetectorChecksum::invalidate(DetElement det)   {
+  auto& dat = data();
+  /// Drop the placements with their transformations and volumes
+  std::function<void(PlacedVolume, bool)> drop_place = [&](PlacedVolume pv, bool recursive)   {
+    if ( !pv.isValid() ) return;
+    TGeoMatrix* matrix = pv->GetMatrix();
+    dat.mapOfPlacements.erase(pv);
+    dat.mapOfPositions.erase(matrix);
+    dat.mapOfRotations.erase(matrix);
+    dat.mapOfVolumes.erase(pv.volume());
+    if ( recursive )   {
+      for (Int_t i = 0, n = pv.volume()->GetNdaughters(); i < n; ++i)
+        drop_place(pv.volume()->GetNode(i), recursive);
+    }
+  };
+  drop_place(det.placement(), true);
+  /// The DetElement codes of the subtree contain the dropped placements
+  std::function<void(DetElement)> drop_element = [&](DetElement de)   {
+    dat.mapOfDetElements.erase(de);
+    dat.mapOfSubtrees.erase(de);
+    for ( const auto& c : de.children() )
+      drop_element(c.second);
+  };
+  drop_element(det);
+  /// The parents' volumes contain the placement hashes of the daughters:
+  /// drop the placements on the path to the top and the codes of the parents.
+  /// Subtree hashes of other branches do not depend on the parents and stay valid.
+  for ( DetElement child = det, par = det.parent(); par.isValid(); child = par, par = par.parent() )  {
+    auto chain = _get_path(par.placement(), { child.placement() });
+    for ( std::size_t i = 1; i < chain.size(); ++i )
+      drop_place(chain[i], false);
+    dat.mapOfDetElements.erase(par);
+    dat.mapOfSubtrees.erase(par);
+  }
+}
+
+/// Hash the solids used by the subtree in parallel
+void DetectorChecksum::hashSolids(DetElement top)  const  {
+  auto& geo = data().mapOfSolids;
+  std::set<const TGeoVolume*> volumes;
+  std::set<const TGeoShape*>  shapes;
+  std::vector<TGeoVolume*>    stack { top.placement().volume().ptr() };
+  std::vector<Solid>          solids;
+
+  /// Collect the solids of all volumes. Boolean and scaled shapes reference
+  /// other entries and are handled during the tree traversal.
+  while ( !stack.empty() )   {
+    TGeoVolume* vol = stack.back();
+    stack.pop_back();
+    if ( !vol || !volumes.insert(vol).second ) continue;
+    TGeoShape* shape = vol->GetShape();
+    if ( shape && shapes.insert(shape).second &&
+         shape->IsA() != TGeoCompositeShape::Class() &&
+         shape->IsA() != TGeoScaledShape::Class()    &&
+         geo.find(Solid(shape)) == geo.end() )   {
+      solids.emplace_back(shape);
+    }
+    for ( Int_t i = 0, n = vol->GetNdaughters(); i < n; ++i )
+      stack.emplace_back(vol->GetNode(i)->GetVolume());
+  }
+
+  std::size_t num_workers = std::min(std::size_t(num_threads), solids.size());
+  std::vector<entry_t> entries(solids.size());
+  std::vector<std::exception_ptr> errors(num_workers);
+  std::atomic<std::size_t> next { 0 };
+  auto work = [&](std::size_t id)  {
+    try  {
+      for ( std::size_t i = next++; i < solids.size(); i = next++ )
+        entries[i] = hashSolid(solids[i]);
+    }
+    catch(...)  {
+      errors[id] = std::current_exception();
+      next = solids.size();
+    }
+  };
+  std::vector<std::thread> workers;
+  for ( std::size_t i = 1; i < num_workers; ++i )
+    workers.emplace_back(work, i);
+  if ( num_workers > 0 ) work(0);
+  for ( auto& w : workers )
+    w.join();
+  for ( const auto& e : errors )
+    if ( e ) std::rethrow_exception(e);
+  for ( std::size_t i = 0; i < solids.size(); ++i )
+    geo.emplace(solids[i], std::move(entries[i]));
+  if ( debug > 1 )   {
+    printout(ALWAYS, "DetectorChecksum", "++ Hashed %ld solids with %ld threads.",
+             solids.size(), num_workers);
+  }
+}
+
 /// Dump elements used in this apparatus
 void DetectorChecksum::dump_elements()   const   {
   _do_output_name("Element", reorder, write_files, debug>1 && have_hash_strings, data().mapOfElements);
@@ -1373,7 +1526,8 @@ static long create_checksum(Detector& description, int argc, char** argv) {
   int dump_iddesc = 0, dump_segmentations = 0, dump_pos = 0;
   int dump_rot = 0;
   int have_hash_strings = 0, reorder = 0, write_files = 0;
-  std::string len_unit, ang_unit, ene_unit, dens_unit, atom_unit;
+  int threads = 1, merkle = 0;
+  std::string len_unit, ang_unit, ene_unit, dens_unit, atom_unit, recheck, modify;
 
   for(int i = 0; i < argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-detector",argv[i],4) && (i+1)<argc )
@@ -1428,6 +1582,18 @@ static long create_checksum(Detector& description, int argc, char** argv) {
       reorder = 1;
     else if ( 0 == ::strncmp("-keep_hashes",argv[i],8) )
       have_hash_strings = 1;
+    else if ( 0 == ::strncmp("-threads",argv[i],5) && (i+1)<argc )
+      threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-merkle",argv[i],5) )
+      merkle = 1;
+    else if ( 0 == ::strncmp("-recheck",argv[i],5) && (i+1)<argc )  {
+      recheck = argv[++i];
+      merkle  = 1;
+    }
+    else if ( 0 == ::strncmp("-modify",argv[i],4) && (i+1)<argc )  {
+      modify  = argv[++i];
+      merkle  = 1;
+    }
     else  {
       std::cout <<
         "Usage: -plugin DD4hepDetectorChecksum -arg [-arg]                             \n\n"
@@ -1442,6 +1608,16 @@ static long create_checksum(Detector& description, int argc, char** argv) {
         "                            Useful for debugging and -dump_<x> options.         \n"
         "     -precsision <digits>   Set floating point precision after comma            \n"
         "                            for the checsum calculation.                        \n"
+        "     -threads <number>      Number of threads to hash the solids before         \n"
+        "                            the tree traversal. 0: all cores. default: 1        \n"
+        "     -merkle                Compute the checksum as Merkle tree of the          \n"
+        "                            DetElement subtree hashes. Gives a different        \n"
+        "                            value than the default combined hash code.          \n"
+        "     -recheck <path>        Merkle mode: invalidate the DetElement subtree      \n"
+        "                            <path>, rehash and verify the checksum.             \n"
+        "     -modify <path>         Merkle mode: shift the placement of the DetElement  \n"
+        "                            <path>, rehash and verify that only the subtree     \n"
+        "                            hashes of the branch to the top change.             \n"
         "                                                                                \n"
         "   Debugging: Dump individual hash codes (debug>=1)                             \n"
         "   Debugging: and the hashed string (debug>2)                                   \n"
@@ -1489,6 +1665,8 @@ static long create_checksum(Detector& description, int argc, char** argv) {
   wr.hash_readout = readout;
   wr.max_level    = level;
   wr.debug        = debug;
+  wr.num_threads  = threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+  wr.merkle       = merkle;
   wr.configure();
 
   bool make_dump = false;
@@ -1506,6 +1684,71 @@ static long create_checksum(Detector& description, int argc, char** argv) {
 
   DetectorChecksum::hashes_t hash_vec;
   DetectorChecksum::hash_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto print_time = [&start, &wr]()   {
+    std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+    printout(INFO,"DetectorChecksum","+++ Checksum computed in %.1f ms [%d threads]", ms.count(), wr.num_threads);
+    start = std::chrono::steady_clock::now();
+  };
+  if ( merkle )  {
+    std::vector<DetElement> tops;
+    for (const auto& det : detectors )
+      tops.emplace_back(detail::tools::findElement(description,det));
+    if ( tops.empty() ) tops.emplace_back(de);
+    for (DetElement top : tops )   {
+      wr.analyzeDetector(top);
+      auto merkle_hash = [&wr, &description, top]()   {
+        DetectorChecksum::hash_t codes[2] = { wr.checksumSubtree(0, top), 0 };
+        if ( top.ptr() != description.world().ptr() ) return codes[0];
+        codes[1] = wr.data().header.hash;
+        return detail::hash64(codes, sizeof(codes));
+      };
+      checksum = merkle_hash();
+      print_time();
+      printout(ALWAYS,"DetectorChecksum","+++ Merkle hash for %s 0x%016lx",
+               top.path().c_str(), checksum);
+      if ( !recheck.empty() )   {
+        wr.invalidate(detail::tools::findElement(description, recheck));
+        DetectorChecksum::hash_t code = merkle_hash();
+        print_time();
+        printout(ALWAYS,"DetectorChecksum","+++ Merkle hash for %s 0x%016lx after rehashing %s: %s",
+                 top.path().c_str(), code, recheck.c_str(), code == checksum ? "VERIFIED" : "CHANGED");
+      }
+      if ( !modify.empty() )   {
+        DetElement det = detail::tools::findElement(description, modify);
+        auto before = wr.data().mapOfSubtrees;
+        /// Shift the placement by 1 mm along z and rehash incrementally
+        PlacedVolume pv = det.placement();
+        TGeoHMatrix* moved = new TGeoHMatrix(*pv->GetMatrix());
+        moved->SetDz(moved->GetTranslation()[2] + 1e0*dd4hep::mm);
+        static_cast<TGeoNodeMatrix*>(pv.ptr())->SetMatrix(moved);
+        wr.invalidate(det);
+        DetectorChecksum::hash_t code = merkle_hash();
+        print_time();
+        auto incremental = wr.data().mapOfSubtrees;
+        /// Reference: rehash the modified geometry from scratch
+        wr.analyzeDetector(top);
+        DetectorChecksum::hash_t fresh = merkle_hash();
+        const auto& after = wr.data().mapOfSubtrees;
+        std::set<DetElement> branch;
+        for ( DetElement e = det; e.isValid(); e = e.parent() )
+          branch.insert(e);
+        bool only_branch = code != checksum && code == fresh && incremental == after;
+        std::size_t num_changed = 0;
+        for ( const auto& b : before )   {
+          auto it = after.find(b.first);
+          bool changed = it == after.end() || it->second != b.second;
+          num_changed += changed ? 1 : 0;
+          only_branch &= changed == (branch.find(b.first) != branch.end());
+        }
+        printout(ALWAYS,"DetectorChecksum","+++ Merkle hash for %s 0x%016lx after modifying %s: "
+                 "%ld of %ld subtree hashes changed: %s", top.path().c_str(), code, modify.c_str(),
+                 num_changed, before.size(), only_branch ? "ONLY THE MODIFIED BRANCH" : "UNEXPECTED CHANGES");
+      }
+      if ( make_dump ) goto MakeDump;
+    }
+    return 1;
+  }
   if ( !detectors.empty() )  {
     for (const auto& det : detectors )   {
       de = detail::tools::findElement(description,det);
@@ -1517,6 +1760,7 @@ static long create_checksum(Detector& description, int argc, char** argv) {
         wr.debug_hash.str("");
       }
       checksum = detail::hash64(&hash_vec[0], hash_vec.size()*sizeof(DetectorChecksum::hash_t));
+      print_time();
       printout(ALWAYS,"DetectorChecksum","+++ Checksum for %s 0x%016lx",
                de.path().c_str(), checksum);
       if ( make_dump ) goto MakeDump;
@@ -1529,6 +1773,7 @@ static long create_checksum(Detector& description, int argc, char** argv) {
   hash_vec.push_back(wr.handleHeader().hash);
   wr.checksumDetElement(0, description.world(), hash_vec, true);
   checksum = detail::hash64(&hash_vec[0], hash_vec.size()*sizeof(DetectorChecksum::hash_t));
+  print_time();
   if ( wr.debug > 2 ) std::cout << wr.debug_hash.str() << std::endl;
   printout(ALWAYS,"DetectorChecksum","+++ Checksum for %s 0x%016lx",
            de.path().c_str(), checksum);
@@ -57,6 +57,7 @@ namespace dd4hep {
       using FieldMap         = std::map<OverlayedField,    entry_t>;
       using TrafoMap         = std::map<const TGeoMatrix*, entry_t>;
       using MapOfDetElements = std::map<DetElement,        entry_t>;
+      using SubtreeMap       = std::map<DetElement,        hash_t>;
 
       /// Data structure of the geometry converter from dd4hep to Geant 4 in Detector format.
       /**
@@ -82,6 +83,8 @@ namespace dd4hep {
         FieldMap         mapOfFields;
         AlignmentMap     mapOfAlignments;
         MapOfDetElements mapOfDetElements;
+        /// Merkle hashes of the DetElement subtrees
+        SubtreeMap       mapOfSubtrees;
         entry_t  header;
 
         GeometryInfo() = default;
@@ -126,6 +129,10 @@ namespace dd4hep {
       int debug                 { 4 };
       int reorder               { 1 };
       int write_files           { 1 };
+      /// Property: number of threads to hash the solids before the tree traversal
+      int num_threads           { 1 };
+      /// Property: Merkle mode. DetElement codes do not contain the parent's code
+      int merkle                { 0 };
 
       GeometryInfo& data() const {
         return *m_dataPtr;
@@ -150,6 +157,19 @@ namespace dd4hep {
       typedef std::vector<hash_t> hashes_t;
       void checksumPlacement(PlacedVolume pv, hashes_t& hashes, bool recursive)  const;
       void checksumDetElement(int level, DetElement det, hashes_t& hashes, bool recursive)  const;
+      /// Merkle hash of a DetElement subtree: hash of the DetElement's own codes and the children's subtree hashes
+      /** Subtree hashes are cached and depend only on the content of the subtree.
+       *  After invalidate() only the modified subtree and the path to the top are rehashed.
+       *  Requires the "merkle" property to be set before analyzeDetector().
+       */
+      hash_t checksumSubtree(int level, DetElement det)  const;
+      /// Invalidate the cached hashes of a DetElement subtree (e.g. after alignment changes)
+      /** Drops the codes of the subtree and of its parents. Volumes shared with
+       *  other branches must not be modified: their subtree hashes stay cached.
+       */
+      void invalidate(DetElement det);
+      /// Hash the solids used by the subtree in parallel ("num_threads" workers)
+      void hashSolids(DetElement top)  const;
 
       /// Add header information in Detector format
       virtual const entry_t& handleHeader() const;
@@ -162,6 +182,8 @@ namespace dd4hep {
 
       /// Convert the geometry type solid into the corresponding gdml string
       virtual const entry_t& handleSolid(Solid solid) const;
+      /// Compute the hash entry of a solid without registering it
+      entry_t hashSolid(Solid solid) const;
 
       /// Convert the geometry type logical volume into the corresponding gdml string
       virtual const entry_t& handleVolume(Volume volume) const;
@@ -35,6 +35,7 @@ namespace dd4hep {
     /// Forward declarations
     class DigiActionSequence;
     class DigiKernel;
+    class DigiAction;
 
     /// Generic context to extend user, run and event information
     /**
@@ -112,6 +113,8 @@ namespace dd4hep {
 
       /// Initializing constructor
       DigiContext(const DigiKernel& kernel, std::unique_ptr<DigiEvent>&& event);
+      /// Initializing constructor for a private event sharing the random engine of the parent context
+      DigiContext(const DigiContext& parent, std::unique_ptr<DigiEvent>&& event);
       /// Default destructor
       virtual ~DigiContext();
 
@@ -124,6 +127,24 @@ namespace dd4hep {
 
       /// Access to the random engine for this event
       DigiRandomGenerator& randomGenerator()  const  { return *m_random; }
+      /// Counter based random stream of an action and a channel (e.g. a cell or a container key)
+      /** The stream depends only on the kernel seed, the event number,
+       *  the action name and the channel: the numbers are reproducible
+       *  independent of the thread scheduling.
+       */
+      DigiRandomStream randomStream(const DigiAction& action, std::uint64_t channel = 0)  const;
+      /// Per-event key of the random streams of an action
+      std::uint64_t randomKey(const DigiAction& action)  const;
+      /// Per-event key of the random streams of an action from the hash of its name
+      std::uint64_t randomKey(std::uint64_t name_hash)  const;
+      /// Counter based random stream of a per-event key and a channel
+      /** randomStream(randomKey(action), channel) is identical to
+       *  randomStream(action, channel). Callers creating many streams
+       *  per event keep the key and avoid hashing the action name again.
+       */
+      static DigiRandomStream randomStream(std::uint64_t key, std::uint64_t channel)   {
+        return DigiRandomStream(key, channel);
+      }
       /// Access to the user framework. Specialized function to be implemented by the client
       template <typename T> T& framework()  const;
       /// Generic framework access
@@ -144,8 +144,29 @@ namespace dd4hep {
       static submask_type submask(Key k);
       /// Access key name (if registered properly)
       static std::string key_name(const Key& key);
+      /// Register the name of an item key for reverse lookups. Returns the item key
+      /** Lock-free: may be called concurrently during event processing.
+       *  If two names have the same item key, the last registered name is kept.
+       */
+      static itemkey_type register_name(const std::string& name);
+      /// Item key of a name. Identical to detail::hash32, but usable at compile time
+      static constexpr itemkey_type hash(const char* name);
     };
 
+    /// Item key of a name. Identical to detail::hash32, but usable at compile time
+    inline constexpr Key::itemkey_type Key::hash(const char* name)   {
+      itemkey_type hash = 0;
+      for ( ; *name; ++name )   {
+        hash += itemkey_type(*name);
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+      }
+      hash += (hash << 3);
+      hash ^= (hash >> 11);
+      hash += (hash << 15);
+      return hash;
+    }
+
     /// Default constructor
     inline Key::Key()    {
       this->key = 0;
@@ -499,6 +520,7 @@ namespace dd4hep {
         ZERO_SUPPRESSED    = 1 << 4,
         DEPOSIT_NOISE      = 1 << 5,
         RECALIBRATED       = 1 << 6,
+        TIME_OVERLAP       = 1 << 7,
       };
 
       /// Hit position
@@ -17,6 +17,10 @@
 #include <DDDigi/DigiData.h>
 #include <DDDigi/DigiAction.h>
 #include <DDDigi/DigiMonitorOptions.h>
+#include <DD4hep/HistogramAccumulator.h>
+
+/// C/C++ include files
+#include <memory>
 
 /// Forward declarations
 class TH1;
@@ -28,13 +32,25 @@ namespace dd4hep {
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
+    /// Base class of the monitoring histogram wrappers
+    /**
+     *  Entries are accumulated in per-thread bin arrays and merged into
+     *  the ROOT histogram by the monitor handler before it is saved.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
     template <typename HISTO> class Histogram  {
       friend class DigiKernel;
       friend class DigiDepositMonitor;
     protected:
       HISTO* hist  { nullptr };
+      /// Per-thread bin arrays
+      std::shared_ptr<HistogramAccumulator> bins;
     public:
       Histogram(HISTO* h) : hist(h) {}
+      Histogram(HISTO* h, std::shared_ptr<HistogramAccumulator> b) : hist(h), bins(std::move(b)) {}
     };
 
     /// Wrapper for 1 dimensional monitoring histograms
@@ -46,6 +62,7 @@ namespace dd4hep {
      */
     class Histo1D : public Histogram<TH1>  {
     public:
+      using Histogram<TH1>::Histogram;
       /// Add 1D histogram entry with weight
       void fill(double x, double weight=1.0);
     };
@@ -59,6 +76,7 @@ namespace dd4hep {
      */
     class Histo2D : public Histogram<TH2>   {
     public:
+      using Histogram<TH2>::Histogram;
       /// Add 2D histogram entry with weight
       void fill(double x, double y, double weight=1.0);
     };
@@ -27,6 +27,9 @@ class TH1;
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
+  /// Forward declarations
+  class HistogramAccumulator;
+
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
@@ -118,6 +121,12 @@ namespace dd4hep {
       std::size_t events_done()  const;
       /// Access current number of events processing (events in flight)
       std::size_t events_processing()  const;
+      /// Access the seed of the counter based random streams
+      std::uint64_t randomSeed()  const;
+      /// Request to stop the event loop (e.g. after a failure outside the event threads)
+      void stop_event_loop()  const;
+      /// Check if the event loop shall be stopped
+      bool stop_requested()  const;
 
       /// Register configure callback. Signature:   (function)()
       void register_configure(const std::function<void()>& callback)   const;
@@ -132,6 +141,10 @@ namespace dd4hep {
 
       /// Registration of monitoring objects eventually saved by the handler
       void register_monitor(DigiAction* action, TNamed* histo)  const;
+      /// Registration of histograms filled by per-thread accumulation. Merged before saving
+      void register_monitor(DigiAction* action, TNamed* histo, std::shared_ptr<HistogramAccumulator> bins)  const;
+      /// Merge the per-thread accumulated monitoring histograms (on demand, no events may be processed)
+      void merge_monitors()  const;
 
       /// Construct detector geometry using description plugin
       virtual void loadGeometry(const std::string& compact_file);
@@ -17,11 +17,17 @@
 #include <DDDigi/DigiAction.h>
 
 /// C/C++ include files
+#include <memory>
+
+/// Forward declarations
 class TNamed;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
+  /// Forward declarations
+  class HistogramAccumulator;
+
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
@@ -42,6 +48,8 @@ namespace dd4hep {
 
       /// Map of monitoring items
       std::map<DigiAction*, std::set<TNamed*> > m_monitors;
+      /// Per-thread accumulators of monitoring histograms
+      std::map<TNamed*, std::shared_ptr<HistogramAccumulator> > m_accumulators;
 
     public:
       /// Standard constructor
@@ -50,6 +58,10 @@ namespace dd4hep {
       virtual ~DigiMonitorHandler();
       /// Adopt monitor and keep reference for saving
       void adopt(DigiAction* source, TNamed* object);
+      /// Attach per-thread accumulator to an adopted histogram
+      void adopt(TNamed* object, std::shared_ptr<HistogramAccumulator> bins);
+      /// Merge the accumulated entries into the histograms
+      void merge();
       /// Save monitors
       void save();
     };
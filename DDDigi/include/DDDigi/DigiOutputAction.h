@@ -16,6 +16,9 @@
 /// Framework include files
 #include <DDDigi/DigiContainerProcessor.h>
 
+/// C/C++ include files
+#include <memory>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -27,6 +30,15 @@ namespace dd4hep {
 
     /// Base class for output actions to the digitization
     /**
+     *  Writers supporting staged output implement create_frame() and commit_frame():
+     *  the container processors convert the event data concurrently and without
+     *  any lock into the frame of the event. The frames are handed to a single
+     *  committer thread, which writes them in the order of the event numbers.
+     *  If more than maxEventsParallel frames wait for the committer, the event
+     *  threads block until the committer caught up.
+     *  With staged_output=false the frame is committed by the event thread
+     *  under the global IO lock. Writers without frame support convert and
+     *  commit the event data under the global IO lock.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -34,6 +46,23 @@ namespace dd4hep {
      */
     class DigiOutputAction : public DigiContainerSequenceAction {
     public:
+      /// Staged output data of one event
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class frame_t  {
+      public:
+        /// Event number defining the commit order
+        long event  { 0 };
+        /// Default destructor
+        virtual ~frame_t() = default;
+      };
+      using frame_pointer_t = std::unique_ptr<frame_t>;
+      /// Staging and committer thread data
+      class staging_t;
+
     protected:
       /// Property: Processor type to manage containers
       std::string                        m_processor_type  { };
@@ -43,6 +72,11 @@ namespace dd4hep {
       std::string                        m_output { };
       /// Property: Create stream names with sequence numbers
       bool                               m_sequence_streams  {  true };
+      /// Property: Convert events concurrently and commit staged frames in order
+      bool                               m_staged_output     {  true };
+
+      /// Frame staging and committer thread
+      std::unique_ptr<staging_t>         m_staging;
 
       /// Total numbe rof events to be processed
       long num_events  { -1 };
@@ -77,8 +111,22 @@ namespace dd4hep {
       /// Close current output stream
       virtual void close_output() const = 0;
 
-      /// Commit event data to output stream
-      virtual void commit_output() const = 0;
+      /// Commit event data to output stream (writers without frame support)
+      virtual void commit_output() const;
+
+      /// Create the (empty) output frame of one event. Default: no frame support
+      virtual frame_pointer_t create_frame()  const;
+
+      /// Commit staged event data to the output stream (called by the committer thread)
+      virtual void commit_frame(frame_t& frame)  const;
+
+      /// Access the output frame of an event during the conversion
+      frame_t& staged_frame(const context_t& context)  const;
+
+      /// Access the output frame of an event during the conversion
+      template <typename FRAME> FRAME& staged_frame(const context_t& context)  const  {
+        return static_cast<FRAME&>(this->staged_frame(context));
+      }
 
       /// Create new output stream name
       virtual std::string next_stream_name();
@@ -93,6 +141,10 @@ namespace dd4hep {
 
       /// Callback to read event output
       virtual void execute(context_t& context)  const override;
+
+    private:
+      /// Committer thread: write staged frames in the order of the event numbers
+      void run_committer()  const;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
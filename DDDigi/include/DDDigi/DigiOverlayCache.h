@@ -0,0 +1,141 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIOVERLAYCACHE_H
+#define DDDIGI_DIGIOVERLAYCACHE_H
+
+/// Framework include files
+#include <DDDigi/DigiActionSequence.h>
+#include <DDDigi/DigiData.h>
+
+/// C/C++ include files
+#include <list>
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Pile-up overlay from a size-bounded cache of decoded background events
+    /**
+     *  The adopted actions (typically a DigiInputAction reading minimum bias
+     *  events) are executed in a private event context to load one background
+     *  event. The deposit containers of its input segment are decoded once
+     *  and kept read-only in the cache.
+     *
+     *  Every signal event overlays a number of background events, which is
+     *  Poisson distributed with mean mean_overlay (or exactly mean_overlay
+     *  if poisson=false). The background events are sampled with replacement
+     *  from a pool of pool_size slots using the event random stream.
+     *
+     *  If cache_size >= pool_size, slot i is bound to the i-th background
+     *  event of the sources: the slots are loaded in order on demand and
+     *  never evicted. The overlay is then reproducible independent of the
+     *  number of threads and the event scheduling.
+     *  If cache_size < pool_size, at most cache_size events are kept and the
+     *  least recently used are evicted. A slot not present in the cache is
+     *  loaded with the next background event from the sources: the slot to
+     *  event mapping depends on the order of the cache misses and the
+     *  overlay is NOT reproducible.
+     *
+     *  Only the read and the decoding of the background events are cached.
+     *  The deposits of all sampled background events are copied once per
+     *  overlay into one DepositVector per container in the output segment
+     *  with mask output_mask: a background event sampled twice is copied
+     *  twice, but there are no intermediate containers.
+     *  Particles and the deposit history of the background events are not
+     *  overlaid: they refer to the private background event.
+     *
+     *  At the end of the run the cache hit rate is printed.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiOverlayCache : public DigiSequentialActionSequence   {
+    public:
+      /// Decoded background event. Read-only once in the cache
+      struct entry_t   {
+        /// Deposit containers by name
+        std::map<std::string, DepositVector> containers;
+        /// Total number of deposits
+        std::size_t                          num_deposits { 0 };
+      };
+      using entry_pointer_t = std::shared_ptr<const entry_t>;
+      /// Cache slot: entry and position in the LRU list
+      using slot_t = std::pair<entry_pointer_t, std::list<long>::iterator>;
+
+    protected:
+      /// Property: Number of cached background events
+      std::size_t                         m_cache_size        { 100 };
+      /// Property: Number of distinct background events sampled (pool slots)
+      std::size_t                         m_pool_size         { 100 };
+      /// Property: Mean number of overlaid background events per signal event
+      double                              m_mean_overlay      { 1e0 };
+      /// Property: Poisson distributed number of overlays (otherwise fixed)
+      bool                                m_poisson           { true };
+      /// Property: Segment of the background events containing the deposits
+      std::string                         m_input_segment     { "inputs" };
+      /// Property: Output segment of the overlaid containers
+      std::string                         m_output_segment    { "inputs" };
+      /// Property: Output mask of the overlaid containers
+      int                                 m_output_mask       { 0x0 };
+
+      /// Lock protecting the cache
+      mutable std::mutex                  m_lock;
+      /// Lock serializing the background reads
+      mutable std::mutex                  m_read_lock;
+      /// Cached background events by pool slot
+      mutable std::map<long, slot_t>      m_cache;
+      /// Pool slots in the order of the last use (front: most recent)
+      mutable std::list<long>             m_lru;
+      /// Number of background events read
+      mutable long                        m_num_reads         { 0 };
+      /// Next slot to be loaded in order (reproducible mode)
+      mutable long                        m_next_slot         { 0 };
+      /// Number of cache evictions
+      mutable long                        m_num_evictions     { 0 };
+      /// Cache hits
+      mutable std::atomic<long>           m_num_hits          { 0 };
+      /// Cache misses
+      mutable std::atomic<long>           m_num_misses        { 0 };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiOverlayCache);
+
+      /// Read and decode the next background event (m_read_lock held)
+      entry_pointer_t read_entry(context_t& context)  const;
+      /// Access the background event of a pool slot. Reads it on a cache miss
+      entry_pointer_t get_entry(context_t& context, long slot)  const;
+      /// Add a background event to the cache. Evicts the least recently used (m_lock held)
+      void insert_entry(long slot, const entry_pointer_t& entry)  const;
+      /// Check if slots are bound to fixed background events
+      bool reproducible()  const   {  return m_cache_size >= m_pool_size;  }
+      /// Finalization callback
+      void finalize();
+
+    public:
+      /// Standard constructor
+      DigiOverlayCache(const kernel_t& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiOverlayCache();
+      /// Overlay the sampled background events onto the signal event
+      virtual void execute(context_t& context)  const override;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIOVERLAYCACHE_H
@@ -17,6 +17,9 @@
 
 /// C/C++ include files
 #include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <array>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -72,6 +75,101 @@ namespace dd4hep {
       void   sphere(double& x, double& y, double& z, double r)   const;
       void   circle(double &x, double &y, double r)  const;
     };
+
+    /// Counter based random number stream (Philox4x32-10)
+    /**
+     *  The n-th random number of a stream is a pure function of the key,
+     *  the stream identifier and n. Streams created with the same key and
+     *  identifier deliver identical sequences, independent of the thread
+     *  executing the request and of the order in which streams are used.
+     *
+     *  DigiContext::randomStream creates streams with keys derived from
+     *  the kernel seed, the event number and the action name. The stream
+     *  identifier is the channel, e.g. a cell or a container key.
+     *
+     *  The bulk functions fill arrays. Their loops have no dependencies
+     *  between iterations and are left to the compiler to vectorize.
+     *  Each call starts at a new counter block.
+     *
+     *  Algorithm: J.K.Salmon et al., Parallel random numbers: as easy as 1, 2, 3,
+     *             SC'11, doi:10.1145/2063384.2063405
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiRandomStream  {
+    public:
+      typedef std::array<std::uint32_t,4> counter_t;
+      typedef std::array<std::uint32_t,2> key_t;
+
+    protected:
+      /// Philox key
+      key_t         m_key;
+      /// Stream identifier: upper half of the counter
+      std::uint64_t m_stream  { 0 };
+      /// Next counter block to be used: lower half of the counter
+      std::uint64_t m_block   { 0 };
+      /// Buffered values of the last block for single value access
+      double        m_buffer[2] { 0e0, 0e0 };
+      /// Number of buffered values
+      int           m_buffered  { 0 };
+
+      /// Fill pairs of uniform numbers in ]0,1[ from consecutive counter blocks
+      void fill(double* first, double* second, std::size_t pairs);
+
+    public:
+      /// Initializing constructor
+      DigiRandomStream(std::uint64_t key, std::uint64_t stream);
+      /// Default copy constructor
+      DigiRandomStream(const DigiRandomStream& copy) = default;
+      /// Default assignment
+      DigiRandomStream& operator=(const DigiRandomStream& copy) = default;
+      /// Default destructor
+      ~DigiRandomStream() = default;
+
+      /// Philox4x32 bijection with 10 rounds
+      static inline counter_t philox(counter_t ctr, key_t key);
+      /// Convert two random words to a double in ]0,1[
+      static inline double to_uniform(std::uint32_t hi, std::uint32_t lo);
+
+      /// Next uniform number in ]0,1[. Allows to use the stream as DigiRandomGenerator::engine
+      double operator()();
+      /// Generator with the TRandom algorithms drawing from this stream (must outlive the generator)
+      DigiRandomGenerator generator();
+
+      /// Fill uniform numbers in ]x1,x2[
+      void uniform(double* values, std::size_t n, double x1 = 0e0, double x2 = 1e0);
+      /// Fill gaussian numbers (Box-Muller)
+      void gaussian(double* values, std::size_t n, double mean = 0e0, double sigma = 1e0);
+      /// Fill exponentially distributed numbers
+      void exponential(double* values, std::size_t n, double tau);
+      /// Fill landau distributed numbers
+      void landau(double* values, std::size_t n, double mean = 0e0, double sigma = 1e0);
+      /// Fill poisson distributed numbers
+      void poisson(double* values, std::size_t n, double mean);
+    };
+
+    /// Philox4x32 bijection with 10 rounds
+    inline DigiRandomStream::counter_t DigiRandomStream::philox(counter_t ctr, key_t key)   {
+      constexpr std::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+      constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+      for( int round = 0; round < 10; ++round )   {
+        std::uint64_t p0 = M0 * ctr[0];
+        std::uint64_t p1 = M1 * ctr[2];
+        ctr = { std::uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], std::uint32_t(p1),
+                std::uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], std::uint32_t(p0) };
+        key[0] += W0;
+        key[1] += W1;
+      }
+      return ctr;
+    }
+
+    /// Convert two random words to a double in ]0,1[
+    inline double DigiRandomStream::to_uniform(std::uint32_t hi, std::uint32_t lo)   {
+      std::uint64_t bits = ((std::uint64_t(hi) << 32) | lo) >> 11;
+      return (double(bits) + 0.5) * 0x1.0p-53;
+    }
   }    // End namespace digi
 }      // End namespace dd4hep
 #endif // DDDIGI_DIGIRANDOMGENERATOR_H
@@ -15,11 +15,19 @@
 
 /// Framework include files
 #include <DD4hep/Segmentations.h>
+#include <DD4hep/IDDescriptor.h>
 #include <DD4hep/Volumes.h>
 #include <DD4hep/Shapes.h>
 
 /// C/C++ include files
 #include <functional>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <mutex>
+#include <map>
+#include <memory>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -42,12 +50,10 @@ namespace dd4hep {
      */
     class DigiCellData   {
     public:
-#if 0
       PlacedVolume  placement  { };
       Volume        volume     { };
       Solid         solid      { };
       CellID        cell_id    { 0 };
-#endif
       double        signal     { 0.0 };
       mutable bool  kill       { false };
 
@@ -68,6 +74,105 @@ namespace dd4hep {
     template <typename SEGMENTATION> 
     void init_segmentation_data(segmentation_data<SEGMENTATION>& data, const Segmentation& seg);
 
+    /// Valid cells of a solid in row-run-length encoding
+    /**
+     *  The cells of a grid segmentation are grouped in rows along the last
+     *  grid axis (y for XY grids, z for XYZ grids). A row holds the identifier
+     *  bits and bins of the other axes and the runs of consecutive valid bins
+     *  along the last axis. A cell is valid if its center is inside the solid.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiCellRuns   {
+    public:
+      /// Inclusive range of valid bins along the run axis
+      struct run_t   {
+        long first;
+        long last;
+      };
+      /// Row of cells along the run axis
+      struct row_t   {
+        CellID   cell_id;
+        long     bins[2];
+        uint32_t begin;
+        uint32_t end;
+      };
+      std::vector<row_t> rows;
+      std::vector<run_t> runs;
+      /// Number of cells before each run
+      std::vector<std::size_t> offsets;
+      /// Field of the run axis
+      int         run_offset { 0 };
+      CellID      run_mask   { 0 };
+      /// Total number of valid cells
+      std::size_t num_cells  { 0 };
+
+    public:
+      /// Initializing constructor with the field of the run axis
+      DigiCellRuns(int offset, CellID mask) : run_offset(offset), run_mask(mask)  { }
+      /// Tolerance of cell centers on the boundary of a solid
+      static double tolerance(double grid)  {
+        return 1e-10 * grid;
+      }
+      /// Bins [first,last] with the centers bin*grid+offset inside [lo,hi]
+      static std::pair<long,long> bin_range(double lo, double hi, double grid, double offset)  {
+        double tol = tolerance(grid);
+        return { long(std::ceil((lo - offset - tol) / grid)), long(std::floor((hi - offset + tol) / grid)) };
+      }
+      /// Squared radii [r2min,r2max] of the cell centers inside the radii [rmin,rmax]
+      static std::pair<double,double> radial_range(double rmin, double rmax, double grid)  {
+        double tol = tolerance(grid);
+        return { rmin > tol ? (rmin - tol) * (rmin - tol) : 0e0, (rmax + tol) * (rmax + tol) };
+      }
+      /// Radii of a tube without phi segmentation. Returns false for all other solids
+      static bool full_tube(Solid solid, double& rmin, double& rmax);
+      /// Start a new row. An empty previous row is replaced
+      void add_row(CellID cell_id, long bin0, long bin1 = 0)  {
+        uint32_t n = uint32_t(runs.size());
+        if ( !rows.empty() && rows.back().begin == rows.back().end ) rows.pop_back();
+        rows.push_back({ cell_id, { bin0, bin1 }, n, n });
+      }
+      /// Add the valid bins [first,last] to the current row
+      void add_run(long first, long last)  {
+        if ( first > last ) return;
+        runs.push_back({ first, last });
+        offsets.push_back(num_cells);
+        rows.back().end = uint32_t(runs.size());
+        num_cells += std::size_t(last - first + 1);
+      }
+      /// Add the range of valid bins to the current row
+      void add_run(const std::pair<long,long>& range)  {
+        add_run(range.first, range.second);
+      }
+      /// Remove a trailing empty row
+      void close()  {
+        if ( !rows.empty() && rows.back().begin == rows.back().end ) rows.pop_back();
+      }
+      /// Cell identifier bits of a bin along the run axis
+      CellID run_id(long bin)  const  {
+        return (CellID(bin) << run_offset) & run_mask;
+      }
+      /// Identifier of the cell with the given index in [0, num_cells[ in scan order
+      CellID cell(VolumeID vid, std::size_t index)  const  {
+        std::size_t irun = std::upper_bound(offsets.begin(), offsets.end(), index) - offsets.begin() - 1;
+        auto row = std::upper_bound(rows.begin(), rows.end(), uint32_t(irun),
+                                    [](uint32_t r, const row_t& w)  {  return r < w.begin;  }) - 1;
+        return vid | row->cell_id | run_id(runs[irun].first + long(index - offsets[irun]));
+      }
+      /// Call func(cell_id, row, bin) for all cells of the volume with the given identifier
+      template <typename FUNC> void scan(VolumeID vid, FUNC&& func)  const  {
+        for( const auto& row : rows )   {
+          CellID row_id = vid | row.cell_id;
+          for( uint32_t i = row.begin; i < row.end; ++i )   {
+            for( long bin = runs[i].first; bin <= runs[i].last; ++bin )
+              func(row_id | run_id(bin), row, bin);
+          }
+        }
+      }
+    };
+
     /// 
     /**
      *
@@ -78,14 +183,71 @@ namespace dd4hep {
     class DigiCellScanner  {
     public:
       typedef std::function<void(DigiContext& context, const DigiCellScanner& env, const DigiCellData&)> cell_handler_t;
+    protected:
+      /// Cache of the valid cells by solid
+      std::map<const TGeoShape*, std::shared_ptr<const DigiCellRuns> > m_cells;
+      /// Lock to protect the cache
+      std::mutex m_lock;
+      /// Compute the valid cells of a solid
+      virtual std::shared_ptr<const DigiCellRuns> build_cells(Solid solid)  const;
     public:
       DigiCellScanner() = default;
       virtual ~DigiCellScanner() = default;
+      /// Access the valid cells of a solid. Computed on first access and cached
+      const DigiCellRuns& cells(Solid solid);
+      /// Compute the valid cells of a placement ahead of the event processing
+      void prepare(PlacedVolume pv)   {
+        this->cells(pv.volume().solid());
+      }
+      /// Append the identifiers of all cells of a placement. Returns the number of cells
+      std::size_t cell_ids(PlacedVolume pv, VolumeID vid, std::vector<CellID>& ids);
       virtual void operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler) = 0;
     };
     std::shared_ptr<DigiCellScanner> create_cell_scanner(Solid solid, Segmentation segment);
     std::shared_ptr<DigiCellScanner> create_cell_scanner(const std::string& typ, Segmentation segment);
 
+    /// Channels of a subdetector: all cells of its sensitive placements
+    /**
+     *  The sensitive placements below the subdetector placement are visited
+     *  depth first. Their cells, as enumerated by the DigiCellScanner of the
+     *  readout segmentation, are numbered consecutively in [0, num_channels[.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiSubdetectorChannels   {
+    public:
+      /// Cells of one sensitive placement
+      struct channels_t  {
+        VolumeID            vid;
+        const DigiCellRuns* cells;
+        std::size_t         first;
+      };
+      /// Readout segmentation of the subdetector
+      Segmentation             segment  { };
+      /// Cell scanners by solid type
+      std::map<const TClass*, std::shared_ptr<DigiCellScanner> > scanners;
+      /// Channels of all sensitive placements
+      std::vector<channels_t>  channels;
+      /// Total number of channels
+      std::size_t              num_channels { 0 };
+
+    public:
+      /// Default constructor
+      DigiSubdetectorChannels() = default;
+      /// Initializing constructor with the readout segmentation
+      DigiSubdetectorChannels(Segmentation seg) : segment(seg)  { }
+      /// Collect the channels of all sensitive placements below pv with the volume identifier vid
+      void scan(const IDDescriptor& id_desc, PlacedVolume pv, VolumeID vid);
+      /// Cell identifier of a channel index
+      CellID channel(std::size_t index)  const   {
+        auto it = std::upper_bound(channels.begin(), channels.end(), index,
+                                   [](std::size_t i, const channels_t& c)  {  return i < c.first;  }) - 1;
+        return it->cells->cell(it->vid, index - it->first);
+      }
+    };
+
   }    // End namespace digi
 }      // End namespace dd4hep
 #endif // DDDIGI_DIGISEGMENTATION_H
@@ -16,6 +16,10 @@
 /// Framework include files
 #include <DDDigi/DigiAction.h>
 #include <DDDigi/DigiData.h>
+#include <DDDigi/DigiRandomGenerator.h>
+
+/// C/C++ include files
+#include <atomic>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -55,6 +59,8 @@ namespace dd4hep {
     protected:
       /// Flag to check if initialized was called
       bool  m_initialized = false;
+      /// Hash of the action name for the random stream keys. Computed on first use
+      mutable std::atomic<std::uint64_t> m_nameHash { 0 };
 
       /// Define standard assignments and constructors
       DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiSignalProcessor);
@@ -68,6 +74,11 @@ namespace dd4hep {
       virtual void initialize();
       /// Callback to read event signalprocessor
       virtual double operator()(DigiCellContext& context)  const = 0;
+      /// Counter based random stream of this processor for the cell of the context
+      /** Identical to DigiContext::randomStream(*this, cell_id), but the
+       *  action name is hashed only once and not for every cell.
+       */
+      DigiRandomStream randomStream(const DigiCellContext& context)  const;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
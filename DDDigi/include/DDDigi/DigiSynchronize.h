@@ -17,6 +17,11 @@
 #include <DDDigi/DigiEventAction.h>
 #include <DDDigi/DigiParallelWorker.h>
 
+/// C/C++ include files
+#include <atomic>
+#include <memory>
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -27,6 +32,9 @@ namespace dd4hep {
 
     /// 
     /**
+     *  With the property timing=true the number of calls and the
+     *  execution time of every adopted action are accumulated and
+     *  printed at the end of the run.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -40,12 +48,24 @@ namespace dd4hep {
       using workers_t = DigiParallelWorkers<worker_t>;
       friend class DigiParallelWorker<DigiEventAction, work_t, std::size_t, self_t&>;
 
+      /// Execution time statistics of one adopted action
+      struct timing_t   {
+        std::atomic<long> calls       { 0 };
+        std::atomic<long> nanoseconds { 0 };
+      };
+
       /// The list of action objects to be called
       workers_t m_actors;
+      /// Execution time statistics by actor index
+      std::vector<std::unique_ptr<timing_t> > m_timing_stats;
+      /// Property: Accumulate the execution time of the adopted actions
+      bool      m_timing  { false };
 
     protected:
       /// Define standard assignments and constructors
       DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiSynchronize);
+      /// Finalization callback: print the execution time statistics
+      void print_timing()  const;
 
     public:
       /// Standard constructor
@@ -0,0 +1,130 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGITIMEFRAMEBUILDER_H
+#define DDDIGI_DIGITIMEFRAMEBUILDER_H
+
+/// Framework include files
+#include <DDDigi/DigiActionSequence.h>
+#include <DDDigi/DigiData.h>
+
+/// C/C++ include files
+#include <mutex>
+#include <set>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Time frame builder for continuous (streaming) readout
+    /**
+     *  The adopted actions (typically DigiInputAction sources followed by
+     *  e.g. a DigiIPMover) are executed once per simulated interaction in a
+     *  private event context. The energy deposits of all deposit containers
+     *  found in the input segment of this private event are placed on a
+     *  continuous timeline: interaction i of bunch crossing k is shifted by
+     *  k * bunch_spacing. The number of interactions per bunch crossing is
+     *  Poisson distributed with mean mean_interactions.
+     *
+     *  Every DDDigi event is one time slice: event number n (starting at 1)
+     *  covers [(n-1)*L, n*L) with L = slice_length. Deposits within
+     *  slice_overlap before and after the slice are added as well and are
+     *  flagged EnergyDeposit::TIME_OVERLAP. Deposit times are given relative
+     *  to the start of the slice. Slices are extracted concurrently in any
+     *  order; the interactions are only read as far as required by the
+     *  latest slice, and deposits earlier than the first slice not yet
+     *  extracted are released. The memory is therefore bounded by the slice
+     *  length and the number of events processed in parallel, not by the
+     *  total length of the time frame.
+     *
+     *  The particles and the deposit history of the source events are not
+     *  transferred: they refer to the private source event.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiTimeFrameBuilder : public DigiSequentialActionSequence   {
+    public:
+      /// Deposit buffer of one container on the timeline. Times are absolute
+      using timeline_t = std::vector<std::pair<CellID, EnergyDeposit> >;
+
+    protected:
+      /// Property: Length of one time slice
+      double                              m_slice_length      { 0e0 };
+      /// Property: Overlap region added before and after each slice
+      double                              m_slice_overlap     { 0e0 };
+      /// Property: Time between two bunch crossings
+      double                              m_bunch_spacing     { 0e0 };
+      /// Property: Mean number of interactions per bunch crossing. <= 0: exactly one
+      double                              m_mean_interactions { 1e0 };
+      /// Property: Segment of the source events containing the deposits
+      std::string                         m_input_segment     { "inputs" };
+      /// Property: Output segment of the time slices
+      std::string                         m_output_segment    { "inputs" };
+      /// Property: Output mask of the time slice containers
+      int                                 m_output_mask       { 0x0 };
+
+      /// Lock protecting the timeline
+      mutable std::mutex                  m_lock;
+      /// Deposits on the timeline by container name
+      mutable std::map<std::string, std::pair<SegmentEntry::data_type_t, timeline_t> > m_timeline;
+      /// Slices extracted beyond the first open slice
+      mutable std::set<long>              m_extracted;
+      /// First slice not yet extracted
+      mutable long                        m_first_open        { 0 };
+      /// Next bunch crossing to be read
+      mutable long                        m_next_bunch        { 0 };
+      /// Number of interactions read
+      mutable long                        m_num_interactions  { 0 };
+      /// Maximal number of buffered deposits (statistics)
+      mutable std::size_t                 m_max_buffered      { 0 };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiTimeFrameBuilder);
+
+      /// Read interactions until all bunch crossings before the time limit are on the timeline
+      void fill_timeline(context_t& context, double time_limit)  const;
+      /// Read one interaction and place its deposits on the timeline
+      std::size_t read_interaction(context_t& context, double t0)  const;
+      /// Copy the deposits of the time window [start, end) into the output segment
+      std::size_t extract_slice(context_t& context, double start, double end)  const;
+      /// Release deposits, which are no longer needed by any open slice
+      void release_deposits()  const;
+      /// Finalization callback
+      void finalize();
+
+    public:
+      /// Check if a deposit at absolute time belongs to the slice [start,end) including the overlap
+      static bool in_slice(double time, double start, double end, double overlap)   {
+        return time >= start - overlap && time < end + overlap;
+      }
+      /// Make the deposit time relative to the slice start. Flag deposits outside [start,end)
+      static void to_slice(EnergyDeposit& dep, double start, double end)   {
+        if ( dep.time < start || dep.time >= end )
+          dep.flag |= EnergyDeposit::TIME_OVERLAP;
+        dep.time -= start;
+      }
+
+      /// Standard constructor
+      DigiTimeFrameBuilder(const kernel_t& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiTimeFrameBuilder();
+      /// Build the time slice of this event
+      virtual void execute(context_t& context)  const override;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGITIMEFRAMEBUILDER_H
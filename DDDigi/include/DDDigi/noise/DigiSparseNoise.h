@@ -0,0 +1,138 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_NOISE_DIGISPARSENOISE_H
+#define DDDIGI_NOISE_DIGISPARSENOISE_H
+
+/// Framework include files
+#include <DDDigi/DigiRandomGenerator.h>
+
+/// C/C++ include files
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Gaussian noise of channels without signal after zero suppression
+    /**
+     *  Adding gaussian noise to all channels and discarding the channels
+     *  below threshold keeps every channel with probability
+     *      p = P(noise > threshold)
+     *  independently, with the noise distributed as the gaussian tail
+     *  above the threshold.
+     *
+     *  sample_sparse() produces the same distribution directly:
+     *  the distance to the next channel above threshold is geometric,
+     *  the noise value is obtained by inverting the tail distribution.
+     *  The work is proportional to the number of channels above threshold.
+     *
+     *  sample_dense() is the reference: noise for every channel and cut.
+     *
+     *  The geometric skip itself is available as select_channels() to
+     *  pick channels with any fixed probability, e.g. a channel occupancy.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiSparseNoise   {
+    public:
+      /// Noise mean value
+      double mean      { 0e0 };
+      /// Noise sigma
+      double sigma     { 1e0 };
+      /// Zero suppression threshold
+      double threshold { 0e0 };
+      /// Probability of a channel without signal to be above threshold
+      double tail      { 0e0 };
+
+    public:
+      /// Initializing constructor
+      DigiSparseNoise(double mean, double sigma, double threshold);
+      /// Default destructor
+      ~DigiSparseNoise() = default;
+
+      /// Noise value above threshold from a uniform number in ]0,1[
+      double tail_value(double u)  const;
+
+      /// Call func(index) for the channels in [0,num_channels[, each selected with probability prob
+      template <typename FUNC> static
+      std::size_t select_channels(DigiRandomStream& random, double prob, std::size_t num_channels, FUNC&& func);
+
+      /// Call func(index, noise) for the channels in [0,num_channels[ with noise above threshold
+      template <typename FUNC>
+      std::size_t sample_sparse(DigiRandomStream& random, std::size_t num_channels, FUNC&& func)  const;
+
+      /// Reference implementation: noise for every channel in [0,num_channels[, then zero suppression
+      template <typename FUNC>
+      std::size_t sample_dense(DigiRandomStream& random, std::size_t num_channels, FUNC&& func)  const;
+    };
+
+    /// Call func(index) for the channels, each selected with probability prob
+    template <typename FUNC> std::size_t
+    DigiSparseNoise::select_channels(DigiRandomStream& random, double prob, std::size_t num_channels, FUNC&& func)  {
+      if ( prob <= 0e0 || num_channels == 0 )   {
+        return 0;
+      }
+      if ( prob >= 1e0 )   {
+        for( std::size_t index = 0; index < num_channels; ++index )
+          func(index);
+        return num_channels;
+      }
+      const double log_q = std::log1p(-prob);
+      std::size_t count = 0;
+      for( std::size_t index = 0; ; ++index )   {
+        double skip = std::floor(std::log(random()) / log_q);
+        if ( skip >= double(num_channels - index) ) break;
+        index += std::size_t(skip);
+        func(index);
+        ++count;
+      }
+      return count;
+    }
+
+    /// Call func(index, noise) for the channels with noise above threshold
+    template <typename FUNC> std::size_t
+    DigiSparseNoise::sample_sparse(DigiRandomStream& random, std::size_t num_channels, FUNC&& func)  const  {
+      if ( tail >= 1e0 )   {
+        return sample_dense(random, num_channels, func);
+      }
+      return select_channels(random, tail, num_channels,
+                             [this, &random, &func](std::size_t index)  {  func(index, tail_value(random()));  });
+    }
+
+    /// Reference implementation: noise for every channel, then zero suppression
+    template <typename FUNC> std::size_t
+    DigiSparseNoise::sample_dense(DigiRandomStream& random, std::size_t num_channels, FUNC&& func)  const  {
+      constexpr std::size_t chunk = 4096;
+      std::vector<double> noise(chunk);
+      std::size_t count = 0;
+      for( std::size_t first = 0; first < num_channels; first += chunk )   {
+        std::size_t num = std::min(chunk, num_channels - first);
+        random.gaussian(noise.data(), num, mean, sigma);
+        for( std::size_t i = 0; i < num; ++i )   {
+          if ( noise[i] > threshold )   {
+            func(first + i, noise[i]);
+            ++count;
+          }
+        }
+      }
+      return count;
+    }
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_NOISE_DIGISPARSENOISE_H
@@ -43,6 +43,25 @@ namespace dd4hep {
       int    y_f_offset  {0};
     };
 
+    template <> void init_segmentation_data<CartesianGridXY>(segmentation_data<CartesianGridXY>& data,
+                                                            const Segmentation& seg);
+
+    /// Valid cells of a solid: rows along x with runs of y bins
+    std::shared_ptr<const DigiCellRuns>
+    create_cell_runs(const segmentation_data<CartesianGridXY>& segment, Solid solid);
+
+    /// Fill the cell data of a cell enumerated by DigiCellRuns
+    inline void set_cell_data(cell_data<CartesianGridXY>& e,
+                              const DigiCellRuns::row_t& row,
+                              long bin,
+                              const segmentation_data<CartesianGridXY>& segment)
+    {
+      e.x_bin = row.bins[0];
+      e.x_cid = row.cell_id;
+      e.y_bin = bin;
+      e.y_cid = (CellID(bin) << segment.y_f_offset) & segment.y_mask;
+    }
+
   }    // End namespace digi
 }      // End namespace dd4hep
 #endif // DDDIGI_SEGMENTATIONS_CARTESIANGRIDXY_H
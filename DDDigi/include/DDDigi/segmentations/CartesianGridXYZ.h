@@ -45,6 +45,27 @@ namespace dd4hep {
       int    x_f_offset {0}, y_f_offset {0}, z_f_offset {0};
     };
 
+    template <> void init_segmentation_data<CartesianGridXYZ>(segmentation_data<CartesianGridXYZ>& data,
+                                                             const Segmentation& seg);
+
+    /// Valid cells of a solid: rows along (x,y) with runs of z bins
+    std::shared_ptr<const DigiCellRuns>
+    create_cell_runs(const segmentation_data<CartesianGridXYZ>& segment, Solid solid);
+
+    /// Fill the cell data of a cell enumerated by DigiCellRuns
+    inline void set_cell_data(cell_data<CartesianGridXYZ>& e,
+                              const DigiCellRuns::row_t& row,
+                              long bin,
+                              const segmentation_data<CartesianGridXYZ>& segment)
+    {
+      e.x_bin = row.bins[0];
+      e.y_bin = row.bins[1];
+      e.z_bin = bin;
+      e.x_cid = (CellID(row.bins[0]) << segment.x_f_offset) & segment.x_mask;
+      e.y_cid = (CellID(row.bins[1]) << segment.y_f_offset) & segment.y_mask;
+      e.z_cid = (CellID(bin) << segment.z_f_offset) & segment.z_mask;
+    }
+
   }    // End namespace digi
 }      // End namespace dd4hep
 #endif // DDDIGI_SEGMENTATIONS_CARTESIANGRIDXYZ_H
@@ -23,8 +23,11 @@ namespace dd4hep {
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
-    /// 
+    /// Cell scanner of a given segmentation type and solid type
     /**
+     *  The valid cells of each solid are computed once by the overloaded
+     *  function create_cell_runs(segmentation_data, solid) and cached.
+     *  The cell data are filled by the overloaded function set_cell_data.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -43,7 +46,24 @@ namespace dd4hep {
       CellScanner(segmentation_t seg)   {
         init_segmentation_data<segmentation_t>(segment, seg);
       }
-      virtual void operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler)  override;
+    protected:
+      /// Compute the valid cells of a solid
+      virtual std::shared_ptr<const DigiCellRuns> build_cells(Solid solid)  const  override  {
+        return create_cell_runs(segment, solid);
+      }
+    public:
+      /// Call the cell handler for all valid cells of the placement
+      virtual void operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler)  override  {
+        cell_data_t e;
+        e.placement = pv;
+        e.volume    = pv.volume();
+        e.solid     = e.volume.solid();
+        this->cells(e.solid).scan(vid, [&](CellID cell_id, const DigiCellRuns::row_t& row, long bin)  {
+          e.cell_id = cell_id;
+          set_cell_data(e, row, bin, segment);
+          cell_handler(context, *this, e);
+        });
+      }
     };
   }    // End namespace digi
 }      // End namespace dd4hep
@@ -58,8 +58,10 @@ namespace dd4hep {
       virtual void open_output() const  override final;
       /// Close possible open stream
       virtual void close_output()  const  override final;
-      /// Commit event data to output stream
-      virtual void commit_output() const  override final;
+      /// Create the (empty) output frame of one event
+      virtual frame_pointer_t create_frame()  const  override final;
+      /// Commit staged event data to output stream
+      virtual void commit_frame(frame_t& frame)  const  override final;
     };
 
     /// Actor to save individual data containers to edm4hep
@@ -83,9 +85,9 @@ namespace dd4hep {
       /// Standard destructor
       virtual ~Digi2ROOTProcessor() = default;
 
-      void convert_particles(DigiContext& context, ParticleMapping& cont)  const;
-      void convert_deposits(DigiContext& context, DepositVector& cont, const predicate_t& predicate)  const;
-      void convert_deposits(DigiContext& context, DepositMapping& cont, const predicate_t& predicate)  const;
+      void convert_particles(DigiContext& context, const ParticleMapping& cont)  const;
+      template <typename T>
+      void convert_deposits(DigiContext& context, const T& cont, const predicate_t& predicate)  const;
       void convert_history(DigiContext& context, DepositsHistory& cont, work_t& work, const predicate_t& predicate)  const;
 
       /// Main functional callback
@@ -159,6 +161,12 @@ namespace dd4hep {
       };
       typedef std::map<std::string, BranchWrapper> Collections;
 
+      /// Event data staged for output. The frame owns copies of the event data
+      struct event_data_t : public DigiOutputAction::frame_t  {
+        std::map<std::string, std::vector<std::pair<Key::key_type, Particle> > > particles;
+        std::map<std::string, std::vector<std::pair<CellID, EnergyDeposit> > >   deposits;
+      };
+
       /// Reference to the parent
       Digi2ROOTWriter*         m_parent       { nullptr };
       /// Collections in the event tree
@@ -190,15 +198,17 @@ namespace dd4hep {
       void open();
       /// Commit data to disk and close output stream
       void close();
-      /// Commit data at end of filling procedure
-      void commit();
+      /// Commit staged event data
+      void commit(event_data_t& data);
 
       /// Create all collections according to the parent setup (locked)
       void create_collections();
+      /// Create the (empty) output frame of one event
+      std::unique_ptr<event_data_t> create_frame()  const;
       /// Clear collection content: Store is still owner!
       void clearCollections();
-      /// Access named collection: throws exception ifd the collection is not present (unlocked!)
-      template <typename T> BranchWrapper& get_collection(const T&);
+      /// Access named container of an output frame: throws exception if the container is not present
+      template <typename C> typename C::mapped_type& get_container(C& containers, const std::string& nam)  const;
     };
 
     template <typename T> void Digi2ROOTWriter::internals_t::BranchWrapper::set(T* ptr)   {
@@ -249,12 +259,25 @@ namespace dd4hep {
       }
     }
 
-    /// Access named collection: throws exception ifd the collection is not present
-    template <typename T> 
-    Digi2ROOTWriter::internals_t::BranchWrapper& Digi2ROOTWriter::internals_t::get_collection(const T& cont)  {
-      auto iter = m_collections.find(cont.name);
-      if ( iter == m_collections.end() )    {
-        m_parent->except("Error");
+    /// Create the (empty) output frame of one event
+    std::unique_ptr<Digi2ROOTWriter::internals_t::event_data_t>
+    Digi2ROOTWriter::internals_t::create_frame()  const   {
+      auto frame = std::make_unique<event_data_t>();
+      for( const auto& cont : m_parent->m_containers )   {
+        if ( cont.second == "MCParticles" )
+          frame->particles[cont.first];
+        else
+          frame->deposits[cont.first];
+      }
+      return frame;
+    }
+
+    /// Access named container of an output frame: throws exception if the container is not present
+    template <typename C> typename C::mapped_type&
+    Digi2ROOTWriter::internals_t::get_container(C& containers, const std::string& nam)  const  {
+      auto iter = containers.find(nam);
+      if ( iter == containers.end() )    {
+        m_parent->except("+++ No output collection registered for container %s", nam.c_str());
       }
       return iter->second;
     }
@@ -304,9 +327,22 @@ namespace dd4hep {
       m_file.reset();
     }
 
-    /// Commit data at end of filling procedure
-    void Digi2ROOTWriter::internals_t::commit()   {
+    /// Commit staged event data
+    void Digi2ROOTWriter::internals_t::commit(event_data_t& data)   {
       if ( m_tree )   {
+        /// The branches point to the persistent vectors: fill them from the frame
+        for( auto& p : data.particles )   {
+          auto* vec = get_container(m_collections, p.first).get<persistent_particles_t>();
+          vec->reserve(p.second.size());
+          for( auto& part : p.second )
+            vec->emplace_back(part.first, &part.second);
+        }
+        for( auto& d : data.deposits )   {
+          auto* vec = get_container(m_collections, d.first).get<persistent_deposits_t>();
+          vec->reserve(d.second.size());
+          for( auto& depo : d.second )
+            vec->emplace_back(depo.first, &depo.second);
+        }
 	m_tree->Fill();
         clearCollections();
 	++m_parent->event_count;
@@ -348,7 +384,6 @@ namespace dd4hep {
         }
 	except("Error: Invalid processor type for ROOT output: %s", c.second->c_name());
       }
-      m_parallel = false;
       internals->create_collections();
     }
 
@@ -367,9 +402,14 @@ namespace dd4hep {
       internals->close();
     }
 
-    /// Commit event data to output stream
-    void Digi2ROOTWriter::commit_output() const  {
-      internals->commit();
+    /// Create the (empty) output frame of one event
+    DigiOutputAction::frame_pointer_t Digi2ROOTWriter::create_frame()  const   {
+      return internals->create_frame();
+    }
+
+    /// Commit staged event data to output stream
+    void Digi2ROOTWriter::commit_frame(frame_t& frame) const  {
+      internals->commit(static_cast<internals_t::event_data_t&>(frame));
     }
 
     /// Standard constructor
@@ -378,52 +418,34 @@ namespace dd4hep {
     {
     }
 
-    void Digi2ROOTProcessor::convert_particles(DigiContext&     ctxt,
-					       ParticleMapping& cont)  const
+    void Digi2ROOTProcessor::convert_particles(DigiContext&           ctxt,
+					       const ParticleMapping& cont)  const
     {
-      auto& coll = internals->get_collection(cont);
-      auto* vec = coll.get<persistent_particles_t>();
-      vec->clear();
-      vec->reserve(cont.size());
-      for( auto& p : cont )   {
-	vec->emplace_back(std::make_pair(p.first, &p.second));
-      }
-      info("%s+++ %-24s added %6ld entries from mask: %04X",
-           ctxt.event->id(), cont.name.c_str(), vec->size(), cont.key.mask());
-    }
-
-    void Digi2ROOTProcessor::convert_deposits(DigiContext&       ctxt,
-					      DepositMapping&    cont,
-					      const predicate_t& predicate)  const
-    {
-      auto& coll = internals->get_collection(cont);
-      auto* vec  = coll.get<persistent_deposits_t>();
-      vec->clear();
-      vec->reserve(cont.size());
-      for ( auto& depo : cont )   {
-	if ( predicate(depo) )   {
-	  vec->emplace_back(std::make_pair(depo.first, &depo.second));
-	}
+      auto& frame = internals->m_parent->staged_frame<Digi2ROOTWriter::internals_t::event_data_t>(ctxt);
+      auto& vec   = internals->get_container(frame.particles, cont.name);
+      vec.reserve(cont.size());
+      for( const auto& p : cont )   {
+	vec.emplace_back(p.first, p.second);
       }
       info("%s+++ %-24s added %6ld entries from mask: %04X",
-           ctxt.event->id(), cont.name.c_str(), vec->size(), cont.key.mask());
+           ctxt.event->id(), cont.name.c_str(), vec.size(), cont.key.mask());
     }
 
+    template <typename T>
     void Digi2ROOTProcessor::convert_deposits(DigiContext&       ctxt,
-					      DepositVector&     cont,
+					      const T&           cont,
 					      const predicate_t& predicate)  const
     {
-      auto& coll = internals->get_collection(cont);
-      auto* vec  = coll.get<persistent_deposits_t>();
-      vec->clear();
-      vec->reserve(cont.size());
-      for ( auto& depo : cont )   {
+      auto& frame = internals->m_parent->staged_frame<Digi2ROOTWriter::internals_t::event_data_t>(ctxt);
+      auto& vec   = internals->get_container(frame.deposits, cont.name);
+      vec.reserve(cont.size());
+      for ( const auto& depo : cont )   {
 	if ( predicate(depo) )   {
-	  vec->emplace_back(std::make_pair(depo.first, &depo.second));
+	  vec.emplace_back(depo.first, depo.second);
 	}
       }
       info("%s+++ %-24s added %6ld entries from mask: %04X",
-           ctxt.event->id(), cont.name.c_str(), vec->size(), cont.key.mask());
+           ctxt.event->id(), cont.name.c_str(), vec.size(), cont.key.mask());
     }
 
     void Digi2ROOTProcessor::convert_history(DigiContext&       ctxt,
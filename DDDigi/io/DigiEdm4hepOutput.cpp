@@ -54,17 +54,22 @@ namespace dd4hep {
     public:
       using particlecollection_t = std::pair<std::string,std::unique_ptr<edm4hep::MCParticleCollection> >;
       using headercollection_t   = std::pair<std::string,std::unique_ptr<edm4hep::EventHeaderCollection> >;
+
+      /// Event data staged for output: the edm4hep collections of one event
+      struct event_data_t : public DigiOutputAction::frame_t  {
+        /// edm4hep event header collection
+        headercollection_t  header    { };
+        /// MC particle collection
+        particlecollection_t particles { };
+        /// Collection of all edm4hep tracker object collections
+        std::map<std::string, std::unique_ptr<edm4hep::TrackerHit3DCollection> > tracker_collections;
+        /// Collection of all edm4hep calorimeter object collections
+        std::map<std::string, std::unique_ptr<edm4hep::CalorimeterHitCollection> > calo_collections;
+      };
+
       DigiEdm4hepOutput*                      m_parent    { nullptr };
       /// Reference to podio writer
       std::unique_ptr<podio::ROOTWriter>      m_writer    { };
-      /// edm4hep event header collection
-      headercollection_t                      m_header    { };
-      /// MC particle collection
-      particlecollection_t                    m_particles { };
-      /// Collection of all edm4hep tracker object collections
-      std::map<std::string, std::unique_ptr<edm4hep::TrackerHit3DCollection> > m_tracker_collections;
-      /// Collection of all edm4hep calorimeter object collections
-      std::map<std::string, std::unique_ptr<edm4hep::CalorimeterHitCollection> > m_calo_collections;
       /// Output section name
       std::string                             m_section_name{ "EVENT" };
       /// Output mutex
@@ -80,19 +85,17 @@ namespace dd4hep {
       /// Default destructor
       ~internals_t();
 
-      /// Clear local data content
-      void clear();
-      /// Commit data at end of filling procedure
-      void commit();
+      /// Commit staged event data
+      void commit(event_data_t& data);
       /// Open new output stream
       void open();
       /// Commit data to disk and close output stream
       void close();
 
-      /// Create all collections according to the parent setup (locked)
-      void create_collections();
-      /// Access named collection: throws exception ifd the collection is not present (unlocked!)
-      template <typename T> podio::CollectionBase* get_collection(const T&);
+      /// Create the (empty) output frame of one event with all collections according to the parent setup
+      std::unique_ptr<event_data_t> create_frame()  const;
+      /// Access named collection of an output frame: throws exception if the collection is not present
+      template <typename T> podio::CollectionBase* get_collection(event_data_t& data, const T&)  const;
     };
 
     /// Default constructor
@@ -103,46 +106,43 @@ namespace dd4hep {
     /// Default destructor
     DigiEdm4hepOutput::internals_t::~internals_t()    {
       if ( m_writer ) close();
-      m_tracker_collections.clear();
-      m_calo_collections.clear();
-      m_particles.second.reset();
-      m_header.second.reset();
     }
 
-    /// Create all collections according to the parent setup
-    void DigiEdm4hepOutput::internals_t::create_collections()    {
-      if ( !m_header.second )   {
-        m_header = std::make_pair("EventHeader", std::make_unique<edm4hep::EventHeaderCollection>());
-        for( auto& cont : m_parent->m_containers )   {
-          const std::string& nam = cont.first;
-          const std::string& typ = cont.second;
-          if ( typ == "MCParticles" )   {
-            m_particles = std::make_pair(nam, std::make_unique<edm4hep::MCParticleCollection>());
-          }
-          else if ( typ == "TrackerHits" )   {
-            m_tracker_collections.emplace(nam, std::make_unique<edm4hep::TrackerHit3DCollection>());
-          }
-          else if ( typ == "CalorimeterHits" )   {
-            m_calo_collections.emplace(nam, std::make_unique<edm4hep::CalorimeterHitCollection>());
-          }
+    /// Create the (empty) output frame of one event with all collections according to the parent setup
+    std::unique_ptr<DigiEdm4hepOutput::internals_t::event_data_t>
+    DigiEdm4hepOutput::internals_t::create_frame()  const   {
+      auto data = std::make_unique<event_data_t>();
+      data->header = std::make_pair("EventHeader", std::make_unique<edm4hep::EventHeaderCollection>());
+      for( auto& cont : m_parent->m_containers )   {
+        const std::string& nam = cont.first;
+        const std::string& typ = cont.second;
+        if ( typ == "MCParticles" )   {
+          data->particles = std::make_pair(nam, std::make_unique<edm4hep::MCParticleCollection>());
+        }
+        else if ( typ == "TrackerHits" )   {
+          data->tracker_collections.emplace(nam, std::make_unique<edm4hep::TrackerHit3DCollection>());
+        }
+        else if ( typ == "CalorimeterHits" )   {
+          data->calo_collections.emplace(nam, std::make_unique<edm4hep::CalorimeterHitCollection>());
         }
-        m_parent->info("+++ Will save %ld events to %s", num_events, m_parent->m_output.c_str());
       }
+      return data;
     }
-    /// Access named collection: throws exception ifd the collection is not present
-    template <typename T> 
-    podio::CollectionBase* DigiEdm4hepOutput::internals_t::get_collection(const T& cont)  {
+
+    /// Access named collection of an output frame: throws exception if the collection is not present
+    template <typename T> podio::CollectionBase*
+    DigiEdm4hepOutput::internals_t::get_collection(event_data_t& data, const T& cont)  const  {
       switch(cont.data_type)   {
       case SegmentEntry::TRACKER_HITS:   {
-        auto iter = m_tracker_collections.find(cont.name);
-        if ( iter == m_tracker_collections.end() )
-          m_parent->except("Error");
+        auto iter = data.tracker_collections.find(cont.name);
+        if ( iter == data.tracker_collections.end() )
+          m_parent->except("+++ No output collection registered for container %s", cont.name.c_str());
         return iter->second.get();
       }
       case SegmentEntry::CALORIMETER_HITS:   {
-        auto iter = m_calo_collections.find(cont.name);
-        if ( iter == m_calo_collections.end() )
-          m_parent->except("Error");
+        auto iter = data.calo_collections.find(cont.name);
+        if ( iter == data.calo_collections.end() )
+          m_parent->except("+++ No output collection registered for container %s", cont.name.c_str());
         return iter->second.get();
       }
       default:
@@ -150,39 +150,20 @@ namespace dd4hep {
       }
     };
 
-    /// Clear local data content
-    void DigiEdm4hepOutput::internals_t::clear()   {
-#if 0
-      m_header.second->clear();
-      m_particles.second->clear();
-      for( const auto& c : m_tracker_collections )
-        c.second->clear();
-      for( const auto& c : m_calo_collections )
-        c.second->clear();
-#endif
-      *m_header.second = {};
-      *m_particles.second = {};
-      for( const auto& c : m_tracker_collections )
-        *c.second = {};
-      for( const auto& c : m_calo_collections )
-        *c.second = {};
-    }
-
-    /// Commit data at end of filling procedure
-    void DigiEdm4hepOutput::internals_t::commit()   {
-      if ( m_writer )   {{
-          std::lock_guard<std::mutex> protection(m_lock);
-          podio::Frame frame { };
-          frame.put( std::move(*m_header.second), m_header.first);
-          frame.put( std::move(*m_particles.second), m_particles.first);
-          for( const auto& c : m_tracker_collections )
-            frame.put( std::move(*c.second), c.first);
-          for( const auto& c : m_calo_collections )
-            frame.put( std::move(*c.second), c.first);
-
-          m_writer->writeFrame(frame, m_section_name);
-        }
-        clear();
+    /// Commit staged event data
+    void DigiEdm4hepOutput::internals_t::commit(event_data_t& data)   {
+      if ( m_writer )   {
+        std::lock_guard<std::mutex> protection(m_lock);
+        podio::Frame frame { };
+        frame.put( std::move(*data.header.second), data.header.first);
+        if ( data.particles.second )
+          frame.put( std::move(*data.particles.second), data.particles.first);
+        for( const auto& c : data.tracker_collections )
+          frame.put( std::move(*c.second), c.first);
+        for( const auto& c : data.calo_collections )
+          frame.put( std::move(*c.second), c.first);
+        m_writer->writeFrame(frame, m_section_name);
+        ++event_count;
         return;
       }
       m_parent->except("+++ Failed to write output file. [Stream is not open]");
@@ -193,7 +174,6 @@ namespace dd4hep {
       if ( m_writer )   {
         close();
       }
-      clear();
       m_writer.reset();
       std::string fname = m_parent->next_stream_name();
       m_writer = std::make_unique<podio::ROOTWriter>(fname);
@@ -234,8 +214,8 @@ namespace dd4hep {
         }
         except("Error: Invalid processor type for EDM4HEP output: %s", c.second->c_name());
       }
-      m_parallel = false;
-      internals->create_collections();
+      internals->num_events = num_events;
+      info("+++ Will save %ld events to %s", num_events, m_output.c_str());
     }
 
     /// Check for valid output stream
@@ -253,9 +233,14 @@ namespace dd4hep {
       internals->close();
     }
 
-    /// Commit event data to output stream
-    void DigiEdm4hepOutput::commit_output() const  {
-      internals->commit();
+    /// Create the (empty) output frame of one event
+    DigiOutputAction::frame_pointer_t DigiEdm4hepOutput::create_frame()  const   {
+      return internals->create_frame();
+    }
+
+    /// Commit staged event data to output stream
+    void DigiEdm4hepOutput::commit_frame(frame_t& frame) const  {
+      internals->commit(static_cast<internals_t::event_data_t&>(frame));
     }
 
     /// Standard constructor
@@ -270,7 +255,11 @@ namespace dd4hep {
     void DigiEdm4hepOutputProcessor::convert_particles(DigiContext& ctxt,
                                                        const ParticleMapping& cont)  const
     {
-      auto& parts = internals->m_particles.second;
+      auto& data  = internals->m_parent->staged_frame<DigiEdm4hepOutput::internals_t::event_data_t>(ctxt);
+      auto& parts = data.particles.second;
+      if ( !parts )   {
+        except("+++ No output collection registered for container %s", cont.name.c_str());
+      }
       data_io<edm4hep_input>::_to_edm4hep(cont, parts.get());
       info("%s+++ %-24s added %6ld entries from mask: %04X to %s",
            ctxt.event->id(), cont.name.c_str(), parts->size(), cont.key.mask(),
@@ -309,7 +298,8 @@ namespace dd4hep {
                                                  const T&           cont,
                                                  const predicate_t& predicate)  const
     {
-      podio::CollectionBase* coll = internals->get_collection(cont);
+      auto& data = internals->m_parent->staged_frame<DigiEdm4hepOutput::internals_t::event_data_t>(ctxt);
+      podio::CollectionBase* coll = internals->get_collection(data, cont);
       std::size_t start = coll->size();
       if ( !cont.empty() )   {
         switch(cont.data_type)    {
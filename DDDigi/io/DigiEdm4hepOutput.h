@@ -75,8 +75,10 @@ namespace dd4hep {
       virtual void open_output() const  override final;
       /// Close possible open stream
       virtual void close_output()  const  override final;
-      /// Commit event data to output stream
-      virtual void commit_output() const  override final;
+      /// Create the (empty) output frame of one event
+      virtual frame_pointer_t create_frame()  const  override final;
+      /// Commit staged event data to output stream
+      virtual void commit_frame(frame_t& frame)  const  override final;
     };
 
     /// Actor to save individual data containers to edm4hep
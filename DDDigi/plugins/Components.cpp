@@ -32,6 +32,12 @@ DECLARE_DIGIACTION_NS(dd4hep::digi,DigiActionSequence)
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiParallelActionSequence)
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiSequentialActionSequence)
 
+#include <DDDigi/DigiTimeFrameBuilder.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiTimeFrameBuilder)
+
+#include <DDDigi/DigiOverlayCache.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiOverlayCache)
+
 //#include <DDDigi/DigiSubdetectorSequence.h>
 // DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiSubdetectorSequence)
 
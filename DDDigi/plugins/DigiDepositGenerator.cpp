@@ -0,0 +1,191 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/DigiData.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiEventAction.h>
+#include <DDDigi/DigiSegmentation.h>
+#include <DDDigi/DigiRandomGenerator.h>
+#include <DDDigi/noise/DigiSparseNoise.h>
+
+#include <DD4hep/Detector.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DD4hep/IDDescriptor.h>
+#include <DD4hep/VolumeManager.h>
+
+/// C/C++ include files
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Generator of synthetic energy deposits with a given channel occupancy
+    /**
+     *  Creates for every subdetector one deposit container named after
+     *  the readout in the output segment, as if read by a DigiInputAction.
+     *  Every channel of the subdetector is hit with the probability
+     *  occupancy. The channels are all cells of the sensitive volumes as
+     *  enumerated by the DigiCellScanner of the readout segmentation.
+     *  The deposits have exponentially distributed energies with mean
+     *  mean_energy, uniform times in [0,time_window[, the global position
+     *  of the cell center and no history.
+     *
+     *  Intended to feed benchmarks and tests with reproducible input of
+     *  configurable size, independent of simulated data files.
+     *
+     *  Properties:
+     *  detectors:      Names of the subdetectors
+     *  occupancy:      Probability of a channel to carry a deposit
+     *  mean_energy:    Mean deposited energy
+     *  time_window:    Deposit times are uniform within [0,time_window[
+     *  container:      Container type: DepositVector or DepositMapping
+     *  mask:           Mask of the containers and deposits
+     *  output_segment: Segment receiving the containers
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDepositGenerator : public DigiEventAction  {
+    protected:
+      /// Channel description of one subdetector
+      struct detector_t  {
+        std::string                 collection;
+        SegmentEntry::data_type_t   data_type  { SegmentEntry::TRACKER_HITS };
+        DigiSubdetectorChannels     channels   { };
+      };
+
+      /// Property: Names of the subdetectors
+      std::vector<std::string> m_detector_names { };
+      /// Property: Probability of a channel to carry a deposit
+      double       m_occupancy      { 1e-3 };
+      /// Property: Mean deposited energy
+      double       m_mean_energy    { 0e0 };
+      /// Property: Deposit times are uniform within [0,time_window[
+      double       m_time_window    { 0e0 };
+      /// Property: Container type: DepositVector or DepositMapping
+      std::string  m_container      { "DepositVector" };
+      /// Property: Mask of the containers and deposits
+      int          m_mask           { 0x0 };
+      /// Property: Segment receiving the containers
+      std::string  m_output_segment { "inputs" };
+
+      /// Channels of all subdetectors
+      std::vector<detector_t> m_detectors;
+      /// Volume manager to compute the position of the deposits
+      VolumeManager m_volumeMgr     { };
+
+      /// Fill the deposits of one subdetector. Channels are selected by geometric skips
+      template <typename CONT> std::size_t
+      generate(DigiRandomStream& random, const detector_t& det, CONT& cont)  const   {
+        const DigiSubdetectorChannels& chans = det.channels;
+        return DigiSparseNoise::select_channels(random, m_occupancy, chans.num_channels, [&](std::size_t index)  {
+          CellID cell = chans.channel(index);
+          EnergyDeposit dep;
+          dep.deposit  = -m_mean_energy * std::log(random());
+          dep.time     = m_time_window * random();
+          dep.mask     = m_mask;
+          dep.position = m_volumeMgr.lookupContext(cell)->localToWorld(chans.segment.position(cell));
+          cont.emplace(cell, std::move(dep));
+        });
+      }
+
+      /// Create and fill the container of one subdetector
+      template <typename CONT> std::size_t
+      create_container(DigiContext& context, DataSegment& segment, const detector_t& det)  const   {
+        Key  key(det.collection, m_mask);
+        auto random = context.randomStream(*this, key.value());
+        CONT cont(det.collection, m_mask, det.data_type);
+        std::size_t count = generate(random, det, cont);
+        segment.emplace(key, std::move(cont));
+        return count;
+      }
+
+    public:
+      /// Standard constructor
+      DigiDepositGenerator(const DigiKernel& krnl, const std::string& nam)
+        : DigiEventAction(krnl, nam)
+      {
+        declareProperty("detectors",      m_detector_names);
+        declareProperty("occupancy",      m_occupancy);
+        declareProperty("mean_energy",    m_mean_energy = 100e0 * dd4hep::keV);
+        declareProperty("time_window",    m_time_window =  25e0 * dd4hep::ns);
+        declareProperty("container",      m_container);
+        declareProperty("mask",           m_mask);
+        declareProperty("output_segment", m_output_segment);
+        m_kernel.register_initialize(std::bind(&DigiDepositGenerator::initialize,this));
+      }
+
+      /// Initialization callback: enumerate the channels of the subdetectors
+      void initialize()   {
+        Detector& detector = m_kernel.detectorDescription();
+        if ( m_container != "DepositVector" && m_container != "DepositMapping" )   {
+          except("+++ Invalid container type: %s [Must be DepositVector or DepositMapping]",
+                 m_container.c_str());
+        }
+        m_volumeMgr = detector.volumeManager();
+        if ( !m_volumeMgr.isValid() )   {
+          detector.apply("DD4hepVolumeManager",0,nullptr);
+        }
+        m_volumeMgr = detector.volumeManager();
+        if ( !m_volumeMgr.isValid() )   {
+          except("+++ Cannot locate volume manager!");
+        }
+        m_detectors.clear();
+        m_detectors.reserve(m_detector_names.size());
+        for( const auto& name : m_detector_names )   {
+          DetElement de = detector.detector(name);
+          if ( !de.isValid() )   {
+            except("+++ Cannot locate subdetector: %s", name.c_str());
+          }
+          SensitiveDetector sd = detector.sensitiveDetector(name);
+          Readout      readout = sd.readout();
+          IDDescriptor id_desc = readout.idSpec();
+          PlacedVolume pv      = de.placement();
+          detector_t&  det     = m_detectors.emplace_back();
+          det.collection = readout.name();
+          det.data_type  = sd.type() == "calorimeter" ? SegmentEntry::CALORIMETER_HITS : SegmentEntry::TRACKER_HITS;
+          det.channels   = DigiSubdetectorChannels(readout.segmentation());
+          det.channels.scan(id_desc, pv, id_desc.encode(pv.volIDs()));
+          info("+++ %-24s %-24s %9ld channels in %6ld sensitive volumes. Expected deposits/event: %9.1f",
+               name.c_str(), det.collection.c_str(), long(det.channels.num_channels),
+               long(det.channels.channels.size()), std::min(m_occupancy, 1e0) * double(det.channels.num_channels));
+        }
+      }
+
+      /// Main functional callback
+      virtual void execute(DigiContext& context)   const  override final  {
+        auto& segment = context.event->get_segment(m_output_segment);
+        std::size_t count = 0;
+        for( const auto& det : m_detectors )   {
+          if ( m_container == "DepositMapping" )
+            count += create_container<DepositMapping>(context, segment, det);
+          else
+            count += create_container<DepositVector>(context, segment, det);
+        }
+        info("%s+++ Generated %ld deposits in %ld %s containers. Mask: %04X",
+             context.event->id(), count, m_detectors.size(), m_container.c_str(), m_mask);
+      }
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+
+#include <DDDigi/DigiFactories.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiDepositGenerator)
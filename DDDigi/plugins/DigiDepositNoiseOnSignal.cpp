@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -42,12 +43,15 @@ namespace dd4hep {
       /// Create deposit mapping with updates on same cellIDs
       template <typename T> void
       create_noise(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
-        auto& random = context.randomGenerator();
+        auto random = context.randomStream(*this, cont.key.value());
+        std::vector<double> deltas(cont.size());
         std::size_t updated = 0UL;
+        std::size_t index   = 0UL;
+        random.gaussian(deltas.data(), deltas.size(), m_mean, m_sigma);
         for( auto& dep : cont )  {
+          double delta_E = deltas[index++];
           if ( predicate(dep) )  {
             int flag = EnergyDeposit::DEPOSIT_NOISE;
-            double delta_E = random.gaussian(m_mean, m_sigma);
             if ( m_monitor ) m_monitor->energy_shift(dep, delta_E);
             dep.second.deposit += delta_E;
             dep.second.flag |= flag;
@@ -0,0 +1,172 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/DigiContainerProcessor.h>
+#include <DDDigi/DigiSegmentation.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/noise/DigiSparseNoise.h>
+
+#include <DD4hep/Detector.h>
+#include <DD4hep/IDDescriptor.h>
+#include <DD4hep/VolumeManager.h>
+
+/// C/C++ include files
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Actor to add gaussian noise to all channels of a subdetector followed by zero suppression
+    /**
+     *  Equivalent to DigiDepositNoiseOnSignal applied to every channel of the
+     *  subdetector followed by DigiDepositZeroSuppress, but without creating
+     *  a deposit for every channel:
+     *
+     *  - Channels with a deposit get gaussian noise added and are flagged
+     *    KILLED if the result is below threshold.
+     *  - Of the channels without deposit only those with noise above
+     *    threshold are created (see DigiSparseNoise).
+     *
+     *  The channels are all cells of the sensitive volumes of the subdetector
+     *  as enumerated by the DigiCellScanner of the readout segmentation.
+     *
+     *  Properties:
+     *  detector:   Name of the subdetector
+     *  mean:       Mean of the noise in absolute values
+     *  sigma:      Sigma of the noise in absolute values
+     *  threshold:  Zero suppression threshold
+     *  dense:      Reference mode: sample the noise of every channel
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDepositNoiseZeroSuppress : public DigiDepositsProcessor  {
+    protected:
+      /// Property: Name of the subdetector
+      std::string  m_detector_name  { };
+      /// Property: Mean of the noise in absolute values
+      double       m_mean           { 0e0 };
+      /// Property: Sigma of the noise in absolute values
+      double       m_sigma          { 0e0 };
+      /// Property: Zero suppression threshold
+      double       m_threshold      { 0e0 };
+      /// Property: Reference mode: sample the noise of every channel
+      bool         m_dense          { false };
+
+      /// Volume manager to compute the position of noise deposits
+      VolumeManager m_volumeMgr     { };
+      /// Channels of the subdetector
+      DigiSubdetectorChannels m_channels { };
+      /// Noise sampler
+      std::unique_ptr<DigiSparseNoise> m_noise;
+
+    public:
+      /// Standard constructor
+      DigiDepositNoiseZeroSuppress(const DigiKernel& krnl, const std::string& nam)
+        : DigiDepositsProcessor(krnl, nam)
+      {
+        declareProperty("detector",  m_detector_name);
+        declareProperty("mean",      m_mean);
+        declareProperty("sigma",     m_sigma);
+        declareProperty("threshold", m_threshold);
+        declareProperty("dense",     m_dense);
+        m_kernel.register_initialize(std::bind(&DigiDepositNoiseZeroSuppress::initialize,this));
+        DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositNoiseZeroSuppress::handle_deposits);
+      }
+
+      /// Processor initialization: enumerate the channels of the subdetector
+      void initialize()   {
+        Detector&  detector = m_kernel.detectorDescription();
+        DetElement de = detector.detector(m_detector_name);
+        if ( !de.isValid() )   {
+          except("+++ Cannot locate subdetector: %s", m_detector_name.c_str());
+        }
+        Readout      readout = detector.sensitiveDetector(m_detector_name).readout();
+        IDDescriptor id_desc = readout.idSpec();
+        PlacedVolume pv      = de.placement();
+        m_volumeMgr = detector.volumeManager();
+        m_noise     = std::make_unique<DigiSparseNoise>(m_mean, m_sigma, m_threshold);
+        m_channels  = DigiSubdetectorChannels(readout.segmentation());
+        m_channels.scan(id_desc, pv, id_desc.encode(pv.volIDs()));
+        info("+++ %s: %ld channels in %ld sensitive volumes. Probability of noise above threshold: %9.3e",
+             m_detector_name.c_str(), long(m_channels.num_channels), long(m_channels.channels.size()), m_noise->tail);
+      }
+
+      /// Add noise to the deposits and create the channels with noise above threshold
+      template <typename T> void
+      handle_deposits(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        auto random = context.randomStream(*this, cont.key.value());
+        std::vector<double> deltas(cont.size());
+        std::unordered_set<CellID> hits;
+        std::size_t updated = 0UL, killed = 0UL;
+        std::size_t index   = 0UL;
+
+        /// Channels with signal: add noise and apply the threshold
+        hits.reserve(cont.size());
+        random.gaussian(deltas.data(), deltas.size(), m_mean, m_sigma);
+        for( auto& dep : cont )  {
+          double delta_E = deltas[index++];
+          hits.insert(dep.first);
+          if ( predicate(dep) )  {
+            int flag = EnergyDeposit::DEPOSIT_NOISE | EnergyDeposit::ZERO_SUPPRESSED;
+            if ( m_monitor ) m_monitor->energy_shift(dep, delta_E);
+            dep.second.deposit += delta_E;
+            if ( dep.second.deposit < m_threshold )   {
+              flag |= EnergyDeposit::KILLED;
+              ++killed;
+            }
+            dep.second.flag |= flag;
+            ++updated;
+          }
+        }
+        /// Channels without signal: only the ones above threshold
+        std::vector<std::pair<CellID, double> > noise;
+        auto add_noise = [this, &hits, &noise](std::size_t channel_index, double value)  {
+          CellID cell = this->m_channels.channel(channel_index);
+          if ( hits.find(cell) == hits.end() ) noise.emplace_back(cell, value);
+        };
+        if ( m_dense )
+          m_noise->sample_dense(random, m_channels.num_channels, add_noise);
+        else
+          m_noise->sample_sparse(random, m_channels.num_channels, add_noise);
+
+        std::size_t created = 0UL;
+        for( const auto& n : noise )   {
+          std::pair<const CellID, EnergyDeposit> dep(n.first, EnergyDeposit());
+          EnergyDeposit& depo = dep.second;
+          depo.deposit  = n.second;
+          depo.flag     = EnergyDeposit::DEPOSIT_NOISE | EnergyDeposit::ZERO_SUPPRESSED;
+          depo.mask     = cont.key.mask();
+          depo.position = m_volumeMgr.lookupContext(n.first)->localToWorld(m_channels.segment.position(n.first));
+          if ( predicate(dep) )  {
+            cont.emplace(dep.first, std::move(depo));
+            ++created;
+          }
+        }
+        info("%s+++ %-32s Noise+zero suppression: %6ld entries, updated %6ld killed %6ld, %6ld noise channels created. mask: %04X",
+             context.event->id(), cont.name.c_str(), cont.size(), updated, killed, created, cont.key.mask());
+      }
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+
+/// Factory instantiation:
+#include <DDDigi/DigiFactories.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiDepositNoiseZeroSuppress)
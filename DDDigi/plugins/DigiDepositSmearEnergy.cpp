@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -101,10 +102,15 @@ namespace dd4hep {
       /// Create deposit mapping with updates on same cellIDs
       template <typename T> void
       smear(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
-        auto& random = context.randomGenerator();
+        auto random = context.randomStream(*this, cont.key.value());
+        auto poisson = random.generator();
+        std::vector<double> gauss(3 * cont.size());
         std::size_t updated = 0UL;
+        std::size_t index   = 0UL;
 
+        random.gaussian(gauss.data(), gauss.size());
         for( auto& dep : cont )    {
+          const double* g = &gauss[3 * index++];
           if ( predicate(dep) )   {
             CellID cell = dep.first;
             EnergyDeposit& depo = dep.second;
@@ -117,17 +123,17 @@ namespace dd4hep {
             double delta_ion = 0e0, num_pairs = 0e0;
             constexpr static double eps = std::numeric_limits<double>::epsilon();
             if ( sigma_E_systematic > eps )   {
-              delta_E += sigma_E_systematic * random.gaussian(0e0, 1e0);
+              delta_E += sigma_E_systematic * g[0];
             }
             if ( sigma_E_intrin_fluct > eps )   {
-              delta_E += sigma_E_intrin_fluct * random.gaussian(0e0, 1e0);
+              delta_E += sigma_E_intrin_fluct * g[1];
             }
             if ( sigma_E_instrument > eps )   {
-              delta_E += sigma_E_instrument * random.gaussian(0e0, 1e0);
+              delta_E += sigma_E_instrument * g[2];
             }
             if ( m_ionization_fluctuation )   {
               num_pairs = energy / (m_pair_ionization_energy/dd4hep::GeV);
-              delta_ion = energy * (random.poisson(num_pairs)/num_pairs);
+              delta_ion = energy * (poisson.poisson(num_pairs)/num_pairs);
               delta_E += delta_ion;
             }
             if ( dd4hep::isActivePrintLevel(outputLevel()) )   {
@@ -21,6 +21,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -59,17 +60,21 @@ namespace dd4hep {
       template <typename T> void
       smear(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
         VolumeManager volMgr = m_kernel.detectorDescription().volumeManager();
-        auto& random = context.randomGenerator();
+        auto random = context.randomStream(*this, cont.key.value());
+        std::vector<double> gauss(2 * cont.size());
         std::size_t updated = 0UL;
+        std::size_t index   = 0UL;
 
+        random.gaussian(gauss.data(), gauss.size());
         for( auto& dep : cont )    {
+          const double* g = &gauss[2 * index++];
           if ( predicate(dep) )   {
             CellID cell = dep.first;
             EnergyDeposit& depo = dep.second;
             auto*     ctxt = volMgr.lookupContext(cell);
             Position  local_pos = ctxt->worldToLocal(depo.position);
-            double    delta_u   = m_resolution_u * random.gaussian();
-            double    delta_v   = m_resolution_v * random.gaussian();
+            double    delta_u   = m_resolution_u * g[0];
+            double    delta_v   = m_resolution_v * g[1];
             Position  delta_pos(delta_u, delta_v, 0e0);
             Position  oldpos = depo.position;
             Position  newpos = ctxt->localToWorld(local_pos + delta_pos);
@@ -21,6 +21,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -65,12 +66,16 @@ namespace dd4hep {
       template <typename T> void
       smear(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
         constexpr double eps = detail::numeric_epsilon;
-        auto& random = context.randomGenerator();
+        auto random = context.randomStream(*this, cont.key.value());
         const auto& ev = *(context.event);
+        std::vector<double> gauss(2 * cont.size());
         std::size_t updated = 0UL;
+        std::size_t index   = 0UL;
 
         VolumeManager volMgr = m_kernel.detectorDescription().volumeManager();
+        random.gaussian(gauss.data(), gauss.size());
         for( auto& dep : cont )    {
+          const double* g = &gauss[2 * index++];
           if ( predicate(dep) )   {
             CellID cell = dep.first;
             EnergyDeposit& depo = dep.second;
@@ -81,12 +86,12 @@ namespace dd4hep {
             double    cos_u   = local_dir.Dot(Position(1,0,0));
             double    sin_u   = std::sqrt(1e0 - cos_u*cos_u);
             double    tan_u   = sin_u/(std::abs(cos_u)>eps ? cos_u : eps);
-            double    delta_u = tan_u * m_resolution_u * random.gaussian();
+            double    delta_u = tan_u * m_resolution_u * g[0];
 
             double    cos_v   = local_dir.Dot(Position(0,1,0));
             double    sin_v   = std::sqrt(1e0 - cos_v*cos_v);
             double    tan_v   = sin_v/(std::abs(cos_v)>eps ? cos_v : eps);
-            double    delta_v = tan_v * m_resolution_v * random.gaussian();
+            double    delta_v = tan_v * m_resolution_v * g[1];
 
             Position  delta_pos(delta_u, delta_v, 0e0);
             Position  oldpos = depo.position;
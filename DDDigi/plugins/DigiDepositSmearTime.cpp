@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -44,13 +45,16 @@ namespace dd4hep {
       /// Create deposit mapping with updates on same cellIDs
       template <typename T> void
       smear(DigiContext& context, T& cont, work_t& /* work */, const predicate_t& predicate)  const  {
-        auto& random = context.randomGenerator();
+        auto random = context.randomStream(*this, cont.key.value());
+        std::vector<double> deltas(cont.size());
         std::size_t killed  = 0UL;
         std::size_t updated = 0UL;
+        std::size_t index   = 0UL;
+        random.gaussian(deltas.data(), deltas.size(), 0e0, m_resolution_time);
         for( auto& dep : cont )  {
+          double delta_T = deltas[index++];
           if ( predicate(dep) )  {
             int flag = EnergyDeposit::TIME_SMEARED;
-            double delta_T = m_resolution_time * random.gaussian();
             if ( delta_T < m_window_time.first || delta_T > m_window_time.second )   {
               flag |= EnergyDeposit::KILLED;
               ++killed;
@@ -13,6 +13,7 @@
 
 // Framework include files
 #include <DDDigi/DigiData.h>
+#include <DDDigi/DigiContext.h>
 #include <DDDigi/DigiEventAction.h>
 
 /// C/C++ include files
@@ -40,10 +41,10 @@ namespace dd4hep {
 
       /// Main functional callback
       virtual void execute(DigiContext& context)   const  override final  {
-        auto& rndm = context.randomGenerator();
-        double theta  = rndm.uniform(0.0, M_PI);       // theta  = [0,pi]
-        double phi    = rndm.uniform(0.0, 2.0*M_PI);   // phi    = [0,2*pi]	
-        double radius = rndm.uniform(0.0, 1.0);        // radius = [0,1]
+        auto   random = context.randomStream(*this);
+        double theta  = M_PI * random();               // theta  = ]0,pi[
+        double phi    = 2.0 * M_PI * random();         // phi    = ]0,2*pi[
+        double radius = random();                      // radius = ]0,1[
         radius = std::sqrt( -std::log(radius) );       // radius in a gaussian distribution
 
         double st = std::sin(theta);
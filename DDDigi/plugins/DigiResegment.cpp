@@ -22,6 +22,18 @@
 #include <DD4hep/IDDescriptor.h>
 #include <DD4hep/Segmentations.h>
 #include <DD4hep/DetectorLoad.h>
+#include <DD4hep/VolumeManager.h>
+
+/// ROOT include files
+#include <TGeoMatrix.h>
+
+/// C/C++ include files
+#include <algorithm>
+
+#ifdef DD4HEP_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -35,6 +47,14 @@ namespace dd4hep {
      *  The selected deposits are placed in the output container
      *  supplied by the arguments.
      *
+     *  The deposits are grouped by sensitive volume: the volume context and
+     *  the transformation to the world are resolved once per volume and the
+     *  positions of all deposits of a volume are converted in one go.
+     *  With TBB the volumes are processed in parallel. The volume contexts
+     *  and transformations are resolved before, in the calling thread:
+     *  the geometry lookups are not thread safe. The output is filled in
+     *  the order of the input independent of the number of threads.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_DIGITIZATION
@@ -45,6 +65,10 @@ namespace dd4hep {
       std::string  m_readout_name  { };
       std::string  m_readout_descriptor { };
       bool         m_debug              { false };
+      /// Property: Process the volumes in parallel (TBB only)
+      bool         m_parallel           { true };
+      /// Property: Minimal number of deposits to process the volumes in parallel
+      long         m_parallel_min       { 1024 };
 
       Readout      m_new_readout  { };
       Segmentation m_new_segment  { };
@@ -54,6 +78,53 @@ namespace dd4hep {
       IDDescriptor m_org_id_desc  { };
       DetElement   m_detector { };
       VolumeManager m_volmgr  { };
+
+      /// Resegmentation result of one deposit
+      struct cell_t   {
+        const VolumeManagerContext* context { nullptr };
+        CellID   cell   { 0 };
+        Position local  { };
+        Position global { };
+      };
+      /// Volume context and combined transformation sensitive volume -> world of one volume
+      struct volume_t   {
+        const VolumeManagerContext* context { nullptr };
+        TGeoHMatrix trafo { };
+      };
+
+      /// Create the nominal alignments of all detector elements of the subdetector
+      /** DetElement::nominal() creates the alignment on first access without locking.
+       *  Creating them at initialization keeps the accesses during event processing read-only.
+       */
+      void prepare_alignments(DetElement de)  const  {
+        de.nominal();
+        for( const auto& child : de.children() )
+          prepare_alignments(child.second);
+      }
+
+      /// Resegment the deposits of one volume: order[begin, end) are the (volume, deposit index) pairs
+      template <typename DEPOSIT> void
+      resegment_volume(const std::vector<const DEPOSIT*>& deposits,
+                       const std::vector<std::pair<VolumeID, std::size_t> >& order,
+                       std::size_t begin, std::size_t end,
+                       const volume_t& volume,
+                       std::vector<cell_t>& cells)  const  {
+        VolumeID      volID = order[begin].first;
+        const double* r = volume.trafo.GetRotationMatrix();
+        const double* t = volume.trafo.GetTranslation();
+        for( std::size_t i = begin; i < end; ++i )
+          cells[order[i].second].local = m_org_segment.position(deposits[order[i].second]->first);
+        for( std::size_t i = begin; i < end; ++i )   {
+          cell_t& c = cells[order[i].second];
+          double  x = c.local.X(), y = c.local.Y(), z = c.local.Z();
+          c.global.SetCoordinates(r[0]*x + r[1]*y + r[2]*z + t[0],
+                                  r[3]*x + r[4]*y + r[5]*z + t[1],
+                                  r[6]*x + r[7]*y + r[8]*z + t[2]);
+          c.cell    = m_new_segment.cellID(c.local, c.global, volID);
+          c.context = volume.context;
+        }
+      }
+
     public:
       /// Standard constructor
       DigiResegment(const DigiKernel& krnl, const std::string& nam)
@@ -63,6 +134,8 @@ namespace dd4hep {
         declareProperty("detector",   m_detector_name);
         declareProperty("readout",    m_readout_name);
         declareProperty("descriptor", m_readout_descriptor);
+        declareProperty("parallel",     m_parallel);
+        declareProperty("parallel_min", m_parallel_min);
         m_kernel.register_initialize(std::bind(&DigiResegment::initialize, this));
       }
 
@@ -100,47 +173,83 @@ namespace dd4hep {
         if ( !m_volmgr.isValid() )   {
           except("+++ Cannot locate volume manager!");
         }
+        prepare_alignments(m_detector);
         info("+++ Successfully initialized resegmentation action.");
       }
 
       template <typename T> void
       resegment_deposits(const T& cont, work_t& work, const predicate_t& predicate)  const  {
+        using deposit_t = typename T::value_type;
         Key key(cont.name, work.environ.output.mask);
         DepositVector m(cont.name, key.mask(), cont.data_type);
         std::size_t start = m.size();
+
+        // Selected deposits in input order and sorted by volume
+        std::vector<const deposit_t*> deposits;
+        deposits.reserve(cont.size());
         for( const auto& dep : cont )   {
-          if( predicate(dep) )   {
-            CellID cell = dep.first;
-            auto*  ctxt = m_volmgr.lookupContext(cell);
-            if ( !ctxt )   {
-              error("+++ Cannot locate volume context for cell %016lX", cell);
-            }
-            else   {
-              VolumeID volID     = m_org_segment.volumeID(cell);
-              Position org_local = m_org_segment.position(cell);
-              Position global    = ctxt->localToWorld(org_local);
-              CellID   new_cell  = m_new_segment.cellID(org_local, global, volID);
-              Position new_local = m_new_segment.position(new_cell);
-              if ( m_debug )   {
-                info("+++ Cell: %016lX -> %016lX DE: %-20s "
-                     "Pos global: %8.2f %8.2f %8.2f  local: %8.2f %8.2f %8.2f -> %8.2f %8.2f %8.2f",
-                     cell, new_cell, ctxt->element.name(), 
-                     global.X(), global.Y(), global.Z(),
-                     org_local.X(), org_local.Y(), org_local.Z(),
-                     new_local.X(), new_local.Y(), new_local.Z()
-                     );
-              }
-              EnergyDeposit d(dep.second);
-              d.position = std::move(global);
-              d.momentum = dep.second.momentum;
-              m.emplace(new_cell, std::move(d));
-            }
+          if( predicate(dep) ) deposits.emplace_back(&dep);
+        }
+        std::vector<std::pair<VolumeID, std::size_t> > order(deposits.size());
+        for( std::size_t i = 0; i < deposits.size(); ++i )
+          order[i] = { m_org_segment.volumeID(deposits[i]->first), i };
+        std::sort(order.begin(), order.end());
+        std::vector<std::size_t> volumes;
+        for( std::size_t i = 0; i < order.size(); ++i )   {
+          if ( i == 0 || order[i].first != order[i-1].first ) volumes.emplace_back(i);
+        }
+        volumes.emplace_back(order.size());
+
+        std::size_t num_volumes = volumes.size() - 1;
+        // Volume contexts and transformations: resolved sequentially. lookupContext throws on failure
+        std::vector<volume_t> volume_data(num_volumes);
+        for( std::size_t i = 0; i < num_volumes; ++i )   {
+          volume_t& v = volume_data[i];
+          v.context = m_volmgr.lookupContext(deposits[order[volumes[i]].second]->first);
+          // Combined transformation: sensitive volume -> detector element -> world
+          v.trafo = v.context->element.nominal().worldTransformation();
+          v.trafo.Multiply(&v.context->toElement());
+        }
+
+        std::vector<cell_t> cells(deposits.size());
+#ifdef DD4HEP_USE_TBB
+        if ( m_parallel && num_volumes > 1 && long(deposits.size()) >= m_parallel_min )   {
+          tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_volumes),
+                            [&](const tbb::blocked_range<std::size_t>& r)  {
+                              for( std::size_t i = r.begin(); i != r.end(); ++i )
+                                resegment_volume(deposits, order, volumes[i], volumes[i+1], volume_data[i], cells);
+                            });
+        }
+        else
+#endif
+        {
+          for( std::size_t i = 0; i < num_volumes; ++i )
+            resegment_volume(deposits, order, volumes[i], volumes[i+1], volume_data[i], cells);
+        }
+
+        // Fill the output in the order of the input
+        for( std::size_t i = 0; i < deposits.size(); ++i )   {
+          const auto& dep = *deposits[i];
+          const auto& c   = cells[i];
+          if ( m_debug )   {
+            Position new_local = m_new_segment.position(c.cell);
+            info("+++ Cell: %016lX -> %016lX DE: %-20s "
+                 "Pos global: %8.2f %8.2f %8.2f  local: %8.2f %8.2f %8.2f -> %8.2f %8.2f %8.2f",
+                 dep.first, c.cell, c.context->element.name(), 
+                 c.global.X(), c.global.Y(), c.global.Z(),
+                 c.local.X(), c.local.Y(), c.local.Z(),
+                 new_local.X(), new_local.Y(), new_local.Z()
+                 );
           }
+          EnergyDeposit d(dep.second);
+          d.position = c.global;
+          d.momentum = dep.second.momentum;
+          m.emplace(c.cell, std::move(d));
         }
         std::size_t end   = m.size();
         work.environ.output.data.put(m.key, std::move(m));
-        info("+++ %-32s added %6ld entries (now: %6ld) from mask: %04X to mask: %04X",
-             cont.name.c_str(), end-start, end, cont.key.mask(), m.key.mask());
+        info("+++ %-32s added %6ld entries (now: %6ld) from mask: %04X to mask: %04X [%ld volumes]",
+             cont.name.c_str(), end-start, end, cont.key.mask(), m.key.mask(), long(num_volumes));
       }
 
       /// Main functional callback
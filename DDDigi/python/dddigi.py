@@ -335,6 +335,8 @@ _props('DigiSynchronize', adopt=_adopt_event_action, adopt_action=_adopt_sequenc
 _props('DigiActionSequence', adopt=_adopt_event_action, adopt_action=_adopt_sequence_action)
 _props('DigiParallelActionSequence', adopt_action=_adopt_sequence_action)
 _props('DigiSequentialActionSequence', adopt_action=_adopt_sequence_action)
+_props('DigiTimeFrameBuilder', adopt=_adopt_event_action, adopt_action=_adopt_sequence_action)
+_props('DigiOverlayCache', adopt=_adopt_event_action, adopt_action=_adopt_sequence_action)
 _props('DigiContainerSequenceAction', adopt_container_processor=_adopt_container_processor)
 _props('DigiMultiContainerProcessor', adopt_processor=_adopt_processor)
 _props('DigiSegmentSplitter', adopt_segment_processor=_adopt_segment_processor)
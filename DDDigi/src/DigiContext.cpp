@@ -16,6 +16,7 @@
 #include <DD4hep/InstanceCount.h>
 #include <DDDigi/DigiContext.h>
 #include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiAction.h>
 
 // C/C++ include files
 #include <algorithm>
@@ -29,6 +30,13 @@ DigiContext::DigiContext(const DigiKernel& k, std::unique_ptr<DigiEvent>&& e)
   InstanceCount::increment(this);
 }
 
+/// Initializing constructor for a private event sharing the random engine of the parent context
+DigiContext::DigiContext(const DigiContext& parent, std::unique_ptr<DigiEvent>&& e)
+  : kernel(parent.kernel), event(std::move(e)), m_random(parent.m_random)
+{
+  InstanceCount::increment(this);
+}
+
 /// Default destructor
 DigiContext::~DigiContext() {
   // Do not delete run and event structures here. This is done outside in the framework
@@ -50,6 +58,24 @@ std::mutex& DigiContext::global_output_lock()   const  {
   return kernel.global_output_lock();
 }
 
+/// Counter based random stream of an action and a channel
+DigiRandomStream DigiContext::randomStream(const DigiAction& action, std::uint64_t channel)  const   {
+  return DigiRandomStream(randomKey(action), channel);
+}
+
+/// Per-event key of the random streams of an action
+std::uint64_t DigiContext::randomKey(const DigiAction& action)  const   {
+  return randomKey(detail::hash64(action.name()));
+}
+
+/// Per-event key of the random streams of an action from the hash of its name
+std::uint64_t DigiContext::randomKey(std::uint64_t name_hash)  const   {
+  std::uint64_t seed = kernel.randomSeed();
+  std::int32_t  num  = event->eventNumber;
+  std::uint64_t key  = detail::update_hash64(name_hash, &seed, sizeof(seed));
+  return detail::update_hash64(key, &num,  sizeof(num));
+}
+
 /// Access to detector description
 dd4hep::Detector& DigiContext::detectorDescription()  const {
   return kernel.detectorDescription();
@@ -20,16 +20,115 @@
 
 // C/C++ include files
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace   {
-  struct digi_keys   {
-    std::mutex  lock;
-    std::map<unsigned long, std::string> map;
+
+  /// Append-only registry of the key names for reverse lookups
+  /**
+   *  Open addressing hash tables with atomic slots. Names are never removed,
+   *  hence registration and lookup do not need a lock. If the probed slots
+   *  of a table are all taken, the search continues in a chained table of
+   *  twice the size, which is created on demand: the registry has no size limit.
+   *  If two names have the same item key, the last registered name is kept,
+   *  as with the former map. Registering the name already stored is a no-op.
+   */
+  class digi_keys   {
+    static constexpr std::size_t NUM_SLOTS  = 1UL << 13;
+    static constexpr std::size_t MAX_PROBES = 64;
+
+    /// One table of the chain
+    struct table_t  {
+      const std::size_t mask;
+      /// Slot tag: 0 if empty, else bit 32 set plus the item key
+      std::unique_ptr<std::atomic<std::uint64_t>[]>      items;
+      /// Names of the items. Published after the slot was claimed
+      std::unique_ptr<std::atomic<const std::string*>[]> names;
+      /// Next table, twice the size of this one
+      std::atomic<table_t*>                              next { nullptr };
+
+      table_t(std::size_t num_slots)
+        : mask(num_slots - 1),
+          items(new std::atomic<std::uint64_t>[num_slots]()),
+          names(new std::atomic<const std::string*>[num_slots]())   {
+      }
+      ~table_t()   {
+        for( std::size_t i = 0; i <= mask; ++i ) delete names[i].load();
+        delete next.load();
+      }
+    };
+    /// First table of the chain
+    table_t                                          m_table { NUM_SLOTS };
+    /// Names replaced by a later registration: kept alive for concurrent readers
+    std::mutex                                       m_lock;
+    std::vector<std::unique_ptr<const std::string> > m_replaced;
+
+    /// Wait until the name of a claimed slot is published
+    static const std::string* published(const std::atomic<const std::string*>& slot)   {
+      const std::string* name = slot.load(std::memory_order_acquire);
+      for( ; !name; name = slot.load(std::memory_order_acquire) )
+        std::this_thread::yield();
+      return name;
+    }
+    /// Access the next table of the chain. Created if it does not exist yet
+    static table_t* next_table(table_t* table)   {
+      table_t* next = table->next.load(std::memory_order_acquire);
+      if ( !next )  {
+        std::unique_ptr<table_t> created(new table_t(2 * (table->mask + 1)));
+        if ( table->next.compare_exchange_strong(next, created.get(), std::memory_order_acq_rel) )
+          next = created.release();
+      }
+      return next;
+    }
+    /// Replace the name of a slot if it differs
+    void replace(std::atomic<const std::string*>& slot, const std::string& name)   {
+      if ( *published(slot) == name ) return;
+      std::lock_guard<std::mutex> guard(m_lock);
+      m_replaced.emplace_back(slot.exchange(new std::string(name), std::memory_order_acq_rel));
+    }
+
+  public:
+    /// Register name of an item key
+    void add(Key::itemkey_type item, const std::string& name)   {
+      const std::uint64_t tag = (1ULL << 32) | item;
+      for( table_t* t = &m_table; ; t = next_table(t) )   {
+        for( std::size_t i = 0, slot = item & t->mask; i < MAX_PROBES; ++i, slot = (slot + 1) & t->mask )  {
+          std::uint64_t current = t->items[slot].load(std::memory_order_acquire);
+          if ( current == 0 && t->items[slot].compare_exchange_strong(current, tag, std::memory_order_acq_rel) )  {
+            t->names[slot].store(new std::string(name), std::memory_order_release);
+            return;
+          }
+          if ( current == tag )  {
+            replace(t->names[slot], name);
+            return;
+          }
+        }
+      }
+    }
+    /// Access name of an item key. nullptr if not registered
+    const std::string* get(Key::itemkey_type item)  const   {
+      const std::uint64_t tag = (1ULL << 32) | item;
+      for( const table_t* t = &m_table; t; t = t->next.load(std::memory_order_acquire) )   {
+        for( std::size_t i = 0, slot = item & t->mask; i < MAX_PROBES; ++i, slot = (slot + 1) & t->mask )  {
+          std::uint64_t current = t->items[slot].load(std::memory_order_acquire);
+          if ( current == 0 ) return nullptr;
+          if ( current == tag ) return published(t->names[slot]);
+        }
+      }
+      return nullptr;
+    }
   };
   digi_keys& keys()  {
     static digi_keys k;
     return k;
   }
+
+  /// Item key of the particle containers: computed at compile time, registered at load time
+  constexpr dd4hep::digi::Key::itemkey_type MCPARTICLES_ITEM = dd4hep::digi::Key::hash("MCParticles");
+  [[maybe_unused]] const dd4hep::digi::Key::itemkey_type mcparticles_registered = dd4hep::digi::Key::register_name("MCParticles");
 }
 
 using namespace dd4hep::digi;
@@ -55,20 +154,23 @@ Key& Key::set(const std::string& name, int mask)    {
 
 /// Generate key using hash algorithm
 Key& Key::set(const std::string& name, int segment, int mask)    {
-  auto& _k = keys();
-  if ( name.empty() )   {
-    std::lock_guard<std::mutex> lock(_k.lock);
-    except("DDDigi::Key", "+++ No key name was specified  --  this is illegal!");
-  }
   this->key = 0;
-  this->set_item(detail::hash32(name));
+  this->set_item(register_name(name));
   this->set_mask(Key::mask_type(0xFFFF&mask));
   this->set_segment(Key::segment_type(0xFF&segment));
-  std::lock_guard<std::mutex> lock(_k.lock);
-  _k.map[this->item()] = name;
   return *this;
 }
 
+/// Register the name of an item key for reverse lookups. Returns the item key
+Key::itemkey_type Key::register_name(const std::string& name)   {
+  if ( name.empty() )   {
+    except("DDDigi::Key", "+++ No key name was specified  --  this is illegal!");
+  }
+  itemkey_type item = detail::hash32(name);
+  keys().add(item, name);
+  return item;
+}
+
 /// Set key submask
 Key& Key::set_submask(const char* opt_tag)   {
   submask_type sm = detail::hash16(opt_tag);
@@ -78,24 +180,16 @@ Key& Key::set_submask(const char* opt_tag)   {
 
 /// Access key name (if registered properly)
 std::string Key::key_name(const Key& k)    {
-  auto& _k = keys();
-  std::lock_guard<std::mutex> lock(_k.lock);
-  std::map<unsigned long, std::string>::const_iterator it = _k.map.find(k.item());
-  if ( it != _k.map.end() ) return it->second;
-  for( const auto& e : _k.map )   {
-    if ( e.first == k.values.item )
-      return e.second;
-  }
-  return "UNKNOWN";
+  const std::string* name = keys().get(k.item());
+  return name ? *name : std::string("UNKNOWN");
 }
 
 const Particle& dd4hep::digi::get_history_particle(const DigiEvent& event, Key history_key)   {
-  static Key item_key("MCParticles",0x0);
   Key key;
   const auto& segment = event.get_segment(history_key.segment());
   key.set_segment(history_key.segment());
   key.set_mask(history_key.mask());
-  key.set_item(item_key.item());
+  key.set_item(MCPARTICLES_ITEM);
   const auto& particles = segment.get<ParticleMapping>(std::move(key));
   return particles.get(std::move(history_key));
 }
@@ -125,10 +219,9 @@ std::pair<std::size_t,std::size_t> History::drop()   {
 }
 
 const Particle& History::hist_entry_t::get_particle(const DigiEvent& event)  const  {
-  static Key item_key("MCParticles",0x0);
   Key key(this->source);
   const auto& segment = event.get_segment(Key(this->source).segment());
-  const auto& particle_data = segment.get<ParticleMapping>(key.set_item(item_key.item()));
+  const auto& particle_data = segment.get<ParticleMapping>(key.set_item(MCPARTICLES_ITEM));
   return particle_data.get(this->source);
 }
 
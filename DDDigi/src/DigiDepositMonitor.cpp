@@ -26,12 +26,12 @@ using namespace dd4hep::digi;
 
 /// Add 1D histogram entry with weight
 void Histo1D::fill(double x, double weight)    {
-  hist->Fill(x, weight);
+  bins->fill(x, weight);
 }
 
 /// Add 2D histogram entry with weight
 void Histo2D::fill(double x, double y, double weight)    {
-  hist->Fill(x, y, weight);
+  bins->fill(x, y, weight);
 }
 
 /// Standard constructor
@@ -55,8 +55,9 @@ void DigiDepositMonitor::initialize()    {
 Histo1D DigiDepositMonitor::book1D(const std::string& name, const std::string& title,
 				   std::size_t nbin_x, double min_x, double max_x)   {
   auto* h = new TH1F(name.c_str(), title.c_str(), nbin_x, min_x, max_x);
-  m_kernel.register_monitor(this, h);
-  return { h };
+  auto  b = std::make_shared<HistogramAccumulator>(nbin_x, min_x, max_x);
+  m_kernel.register_monitor(this, h, b);
+  return { h, b };
 }
 
 /// Book 1D histogram and register it to the kernel for output handling
@@ -64,8 +65,9 @@ Histo2D DigiDepositMonitor::book2D(const std::string& name, const std::string& t
 				   std::size_t nbin_x, double min_x, double max_x,
 				   std::size_t nbin_y, double min_y, double max_y)   {
   auto* h = new TH2F(name.c_str(), title.c_str(), nbin_x, min_x, max_x, nbin_y, min_y, max_y);
-  m_kernel.register_monitor(this, h);
-  return { h };
+  auto  b = std::make_shared<HistogramAccumulator>(nbin_x, min_x, max_x, nbin_y, min_y, max_y);
+  m_kernel.register_monitor(this, h, b);
+  return { h, b };
 }
 
 /// Standard constructor
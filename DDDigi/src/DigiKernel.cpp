@@ -108,8 +108,10 @@ public:
   int                   maxEventsParallel;
   /// Property: maximum number of threads to be used (if TBB)
   int                   num_threads;
-  /// Property: Allow to stop execution from interactive prompt
+  /// Property: Allow to stop execution from interactive prompt. Accessed under counter_lock
   bool                  stop = false;
+  /// Property: Seed of the counter based random streams
+  long                  random_seed = 0;
 
 public:
   /// Default constructor
@@ -186,6 +188,7 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->num_threads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("randomSeed",       internals->random_seed = 0);
   declareProperty("OutputLevels",     internals->clientLevels);
   auto* h = new DigiMonitorHandler(*this, "MonitorData");
   properties().add("MonitorOutput", h->property("MonitorOutput"));
@@ -271,6 +274,23 @@ std::size_t DigiKernel::events_todo()  const   {
   return evts;
 }
 
+/// Access the seed of the counter based random streams
+std::uint64_t DigiKernel::randomSeed()  const   {
+  return std::uint64_t(internals->random_seed);
+}
+
+/// Request to stop the event loop (e.g. after a failure outside the event threads)
+void DigiKernel::stop_event_loop()  const   {
+  std::lock_guard<std::mutex> lock(internals->counter_lock);
+  internals->stop = true;
+}
+
+/// Check if the event loop shall be stopped
+bool DigiKernel::stop_requested()  const   {
+  std::lock_guard<std::mutex> lock(internals->counter_lock);
+  return internals->stop;
+}
+
 /// Access current number of events already processed
 std::size_t DigiKernel::events_done()  const   {
   std::lock_guard<std::mutex> lock(internals->counter_lock);
@@ -365,6 +385,18 @@ void DigiKernel::register_monitor(DigiAction* action, TNamed* object)  const
 	 object ? object->GetTitle() : "");
 }
 
+/// Registration of histograms filled by per-thread accumulation. Merged before saving
+void DigiKernel::register_monitor(DigiAction* action, TNamed* object, std::shared_ptr<HistogramAccumulator> bins)  const    {
+  this->register_monitor(action, object);
+  std::lock_guard<std::mutex> lock(internals->counter_lock);
+  internals->monitor_handler->adopt(object, std::move(bins));
+}
+
+/// Merge the per-thread accumulated monitoring histograms
+void DigiKernel::merge_monitors()  const    {
+  internals->monitor_handler->merge();
+}
+
 /// Submit a bunch of actions to be executed in parallel
 void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[], std::size_t count, void* data, bool parallel)  const    {
   const char* tag = context.event->id();
@@ -374,13 +406,13 @@ void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[],
     tbb::task_group que;
     info("%s+++ Executing chunk of %3ld execution entries in parallel", tag, count);
     try   {
-      for( std::size_t i=0; i<count && !internals->stop; ++i)
+      for( std::size_t i=0; i<count && !stop_requested(); ++i)
 	que.run( Wrapper<ParallelCall,void*>(algorithms[i], data) );
       que.wait();
     }
     catch(const std::exception& e)    {
       std::exception_ptr eptr = std::current_exception();
-      internals->stop = true;
+      stop_event_loop();
       error("%s+++ C++ exception. STOP event loop. [%s]", tag, e.what());
       std::rethrow_exception(std::move(eptr));
     }
@@ -431,7 +463,7 @@ void DigiKernel::notify(std::unique_ptr<DigiContext>&& context)   {
 /// Notify kernel that the execution of one single event finished
 void DigiKernel::notify(std::unique_ptr<DigiContext>&& context, const std::exception& e)   {
   const char* tag = context->event->id();
-  internals->stop = true;
+  stop_event_loop();
   error("%s+++ Exception during event processing [Shall stop the event loop]", tag);
   error("%s -> %s", tag, e.what());
   notify(std::move(context));
@@ -464,7 +496,7 @@ int DigiKernel::run()   {
 	  main_group.wait();
 	}
 	catch(const std::exception& e)    {
-	  internals->stop = true;
+	  stop_event_loop();
 	  error("run: +++ C++ exception. Event loop stop. [%s]", e.what());
 	  main_group.wait();
 	}
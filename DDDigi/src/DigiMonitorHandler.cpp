@@ -13,10 +13,12 @@
 
 /// Framework include files
 #include <DD4hep/Printout.h>
+#include <DD4hep/HistogramAccumulator.h>
 #include <DDDigi/DigiMonitorHandler.h>
 
 /// ROOT include files
 #include <TFile.h>
+#include <TH1.h>
 
 /// C/C++ include files
 
@@ -31,6 +33,7 @@ DigiMonitorHandler::DigiMonitorHandler(const DigiKernel& kernel, const std::stri
 
 /// Default destructor
 DigiMonitorHandler::~DigiMonitorHandler()    {
+  m_accumulators.clear();
   for( auto& m : m_monitors )   {
     m.first->release();
     for( auto* itm : m.second )   {
@@ -47,8 +50,25 @@ void DigiMonitorHandler::adopt(DigiAction* source, TNamed* object)    {
   m_monitors[source].insert(object);
 }
 
+/// Attach per-thread accumulator to an adopted histogram
+void DigiMonitorHandler::adopt(TNamed* object, std::shared_ptr<HistogramAccumulator> bins)    {
+  m_accumulators[object] = std::move(bins);
+}
+
+/// Merge the accumulated entries into the histograms
+void DigiMonitorHandler::merge()    {
+  for( auto& a : m_accumulators )   {
+    TH1* hist = dynamic_cast<TH1*>(a.first);
+    if ( !hist )  {
+      dd4hep::except("DigiMonitorHandler", "+++ Monitor %s is no histogram: cannot merge accumulated entries.", a.first->GetName());
+    }
+    a.second->merge(hist);
+  }
+}
+
 /// Save monitors
 void DigiMonitorHandler::save()    {
+  this->merge();
   if ( !m_output_file.empty() )    {
     TFile* output = TFile::Open(m_output_file.c_str(),
                                 "DD4hep Digitization monitoring information",
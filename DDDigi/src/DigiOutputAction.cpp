@@ -19,10 +19,61 @@
 #include <DDDigi/DigiKernel.h>
 
 // C/C++ include files
+#include <condition_variable>
+#include <algorithm>
 #include <stdexcept>
+#include <chrono>
+#include <thread>
 
 using namespace dd4hep::digi;
 
+/// Staging and committer thread data
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiOutputAction::staging_t  {
+public:
+  using clock_t = std::chrono::steady_clock;
+  /// Lock protecting the staging data
+  std::mutex                           lock;
+  /// Signal for the committer thread
+  std::condition_variable              signal;
+  /// Signal for event threads waiting for space in the ready queue
+  std::condition_variable              space;
+  /// Frames under conversion
+  std::map<const DigiEvent*, frame_t*> active;
+  /// Converted frames waiting for commit. Failed events have no frame
+  std::map<long, frame_pointer_t>      ready;
+  /// Committer thread
+  std::thread                          committer;
+  /// Number of the next event to be committed
+  long                                 next_event   { 1 };
+  /// Number of committed frames
+  long                                 num_commits  { 0 };
+  /// Number of frames which failed to commit
+  long                                 num_errors   { 0 };
+  /// Maximum number of frames waiting for commit before event threads block
+  std::size_t                          max_ready    { 1 };
+  /// Flag to stop the committer thread once all frames are written
+  bool                                 stop         { false };
+  /// Time of the first conversion and of the last commit
+  clock_t::time_point                  start, end;
+
+  /// Write all pending frames and stop the committer thread
+  void finish()   {
+    if ( committer.joinable() )   {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+      }
+      signal.notify_all();
+      committer.join();
+    }
+  }
+};
+
 /// Standard constructor
 DigiOutputAction::DigiOutputAction(const DigiKernel& kernel, const std::string& nam)
   : DigiContainerSequenceAction(kernel, nam)
@@ -31,11 +82,15 @@ DigiOutputAction::DigiOutputAction(const DigiKernel& kernel, const std::string&
   declareProperty("processor_type", m_processor_type);
   declareProperty("containers",     m_containers);
   declareProperty("output",         m_output);
+  declareProperty("staged_output",  m_staged_output);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 DigiOutputAction::~DigiOutputAction()   {
+  if ( m_staging )   {
+    m_staging->finish();
+  }
   InstanceCount::decrement(this);
 }
 
@@ -79,14 +134,108 @@ void DigiOutputAction::initialize()   {
   }
   std::lock_guard<std::mutex> lock(m_kernel.global_io_lock());
   this->DigiContainerSequenceAction::initialize();
+  if ( create_frame() )   {
+    m_staging = std::make_unique<staging_t>();
+    m_staging->max_ready = std::max(1, m_kernel.property("maxEventsParallel").value<int>());
+    if ( m_staged_output )   {
+      m_staging->committer = std::thread([this]() { this->run_committer(); });
+      info("+++ Staged output: events are converted concurrently and committed in order.");
+    }
+  }
 }
 
 /// Finalization callback
 void DigiOutputAction::finalize()   {
+  if ( m_staging )   {
+    m_staging->finish();
+    if ( m_staging->num_commits > 0 )   {
+      std::chrono::duration<double> secs = m_staging->end - m_staging->start;
+      info("+++ Committed %ld events in %.3f seconds: %.2f events/s [%d threads]",
+           m_staging->num_commits, secs.count(),
+           secs.count() > 0e0 ? double(m_staging->num_commits)/secs.count() : 0e0,
+           m_kernel.property("numThreads").value<int>());
+    }
+    if ( m_staging->num_errors > 0 )   {
+      error("+++ %ld events failed to be committed.", m_staging->num_errors);
+    }
+  }
   close_output();
+  m_staging.reset();
   this->DigiContainerSequenceAction::finalize();
 }
 
+/// Commit event data to output stream (writers without frame support)
+void DigiOutputAction::commit_output() const   {
+  except("+++ The output action does not implement commit_output.");
+}
+
+/// Create the (empty) output frame of one event. Default: no frame support
+DigiOutputAction::frame_pointer_t DigiOutputAction::create_frame()  const   {
+  return { };
+}
+
+/// Commit staged event data to the output stream
+void DigiOutputAction::commit_frame(frame_t& /* frame */)  const   {
+  except("+++ The output action does not implement commit_frame.");
+}
+
+/// Access the output frame of an event during the conversion
+DigiOutputAction::frame_t& DigiOutputAction::staged_frame(const context_t& context)  const   {
+  if ( m_staging )   {
+    std::lock_guard<std::mutex> lock(m_staging->lock);
+    auto it = m_staging->active.find(context.event.get());
+    if ( it != m_staging->active.end() )   {
+      return *it->second;
+    }
+  }
+  except("%s+++ No output frame present for this event.", context.event->id());
+  throw std::runtime_error("No output frame");
+}
+
+/// Committer thread: write staged frames in the order of the event numbers
+void DigiOutputAction::run_committer()  const   {
+  auto& stage = *m_staging;
+  std::unique_lock<std::mutex> lock(stage.lock);
+  while( true )   {
+    stage.signal.wait(lock, [&stage]()  {
+      return stage.stop || (!stage.ready.empty() && stage.ready.begin()->first <= stage.next_event);
+    });
+    if ( stage.ready.empty() )   {
+      break;   // Stop requested and all frames are written
+    }
+    auto it = stage.ready.begin();
+    long evt = it->first;
+    frame_pointer_t frame = std::move(it->second);
+    stage.ready.erase(it);
+    stage.next_event = evt + 1;
+    lock.unlock();
+    bool ok = true, written = false;
+    if ( frame )   {
+      /// ROOT/podio I/O is not thread safe: serialize with the event threads
+      std::lock_guard<std::mutex> io_lock(m_kernel.global_io_lock());
+      try   {
+        if ( !have_output() )   {
+          open_output();
+        }
+        commit_frame(*frame);
+        written = true;
+      }
+      catch(const std::exception& e)   {
+        error("+++ Failed to commit event %ld: %s [Shall stop the event loop]", evt, e.what());
+        m_kernel.stop_event_loop();
+        ok = false;
+      }
+    }
+    frame.reset();
+    lock.lock();
+    stage.end = staging_t::clock_t::now();
+    if ( !ok ) ++stage.num_errors;
+    if ( written ) ++stage.num_commits;
+    stage.space.notify_all();
+  }
+  stage.space.notify_all();
+}
+
 /// Adopt new parallel worker
 void DigiOutputAction::adopt_processor(DigiContainerProcessor* action,
 				       const std::string& container)
@@ -112,6 +261,58 @@ void DigiOutputAction::adopt_processor(DigiContainerProcessor* action,
 
 /// Pre-track action callback
 void DigiOutputAction::execute(DigiContext& context)  const   {
+  if ( m_staging )   {
+    auto& stage = *m_staging;
+    frame_pointer_t frame = create_frame();
+    frame->event = context.event->eventNumber;
+    {
+      std::lock_guard<std::mutex> lock(stage.lock);
+      if ( stage.start == staging_t::clock_t::time_point() )
+        stage.start = staging_t::clock_t::now();
+      stage.active.emplace(context.event.get(), frame.get());
+    }
+    /// Convert the containers into the event frame: no lock required
+    try   {
+      this->DigiContainerSequenceAction::execute(context);
+    }
+    catch(...)   {
+      std::lock_guard<std::mutex> lock(stage.lock);
+      stage.active.erase(context.event.get());
+      if ( stage.committer.joinable() )   {
+        stage.ready.emplace(frame->event, frame_pointer_t());
+        stage.signal.notify_one();
+      }
+      throw;
+    }
+    {
+      std::lock_guard<std::mutex> lock(stage.lock);
+      stage.active.erase(context.event.get());
+    }
+    if ( stage.committer.joinable() )   {
+      std::unique_lock<std::mutex> lock(stage.lock);
+      stage.ready.emplace(frame->event, std::move(frame));
+      stage.signal.notify_one();
+      /// Backpressure: do not start new events while the committer falls behind.
+      /// The own frame is queued first: the committer may be waiting for it.
+      /// A frame missing after a failed event stalls the committer: poll the stop flag.
+      while ( stage.ready.size() > stage.max_ready && !stage.stop )   {
+        if ( stage.space.wait_for(lock, std::chrono::milliseconds(100)) == std::cv_status::timeout )   {
+          if ( m_kernel.stop_requested() ) break;
+        }
+      }
+      return;
+    }
+    /// No committer thread: commit the frame directly
+    std::lock_guard<std::mutex> lock(context.global_io_lock());
+    if ( !have_output() )   {
+      open_output();
+    }
+    commit_frame(*frame);
+    std::lock_guard<std::mutex> stage_lock(stage.lock);
+    stage.end = staging_t::clock_t::now();
+    ++stage.num_commits;
+    return;
+  }
   std::lock_guard<std::mutex> lock(context.global_io_lock());
   /// Check for valid output stream. If not: open new stream
   if ( !have_output() )   {
@@ -0,0 +1,181 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiOverlayCache.h>
+#include <DDDigi/DigiRandomGenerator.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiKernel.h>
+
+// C/C++ include files
+#include <cmath>
+#include <vector>
+
+using namespace dd4hep::digi;
+
+namespace   {
+  /// Decode one background container: the deposits carry the overlay mask, no history
+  template <typename CONT> std::size_t
+  decode_container(DepositVector& output, CONT& cont, Key::mask_type mask)   {
+    for( auto& depo : cont )   {
+      EnergyDeposit dep(std::move(depo.second));
+      dep.mask    = mask;
+      dep.history = History();
+      output.emplace(depo.first, std::move(dep));
+    }
+    return cont.size();
+  }
+}
+
+/// Standard constructor
+DigiOverlayCache::DigiOverlayCache(const DigiKernel& krnl, const std::string& nam)
+  : DigiSequentialActionSequence(krnl, nam)
+{
+  declareProperty("cache_size",     m_cache_size);
+  declareProperty("pool_size",      m_pool_size);
+  declareProperty("mean_overlay",   m_mean_overlay);
+  declareProperty("poisson",        m_poisson);
+  declareProperty("input_segment",  m_input_segment);
+  declareProperty("output_segment", m_output_segment);
+  declareProperty("output_mask",    m_output_mask);
+  m_kernel.register_terminate(std::bind(&DigiOverlayCache::finalize,this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiOverlayCache::~DigiOverlayCache() {
+  InstanceCount::decrement(this);
+}
+
+/// Finalization callback
+void DigiOverlayCache::finalize()   {
+  long hits = m_num_hits, misses = m_num_misses;
+  info("+++ Overlay cache: %ld requests, %ld hits, %ld misses. Hit rate: %.1f %%  "
+       "%ld background events read, %ld evicted. Cache size: %ld Pool size: %ld Reproducible: %s",
+       hits+misses, hits, misses, hits+misses > 0 ? 100e0*double(hits)/double(hits+misses) : 0e0,
+       m_num_reads, m_num_evictions, long(m_cache_size), long(m_pool_size), yes_no(reproducible()));
+}
+
+/// Read and decode the next background event (m_read_lock held)
+DigiOverlayCache::entry_pointer_t DigiOverlayCache::read_entry(context_t& context)  const   {
+  DigiContext source(context, std::make_unique<DigiEvent>(int(++m_num_reads)));
+  this->DigiSequentialActionSequence::execute(source);
+
+  auto entry = std::make_shared<entry_t>();
+  auto& segment = source.event->get_segment(m_input_segment);
+  for( auto& item : segment )   {
+    if ( auto* v = std::any_cast<DepositVector>(&item.second) )   {
+      auto& out = entry->containers.emplace(v->name, DepositVector(v->name, m_output_mask, v->data_type)).first->second;
+      entry->num_deposits += decode_container(out, *v, m_output_mask);
+    }
+    else if ( auto* m = std::any_cast<DepositMapping>(&item.second) )   {
+      auto& out = entry->containers.emplace(m->name, DepositVector(m->name, m_output_mask, m->data_type)).first->second;
+      entry->num_deposits += decode_container(out, *m, m_output_mask);
+    }
+  }
+  return entry;
+}
+
+/// Add a background event to the cache. Evicts the least recently used (m_lock held)
+void DigiOverlayCache::insert_entry(long slot, const entry_pointer_t& entry)  const   {
+  if ( m_cache_size > 0 )   {
+    while( m_cache.size() >= m_cache_size )   {
+      m_cache.erase(m_lru.back());
+      m_lru.pop_back();
+      ++m_num_evictions;
+    }
+    m_lru.push_front(slot);
+    m_cache.emplace(slot, slot_t(entry, m_lru.begin()));
+  }
+}
+
+/// Access the background event of a pool slot. Reads it on a cache miss
+DigiOverlayCache::entry_pointer_t DigiOverlayCache::get_entry(context_t& context, long slot)  const   {
+  auto lookup = [this, slot]()  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto iter = m_cache.find(slot);
+    if ( iter == m_cache.end() ) return entry_pointer_t();
+    m_lru.splice(m_lru.begin(), m_lru, iter->second.second);
+    ++m_num_hits;
+    return iter->second.first;
+  };
+  if ( entry_pointer_t entry = lookup() )   {
+    return entry;
+  }
+  std::lock_guard<std::mutex> read_lock(m_read_lock);
+  /// Another event may have loaded the slot while waiting for the reader
+  if ( entry_pointer_t entry = lookup() )   {
+    return entry;
+  }
+  ++m_num_misses;
+  if ( reproducible() )   {
+    /// Load the slots in order: slot i is always the i-th background event
+    entry_pointer_t entry;
+    while( m_next_slot <= slot )   {
+      entry_pointer_t next = read_entry(context);
+      std::lock_guard<std::mutex> lock(m_lock);
+      insert_entry(m_next_slot, next);
+      if ( m_next_slot == slot ) entry = next;
+      ++m_next_slot;
+    }
+    return entry;
+  }
+  entry_pointer_t entry = read_entry(context);
+  std::lock_guard<std::mutex> lock(m_lock);
+  insert_entry(slot, entry);
+  return entry;
+}
+
+/// Overlay the sampled background events onto the signal event
+void DigiOverlayCache::execute(context_t& context)  const   {
+  if ( m_pool_size == 0 )   {
+    except("+++ Invalid overlay setup: the pool size must be positive.");
+  }
+  auto   stream = context.randomStream(*this);
+  double num_overlay = m_mean_overlay;
+  if ( m_poisson && m_mean_overlay > 0e0 )
+    stream.poisson(&num_overlay, 1, m_mean_overlay);
+  std::size_t num = std::size_t(std::lround(std::max(num_overlay, 0e0)));
+
+  /// Sample the pool slots with replacement
+  std::vector<double> rndm(num);
+  stream.uniform(rndm.data(), num);
+  std::vector<entry_pointer_t> entries;
+  entries.reserve(num);
+  for( double r : rndm )   {
+    long slot = std::min(long(r * double(m_pool_size)), long(m_pool_size) - 1);
+    entries.emplace_back(get_entry(context, slot));
+  }
+
+  /// Copy the deposits of the cached containers into the output containers
+  std::map<std::string, DepositVector> outputs;
+  std::size_t num_deposits = 0;
+  for( const auto& entry : entries )   {
+    for( const auto& cont : entry->containers )   {
+      auto iter = outputs.find(cont.first);
+      if ( iter == outputs.end() )   {
+        DepositVector out(cont.first, m_output_mask, cont.second.data_type);
+        iter = outputs.emplace(cont.first, std::move(out)).first;
+      }
+      num_deposits += iter->second.insert(cont.second);
+    }
+  }
+  auto& segment = context.event->get_segment(m_output_segment);
+  for( auto& out : outputs )   {
+    Key key(out.first, m_output_mask);
+    segment.emplace(std::move(key), std::move(out.second));
+  }
+  info("%s+++ Overlaid %ld background events with %ld deposits in %ld containers.",
+       context.event->id(), num, num_deposits, outputs.size());
+}
@@ -28,6 +28,7 @@
 #include <Math/ProbFuncMathCore.h>
 #include <Math/SpecFuncMathCore.h>
 #include <Math/QuantFuncMathCore.h>
+#include <algorithm>
 #include <cmath>
 
 
@@ -243,3 +244,104 @@ void   DigiRandomGenerator::circle(double &x, double &y, double r)   const  {
   x = r*std::cos(phi);
   y = r*std::sin(phi);
 }
+
+/// Number of counter blocks processed per chunk by the bulk functions
+static constexpr std::size_t CHUNK = 128;
+
+/// Initializing constructor
+DigiRandomStream::DigiRandomStream(std::uint64_t key, std::uint64_t stream)
+  : m_key{ std::uint32_t(key), std::uint32_t(key >> 32) }, m_stream(stream)
+{
+}
+
+/// Fill pairs of uniform numbers in ]0,1[ from consecutive counter blocks
+void DigiRandomStream::fill(double* first, double* second, std::size_t pairs)   {
+  const std::uint32_t s0 = std::uint32_t(m_stream), s1 = std::uint32_t(m_stream >> 32);
+  for( std::size_t i = 0; i < pairs; ++i )   {
+    std::uint64_t block = m_block + i;
+    counter_t r = philox({ std::uint32_t(block), std::uint32_t(block >> 32), s0, s1 }, m_key);
+    first[i]  = to_uniform(r[0], r[1]);
+    second[i] = to_uniform(r[2], r[3]);
+  }
+  m_block += pairs;
+}
+
+/// Next uniform number in ]0,1[
+double DigiRandomStream::operator()()   {
+  if ( m_buffered == 0 )   {
+    fill(&m_buffer[0], &m_buffer[1], 1);
+    m_buffered = 2;
+  }
+  return m_buffer[2 - m_buffered--];
+}
+
+/// Generator with the TRandom algorithms drawing from this stream
+DigiRandomGenerator DigiRandomStream::generator()   {
+  DigiRandomGenerator gen;
+  gen.engine = [this]  {  return (*this)();  };
+  return gen;
+}
+
+/// Fill uniform numbers in ]x1,x2[
+void DigiRandomStream::uniform(double* values, std::size_t n, double x1, double x2)   {
+  double a[CHUNK], b[CHUNK], scale = x2 - x1;
+  for( std::size_t i = 0; i < n; i += 2*CHUNK )   {
+    std::size_t num   = std::min(2*CHUNK, n - i);
+    std::size_t pairs = (num + 1) / 2;
+    double*     out   = values + i;
+    fill(a, b, pairs);
+    for( std::size_t j = 0; j < num/2; ++j )   {
+      out[2*j]   = x1 + scale * a[j];
+      out[2*j+1] = x1 + scale * b[j];
+    }
+    if ( num % 2 ) out[num-1] = x1 + scale * a[pairs-1];
+  }
+}
+
+/// Fill gaussian numbers (Box-Muller)
+void DigiRandomStream::gaussian(double* values, std::size_t n, double mean, double sigma)   {
+  double a[CHUNK], b[CHUNK];
+  for( std::size_t i = 0; i < n; i += 2*CHUNK )   {
+    std::size_t num   = std::min(2*CHUNK, n - i);
+    std::size_t pairs = (num + 1) / 2;
+    double*     out   = values + i;
+    fill(a, b, pairs);
+    for( std::size_t j = 0; j < pairs; ++j )   {
+      double r   = sigma * std::sqrt(-2e0 * std::log(a[j]));
+      double phi = TWOPI * b[j];
+      a[j] = mean + r * std::cos(phi);
+      b[j] = mean + r * std::sin(phi);
+    }
+    for( std::size_t j = 0; j < num/2; ++j )   {
+      out[2*j]   = a[j];
+      out[2*j+1] = b[j];
+    }
+    if ( num % 2 ) out[num-1] = a[pairs-1];
+  }
+}
+
+/// Fill exponentially distributed numbers
+void DigiRandomStream::exponential(double* values, std::size_t n, double tau)   {
+  uniform(values, n);
+  for( std::size_t i = 0; i < n; ++i )
+    values[i] = -tau * std::log(values[i]);
+}
+
+/// Fill landau distributed numbers
+void DigiRandomStream::landau(double* values, std::size_t n, double mean, double sigma)   {
+  if ( sigma <= 0 )   {
+    std::fill(values, values + n, 0e0);
+    return;
+  }
+  uniform(values, n);
+  for( std::size_t i = 0; i < n; ++i )
+    values[i] = mean + ROOT::Math::landau_quantile(values[i], sigma);
+}
+
+/// Fill poisson distributed numbers
+void DigiRandomStream::poisson(double* values, std::size_t n, double mean)   {
+  // Rejection sampling consumes a variable number of uniforms: no batching
+  DigiRandomGenerator gen = this->generator();
+  for( std::size_t i = 0; i < n; ++i )
+    values[i] = gen.poisson(mean);
+}
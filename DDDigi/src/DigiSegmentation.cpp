@@ -18,6 +18,73 @@
 #include <DD4hep/Plugins.h>
 #include <DD4hep/Shapes.h>
 
+// ROOT include files
+#include <TGeoTube.h>
+
+using namespace dd4hep::digi;
+
+/// Radii of a tube without phi segmentation. Returns false for all other solids
+bool DigiCellRuns::full_tube(Solid solid, double& rmin, double& rmax)   {
+  const TGeoShape* shape = solid.ptr();
+  /// Exact types only: cut tubes etc. inherit from TGeoTubeSeg
+  if ( shape->IsA() == TGeoTubeSeg::Class() )   {
+    const TGeoTubeSeg* seg = static_cast<const TGeoTubeSeg*>(shape);
+    if ( seg->GetPhi2() - seg->GetPhi1() < 360e0 - 1e-10 ) return false;
+  }
+  else if ( shape->IsA() != TGeoTube::Class() )   {
+    return false;
+  }
+  const TGeoTube* tube = static_cast<const TGeoTube*>(shape);
+  rmin = tube->GetRmin();
+  rmax = tube->GetRmax();
+  return true;
+}
+
+/// Compute the valid cells of a solid
+std::shared_ptr<const DigiCellRuns> DigiCellScanner::build_cells(Solid solid)  const   {
+  except("DigiCellScanner","+++ Cell enumeration of solid %s [%s] is not implemented.",
+         solid.name(), solid.title());
+  return {};
+}
+
+/// Access the valid cells of a solid. Computed on first access and cached
+const DigiCellRuns& DigiCellScanner::cells(Solid solid)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto& entry = m_cells[solid.ptr()];
+  if ( !entry )   {
+    entry = this->build_cells(solid);
+    printout(DEBUG,"DigiCellScanner","+++ Solid %-24s [%s]: %ld cells in %ld rows and %ld runs.",
+             solid.name(), solid.title(), long(entry->num_cells), long(entry->rows.size()), long(entry->runs.size()));
+  }
+  return *entry;
+}
+
+/// Append the identifiers of all cells of a placement
+std::size_t DigiCellScanner::cell_ids(PlacedVolume pv, VolumeID vid, std::vector<CellID>& ids)   {
+  const DigiCellRuns& c = this->cells(pv.volume().solid());
+  ids.reserve(ids.size() + c.num_cells);
+  c.scan(vid, [&ids](CellID cell_id, const DigiCellRuns::row_t&, long)  {  ids.emplace_back(cell_id);  });
+  return c.num_cells;
+}
+
+/// Collect the channels of all sensitive placements below pv with the volume identifier vid
+void DigiSubdetectorChannels::scan(const IDDescriptor& id_desc, PlacedVolume pv, VolumeID vid)   {
+  Volume vol = pv.volume();
+  if ( vol.isSensitive() )    {
+    Solid sol = vol.solid();
+    auto& scanner = scanners[sol->IsA()];
+    if ( !scanner ) scanner = create_cell_scanner(sol, segment);
+    const DigiCellRuns& cells = scanner->cells(sol);
+    channels.push_back({ vid, &cells, num_channels });
+    num_channels += cells.num_cells;
+  }
+  for ( int idau = 0, ndau = pv->GetNdaughters(); idau < ndau; ++idau ) {
+    PlacedVolume  p(pv->GetDaughter(idau));
+    const VolIDs& new_ids = p.volIDs();
+    scan(id_desc, p, new_ids.empty() ? vid : vid | id_desc.encode(new_ids));
+  }
+}
+
 std::shared_ptr<dd4hep::digi::DigiCellScanner>
 dd4hep::digi::create_cell_scanner(Solid solid, Segmentation segment)   {
   std::string typ = "DigiCellScanner" +
@@ -14,6 +14,8 @@
 // Framework include files
 #include <DD4hep/InstanceCount.h>
 #include <DDDigi/DigiSignalProcessor.h>
+#include <DDDigi/DigiSegmentation.h>
+#include <DDDigi/DigiContext.h>
 
 /// Standard constructor
 dd4hep::digi::DigiSignalProcessor::DigiSignalProcessor(const DigiKernel& krnl, const std::string& nam)
@@ -32,3 +34,14 @@ void dd4hep::digi::DigiSignalProcessor::initialize()   {
   m_initialized = true;
 }
 
+/// Counter based random stream of this processor for the cell of the context
+dd4hep::digi::DigiRandomStream
+dd4hep::digi::DigiSignalProcessor::randomStream(const DigiCellContext& context)  const   {
+  std::uint64_t name_hash = m_nameHash.load(std::memory_order_relaxed);
+  if ( 0 == name_hash )   {
+    name_hash = detail::hash64(name());
+    m_nameHash.store(name_hash, std::memory_order_relaxed);
+  }
+  return DigiContext::randomStream(context.context.randomKey(name_hash), context.data.cell_id);
+}
+
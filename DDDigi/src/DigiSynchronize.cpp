@@ -19,6 +19,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <chrono>
 
 using namespace dd4hep::digi;
 
@@ -26,6 +27,15 @@ using namespace dd4hep::digi;
 template <> void 
 DigiParallelWorker<DigiEventAction, DigiSynchronize::work_t, std::size_t, DigiSynchronize&>::execute(void* data) const  {
   calldata_t* args = reinterpret_cast<calldata_t*>(data);
+  if ( predicate.m_timing )   {
+    auto start = std::chrono::steady_clock::now();
+    action->execute(*args);
+    std::chrono::nanoseconds ns = std::chrono::steady_clock::now() - start;
+    auto& stat = *predicate.m_timing_stats[options];
+    stat.nanoseconds += long(ns.count());
+    ++stat.calls;
+    return;
+  }
   action->execute(*args);
 }
 
@@ -33,6 +43,8 @@ DigiParallelWorker<DigiEventAction, DigiSynchronize::work_t, std::size_t, DigiSy
 DigiSynchronize::DigiSynchronize(const DigiKernel& kernel, const std::string& nam)
   : DigiEventAction(kernel, nam)
 {
+  declareProperty("timing", m_timing);
+  m_kernel.register_terminate(std::bind(&DigiSynchronize::print_timing,this));
   InstanceCount::increment(this);
 }
 
@@ -41,6 +53,22 @@ DigiSynchronize::~DigiSynchronize() {
   InstanceCount::decrement(this);
 }
 
+/// Finalization callback: print the execution time statistics
+void DigiSynchronize::print_timing()  const   {
+  if ( m_timing )   {
+    auto group   = m_actors.get_group();
+    auto workers = group.actors();
+    for( std::size_t i = 0; i < workers.size(); ++i )   {
+      const auto* worker = workers[i];
+      const auto& stat   = *m_timing_stats[worker->options];
+      long   calls = stat.calls;
+      double secs  = 1e-9 * double(stat.nanoseconds);
+      info("+++ Timing %-32s calls: %8ld total: %12.6f sec mean: %12.6f ms",
+           worker->name(), calls, secs, calls > 0 ? 1e3 * secs / double(calls) : 0e0);
+    }
+  }
+}
+
 /// Pre-track action callback
 void DigiSynchronize::execute(DigiContext& context)  const   {
   auto start = std::chrono::high_resolution_clock::now();
@@ -57,6 +85,7 @@ void DigiSynchronize::execute(DigiContext& context)  const   {
 /// Add an actor responding to all callbacks. Sequence takes ownership.
 void DigiSynchronize::adopt(DigiEventAction* action) {
   if (action)    {
+    m_timing_stats.emplace_back(std::make_unique<timing_t>());
     m_actors.insert(new worker_t(action, m_actors.size(), *this));
     return;
   }
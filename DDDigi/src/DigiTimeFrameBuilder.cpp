@@ -0,0 +1,171 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Primitives.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiTimeFrameBuilder.h>
+#include <DDDigi/DigiRandomGenerator.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiKernel.h>
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+namespace   {
+  /// Move the deposits of one source container to the timeline
+  template <typename CONT> std::size_t
+  add_to_timeline(DigiTimeFrameBuilder::timeline_t& timeline, CONT& cont, double t0)   {
+    timeline.reserve(timeline.size() + cont.size());
+    for( auto& depo : cont )   {
+      EnergyDeposit dep(std::move(depo.second));
+      dep.time   += t0;
+      dep.history = History();
+      timeline.emplace_back(depo.first, std::move(dep));
+    }
+    return cont.size();
+  }
+}
+
+/// Standard constructor
+DigiTimeFrameBuilder::DigiTimeFrameBuilder(const DigiKernel& krnl, const std::string& nam)
+  : DigiSequentialActionSequence(krnl, nam)
+{
+  declareProperty("slice_length",      m_slice_length  = 1000e0 * dd4hep::ns);
+  declareProperty("slice_overlap",     m_slice_overlap =   50e0 * dd4hep::ns);
+  declareProperty("bunch_spacing",     m_bunch_spacing =   25e0 * dd4hep::ns);
+  declareProperty("mean_interactions", m_mean_interactions);
+  declareProperty("input_segment",     m_input_segment);
+  declareProperty("output_segment",    m_output_segment);
+  declareProperty("output_mask",       m_output_mask);
+  m_kernel.register_terminate(std::bind(&DigiTimeFrameBuilder::finalize,this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiTimeFrameBuilder::~DigiTimeFrameBuilder() {
+  InstanceCount::decrement(this);
+}
+
+/// Finalization callback
+void DigiTimeFrameBuilder::finalize()   {
+  info("+++ Read %ld interactions from %ld bunch crossings. Maximum buffer: %ld deposits.",
+       m_num_interactions, m_next_bunch, m_max_buffered);
+}
+
+/// Read one interaction and place its deposits on the timeline
+std::size_t DigiTimeFrameBuilder::read_interaction(context_t& context, double t0)  const   {
+  DigiContext source(context, std::make_unique<DigiEvent>(int(++m_num_interactions)));
+  this->DigiSequentialActionSequence::execute(source);
+
+  std::size_t count = 0;
+  auto& segment = source.event->get_segment(m_input_segment);
+  for( auto& entry : segment )   {
+    if ( auto* v = std::any_cast<DepositVector>(&entry.second) )   {
+      auto& line = m_timeline[v->name];
+      line.first = v->data_type;
+      count += add_to_timeline(line.second, *v, t0);
+    }
+    else if ( auto* m = std::any_cast<DepositMapping>(&entry.second) )   {
+      auto& line = m_timeline[m->name];
+      line.first = m->data_type;
+      count += add_to_timeline(line.second, *m, t0);
+    }
+  }
+  return count;
+}
+
+/// Read interactions until all bunch crossings before the time limit are on the timeline
+void DigiTimeFrameBuilder::fill_timeline(context_t& context, double time_limit)  const   {
+  std::uint64_t seed = m_kernel.randomSeed();
+  std::uint64_t key  = detail::hash64(name());
+  key = detail::update_hash64(key, &seed, sizeof(seed));
+  while( double(m_next_bunch) * m_bunch_spacing < time_limit )   {
+    double t0 = double(m_next_bunch) * m_bunch_spacing;
+    double num_interactions = 1e0;
+    if ( m_mean_interactions > 0e0 )   {
+      DigiRandomStream(key, m_next_bunch).poisson(&num_interactions, 1, m_mean_interactions);
+    }
+    for( long i = 0; i < long(num_interactions); ++i )   {
+      std::size_t count = read_interaction(context, t0);
+      debug("%s+++ Bunch crossing %ld t0: %9.2f ns: added %ld deposits to the timeline.",
+            context.event->id(), m_next_bunch, t0/dd4hep::ns, count);
+    }
+    ++m_next_bunch;
+  }
+}
+
+/// Copy the deposits of the time window [start, end) into the output segment
+std::size_t DigiTimeFrameBuilder::extract_slice(context_t& context, double start, double end)  const   {
+  auto& outputs = context.event->get_segment(m_output_segment);
+  std::size_t count = 0, buffered = 0;
+  for( const auto& line : m_timeline )   {
+    DepositVector out(line.first, m_output_mask, line.second.first);
+    for( const auto& depo : line.second.second )   {
+      double time = depo.second.time;
+      if ( in_slice(time, start, end, m_slice_overlap) )   {
+        EnergyDeposit dep(depo.second);
+        to_slice(dep, start, end);
+        dep.mask  = m_output_mask;
+        out.emplace(depo.first, std::move(dep));
+      }
+    }
+    buffered += line.second.second.size();
+    count    += out.size();
+    Key key(out.name, m_output_mask);
+    outputs.emplace(std::move(key), std::move(out));
+  }
+  m_max_buffered = std::max(m_max_buffered, buffered);
+  return count;
+}
+
+/// Release deposits, which are no longer needed by any open slice
+void DigiTimeFrameBuilder::release_deposits()  const   {
+  double limit = double(m_first_open) * m_slice_length - m_slice_overlap;
+  for( auto& line : m_timeline )   {
+    auto& deposits = line.second.second;
+    auto iter = std::remove_if(deposits.begin(), deposits.end(),
+                               [limit](const timeline_t::value_type& d) { return d.second.time < limit; });
+    deposits.erase(iter, deposits.end());
+  }
+}
+
+/// Build the time slice of this event
+void DigiTimeFrameBuilder::execute(context_t& context)  const   {
+  long   slice = context.event->eventNumber - 1;
+  double start = double(slice) * m_slice_length;
+  double end   = start + m_slice_length;
+  if ( m_slice_length <= 0e0 || m_bunch_spacing <= 0e0 )   {
+    except("+++ Invalid time frame: slice length: %g ns bunch spacing: %g ns",
+           m_slice_length/dd4hep::ns, m_bunch_spacing/dd4hep::ns);
+  }
+  std::lock_guard<std::mutex> lock(m_lock);
+  if ( slice < m_first_open || m_extracted.count(slice) )   {
+    except("%s+++ Time slice %ld was already extracted.", context.event->id(), slice);
+  }
+  fill_timeline(context, end + m_slice_overlap);
+  std::size_t count = extract_slice(context, start, end);
+  m_extracted.insert(slice);
+  if ( slice == m_first_open )   {
+    while( !m_extracted.empty() && *m_extracted.begin() == m_first_open )   {
+      m_extracted.erase(m_extracted.begin());
+      ++m_first_open;
+    }
+    release_deposits();
+  }
+  info("%s+++ Time slice %ld [%9.2f, %9.2f] ns: %ld deposits in %ld containers.",
+       context.event->id(), slice, start/dd4hep::ns, end/dd4hep::ns, count, m_timeline.size());
+}
@@ -34,5 +34,7 @@ DigiExponentialNoise::~DigiExponentialNoise() {
 
 /// Callback to read event exponentialnoise
 double DigiExponentialNoise::operator()(DigiCellContext& context)  const  {
-  return context.context.randomGenerator().exponential(m_tau);
+  double value = 0e0;
+  randomStream(context).exponential(&value, 1, m_tau);
+  return value;
 }
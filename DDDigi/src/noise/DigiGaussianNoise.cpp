@@ -38,5 +38,7 @@ DigiGaussianNoise::~DigiGaussianNoise() {
 double DigiGaussianNoise::operator()(DigiCellContext& context)  const  {
   if ( context.data.signal < m_cutoff )
     return 0;
-  return context.context.randomGenerator().gaussian(m_mean,m_sigma);
+  double value = 0e0;
+  randomStream(context).gaussian(&value, 1, m_mean, m_sigma);
+  return value;
 }
@@ -38,5 +38,7 @@ DigiLandauNoise::~DigiLandauNoise() {
 double DigiLandauNoise::operator()(DigiCellContext& context)  const  {
   if ( context.data.signal < m_cutoff )
     return 0;
-  return context.context.randomGenerator().landau(m_mean,m_sigma);
+  double value = 0e0;
+  randomStream(context).landau(&value, 1, m_mean, m_sigma);
+  return value;
 }
@@ -37,5 +37,7 @@ DigiPoissonNoise::~DigiPoissonNoise() {
 double DigiPoissonNoise::operator()(DigiCellContext& context)  const  {
   if ( context.data.signal >= m_cutoff )
     return 0;
-  return context.context.randomGenerator().poisson(m_mean);
+  double value = 0e0;
+  randomStream(context).poisson(&value, 1, m_mean);
+  return value;
 }
@@ -31,6 +31,8 @@ DigiRandomNoise::~DigiRandomNoise() {
 
 /// Initialize the noise source
 void DigiRandomNoise::initialize()   {
+  // Default seeded engine: the variance calibration is identical in all
+  // processes and does not depend on the event random streams
   std::default_random_engine generator;
   m_noise.init(m_poles, m_alpha, m_variance);
   m_noise.normalize(generator, 5000);
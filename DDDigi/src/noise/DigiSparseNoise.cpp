@@ -0,0 +1,39 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Printout.h>
+#include <DDDigi/noise/DigiSparseNoise.h>
+
+// ROOT include files
+#include <Math/ProbFuncMathCore.h>
+#include <Math/QuantFuncMathCore.h>
+
+using namespace dd4hep::digi;
+
+/// Initializing constructor
+DigiSparseNoise::DigiSparseNoise(double m, double s, double thr)
+  : mean(m), sigma(s), threshold(thr)
+{
+  if ( !(sigma > 0e0) )   {
+    except("DigiSparseNoise","+++ Invalid noise sigma: %g", sigma);
+  }
+  tail = ROOT::Math::normal_cdf_c(threshold - mean, sigma);
+}
+
+/// Noise value above threshold from a uniform number in ]0,1[
+double DigiSparseNoise::tail_value(double u)  const   {
+  double value = mean + ROOT::Math::normal_quantile_c(u * tail, sigma);
+  // Protect against rounding at the threshold
+  return value > threshold ? value : std::nextafter(threshold, 1e300);
+}
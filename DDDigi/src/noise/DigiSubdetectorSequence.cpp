@@ -73,6 +73,8 @@ void DigiSubdetectorSequence::scan_sensitive(PlacedVolume pv, VolumeID vid, Volu
     if ( is == m_scanners.end() )  {
       is = m_scanners.insert(std::make_pair(key, create_cell_scanner(sol, m_segmentation))).first;
     }
+    /// Compute the valid cells of the solid once before the event processing
+    is->second->prepare(pv);
   }
   for ( int idau = 0, ndau = pv->GetNdaughters(); idau < ndau; ++idau ) {
     PlacedVolume  p(pv->GetDaughter(idau));
@@ -34,5 +34,7 @@ DigiUniformNoise::~DigiUniformNoise() {
 
 /// Callback to read event uniformnoise
 double DigiUniformNoise::operator()(DigiCellContext& context)  const  {
-  return context.context.randomGenerator().uniform(m_min,m_max);
+  double value = 0e0;
+  randomStream(context).uniform(&value, 1, m_min, m_max);
+  return value;
 }
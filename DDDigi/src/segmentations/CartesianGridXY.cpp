@@ -0,0 +1,101 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/segmentations/CartesianGridXY.h>
+#include <DD4hep/detail/SegmentationsInterna.h>
+#include <DD4hep/Shapes.h>
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+template <>
+void dd4hep::digi::init_segmentation_data<dd4hep::CartesianGridXY>(segmentation_data<CartesianGridXY>& data,
+                                                                   const Segmentation& seg)
+{
+  CartesianGridXYHandle xy_seg = seg;
+  data.segmentation_xy = xy_seg->implementation;
+  const auto& x_f      = (*seg.decoder())[data.segmentation_xy->fieldNameX()];
+  const auto& y_f      = (*seg.decoder())[data.segmentation_xy->fieldNameY()];
+  data.x_grid_size     = data.segmentation_xy->gridSizeX();
+  data.y_grid_size     = data.segmentation_xy->gridSizeY();
+  data.x_offset        = data.segmentation_xy->offsetX();
+  data.y_offset        = data.segmentation_xy->offsetY();
+  data.x_f_offset      = x_f.offset();
+  data.y_f_offset      = y_f.offset();
+  data.x_mask          = x_f.mask();
+  data.y_mask          = y_f.mask();
+}
+
+/// Valid cells of a solid: rows along x with runs of y bins
+/**
+ *  Cells are valid if their center in the x-y plane at the z position of
+ *  the bounding box center is inside the solid. Boxes and tubes without
+ *  phi segmentation are computed analytically, all other solids by
+ *  probing the cell centers inside the bounding box.
+ */
+std::shared_ptr<const DigiCellRuns>
+dd4hep::digi::create_cell_runs(const segmentation_data<CartesianGridXY>& segment, Solid solid)   {
+  const TGeoBBox* box = dynamic_cast<const TGeoBBox*>(solid.ptr());
+  const double*   org = box->GetOrigin();
+  const double    gx = segment.x_grid_size, gy = segment.y_grid_size;
+  const double    ox = segment.x_offset,    oy = segment.y_offset;
+  auto xr    = DigiCellRuns::bin_range(org[0] - box->GetDX(), org[0] + box->GetDX(), gx, ox);
+  auto yr    = DigiCellRuns::bin_range(org[1] - box->GetDY(), org[1] + box->GetDY(), gy, oy);
+  auto cells = std::make_shared<DigiCellRuns>(segment.y_f_offset, segment.y_mask);
+  auto row   = [&](long bx)  {
+    cells->add_row((CellID(bx) << segment.x_f_offset) & segment.x_mask, bx);
+  };
+  double rmin = 0e0, rmax = 0e0;
+  if ( isA<Box>(solid) )   {
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      row(bx);
+      cells->add_run(yr);
+    }
+  }
+  else if ( DigiCellRuns::full_tube(solid, rmin, rmax) )   {
+    const auto r2 = DigiCellRuns::radial_range(rmin, rmax, std::max(gx, gy));
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      double x  = bx * gx + ox;
+      double x2 = x * x;
+      if ( x2 > r2.second ) continue;
+      double ymax = std::sqrt(r2.second - x2);
+      row(bx);
+      if ( x2 < r2.first )   {
+        double ymin = std::sqrt(r2.first - x2);
+        cells->add_run(DigiCellRuns::bin_range(-ymax, -ymin, gy, oy));
+        cells->add_run(DigiCellRuns::bin_range( ymin,  ymax, gy, oy));
+        continue;
+      }
+      cells->add_run(DigiCellRuns::bin_range(-ymax, ymax, gy, oy));
+    }
+  }
+  else   {
+    double pos[3] = { 0e0, 0e0, org[2] };
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      pos[0] = bx * gx + ox;
+      row(bx);
+      long first = yr.first;
+      for( long by = yr.first; by <= yr.second + 1; ++by )   {
+        pos[1] = by * gy + oy;
+        if ( by <= yr.second && solid->Contains(pos) ) continue;
+        cells->add_run(first, by - 1);
+        first = by + 1;
+      }
+    }
+  }
+  cells->close();
+  return cells;
+}
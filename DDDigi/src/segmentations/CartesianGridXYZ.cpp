@@ -0,0 +1,108 @@
+//==========================================================================
+//  AIDA Detector description implementation 
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/segmentations/CartesianGridXYZ.h>
+#include <DD4hep/detail/SegmentationsInterna.h>
+#include <DD4hep/Shapes.h>
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+template <>
+void dd4hep::digi::init_segmentation_data<dd4hep::CartesianGridXYZ>(segmentation_data<CartesianGridXYZ>& data,
+                                                                    const Segmentation& seg)
+{
+  CartesianGridXYZHandle xyz_seg = seg;
+  data.segmentation_xyz = xyz_seg->implementation;
+  const auto& x_f       = (*seg.decoder())[data.segmentation_xyz->fieldNameX()];
+  const auto& y_f       = (*seg.decoder())[data.segmentation_xyz->fieldNameY()];
+  const auto& z_f       = (*seg.decoder())[data.segmentation_xyz->fieldNameZ()];
+  data.x_grid_size      = data.segmentation_xyz->gridSizeX();
+  data.y_grid_size      = data.segmentation_xyz->gridSizeY();
+  data.z_grid_size      = data.segmentation_xyz->gridSizeZ();
+  data.x_offset         = data.segmentation_xyz->offsetX();
+  data.y_offset         = data.segmentation_xyz->offsetY();
+  data.z_offset         = data.segmentation_xyz->offsetZ();
+  data.x_f_offset       = x_f.offset();
+  data.y_f_offset       = y_f.offset();
+  data.z_f_offset       = z_f.offset();
+  data.x_mask           = x_f.mask();
+  data.y_mask           = y_f.mask();
+  data.z_mask           = z_f.mask();
+}
+
+/// Valid cells of a solid: rows along (x,y) with runs of z bins
+/**
+ *  Cells are valid if their center is inside the solid. Boxes and tubes
+ *  without phi segmentation are computed analytically, all other solids
+ *  by probing the cell centers inside the bounding box.
+ */
+std::shared_ptr<const DigiCellRuns>
+dd4hep::digi::create_cell_runs(const segmentation_data<CartesianGridXYZ>& segment, Solid solid)   {
+  const TGeoBBox* box = dynamic_cast<const TGeoBBox*>(solid.ptr());
+  const double*   org = box->GetOrigin();
+  const double    gx = segment.x_grid_size, gy = segment.y_grid_size, gz = segment.z_grid_size;
+  const double    ox = segment.x_offset,    oy = segment.y_offset,    oz = segment.z_offset;
+  auto xr    = DigiCellRuns::bin_range(org[0] - box->GetDX(), org[0] + box->GetDX(), gx, ox);
+  auto yr    = DigiCellRuns::bin_range(org[1] - box->GetDY(), org[1] + box->GetDY(), gy, oy);
+  auto zr    = DigiCellRuns::bin_range(org[2] - box->GetDZ(), org[2] + box->GetDZ(), gz, oz);
+  auto cells = std::make_shared<DigiCellRuns>(segment.z_f_offset, segment.z_mask);
+  auto row   = [&](long bx, long by)  {
+    cells->add_row(((CellID(bx) << segment.x_f_offset) & segment.x_mask) |
+                   ((CellID(by) << segment.y_f_offset) & segment.y_mask), bx, by);
+  };
+  double rmin = 0e0, rmax = 0e0;
+  if ( isA<Box>(solid) )   {
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      for( long by = yr.first; by <= yr.second; ++by )   {
+        row(bx, by);
+        cells->add_run(zr);
+      }
+    }
+  }
+  else if ( DigiCellRuns::full_tube(solid, rmin, rmax) )   {
+    const auto r2 = DigiCellRuns::radial_range(rmin, rmax, std::max(gx, gy));
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      double x = bx * gx + ox;
+      for( long by = yr.first; by <= yr.second; ++by )   {
+        double y  = by * gy + oy;
+        double rr = x * x + y * y;
+        if ( rr < r2.first || rr > r2.second ) continue;
+        row(bx, by);
+        cells->add_run(zr);
+      }
+    }
+  }
+  else   {
+    double pos[3] = { 0e0, 0e0, 0e0 };
+    for( long bx = xr.first; bx <= xr.second; ++bx )   {
+      pos[0] = bx * gx + ox;
+      for( long by = yr.first; by <= yr.second; ++by )   {
+        pos[1] = by * gy + oy;
+        row(bx, by);
+        long first = zr.first;
+        for( long bz = zr.first; bz <= zr.second + 1; ++bz )   {
+          pos[2] = bz * gz + oz;
+          if ( bz <= zr.second && solid->Contains(pos) ) continue;
+          cells->add_run(first, bz - 1);
+          first = bz + 1;
+        }
+      }
+    }
+  }
+  cells->close();
+  return cells;
+}
@@ -142,6 +142,7 @@ HEPMC3FileReader::HEPMC3FileReader(const std::string& nam)
   m_reader->set_run_info(std::move(runInfo));
 #endif
   m_directAccess = false;
+  m_eventContextAccess = true;   // Attaches the EventParameters to the event
 }
 
 void HEPMC3FileReader::registerRunParameters() {
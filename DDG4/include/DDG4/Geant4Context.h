@@ -93,7 +93,7 @@ namespace dd4hep {
       }
       /// Access to type safe extension object. Exception is thrown if the object is invalid
       template <typename T> T* extension(bool alert=true) {
-        return (T*)ObjectExtensions::extension(detail::typeHash64<T>(),alert);
+        return (T*)ObjectExtensions::extension(ObjectExtensions::slot<T>(),detail::typeHash64<T>(),alert);
       }
     };
 
@@ -123,6 +123,8 @@ namespace dd4hep {
       const G4Event* m_event  { nullptr };
       /// Reference to the main random number generator
       Geant4Random* m_random  { nullptr };
+      /// Event number assigned by the run manager
+      int           m_eventID { -1 };
 
     public:
       /// Intializing constructor
@@ -135,6 +137,8 @@ namespace dd4hep {
       const G4Event& event() const     {  return *m_event;   }
       /// Access the random number generator
       Geant4Random& random() const     {  return *m_random;  }
+      /// Event number assigned by the run manager, before generator actions modified it
+      int eventID() const              {  return m_eventID;  }
 
       /// Add an extension object to the detector element
       void* addExtension(unsigned long long int k, ExtensionEntry* e)  {
@@ -149,7 +153,7 @@ namespace dd4hep {
       }
       /// Access to type safe extension object. Exception is thrown if the object is invalid
       template <typename T> T* extension(bool alert=true) {
-        return (T*)ObjectExtensions::extension(detail::typeHash64<T>(),alert);
+        return (T*)ObjectExtensions::extension(ObjectExtensions::slot<T>(),detail::typeHash64<T>(),alert);
       }
     };
 
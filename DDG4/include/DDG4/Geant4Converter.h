@@ -59,6 +59,16 @@ namespace dd4hep {
       bool       checkOverlaps = true;
       /// Property: Output level for debug printing
       PrintLevel outputLevel = INFO;
+      /// Property: Number of threads for the parallel conversion steps. <= 1: sequential
+      int        numThreads    = 1;
+      /// Property: Flag to print the time spent in the conversion passes
+      bool       printTimings  = false;
+
+    protected:
+      /// Tessellated solids, which are filled in parallel after the solid pass
+      mutable std::vector<std::pair<const TGeoShape*, G4VSolid*> >* m_deferredSolids = nullptr;
+
+    public:
 
       /// Initializing Constructor
       Geant4Converter(const Detector& description);
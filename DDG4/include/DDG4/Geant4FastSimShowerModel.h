@@ -18,15 +18,18 @@
 
 // Geant4 include files
 #include <G4FastSimulationPhysics.hh>
+#include <G4ThreeVector.hh>
 
 // C/C++ include files
 #include <set>
+#include <mutex>
 #include <vector>
 #include <memory>
 
 /// Forward declarations
 class G4FastStep;
 class G4FastTrack;
+class G4FastSimHitMaker;
 class G4ParticleDefinition;
 class G4VFastSimulationModel;
 
@@ -38,6 +41,7 @@ namespace dd4hep  {
 
     /// Forard declarations
     class Geant4ShowerModelWrapper;
+    class Geant4FastSimSpotDeposition;
     
     /// Geant4 wrapper for the Geant4 fast simulation shower model
     /**
@@ -70,6 +74,10 @@ namespace dd4hep  {
       ParticleConfig m_eKill          { };
       /// Property: Set minimal kinetic energy for particles to trigger the model
       ParticleConfig m_eTriggerNames  { };
+      /// Property: Buffer the energy spots of a shower and deposit them in one go
+      bool           m_batchSpots     { false };
+      /// Property: Merge buffered spots of one shower hitting the same cell
+      bool           m_mergeSpots     { true };
 
       /// Particle definitions for which this parametrization is applicable
       std::set<const G4ParticleDefinition*> m_applicableParticles  { };
@@ -79,6 +87,14 @@ namespace dd4hep  {
       G4VFastSimulationModel* m_model { nullptr };
       /// Reference to the shower model
       Wrapper        m_wrapper        { nullptr };
+      /// Geant4 hit maker to deposit single energy spots
+      G4FastSimHitMaker* m_hitMaker   { nullptr };
+      /// Spot deposition helpers of all threads buffering energy spots
+      std::vector<std::unique_ptr<Geant4FastSimSpotDeposition> > m_spotDepositions;
+      /// Lock to protect the registration of spot deposition helpers
+      std::mutex     m_spotLock;
+      /// Key of this instance to locate the thread local spot deposition helper
+      long           m_spotKey        { 0 };
 
     protected:
       /// Define standard assignments and constructors
@@ -94,6 +110,20 @@ namespace dd4hep  {
       void addShowerModel(G4Region* region);
       /// Kill primary particle when creating the shower
       void killParticle(G4FastStep& step, double deposit, double step_length = 0e0);
+      /// Access the spot deposition helper of the current thread
+      Geant4FastSimSpotDeposition& spotDeposition();
+      /// Deposit an energy spot. If the property "BatchSpots" is set the spot is only buffered
+      /** Without "BatchSpots" the spot is passed directly to the Geant4 hit maker.
+       *  Statistics are only collected for buffered spots: the counters are kept
+       *  per thread and summed when the model is finalized.
+       */
+      void depositSpot(const G4FastTrack& track, const G4ThreeVector& position, double energy);
+      /// Deposit all buffered energy spots of the current shower
+      /** With the property "MergeSpots" set, all spots of the shower hitting the same
+       *  readout cell are merged to one spot with the summed energy deposit at the
+       *  energy weighted position before being passed to the sensitive detector.
+       */
+      void flushSpots(const G4FastTrack& track);
 
     public:
       /// Standard constructor
@@ -78,7 +78,10 @@ namespace dd4hep  {
       /// File name to be opened and read
       std::string m_name;
       /// Flag if direct event access is supported. To be explicitly set by subclass constructors
+      /** Currently set by the HepMC2 reader only, the other readers skip events sequentially */
       bool m_directAccess  { false };
+      /// Flag if reading accesses the event context (e.g. to attach EventParameters). To be set by subclass constructors
+      bool m_eventContextAccess { false };
       /// Current event number
       int  m_currEvent     { 0 };
       /// The input action context
@@ -114,6 +117,8 @@ namespace dd4hep  {
       const std::string& name()  const   {  return m_name;         }
       /// Flag if direct event access (by event sequence number) is supported (Default: false)
       bool hasDirectAccess() const       {  return m_directAccess; }
+      /// Flag if reading an event accesses the event context (Default: false)
+      bool usesEventContext() const      {  return m_eventContextAccess; }
       /// return current Event Number
       int currentEventNumber() const     {  return m_currEvent;    }
       /// Move to the indicated event number.
@@ -161,6 +166,8 @@ namespace dd4hep  {
       typedef Geant4Particle Particle;
       typedef std::vector<Particle*> Particles;
       typedef std::vector<Vertex*> Vertices;
+      /// Queue of events read ahead by a background reader thread
+      class Prefetcher;
     protected:
       /// Property: input file
       std::string         m_input;
@@ -181,12 +188,23 @@ namespace dd4hep  {
 
       /// Property: set of alternative decay statuses that MC generators might use for unstable particles
       std::set<int> m_alternativeDecayStatuses = {};
+      /// Property: number of events read ahead by a background reader thread (0: read on demand)
+      int m_prefetch      { 0 };
+      /// Property: read the event with the Geant4 event number (requires a reader with direct access)
+      /** Only the HepMC2 reader supports direct access. All other readers read the input
+       *  sequentially and refuse this property. Cannot be combined with Prefetch.
+       */
+      bool m_useEventID   { false };
+      /// Background reader handing out complete events (if m_prefetch > 0)
+      Prefetcher* m_prefetcher  { nullptr };
 
       /// Perform some actions before the run starts, like opening the event inputs
       void beginRun(const G4Run*);
 
       /// Create the input reader
       void createReader();
+      /// Position the reader and read the event without any error handling
+      int readEvent(int event_number, Vertices& vertices, Particles& particles);
     public:
       /// Read an event and return a LCCollectionVec of MCParticles.
       int readParticles(int event_number,
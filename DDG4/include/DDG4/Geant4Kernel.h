@@ -337,6 +337,8 @@ namespace dd4hep {
       virtual Geant4Kernel& createWorker();
       /// Access worker instance by its identifier
       Geant4Kernel& worker(unsigned long thread_identifier, bool create_if=false);
+      /// Access the worker instance of the calling thread (thread-local entry, map search if invalidated)
+      Geant4Kernel& threadWorker(bool create_if=false);
       /// Access number of workers
       int numWorkers() const;
 
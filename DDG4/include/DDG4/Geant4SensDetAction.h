@@ -228,6 +228,11 @@ namespace dd4hep {
       /// Add an actor responding to all callbacks to the sequence front. Sequence takes ownership.
       void adoptFilter_front(Geant4Action* filter);
 
+      /// Access to the filters of this sensitive action
+      const std::vector<Geant4Filter*>& filters() const  {
+        return m_filters;
+      }
+
       /// Callback before hit processing starts. Invoke all filters.
       /** Return false if any filter returns false
        */
@@ -310,6 +315,11 @@ namespace dd4hep {
     /**
      * Concrete implementation of the sensitive detector action sequence
      *
+     * If the property "Compiled" is set, the filters of all sensitive actions
+     * are collected at the begin of each run into one list without duplicates.
+     * When processing a step or a fast simulation spot each of these filters
+     * is then evaluated at most once, even if it is shared by several actions.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -335,6 +345,18 @@ namespace dd4hep {
       Actors<Geant4Sensitive> m_actors;
       /// The list of sensitive detector filter objects
       Actors<Geant4Filter>    m_filters;
+      /// Compiled sensitive action: actor and the indices of its filters in m_compiledFilters
+      typedef std::pair<Geant4Sensitive*, std::vector<std::size_t> > CompiledActor;
+      /// Unique list of the filters of all sensitive actions of the compiled sequence
+      std::vector<Geant4Filter*>  m_compiledFilters;
+      /// Sensitive actions of the compiled sequence
+      std::vector<CompiledActor>  m_compiledActors;
+      /// Filter results of the current step (-1: not evaluated, 0: rejected, 1: accepted)
+      std::vector<signed char>    m_filterResults;
+      /// Property: Compile the sequence at the begin of the run
+      bool                        m_compile     { false };
+      /// Flag if the compiled sequence is valid
+      bool                        m_isCompiled  { false };
 
       /// Hit collection creators
       HitCollections m_collections;
@@ -353,6 +375,8 @@ namespace dd4hep {
     protected:
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4SensDetActionSequence);
+      /// Evaluate the filters of a compiled sensitive action using the per-step result cache
+      template <typename T> bool acceptCompiled(const CompiledActor& actor, const T* object);
 
     public:
       /// Standard constructor
@@ -418,6 +442,9 @@ namespace dd4hep {
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adoptFilter(Geant4Action* filter);
 
+      /// (Re-)build the compiled sensitive action list if the property "Compiled" is set
+      void compile();
+
       /// Callback before hit processing starts. Invoke all filters.
       bool accept(const G4Step* step) const;
 
@@ -40,6 +40,17 @@ namespace dd4hep {
     class Geant4SteppingAction: public Geant4Action {
     public:
       typedef Geant4SharedSteppingAction shared_type;
+      /// Flags of the callbacks an action wants to receive from compiled sequences
+      enum Callbacks  {
+        CALL_NONE  = 0,
+        CALL_STEP  = 1 << 0,
+        CALL_ALL   = CALL_STEP
+      };
+
+    protected:
+      /// Callbacks this action is interested in. Others are skipped by compiled sequences
+      int m_callbacks { CALL_ALL };
+
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4SteppingAction);
 
@@ -48,6 +59,10 @@ namespace dd4hep {
       Geant4SteppingAction(Geant4Context* context, const std::string& name);
       /// Default destructor
       virtual ~Geant4SteppingAction();
+      /// Access the flags of the callbacks this action is interested in
+      int callbacks() const  {
+        return m_callbacks;
+      }
       /// User stepping callback
       virtual void operator()(const G4Step* step, G4SteppingManager* mgr);
     };
@@ -97,6 +112,12 @@ namespace dd4hep {
      * threads calling the Geant4 callbacks!
      * These must be protected in the user actions themselves.
      *
+     * If the property "Compiled" is set, the registered actions and callbacks
+     * are resolved at the begin of each run into flat tables, which are then
+     * executed for every step. Actions, which are not interested in steps
+     * (see Geant4SteppingAction::callbacks()) and invalid callbacks are dropped.
+     * Actions adopted later invalidate the tables until the next call to compile().
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -107,6 +128,14 @@ namespace dd4hep {
       CallbackSequence m_calls;
       /// The list of action objects to be called
       Actors<Geant4SteppingAction> m_actors;
+      /// Actions of the compiled sequence
+      std::vector<Geant4SteppingAction*> m_compiledActors;
+      /// Flat table with the valid callbacks of the compiled sequence
+      std::vector<Callback>              m_compiledCalls;
+      /// Property: Compile the sequence at the begin of the run
+      bool                               m_compile    { false };
+      /// Flag if the compiled sequence is valid
+      bool                               m_isCompiled { false };
 
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4SteppingActionSequence);
@@ -126,9 +155,12 @@ namespace dd4hep {
       template <typename Q, typename T>
       void call(Q* p, void (T::*f)(const G4Step*, G4SteppingManager*)) {
         m_calls.add(p, f);
+        m_isCompiled = false;
       }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4SteppingAction* action);
+      /// (Re-)build the flat callback table if the property "Compiled" is set
+      void compile();
       /// User stepping callback
       virtual void operator()(const G4Step* step, G4SteppingManager* mgr);
     };
@@ -41,6 +41,16 @@ namespace dd4hep {
     class Geant4TrackingAction: public Geant4Action {
     public:
       typedef Geant4SharedTrackingAction shared_type;
+      /// Flags of the callbacks an action wants to receive from compiled sequences
+      enum Callbacks  {
+        CALL_BEGIN = 1 << 0,
+        CALL_END   = 1 << 1,
+        CALL_ALL   = CALL_BEGIN | CALL_END
+      };
+
+    protected:
+      /// Callbacks this action is interested in. Others are skipped by compiled sequences
+      int m_callbacks { CALL_ALL };
 
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4TrackingAction);
@@ -55,6 +65,10 @@ namespace dd4hep {
       }
       /// Mark the track to be kept for MC truth propagation
       void mark(const G4Track* track) const;
+      /// Access the flags of the callbacks this action is interested in
+      int callbacks() const  {
+        return m_callbacks;
+      }
       /// Pre-track action callback
       virtual void begin(const G4Track* track);
       /// Post-track action callback
@@ -107,6 +121,11 @@ namespace dd4hep {
      * threads calling the Geant4 callbacks!
      * These must be protected in the user actions themselves.
      *
+     * If the property "Compiled" is set, the callbacks and the actions are
+     * resolved at the begin of each run into flat tables for the pre- and
+     * post-tracking calls. Actions, which are not interested in one of these
+     * calls (see Geant4TrackingAction::callbacks()) and invalid callbacks are dropped.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -123,7 +142,22 @@ namespace dd4hep {
       CallbackSequence             m_final;
       /// The list of action objects to be called
       Actors<Geant4TrackingAction> m_actors;
-
+      /// Flat callback table of the compiled up-front pre-tracking calls
+      std::vector<Callback>        m_compiledFront;
+      /// Actions of the compiled sequence interested in pre-tracking calls
+      std::vector<Geant4TrackingAction*> m_compiledBegin;
+      /// Flat callback table of the compiled pre-tracking calls
+      std::vector<Callback>        m_compiledBeginCalls;
+      /// Flat callback table of the compiled post-tracking calls
+      std::vector<Callback>        m_compiledEndCalls;
+      /// Actions of the compiled sequence interested in post-tracking calls
+      std::vector<Geant4TrackingAction*> m_compiledEnd;
+      /// Flat callback table of the compiled final post-tracking calls
+      std::vector<Callback>        m_compiledFinal;
+      /// Property: Compile the sequence at the begin of the run
+      bool                         m_compile    { false };
+      /// Flag if the compiled callback tables are valid
+      bool                         m_isCompiled { false };
 
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4TrackingActionSequence);
@@ -144,27 +178,33 @@ namespace dd4hep {
       void callUpFront(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_front.add(p, f, where);
+        m_isCompiled = false;
       }
       /// Register Pre-track action callback
       template <typename Q, typename T>
       void callAtBegin(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_begin.add(p, f, where);
+        m_isCompiled = false;
       }
       /// Register Post-track action callback
       template <typename Q, typename T>
       void callAtEnd(Q* p, void (T::*f)(const G4Track*),
                      CallbackSequence::Location where=CallbackSequence::END) {
         m_end.add(p, f, where);
+        m_isCompiled = false;
       }
       /// Register Post-track action callback
       template <typename Q, typename T>
       void callAtFinal(Q* p, void (T::*f)(const G4Track*),
                        CallbackSequence::Location where=CallbackSequence::END) {
         m_final.add(p, f, where);
+        m_isCompiled = false;
       }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4TrackingAction* action);
+      /// (Re-)build the flat callback tables if the property "Compiled" is set
+      void compile();
       /// Pre-tracking action callback
       virtual void begin(const G4Track* track);
       /// Post-tracking action callback
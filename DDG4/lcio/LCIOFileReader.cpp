@@ -114,6 +114,7 @@ dd4hep::sim::LCIOFileReader::LCIOFileReader(const std::string& nam)
   printout(INFO,"LCIOFileReader","Created file reader. Try to open input %s",nam.c_str());
   m_reader->open(nam);
   m_directAccess = false;
+  m_eventContextAccess = true;   // Attaches the EventParameters to the event
 }
 
 /// Default destructor
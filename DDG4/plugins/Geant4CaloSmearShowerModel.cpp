@@ -42,7 +42,6 @@ namespace dd4hep  {
     /// Configuration structure for the fast simulation shower model Geant4FSShowerModel<par02_em_model>
     class calo_smear_model  {
     public:
-      G4FastSimHitMaker hitMaker          { };
       double            StocasticEnergyResolution { -1e0 };
       double            ConstantEnergyResolution  { -1e0 };
       double            NoiseEnergyResolution     { -1e0 };
@@ -117,7 +116,8 @@ namespace dd4hep  {
       }
       hit.SetEnergy(deposit);
       step.ProposeTotalEnergyDeposited(deposit);
-      this->locals.hitMaker.make(hit, track);
+      this->depositSpot(track, hit.GetPosition(), deposit);
+      this->flushSpots(track);
     }
 
     typedef Geant4FSShowerModel<calo_smear_model> Geant4CaloSmearShowerModel;
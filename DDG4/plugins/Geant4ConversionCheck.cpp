@@ -0,0 +1,143 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DDG4/Geant4Converter.h>
+
+// Geant4 include files
+#include <G4TessellatedSolid.hh>
+#include <G4VFacet.hh>
+
+// C/C++ include files
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+namespace {
+
+  /// Number of probe points per axis used to compare the navigation of tessellated solids
+  constexpr int NUM_PROBES = 7;
+
+  /// Signature of the converted solids and property vectors
+  struct Signature  {
+    std::string text;
+    long        num_solids      { 0 };
+    long        num_tessellated { 0 };
+    long        num_properties  { 0 };
+  };
+
+  /// Convert the geometry with the given number of threads and build the signature of the result
+  Signature convert(dd4hep::Detector& description, int num_threads)   {
+    using namespace dd4hep;
+    sim::Geant4Converter conv(description, WARNING);
+    conv.numThreads   = num_threads;
+    conv.printTimings = true;
+    conv.create(description.world());
+
+    const sim::Geant4GeometryInfo& info = conv.data();
+    std::stringstream str;
+    Signature sig;
+    str.precision(17);
+    // Maps are keyed by the TGeo objects, which are the same for all conversions
+    for( const auto& s : info.g4Solids )   {
+      const G4VSolid* solid = s.second;
+      str << solid->GetName() << " " << solid->GetEntityType() << "\n";
+      ++sig.num_solids;
+      if ( const auto* tes = dynamic_cast<const G4TessellatedSolid*>(solid) )   {
+        G4ThreeVector pmin, pmax;
+        tes->BoundingLimits(pmin, pmax);
+        str << "  closed:" << tes->GetSolidClosed() << " facets:" << tes->GetNumberOfFacets()
+            << " area:" << const_cast<G4TessellatedSolid*>(tes)->GetSurfaceArea()
+            << " min:" << pmin << " max:" << pmax << "\n";
+        for( int i = 0; i < tes->GetNumberOfFacets(); ++i )   {
+          const G4VFacet* facet = tes->GetFacet(i);
+          for( int j = 0; j < facet->GetNumberOfVertices(); ++j )
+            str << "  " << facet->GetVertex(j);
+          str << "\n";
+        }
+        /// Inside() uses the voxelization built when the solid is closed
+        G4ThreeVector step = (pmax - pmin) / double(NUM_PROBES - 1);
+        for( int i = 0; i < NUM_PROBES; ++i )   {
+          for( int j = 0; j < NUM_PROBES; ++j )   {
+            for( int k = 0; k < NUM_PROBES; ++k )   {
+              G4ThreeVector p(pmin.x() + i*step.x(), pmin.y() + j*step.y(), pmin.z() + k*step.z());
+              str << int(tes->Inside(p));
+            }
+          }
+        }
+        str << "\n";
+        ++sig.num_tessellated;
+      }
+    }
+    for( const auto& p : info.g4OpticalProperties )   {
+      const auto* prop = p.second;
+      str << prop->name << " " << prop->title;
+      for( std::size_t i = 0; i < prop->bins.size(); ++i )
+        str << " " << prop->bins[i] << ":" << prop->values[i];
+      str << "\n";
+      ++sig.num_properties;
+    }
+    sig.text = str.str();
+    return sig;
+  }
+}
+
+/// Convert the geometry to Geant4 sequentially and with several threads and compare the results
+/**
+ *  Factory: DD4hep_Geant4ConversionCheck
+ *
+ *  Arguments: -threads <number>   Number of threads of the second conversion (default: 4)
+ *
+ *  The solids, the facets and the navigation of tessellated solids at a grid
+ *  of points as well as the material property vectors must be identical.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static long check_conversion(dd4hep::Detector& description, int argc, char** argv) {
+  using namespace dd4hep;
+  int num_threads = 4;
+  for( int i = 0; i < argc && argv[i]; ++i )   {
+    if ( 0 == ::strncmp("-threads", argv[i], 4) && i+1 < argc )
+      num_threads = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_Geant4ConversionCheck  -arg [-arg]                        \n"
+        "     -threads <number>   Number of threads of the parallel conversion (default: 4)\n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  Signature sequential = convert(description, 1);
+  Signature parallel   = convert(description, num_threads);
+  bool identical = sequential.text == parallel.text;
+  printout(identical ? ALWAYS : ERROR, "Geant4ConversionCheck",
+           "+++ Conversion with %d threads %s the sequential conversion: "
+           "%ld solids (%ld tessellated), %ld property vectors [%016llx]",
+           num_threads, identical ? "IDENTICAL to" : "DIFFERENT from",
+           parallel.num_solids, parallel.num_tessellated, parallel.num_properties,
+           detail::hash64(parallel.text));
+  if ( parallel.num_tessellated < 2 || parallel.num_properties < 2 )   {
+    printout(ERROR, "Geant4ConversionCheck",
+             "+++ The geometry needs at least 2 tessellated solids and 2 property vectors "
+             "to run the parallel conversion steps.");
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_Geant4ConversionCheck,check_conversion)
@@ -57,6 +57,10 @@ namespace dd4hep {
       bool m_printPlacements        = false;
       /// Property: Flag to dump all sensitives after the conversion procedure
       bool m_printSensitives        = false;
+      /// Property: Flag to print the time spent in the conversion passes
+      bool m_printTimings           = false;
+      /// Property: Number of threads for the parallel conversion steps (<= 1: sequential)
+      int  m_conversionThreads      = 1;
 
       /// Property: Printout level of info object
       int  m_geoInfoPrintLevel;
@@ -145,6 +149,8 @@ Geant4DetectorGeometryConstruction::Geant4DetectorGeometryConstruction(Geant4Con
 
   declareProperty("PrintPlacements",   m_printPlacements);
   declareProperty("PrintSensitives",   m_printSensitives);
+  declareProperty("PrintTimings",      m_printTimings);
+  declareProperty("ConversionThreads", m_conversionThreads);
   declareProperty("GeoInfoPrintLevel", m_geoInfoPrintLevel = DEBUG);
 
   declareProperty("DumpHierarchy",     m_dumpHierarchy);
@@ -173,6 +179,8 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
   conv.debugLimits      = m_debugLimits;
   conv.printPlacements  = m_printPlacements;
   conv.printSensitives  = m_printSensitives;
+  conv.printTimings     = m_printTimings;
+  conv.numThreads       = m_conversionThreads;
 
   ctxt->geometry = conv.create(world).detach();
   ctxt->geometry->printLevel = outputLevel();
@@ -1,5 +1,5 @@
 //==========================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------------
 // Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
 // All rights reserved.
@@ -22,10 +22,13 @@
  */
 
 // Framework include files
-#include <DDG4/IoStreams.h>
 #include <DDG4/Geant4InputAction.h>
 
 // C/C++ include files
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <condition_variable>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -35,6 +38,8 @@ namespace dd4hep {
 
     /// HepMC namespace declaration
     namespace HepMC {
+      /// HepMC MappedFile class used internally by the Geant4EventReaderHepMC plugin
+      class MappedFile;
       /// HepMC EventStream class used internally by the Geant4EventReaderHepMC plugin
       class EventStream;
     }
@@ -44,6 +49,13 @@ namespace dd4hep {
      *  Class to populate Geant4 primary particles and vertices from a
      *  file in HepMC format (ASCII)
      *
+     *  The input file is memory mapped. On opening the file is scanned once
+     *  to build an index of the event record offsets, which gives direct
+     *  access to any event: moveToEvent does not need to parse the skipped events.
+     *
+     *  Optionally (parameter "PreParse" > 0) a background thread parses
+     *  up to "PreParse" events ahead of the consumer.
+     *
      *  For details also see:
      *  http://hepmc.web.cern.ch/hepmc/ReaderAsciiHepMC2_8cc_source.html
      *
@@ -53,12 +65,49 @@ namespace dd4hep {
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4EventReaderHepMC : public Geant4EventReader  {
-      typedef boost::iostreams::stream<dd4hep_file_source<int> > in_stream;
-      //typedef boost::iostreams::stream<dd4hep_file_source<TFile*> > in_stream;
+      typedef HepMC::MappedFile  MappedFile;
       typedef HepMC::EventStream EventStream;
+
+      /// Pre-parsed event in the queue of the background parser
+      /** Malformed events are queued with an error status: the queue stays aligned to the event numbers */
+      struct ParsedEvent  {
+        int               event;
+        EventReaderStatus status;
+        Particles         particles;
+      };
+
     protected:
-      in_stream    m_input;
-      EventStream* m_events;
+      MappedFile*  m_input  { nullptr };
+      EventStream* m_events { nullptr };
+      /// Offsets of all event records in the input file
+      std::vector<std::size_t> m_offsets;
+
+      /// Parameter: number of events to be parsed ahead in a background thread (0: disabled)
+      int m_preParse        { 0 };
+      /// Background parser: worker thread
+      std::thread m_worker;
+      /// Background parser: lock protecting the queue of parsed events
+      std::mutex  m_lock;
+      /// Background parser: condition to synchronize producer and consumer
+      std::condition_variable m_cond;
+      /// Background parser: queue of parsed events
+      std::deque<ParsedEvent> m_parsed;
+      /// Background parser: event number of the next event to be queued
+      int  m_queued         { 0 };
+      /// Background parser: flag to stop the worker thread
+      bool m_stop           { false };
+      /// Background parser: flag indicating the worker reached the end of the input
+      bool m_finished       { false };
+
+      /// Background parser: worker thread body
+      void preParse(int first_event);
+      /// Background parser: (re-)start worker thread at the given event
+      void startPreParse(int first_event);
+      /// Background parser: stop worker thread and drop queued events
+      void stopPreParse();
+      /// Background parser: retrieve the next event from the queue
+      EventReaderStatus nextPreParsed(Particles& particles);
+
     public:
       /// Initializing constructor
       explicit Geant4EventReaderHepMC(const std::string& nam);
@@ -70,13 +119,13 @@ namespace dd4hep {
                                               std::vector<Particle*>& particles)  override;
       virtual EventReaderStatus moveToEvent(int event_number)  override;
       virtual EventReaderStatus skipEvent() override { return EVENT_READER_OK; }
-
+      virtual EventReaderStatus setParameters(std::map< std::string, std::string >& parameters) override;
     };
   }     /* End namespace sim   */
 }       /* End namespace dd4hep       */
 
 //====================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------
 //
 //====================================================================
@@ -91,8 +140,18 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <climits>
 #include <algorithm>
+#include <unordered_map>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace dd4hep::sim;
 using PropertyMask = dd4hep::detail::ReferenceBitMask<int>;
@@ -129,7 +188,7 @@ namespace dd4hep {
         std::vector<float>      weights;
         std::vector<long>       random;
         /// Default constructor
-        EventHeader() : id(0), num_vertices(0), bp1(0), bp2(0), 
+        EventHeader() : id(0), num_vertices(0), bp1(0), bp2(0),
                         signal_process_id(0), signal_process_vertex(0),
                         scale(0.0), alpha_qcd(0.0), alpha_qed(0.0), weights(), random() {}
       };
@@ -137,6 +196,72 @@ namespace dd4hep {
       /// The known_io enum is used to track which type of input is being read
       enum known_io { gen=1, ascii, extascii, ascii_pdt, extascii_pdt };
 
+      /// Read-only memory mapped view of the HepMC input file
+      /*
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class MappedFile  {
+      public:
+        const char* begin  { nullptr };
+        const char* end    { nullptr };
+        std::size_t size   { 0 };
+        int         fd     { -1 };
+        /// Default constructor
+        MappedFile() = default;
+        /// Inhibit copy constructor
+        MappedFile(const MappedFile& copy) = delete;
+        /// Default destructor
+        ~MappedFile()  { close();  }
+        /// Inhibit assignment
+        MappedFile& operator=(const MappedFile& copy) = delete;
+        /// Open and map the file. Returns false on failure with errno set
+        bool open(const std::string& name);
+        /// Unmap and close the file
+        void close();
+      };
+
+      /// Cursor over a single text record (=line) of the HepMC input
+      /*
+       *  Mimics the subset of the std::istream interface used by the record parsers.
+       *  Numbers are converted in place without copying the line.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Record  {
+        const char* m_line  { nullptr };
+        const char* m_ptr   { nullptr };
+        const char* m_end   { nullptr };
+        bool        m_fail  { false };
+        /// Access the next blank separated token. Returns false if none is left
+        bool token(const char*& first, const char*& last);
+        template <typename T> Record& get_integer(T& value);
+        template <typename T> Record& get_real(T& value);
+      public:
+        /// Attach cursor to a new line. Strips the record type if followed by a blank
+        void assign(const char* first, const char* last);
+        /// Check if the cursor is in good state
+        explicit operator bool() const  {  return !m_fail;   }
+        /// Check if the cursor failed to extract a value
+        bool operator!() const          {  return m_fail;    }
+        /// Check if the cursor failed to extract a value
+        bool fail() const               {  return m_fail;    }
+        /// Check if no further token is available
+        bool eof();
+        /// Reset failure state
+        void clear()                    {  m_fail = false;   }
+        /// Access the full record as string
+        std::string str() const         {  return std::string(m_line, m_end-m_line); }
+        Record& operator>>(int& value)          {  return get_integer(value);   }
+        Record& operator>>(long& value)         {  return get_integer(value);   }
+        Record& operator>>(float& value)        {  return get_real(value);      }
+        Record& operator>>(double& value)       {  return get_real(value);      }
+        Record& operator>>(std::string& value);
+      };
+
       /// HepMC EventStream class used internally by the Geant4EventReaderHepMC plugin
       /*
        *  \author  P.Kostka (main author)
@@ -146,10 +271,14 @@ namespace dd4hep {
        */
       class EventStream {
       public:
-        typedef std::map<int,Geant4Vertex*> Vertices;
-        typedef std::map<int,Geant4Particle*> Particles;
+        typedef std::unordered_map<int,Geant4Vertex*> Vertices;
+        /// Particles are indexed by their id, which is assigned sequentially
+        typedef std::vector<Geant4Particle*>          Particles;
 
-        std::istream& instream;
+        /// Input buffer and current read position
+        const char* m_begin;
+        const char* m_end;
+        const char* m_curr;
 
         // io information
         std::string key;
@@ -162,8 +291,9 @@ namespace dd4hep {
         Particles m_particles;
 
         /// Default constructor
-        EventStream(std::istream& in) : instream(in), mom_unit(0.0), pos_unit(0.0),
-                                   io_type(0), xsection(0.0), xsection_err(0.0)
+        EventStream(const char* first, const char* last)
+          : m_begin(first), m_end(last), m_curr(first), mom_unit(0.0), pos_unit(0.0),
+            io_type(0), xsection(0.0), xsection_err(0.0)
         { use_default_units();                       }
         /// Check if data stream is in proper state and has data
         bool ok()  const;
@@ -174,21 +304,33 @@ namespace dd4hep {
         { io_type = typ;    key = k;                 }
         void use_default_units()
         { mom_unit = CLHEP::MeV;   pos_unit = CLHEP::mm;           }
+        /// Position the stream at the given offset (start of an event record)
+        void seek(std::size_t offset)
+        { m_curr = std::min(m_begin + offset, m_end);  }
+        /// Record type of the next line
+        char peek() const
+        { return m_curr < m_end ? *m_curr : char(-1);  }
+        /// Attach the next line to the record cursor and return the record type
+        char next(Record& record);
+        /// Move the particles of the last event to the output vector
+        void take(std::vector<Geant4Particle*>& output);
         bool read();
         void clear();
       };
 
-      char get_input(std::istream& is, std::istringstream& iline);
-      int read_until_event_end(std::istream & is);
-      int read_weight_names(EventStream &, std::istringstream& iline);
-      int read_particle(EventStream &info, std::istringstream& iline, Geant4Particle * p);
-      int read_vertex(EventStream &info, std::istream& is, std::istringstream & iline);
-      int read_event_header(EventStream &info, std::istringstream & input, EventHeader& header);
-      int read_cross_section(EventStream &info, std::istringstream & input);
-      int read_units(EventStream &info, std::istringstream & input);
-      int read_heavy_ion(EventStream &, std::istringstream & input);
-      int read_pdf(EventStream &, std::istringstream & input);
+      std::size_t build_index(EventStream& info, std::vector<std::size_t>& offsets);
+      int read_until_event_end(EventStream& info);
+      int read_listing_key(EventStream& info, Record& iline);
+      int read_weight_names(EventStream &, Record& iline);
+      int read_particle(EventStream &info, Record& iline, Geant4Particle * p);
+      int read_vertex(EventStream &info, Record & iline);
+      int read_event_header(EventStream &info, Record & input, EventHeader& header);
+      int read_cross_section(EventStream &info, Record & input);
+      int read_units(EventStream &info, Record & input);
+      int read_heavy_ion(EventStream &, Record & input);
+      int read_pdf(EventStream &, Record & input);
       Geant4Vertex* vertex(EventStream& info, int i);
+      Geant4Particle* particle(EventStream& info, int i);
       void fix_particles(EventStream &info);
     }
   }
@@ -200,38 +342,158 @@ namespace dd4hep {
 
 /// Initializing constructor
 Geant4EventReaderHepMC::Geant4EventReaderHepMC(const std::string& nam)
-  : Geant4EventReader(nam), m_input(), m_events(0)
+  : Geant4EventReader(nam)
 {
   // Now open the input file:
-  m_input.open(nam.c_str(), BOOST_IOS::in|BOOST_IOS::binary);
-  if ( not m_input.is_open() )   {
-    except("+++ Failed to open input stream: %s Error:%s.", nam.c_str(), ::strerror(errno));
+  m_input = new MappedFile();
+  if ( not m_input->open(nam) )   {
+    std::string err = ::strerror(errno);
+    delete m_input;
+    m_input = nullptr;
+    except("+++ Failed to open input stream: %s Error:%s.", nam.c_str(), err.c_str());
   }
-  m_events = new HepMC::EventStream(m_input);
+  m_events = new HepMC::EventStream(m_input->begin, m_input->end);
+  HepMC::build_index(*m_events, m_offsets);
+  m_directAccess = true;
+  printout(DEBUG,"EventReaderHepMC","+++ Indexed %ld events in file %s",
+           long(m_offsets.size()), nam.c_str());
 }
 
 /// Default destructor
 Geant4EventReaderHepMC::~Geant4EventReaderHepMC()    {
+  stopPreParse();
   delete m_events;
   m_events = 0;
-  m_input.close();
+  delete m_input;
+  m_input = 0;
+}
+
+/// Read the optional reader parameters
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMC::setParameters( std::map< std::string, std::string > & parameters ) {
+  _getParameterValue( parameters, "PreParse", m_preParse, 0);
+  if ( m_preParse > 0 )   {
+    printout(INFO,"EventReaderHepMC","--- Will parse up to %d events ahead in a background thread",
+             m_preParse);
+  }
+  return EVENT_READER_OK;
 }
 
 /// skipEvents if required
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderHepMC::moveToEvent(int event_number) {
-  if( m_currEvent < event_number && event_number != 0 ) {
-    printout(INFO,"EventReaderHepMC::moveToEvent","Current event:%d Skipping the next %d events",
-             m_currEvent, event_number);
-    while ( m_currEvent < event_number ) {
-      if ( not m_events->read() ) return EVENT_READER_ERROR;
-      ++m_currEvent;
+  if ( m_currEvent != event_number )   {
+    if ( event_number < 0 )   {
+      printout(ERROR,"EventReaderHepMC::moveToEvent",
+               "Cannot move to invalid event number %d.", event_number);
+      return EVENT_READER_ERROR;
+    }
+    if ( std::size_t(event_number) >= m_offsets.size() )   {
+      printout(DEBUG,"EventReaderHepMC::moveToEvent",
+               "Event %d is beyond the end of file [%ld events].",
+               event_number, long(m_offsets.size()));
+      return EVENT_READER_EOF;
     }
+    printout(INFO,"EventReaderHepMC::moveToEvent","Current event:%d Move to event %d",
+             m_currEvent, event_number);
+    m_events->seek(m_offsets[event_number]);
+    m_currEvent = event_number;
   }
   printout(DEBUG,"EventReaderHepMC::moveToEvent","Current event number: %d",m_currEvent);
   return EVENT_READER_OK;
 }
 
+/// Background parser: worker thread body
+void Geant4EventReaderHepMC::preParse(int first_event)   {
+  EventStream stream(m_input->begin, m_input->end);
+  stream.set_io(m_events->io_type, m_events->key);
+  for( int evt = first_event; ; ++evt )  {
+    ParsedEvent parsed { evt, EVENT_READER_ERROR, {} };
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_cond.wait(lock, [this] { return m_stop || int(m_parsed.size()) < m_preParse; });
+      if ( m_stop ) return;
+      if ( std::size_t(evt) >= m_offsets.size() )  {
+        m_finished = true;
+        m_cond.notify_all();
+        return;
+      }
+    }
+    try  {
+      stream.seek(m_offsets[evt]);
+      if ( stream.read() )  {
+        stream.take(parsed.particles);
+        parsed.status = EVENT_READER_OK;
+      }
+    }
+    catch(const std::exception& e)  {
+      printout(ERROR,"EventReaderHepMC","+++ Exception while parsing event %d: %s", evt, e.what());
+    }
+    if ( parsed.status != EVENT_READER_OK )  {
+      for( auto*& p : parsed.particles ) detail::releasePtr(p);
+      parsed.particles.clear();
+      printout(ERROR,"EventReaderHepMC","+++ Event %d is malformed and cannot be read.", evt);
+    }
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_parsed.emplace_back(std::move(parsed));
+    m_queued = evt + 1;
+    m_cond.notify_all();
+  }
+}
+
+/// Background parser: (re-)start worker thread at the given event
+void Geant4EventReaderHepMC::startPreParse(int first_event)   {
+  stopPreParse();
+  m_stop     = false;
+  m_finished = false;
+  m_queued   = first_event;
+  m_worker   = std::thread([this, first_event] { this->preParse(first_event); });
+}
+
+/// Background parser: stop worker thread and drop queued events
+void Geant4EventReaderHepMC::stopPreParse()   {
+  if ( m_worker.joinable() )   {
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_stop = true;
+      m_cond.notify_all();
+    }
+    m_worker.join();
+  }
+  for( auto& e : m_parsed )   {
+    for( auto*& p : e.particles ) detail::releasePtr(p);
+  }
+  m_parsed.clear();
+}
+
+/// Background parser: retrieve the next event from the queue
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMC::nextPreParsed(Particles& particles)   {
+  bool in_sequence;
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    in_sequence = m_worker.joinable() &&
+      (m_parsed.empty() ? m_queued == m_currEvent : m_parsed.front().event == m_currEvent);
+  }
+  if ( !in_sequence )   {
+    startPreParse(m_currEvent);
+  }
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_cond.wait(lock, [this] { return m_finished || !m_parsed.empty(); });
+  if ( m_parsed.empty() )  {
+    return EVENT_READER_EOF;
+  }
+  ParsedEvent parsed = std::move(m_parsed.front());
+  m_parsed.pop_front();
+  m_cond.notify_all();
+  if ( parsed.status != EVENT_READER_OK )  {
+    ++m_currEvent;   // The failed event is consumed: the next entry belongs to the next event
+    return parsed.status;
+  }
+  particles = std::move(parsed.particles);
+  return EVENT_READER_OK;
+}
+
 /// Read an event and fill a vector of MCParticles.
 Geant4EventReaderHepMC::EventReaderStatus
 Geant4EventReaderHepMC::readParticles(int /* ev_id */,
@@ -246,19 +508,24 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
   primary_vertex->y = 0;
   primary_vertex->z = 0;
 
-  if ( !m_events->ok() )  {
-    vertices.clear();
-    output.clear();
-    return EVENT_READER_EOF;
+  EventReaderStatus status = EVENT_READER_EOF;
+  if ( m_preParse > 0 )  {
+    status = nextPreParsed(output);
   }
-  else if ( m_events->read() )  {
-    EventStream::Particles& parts = m_events->particles();
-
+  else if ( m_events->ok() && m_events->read() )  {
+    m_events->take(output);
+    status = EVENT_READER_OK;
+  }
+  else if ( std::size_t(m_currEvent) < m_offsets.size() )  {
+    /// Malformed event: skip it, the next read starts at the next indexed event
+    printout(ERROR,"EventReaderHepMC","+++ Event %d is malformed and cannot be read.", m_currEvent);
+    status = EVENT_READER_ERROR;
+    if ( std::size_t(++m_currEvent) < m_offsets.size() )
+      m_events->seek(m_offsets[m_currEvent]);
+  }
+  if ( status == EVENT_READER_OK )  {
     Position pos(primary_vertex->x,primary_vertex->y,primary_vertex->z);
 
-    output.reserve(parts.size());
-    transform(parts.begin(),parts.end(),back_inserter(output),detail::reference2nd(parts));
-    m_events->clear();
     if (pos.mag2() > std::numeric_limits<double>::epsilon() )  {
       for(Particles::iterator k=output.begin(); k != output.end(); ++k) {
         Geant4ParticleHandle p(*k);
@@ -283,8 +550,8 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
 
       //add particles to the 'primary vertex'
       if ( p->parents.size() == 0 )  {
-        PropertyMask status(p->status);
-        if ( status.isSet(G4PARTICLE_GEN_EMPTY) || status.isSet(G4PARTICLE_GEN_DOCUMENTATION) )
+        PropertyMask mask(p->status);
+        if ( mask.isSet(G4PARTICLE_GEN_EMPTY) || mask.isSet(G4PARTICLE_GEN_DOCUMENTATION) )
           primary_vertex->in.insert(p->id);  // Beam particles and primary quarks etc.
         else
           primary_vertex->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
@@ -295,16 +562,169 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
   }
   vertices.clear();
   output.clear();
-  return EVENT_READER_EOF;
+  return status;
+}
+
+/// Open and map the file. Returns false on failure with errno set
+bool HepMC::MappedFile::open(const std::string& name)   {
+  struct stat buf;
+  close();
+  fd = ::open(name.c_str(), O_RDONLY);
+  if ( fd < 0 )  {
+    return false;
+  }
+  if ( ::fstat(fd, &buf) != 0 )  {
+    close();
+    return false;
+  }
+  size = buf.st_size;
+  if ( size > 0 )  {
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( ptr == MAP_FAILED )  {
+      size = 0;
+      close();
+      return false;
+    }
+    ::madvise(ptr, size, MADV_SEQUENTIAL);
+    begin = (const char*)ptr;
+    end   = begin + size;
+  }
+  return true;
+}
+
+/// Unmap and close the file
+void HepMC::MappedFile::close()   {
+  if ( begin )  {
+    ::munmap((void*)begin, size);
+  }
+  if ( fd >= 0 )  {
+    ::close(fd);
+  }
+  begin = end = nullptr;
+  size  = 0;
+  fd    = -1;
+}
+
+/// Attach cursor to a new line. Strips the record type if followed by a blank
+void HepMC::Record::assign(const char* first, const char* last)   {
+  m_line = m_ptr = first;
+  m_end  = last;
+  m_fail = false;
+  if ( last - first > 1 && first[1] == ' ' ) m_ptr += 2;
+}
+
+/// Access the next blank separated token. Returns false if none is left
+bool HepMC::Record::token(const char*& first, const char*& last)   {
+  while ( m_ptr < m_end && (*m_ptr == ' ' || *m_ptr == '\t' || *m_ptr == '\r') ) ++m_ptr;
+  first = m_ptr;
+  while ( m_ptr < m_end && *m_ptr != ' ' && *m_ptr != '\t' && *m_ptr != '\r' ) ++m_ptr;
+  last = m_ptr;
+  return first < last;
+}
+
+/// Check if no further token is available
+bool HepMC::Record::eof()   {
+  while ( m_ptr < m_end && (*m_ptr == ' ' || *m_ptr == '\t' || *m_ptr == '\r') ) ++m_ptr;
+  return m_ptr >= m_end;
+}
+
+template <typename T> HepMC::Record& HepMC::Record::get_integer(T& value)   {
+  const char *first = nullptr, *last = nullptr;
+  if ( m_fail || !token(first, last) )  {
+    m_fail = true;
+    return *this;
+  }
+  bool neg = *first == '-';
+  if ( *first == '-' || *first == '+' ) ++first;
+  if ( first == last )  {
+    m_fail = true;
+    return *this;
+  }
+  T val = 0;
+  for( ; first < last; ++first )  {
+    unsigned int digit = (unsigned char)(*first) - '0';
+    if ( digit > 9 )   {
+      m_fail = true;
+      return *this;
+    }
+    val = val*10 + T(digit);
+  }
+  value = neg ? -val : val;
+  return *this;
+}
+
+template <typename T> HepMC::Record& HepMC::Record::get_real(T& value)   {
+  const char *first = nullptr, *last = nullptr;
+  if ( m_fail || !token(first, last) )  {
+    m_fail = true;
+    return *this;
+  }
+  double val = 0e0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  if ( *first == '+' ) ++first;
+  auto result = std::from_chars(first, last, val);
+  m_fail = result.ec != std::errc() || result.ptr != last;
+#else
+  // No floating point std::from_chars: convert from a (small) local copy of the token
+  char buff[64], *end = nullptr;
+  std::size_t len = last - first;
+  if ( len >= sizeof(buff) )  {
+    m_fail = true;
+    return *this;
+  }
+  ::memcpy(buff, first, len);
+  buff[len] = 0;
+  val = ::strtod(buff, &end);
+  m_fail = end != buff + len;
+#endif
+  if ( !m_fail ) value = T(val);
+  return *this;
+}
+
+HepMC::Record& HepMC::Record::operator>>(std::string& value)   {
+  const char *first = nullptr, *last = nullptr;
+  if ( m_fail || !token(first, last) )
+    m_fail = true;
+  else
+    value.assign(first, last);
+  return *this;
+}
+
+/// Attach the next line to the record cursor and return the record type
+char HepMC::EventStream::next(Record& record)   {
+  const char* first = m_curr;
+  if ( first >= m_end )  {
+    return -1;
+  }
+  const char* last = (const char*)::memchr(first, '\n', m_end - first);
+  m_curr = last ? last + 1 : m_end;
+  record.assign(first, last ? last : m_end);
+  return *first;
+}
+
+/// Build the index of event record offsets. Returns the number of events found
+std::size_t HepMC::build_index(EventStream& info, std::vector<std::size_t>& offsets)   {
+  Record record;
+  offsets.clear();
+  info.seek(0);
+  while( info.ok() )   {
+    const char* line = info.m_curr;
+    char value = info.next(record);
+    if ( value == 'E' && line + 1 < info.m_end && line[1] == ' ' )
+      offsets.emplace_back(line - info.m_begin);
+    else if ( value == 'H' && offsets.empty() )
+      read_listing_key(info, record);
+  }
+  info.seek(0);
+  return offsets.size();
 }
 
 void HepMC::fix_particles(EventStream& info)  {
   EventStream::Particles& parts = info.particles();
   EventStream::Vertices&  verts = info.vertices();
-  EventStream::Particles::iterator i;
   std::set<int>::const_iterator id, ip;
-  for(i=parts.begin(); i != parts.end(); ++i)  {
-    Geant4ParticleHandle p((*i).second);
+  for(Geant4Particle* part : parts)  {
+    Geant4ParticleHandle p(part);
     int end_vtx_id = p->secondaries;
     p->secondaries = 0;
     Geant4Vertex* v = vertex(info,end_vtx_id);
@@ -319,8 +739,7 @@ void HepMC::fix_particles(EventStream& info)  {
       p->vez = v->z;
       v->in.insert(p->id);
       for(id=v->out.begin(); id!=v->out.end();++id)    {
-        EventStream::Particles::iterator ipp = parts.find(*id);
-        Geant4Particle* dau = ipp != parts.end() ? (*ipp).second : 0;
+        Geant4Particle* dau = particle(info, *id);
         if ( !dau )
           std::cout << "ERROR: Invalid daughter particle: " << *id << std::endl;
         else
@@ -332,9 +751,8 @@ void HepMC::fix_particles(EventStream& info)  {
   for(const auto& iv : verts)   {
     Geant4Vertex* v = iv.second;
     for (int pout : v->out)   {
-      EventStream::Particles::iterator ipp = parts.find(pout);
-      if ( ipp != parts.end() )  {
-        Geant4Particle* p = (*ipp).second;
+      Geant4Particle* p = particle(info, pout);
+      if ( p )  {
         for (int d : v->in)   {
           p->parents.insert(d);
         }
@@ -344,12 +762,12 @@ void HepMC::fix_particles(EventStream& info)  {
   /// Particles originating from the beam (=no parents) must be
   /// be stripped off their parents and the status set to G4PARTICLE_GEN_DECAYED!
   std::vector<Geant4Particle*> beam;
-  for(const auto& ipart : parts)   {
-    Geant4ParticleHandle p(ipart.second);
+  for(Geant4Particle* part : parts)   {
+    Geant4ParticleHandle p(part);
     if ( p->parents.size() == 0 )  {
       for(int d : p->daughters)   {
-        Geant4Particle *pp = parts[d];
-        beam.emplace_back(pp);
+        Geant4Particle *pp = particle(info, d);
+        if ( pp ) beam.emplace_back(pp);
       }
     }
   }
@@ -365,40 +783,62 @@ Geant4Vertex* HepMC::vertex(EventStream& info, int i)   {
   return (it==info.vertices().end()) ? 0 : (*it).second;
 }
 
-char HepMC::get_input(std::istream& is, std::istringstream& iline)  {
-  char value = is.peek();
-  if ( !is ) {        // make sure the stream is valid
-    std::cerr << "StreamHelpers: setting badbit." << std::endl;
-    is.clear(std::ios::badbit);
-    return -1;
-  }
-  std::string line, firstc;
-  getline(is,line);
-  if ( !is ) {        // make sure the stream is valid
-    std::cerr << "StreamHelpers: setting badbit." << std::endl;
-    is.clear(std::ios::badbit);
-    return -1;
-  }
-  iline.clear();
-  iline.str(line);
-  if ( line.length()>0 && line[1] == ' ' ) iline >> firstc;
-  return iline ? value : -1;
+Geant4Particle* HepMC::particle(EventStream& info, int i)   {
+  EventStream::Particles& parts = info.particles();
+  return (i < 0 || std::size_t(i) >= parts.size()) ? 0 : parts[i];
 }
 
-int HepMC::read_until_event_end(std::istream & is) {
-  std::string line;
-  while ( is ) {
-    char val = is.peek();
-    if( val == 'E' ) {  // next event
+int HepMC::read_until_event_end(EventStream& info) {
+  Record line;
+  while ( info.ok() ) {
+    if( info.peek() == 'E' ) {  // next event
       return 1;
     }
-    getline(is,line);
-    if ( !is.good() ) return 0;
+    info.next(line);
   }
   return 0;
 }
 
-int HepMC::read_weight_names(EventStream&, std::istringstream&)   {
+int HepMC::read_listing_key(EventStream& info, Record& input_line)   {
+  int iotype = 0;
+  std::string key_value;
+  input_line >> key_value;
+  // search for event listing key before first event only.
+  key_value = key_value.substr(0,key_value.find('\r'));
+  if ( key_value == "H" && (info.io_type == gen || info.io_type == extascii) ) {
+    read_heavy_ion(info, input_line);
+    return 0;
+  }
+  else if( key_value == "HepMC::IO_GenEvent-START_EVENT_LISTING" )
+    info.set_io(gen,key_value);
+  else if( key_value == "HepMC::IO_Ascii-START_EVENT_LISTING" )
+    info.set_io(ascii,key_value);
+  else if( key_value == "HepMC::IO_ExtendedAscii-START_EVENT_LISTING" )
+    info.set_io(extascii,key_value);
+  else if( key_value == "HepMC::IO_Ascii-START_PARTICLE_DATA" )
+    info.set_io(ascii_pdt,key_value);
+  else if( key_value == "HepMC::IO_ExtendedAscii-START_PARTICLE_DATA" )
+    info.set_io(extascii_pdt,key_value);
+  else if( key_value == "HepMC::IO_GenEvent-END_EVENT_LISTING" )
+    iotype = gen;
+  else if( key_value == "HepMC::IO_Ascii-END_EVENT_LISTING" )
+    iotype = ascii;
+  else if( key_value == "HepMC::IO_ExtendedAscii-END_EVENT_LISTING" )
+    iotype = extascii;
+  else if( key_value == "HepMC::IO_Ascii-END_PARTICLE_DATA" )
+    iotype = ascii_pdt;
+  else if( key_value == "HepMC::IO_ExtendedAscii-END_PARTICLE_DATA" )
+    iotype = extascii_pdt;
+
+  if( iotype != 0 && info.io_type != iotype )  {
+    std::cerr << "GenEvent::find_end_key: iotype keys have changed. "
+              << "MALFORMED INPUT" << std::endl;
+    return -1;
+  }
+  return iotype;
+}
+
+int HepMC::read_weight_names(EventStream&, Record&)   {
 #if 0
   int HepMC::read_weight_names(EventStream& info, std::istringstream& iline)
     size_t name_size = 0;
@@ -431,7 +871,7 @@ int HepMC::read_weight_names(EventStream&, std::istringstream&)   {
   return 1;
 }
 
-int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Particle * p)   {
+int HepMC::read_particle(EventStream &info, Record& input, Geant4Particle * p)   {
   float ene = 0., theta = 0., phi = 0;
   int   size = 0, stat=0;
   PropertyMask status(p->status);
@@ -480,7 +920,7 @@ int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Par
   }
   /// Keep a copy of the full generator status
   p->genStatus = stat&G4PARTICLE_GEN_STATUS_MASK;
-  
+
   // read flow patterns if any exist. Protect against tainted readings.
   size = std::min(size,100);
   for (int i = 0; i < size; ++i ) {
@@ -490,7 +930,7 @@ int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Par
   return 1;
 }
 
-int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream & input)    {
+int HepMC::read_vertex(EventStream &info, Record & input)    {
   int id=0, dummy = 0, num_orphans_in=0, num_particles_out=0, weights_size=0;
   std::vector<float> weights;
   Geant4Vertex* v = new Geant4Vertex();
@@ -528,8 +968,8 @@ int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream &
     }
   }
   info.vertices().emplace(id,v);
-  for(char value = is.peek(); value=='P'; value=is.peek())  {
-    value = get_input(is,input);
+  while( info.peek() == 'P' )  {
+    char value = info.next(input);
     if( !input || value < 0 )
       return 0;
 
@@ -539,7 +979,7 @@ int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream &
       delete p;
       return 0;
     }
-    info.particles().emplace(p->id,p);
+    info.particles().emplace_back(p);
     p->pex = p->psx;
     p->pey = p->psy;
     p->pez = p->psz;
@@ -573,7 +1013,7 @@ int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream &
   return 1;
 }
 
-int HepMC::read_event_header(EventStream &info, std::istringstream & input, EventHeader& header)   {
+int HepMC::read_event_header(EventStream &info, Record & input, EventHeader& header)   {
   // read values into temp variables, then fill GenEvent
   int size = 0;
   input >> header.id;
@@ -592,14 +1032,16 @@ int HepMC::read_event_header(EventStream &info, std::istringstream & input, Even
   if( info.io_type == gen || info.io_type == extascii )
     input >> header.bp1 >> header.bp2;
 
-  printout(DEBUG,"HepMC","++ Event header: %s",input.str().c_str());
+  if ( isActivePrintLevel(DEBUG) )
+    printout(DEBUG,"HepMC","++ Event header: %s",input.str().c_str());
   input >> size;
   input.clear();
   if( input.fail() )
     return 0;
   if( size < 0 || size > USHRT_MAX )
     return 0;
-  
+
+  header.random.clear();
   for(int i = 0; i < size; ++i )  {
     long val = 0e0;
     input >> val;
@@ -622,15 +1064,17 @@ int HepMC::read_event_header(EventStream &info, std::istringstream & input, Even
   }
   // weight names will be added later if they exist
   if( !wgt.empty() ) header.weights = std::move(wgt);
+  if( header.num_vertices > 0 )
+    info.vertices().reserve(header.num_vertices);
   return 1;
 }
 
-int HepMC::read_cross_section(EventStream &info, std::istringstream & input)   {
+int HepMC::read_cross_section(EventStream &info, Record & input)   {
   input >> info.xsection >> info.xsection_err;
   return input.fail() ? 0 : 1;
 }
 
-int HepMC::read_units(EventStream &info, std::istringstream & input)   {
+int HepMC::read_units(EventStream &info, Record & input)   {
   if( info.io_type == gen )  {
     std::string mom, pos;
     input >> mom >> pos;
@@ -648,7 +1092,7 @@ int HepMC::read_units(EventStream &info, std::istringstream & input)   {
   return input.fail() ? 0 : 1;
 }
 
-int HepMC::read_heavy_ion(EventStream &, std::istringstream & input)  {
+int HepMC::read_heavy_ion(EventStream &, Record & input)  {
   // read values into temp variables, then create a new HeavyIon object
   int nh =0, np =0, nt =0, nc =0,
     neut = 0, prot = 0, nw =0, nwn =0, nwnw =0;
@@ -674,7 +1118,7 @@ int HepMC::read_heavy_ion(EventStream &, std::istringstream & input)  {
   return input.fail() ? 0 : 1;
 }
 
-int HepMC::read_pdf(EventStream &, std::istringstream & input)  {
+int HepMC::read_pdf(EventStream &, Record & input)  {
   // read values into temp variables, then create a new PdfInfo object
   int id1 =0, id2 =0;
   double  x1 = 0., x2 = 0., scale = 0., pdf1 = 0., pdf2 = 0.;
@@ -712,88 +1156,50 @@ int HepMC::read_pdf(EventStream &, std::istringstream & input)  {
 
 /// Check if data stream is in proper state and has data
 bool HepMC::EventStream::ok()  const   {
-  // make sure the stream is good
-  if ( instream.eof() || instream.fail() )  {
-    instream.clear(std::ios::badbit);
-    return false;
-  }
-  return true;
+  return m_curr < m_end;
 }
 
 void HepMC::EventStream::clear()   {
   detail::releaseObjects(m_vertices);
-  detail::releaseObjects(m_particles);
+  for( auto*& p : m_particles ) detail::releasePtr(p);
+  m_particles.clear();
+}
+
+/// Move the particles of the last event to the output vector
+void HepMC::EventStream::take(std::vector<Geant4Particle*>& output)   {
+  output.reserve(output.size() + m_particles.size());
+  output.insert(output.end(), m_particles.begin(), m_particles.end());
+  m_particles.clear();
 }
 
 bool HepMC::EventStream::read()   {
   EventStream& info = *this;
   bool event_read = false;
+  Record input_line;
 
-  detail::releaseObjects(vertices());
-  detail::releaseObjects(particles());
-
-  while( instream.good() ) {
-    char value = instream.peek();
-    std::istringstream input_line;
+  clear();
+  while( ok() ) {
+    char value = peek();
     if      ( value == 'E' && event_read )
       break;
-    else if ( instream.eof() && event_read )
-      goto Done;
-    else if ( instream.eof() )
-      return false;
     else if ( value=='#' || ::isspace(value) )  {
-      get_input(instream,input_line);
+      next(input_line);
       continue;
     }
-    value = get_input(instream,input_line);
+    value = next(input_line);
 
     // On failure switch to end
     if( !input_line || value < 0 )
       goto Skip;
 
     switch( value )   {
-    case 'H':  {
-      int iotype = 0;
-      std::string key_value;
-      input_line >> key_value;
-      // search for event listing key before first event only.
-      key_value = key_value.substr(0,key_value.find('\r'));
-      if ( key_value == "H" && (this->io_type == gen || this->io_type == extascii) ) {
-        read_heavy_ion(info, input_line);
-        break;
-      }
-      else if( key_value == "HepMC::IO_GenEvent-START_EVENT_LISTING" )
-        this->set_io(gen,key_value);
-      else if( key_value == "HepMC::IO_Ascii-START_EVENT_LISTING" )
-        this->set_io(ascii,key_value);
-      else if( key_value == "HepMC::IO_ExtendedAscii-START_EVENT_LISTING" )
-        this->set_io(extascii,key_value);
-      else if( key_value == "HepMC::IO_Ascii-START_PARTICLE_DATA" )
-        this->set_io(ascii_pdt,key_value);
-      else if( key_value == "HepMC::IO_ExtendedAscii-START_PARTICLE_DATA" )
-        this->set_io(extascii_pdt,key_value);
-      else if( key_value == "HepMC::IO_GenEvent-END_EVENT_LISTING" )
-        iotype = gen;
-      else if( key_value == "HepMC::IO_Ascii-END_EVENT_LISTING" )
-        iotype = ascii;
-      else if( key_value == "HepMC::IO_ExtendedAscii-END_EVENT_LISTING" )
-        iotype = extascii;
-      else if( key_value == "HepMC::IO_Ascii-END_PARTICLE_DATA" )
-        iotype = ascii_pdt;
-      else if( key_value == "HepMC::IO_ExtendedAscii-END_PARTICLE_DATA" )
-        iotype = extascii_pdt;
-
-      if( iotype != 0 && this->io_type != iotype )  {
-        std::cerr << "GenEvent::find_end_key: iotype keys have changed. "
-                  << "MALFORMED INPUT" << std::endl;
-        instream.clear(std::ios::badbit);
+    case 'H':           // Listing keys and heavy ion information
+      if ( read_listing_key(info, input_line) < 0 )  {
+        m_curr = m_end;
         return false;
       }
-      else if ( iotype != 0 )  {
-        break;
-      }
       continue;
-    }
+
     case 'E':           // deal with the event line
       if ( !read_event_header(info, input_line, this->header) )
         goto Skip;
@@ -816,7 +1222,7 @@ bool HepMC::EventStream::read()   {
       continue;
 
     case 'V':           // Read vertex with particles
-      if ( !read_vertex(info, instream, input_line) )
+      if ( !read_vertex(info, input_line) )
         goto Skip;
       continue;
 
@@ -835,17 +1241,14 @@ bool HepMC::EventStream::read()   {
     continue;
   Skip:
     printout(WARNING,"HepMC::EventStream","+++ Skip event with ID: %d",this->header.id);
-    detail::releaseObjects(vertices());
-    detail::releaseObjects(particles());
-    read_until_event_end(instream);
+    clear();
+    read_until_event_end(info);
     event_read = false;
-    if ( instream.eof() ) return false;
+    if ( !ok() ) return false;
   }
 
-  if( not instream.good() ) return false;
- Done:
+  if( !event_read ) return false;
   fix_particles(info);
   detail::releaseObjects(vertices());
   return true;
 }
-
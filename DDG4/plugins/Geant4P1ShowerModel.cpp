@@ -54,7 +54,6 @@ namespace dd4hep  {
     /// Configuration structure for the fast simulation shower model Geant4FSShowerModel<par01_em_model>
     class par01_em_model  {
     public:
-      G4FastSimHitMaker hitMaker          { };
       std::string       materialName      { };
       G4Material*       material          { nullptr };
       double            criticalEnergyRef { 800*MeV };
@@ -131,10 +130,9 @@ namespace dd4hep  {
 	// build the position:
 	G4ThreeVector position = sShower + z*zShower + r*std::cos(phi)*xShower + r*std::sin(phi)*yShower;
 	/// Process spot and call sensitive detector
-	hit.SetPosition(position);
-	hit.SetEnergy(deposit);
-	this->locals.hitMaker.make(hit, track);
+	this->depositSpot(track, position, deposit);
       }
+      this->flushSpots(track);
     }
 
     ///===================================================================================================
@@ -146,7 +144,6 @@ namespace dd4hep  {
     /// Configuration structure for the fast simulation shower model Geant4FSShowerModel<par01_pion_model>
     class par01_pion_model  {
     public:
-      G4FastSimHitMaker hitMaker { };
     };
     
     /// Declare optional properties from embedded structure
@@ -196,9 +193,9 @@ namespace dd4hep  {
 	double phi = rndm->uniform(0e0, twopi);
 	G4ThreeVector position = showerCenter + z*zShower + r*std::cos(phi)*xShower + r*std::sin(phi)*yShower;
 	/// Process spot and call sensitive detector
-	G4FastHit hit(position, deposit);
-	this->locals.hitMaker.make(hit, track);
+	this->depositSpot(track, position, deposit);
       }
+      this->flushSpots(track);
     }
 
     typedef Geant4FSShowerModel<par01_em_model>   Geant4Par01EMShowerModel;
@@ -104,7 +104,7 @@ namespace dd4hep {
           RefCountedSequence<Geant4SensDetActionSequence>()
       {
         Geant4Kernel& master = Geant4Kernel::instance(description);
-        Geant4Kernel& kernel = master.worker(Geant4Kernel::thread_self());
+        Geant4Kernel& kernel = master.threadWorker();
         m_sensitive   = description.sensitiveDetector(nam);
         m_context     = kernel.workerContext();
         m_outputLevel = kernel.getOutputLevel(nam);
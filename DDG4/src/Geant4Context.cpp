@@ -17,6 +17,9 @@
 #include <DDG4/Geant4Context.h>
 #include <DDG4/Geant4Kernel.h>
 
+// Geant4 include files
+#include <G4Event.hh>
+
 // C/C++ include files
 #include <algorithm>
 
@@ -36,7 +39,8 @@ Geant4Run::~Geant4Run()   {
 
 /// Intializing constructor
 Geant4Event::Geant4Event(const G4Event* evt, Geant4Random* rnd)
-  : ObjectExtensions(typeid(Geant4Event)), m_event(evt), m_random(rnd)
+  : ObjectExtensions(typeid(Geant4Event)), m_event(evt), m_random(rnd),
+    m_eventID(evt ? evt->GetEventID() : -1)
 {
   InstanceCount::increment(this);
 }
@@ -71,6 +71,7 @@
 #include <G4MaterialPropertiesIndex.hh>
 #endif
 #include <G4ScaledSolid.hh>
+#include <G4TessellatedSolid.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
 // C/C++ include files
@@ -78,6 +79,15 @@
 #include <iomanip>
 #include <sstream>
 #include <limits>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <exception>
+
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#endif
 
 namespace units = dd4hep;
 using namespace dd4hep::sim;
@@ -133,6 +143,55 @@ namespace {
     }
   }
 
+  /// Execute work(i) for i in [0,num_items) with up to num_threads threads
+  /** Uses a TBB task arena if available. Exceptions are rethrown in the caller. */
+  template <typename F> void execute_parallel(int num_threads, std::size_t num_items, F work)   {
+    if ( num_threads <= 1 || num_items < 2 )  {
+      for( std::size_t i = 0; i < num_items; ++i ) work(i);
+      return;
+    }
+#ifdef DD4HEP_USE_TBB
+    tbb::task_arena arena(num_threads);
+    arena.execute([&]()  {  tbb::parallel_for(std::size_t(0), num_items, work);  });
+#else
+    std::atomic<std::size_t> next { 0 };
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto worker = [&](int id)  {
+      try  {
+        for( std::size_t i = next++; i < num_items; i = next++ ) work(i);
+      }
+      catch(...)  {
+        errors[id] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> threads;
+    for( int i = 1; i < num_threads; ++i ) threads.emplace_back(worker, i);
+    worker(0);
+    for( auto& t : threads ) t.join();
+    for( auto& e : errors ) if ( e ) std::rethrow_exception(e);
+#endif
+  }
+
+  /// Check if a property or surface should not be passed to Geant4
+  bool ignore_property(const TNamed* named)   {
+    return ::strstr(named->GetName(), GEANT4_TAG_IGNORE) || ::strstr(named->GetTitle(), GEANT4_TAG_IGNORE);
+  }
+
+  /// Convert a GDML matrix to a property vector. Does not access any shared data
+  Geant4GeometryInfo::PropertyVector* convert_property(const TGDMLMatrix* matrix)   {
+    auto* g4 = new Geant4GeometryInfo::PropertyVector();
+    std::size_t rows = matrix->GetRows();
+    g4->name    = matrix->GetName();
+    g4->title   = matrix->GetTitle();
+    g4->bins.reserve(rows);
+    g4->values.reserve(rows);
+    for( std::size_t i=0; i<rows; ++i )   {
+      g4->bins.emplace_back(matrix->Get(i,0)  /*   *CLHEP::eV/units::eV   */);
+      g4->values.emplace_back(matrix->Get(i,1));
+    }
+    return g4;
+  }
+
   std::string make_NCName(const std::string& in)   {
     std::string res = detail::str_replace(in, "/", "_");
     res = detail::str_replace(res, "#", "_");
@@ -648,8 +707,16 @@ void* Geant4Converter::handleSolid(const std::string& name, const TGeoShape* sha
       solid = convertShape<TGeoArb8>(shape);
     else if (isa == TGeoPara::Class())
       solid = convertShape<TGeoPara>(shape);
-    else if (isa == TGeoTessellated::Class()) 
-      solid = convertShape<TGeoTessellated>(shape);
+    else if (isa == TGeoTessellated::Class())  {
+      // During the solid pass the facets are added in parallel once all solids exist
+      if ( m_deferredSolids )  {
+        solid = new G4TessellatedSolid(shape->GetName());
+        m_deferredSolids->emplace_back(shape, solid);
+      }
+      else  {
+        solid = convertShape<TGeoTessellated>(shape);
+      }
+    }
     else if (isa == TGeoScaledShape::Class())  {
       TGeoScaledShape* sh   = (TGeoScaledShape*) shape;
       TGeoShape*       sol  = sh->GetShape();
@@ -1305,19 +1372,10 @@ void* Geant4Converter::handleMaterialProperties(TObject* mtx) const    {
   
   if ( !g4 )  {
     PrintLevel lvl = debugMaterials ? ALWAYS : outputLevel;
-    g4 = new Geant4GeometryInfo::PropertyVector();
-    std::size_t rows = matrix->GetRows();
-    g4->name    = matrix->GetName();
-    g4->title   = matrix->GetTitle();
-    g4->bins.reserve(rows);
-    g4->values.reserve(rows);
-    for( std::size_t i=0; i<rows; ++i )   {
-      g4->bins.emplace_back(matrix->Get(i,0)  /*   *CLHEP::eV/units::eV   */);
-      g4->values.emplace_back(matrix->Get(i,1));
-    }
+    g4 = convert_property(matrix);
     printout(lvl, "Geant4Converter",
              "++ Successfully converted material property:%s : %s [%ld rows]",
-             matrix->GetName(), matrix->GetTitle(), rows);
+             matrix->GetName(), matrix->GetTitle(), long(g4->bins.size()));
     info.g4OpticalProperties[matrix] = g4;
   }
   return g4;
@@ -1666,42 +1724,98 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   _DAU daughters;
   Geant4GeometryInfo& geo = this->init();
   World wrld = top.world();
+  std::vector<std::pair<std::string, double> > timings;
+  auto timed = [&timings](const char* tag, const std::function<void()>& pass)  {
+    TTimeStamp begin;
+    pass();
+    TTimeStamp end;
+    timings.emplace_back(tag, end.AsDouble() - begin.AsDouble());
+  };
 
   m_data->clear();
   m_set_data->clear();
   m_daughters = &daughters;
   geo.manager = &wrld.detectorDescription().manager();
-  this->collect(top, geo);
+  timed("Collect", [&]()  {  this->collect(top, geo);  });
   this->checkOverlaps = false;
   // We do not have to handle defines etc.
   // All positions and the like are not really named.
   // Hence, start creating the G4 objects for materials, solids and log volumes.
-  handleArray(this, geo.manager->GetListOfGDMLMatrices(), &Geant4Converter::handleMaterialProperties);
-  handleArray(this, geo.manager->GetListOfOpticalSurfaces(), &Geant4Converter::handleOpticalSurface);
-  
-  handle(this,     geo.volumes, &Geant4Converter::collectVolume);
-  handle(this,     geo.solids,  &Geant4Converter::handleSolid);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld solids.", geo.solids.size());
-  handleRefs(this, geo.vis,     &Geant4Converter::handleVis);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes.", geo.vis.size());
-  handleMap(this,  geo.limits,  &Geant4Converter::handleLimitSet);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld limit sets.", geo.limits.size());
-  handleMap(this,  geo.regions, &Geant4Converter::handleRegion);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld regions.", geo.regions.size());
-  handle(this,     geo.volumes, &Geant4Converter::handleVolume);
-  printout(outputLevel, "Geant4Converter", "++ Handled %ld volumes.", geo.volumes.size());
-  handleRMap(this, *m_data,     &Geant4Converter::handleAssembly);
+  timed("Material properties", [&]()  {
+    // The property vectors are independent: convert them in parallel, register them in order
+    std::vector<TGDMLMatrix*> matrices;
+    TObjArrayIter arr(geo.manager->GetListOfGDMLMatrices());
+    for( TObject* i = arr.Next(); i; i = arr.Next() )  {
+      TGDMLMatrix* matrix = (TGDMLMatrix*)i;
+      if ( !ignore_property(matrix) && !geo.g4OpticalProperties[matrix] ) matrices.emplace_back(matrix);
+    }
+    std::vector<Geant4GeometryInfo::PropertyVector*> props(matrices.size());
+    execute_parallel(numThreads, matrices.size(), [&](std::size_t i)  {  props[i] = convert_property(matrices[i]);  });
+    for( std::size_t i = 0; i < matrices.size(); ++i )  {
+      printout(debugMaterials ? ALWAYS : outputLevel, "Geant4Converter",
+               "++ Successfully converted material property:%s : %s [%ld rows]",
+               matrices[i]->GetName(), matrices[i]->GetTitle(), long(props[i]->bins.size()));
+      geo.g4OpticalProperties[matrices[i]] = props[i];
+    }
+    handleArray(this, geo.manager->GetListOfGDMLMatrices(), &Geant4Converter::handleMaterialProperties);
+  });
+  timed("Optical surfaces", [&]()  {
+    handleArray(this, geo.manager->GetListOfOpticalSurfaces(), &Geant4Converter::handleOpticalSurface);
+  });
+  timed("Solids", [&]()  {
+    // Solids are created in order, since Geant4 registers them in the solid store.
+    // Filling and closing tessellated solids is expensive and done in parallel.
+    std::vector<std::pair<const TGeoShape*, G4VSolid*> > deferred;
+    handle(this,     geo.volumes, &Geant4Converter::collectVolume);
+    m_deferredSolids = &deferred;
+    try  {
+      handle(this,   geo.solids,  &Geant4Converter::handleSolid);
+    }
+    catch(...)  {
+      m_deferredSolids = nullptr;
+      throw;
+    }
+    m_deferredSolids = nullptr;
+    execute_parallel(numThreads, deferred.size(), [&deferred](std::size_t i)  {
+      fillTessellatedSolid(deferred[i].second, deferred[i].first);
+    });
+    printout(outputLevel, "Geant4Converter", "++ Handled %ld solids (%ld tessellated).",
+             geo.solids.size(), deferred.size());
+  });
+  timed("Visualization attributes", [&]()  {
+    handleRefs(this, geo.vis,     &Geant4Converter::handleVis);
+    printout(outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes.", geo.vis.size());
+  });
+  timed("Limit sets", [&]()  {
+    handleMap(this,  geo.limits,  &Geant4Converter::handleLimitSet);
+    printout(outputLevel, "Geant4Converter", "++ Handled %ld limit sets.", geo.limits.size());
+  });
+  timed("Regions", [&]()  {
+    handleMap(this,  geo.regions, &Geant4Converter::handleRegion);
+    printout(outputLevel, "Geant4Converter", "++ Handled %ld regions.", geo.regions.size());
+  });
+  timed("Volumes and materials", [&]()  {
+    handle(this,     geo.volumes, &Geant4Converter::handleVolume);
+    printout(outputLevel, "Geant4Converter", "++ Handled %ld volumes.", geo.volumes.size());
+  });
+  timed("Assemblies", [&]()  {
+    handleRMap(this, *m_data,     &Geant4Converter::handleAssembly);
+  });
   // Now place all this stuff appropriately
   //handleRMap(this, *m_data,     &Geant4Converter::handlePlacement);
-  std::map<int, std::vector<const TGeoNode*> >::const_reverse_iterator i = m_data->rbegin();
-  for ( ; i != m_data->rend(); ++i )  {
-    for ( const TGeoNode* node : i->second )  {
-      this->handlePlacement(node->GetName(), node);
+  timed("Placements", [&]()  {
+    std::map<int, std::vector<const TGeoNode*> >::const_reverse_iterator i = m_data->rbegin();
+    for ( ; i != m_data->rend(); ++i )  {
+      for ( const TGeoNode* node : i->second )  {
+        this->handlePlacement(node->GetName(), node);
+      }
     }
-  }
+  });
   /// Handle concrete surfaces
-  handleArray(this, geo.manager->GetListOfSkinSurfaces(),   &Geant4Converter::handleSkinSurface);
-  handleArray(this, geo.manager->GetListOfBorderSurfaces(), &Geant4Converter::handleBorderSurface);
+  timed("Skin and border surfaces", [&]()  {
+    handleArray(this, geo.manager->GetListOfSkinSurfaces(),   &Geant4Converter::handleSkinSurface);
+    handleArray(this, geo.manager->GetListOfBorderSurfaces(), &Geant4Converter::handleBorderSurface);
+  });
   //==================== Fields
   handleProperties(m_detDesc.properties());
   if ( printSensitives )  {
@@ -1715,8 +1829,12 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   geo.setWorld(top.placement().ptr());
   geo.valid = true;
   TTimeStamp stop;
+  if ( printTimings )  {
+    for( const auto& t : timings )
+      printout(ALWAYS, "Geant4Converter", "+++  Pass %-26s %8.3f seconds", t.first.c_str(), t.second);
+  }
   printout(INFO, "Geant4Converter",
-           "+++  Successfully converted geometry to Geant4. [%7.3f seconds]",
-           stop.AsDouble()-start.AsDouble() );
+           "+++  Successfully converted geometry to Geant4. [%7.3f seconds, %d threads]",
+           stop.AsDouble()-start.AsDouble(), std::max(numThreads, 1));
   return *this;
 }
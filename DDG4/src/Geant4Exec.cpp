@@ -22,6 +22,7 @@
 #include <DDG4/Geant4TrackingAction.h>
 #include <DDG4/Geant4StackingAction.h>
 #include <DDG4/Geant4GeneratorAction.h>
+#include <DDG4/Geant4SensDetAction.h>
 #include <DDG4/Geant4UserInitialization.h>
 #include <DDG4/Geant4DetectorConstruction.h>
 #include <DDG4/Geant4PhysicsList.h>
@@ -375,6 +376,11 @@ namespace dd4hep {
       createClientContext(run);
       kernel().executePhase("begin-run",(const void**)&run);
       if ( m_sequence ) m_sequence->begin(run); // Action not mandatory
+      // Resolve the compiled per-step/per-track dispatch tables once all actions are known
+      Geant4Kernel& krnl = kernel();
+      if ( auto* seq = krnl.steppingAction(false) ) seq->compile();
+      if ( auto* seq = krnl.trackingAction(false) ) seq->compile();
+      for( auto& seq : krnl.sensitiveActions().sequences() ) seq.second->compile();
       kernel().applyInterruptHandlers();
     }
 
@@ -413,7 +419,7 @@ namespace dd4hep {
     void Geant4UserDetectorConstruction::ConstructSDandField()  {
       G4AutoLock protection_lock(&action_mutex);
       Geant4Context* ctx = m_sequence->context();
-      Geant4Kernel&  krnl = kernel().worker(Geant4Kernel::thread_self(),true);
+      Geant4Kernel&  krnl = kernel().threadWorker(true);
       updateContext(krnl.workerContext());
       m_sequence->constructField(&m_ctxt);
       m_sequence->constructSensitives(&m_ctxt);
@@ -438,7 +444,7 @@ namespace dd4hep {
     /// Build the actions for the worker thread
     void Geant4UserActionInitialization::Build()  const   {
       G4AutoLock protection_lock(&action_mutex);
-      Geant4Kernel&  krnl = kernel().worker(Geant4Kernel::thread_self(),true);
+      Geant4Kernel&  krnl = kernel().threadWorker(true);
       Geant4Context* ctx  = krnl.workerContext();
 
       if ( m_sequence )  {
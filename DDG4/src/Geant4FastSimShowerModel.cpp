@@ -13,19 +13,42 @@
 
 // Framework include files
 #include <DDG4/Geant4FastSimShowerModel.h>
+#include <DDG4/Geant4SensDetAction.h>
+#include <DDG4/Geant4VolumeManager.h>
+#include <DDG4/Geant4FastSimSpot.h>
 #include <DDG4/Geant4Mapping.h>
 #include <DDG4/Geant4Kernel.h>
 
 // Geant4 include files
 #include <G4FastSimulationManager.hh>
 #include <G4VFastSimulationModel.hh>
+#include <G4TransportationManager.hh>
+#include <G4TouchableHistory.hh>
 #include <G4TouchableHandle.hh>
 #include <G4ParticleTable.hh>
+#include <G4Navigator.hh>
 #include <G4FastStep.hh>
+#include <G4Version.hh>
+#if G4VERSION_NUMBER > 1070
+#include <G4VFastSimSensitiveDetector.hh>
+#include <G4FastSimHitMaker.hh>
+#else
+class G4FastHit          {  public:  G4FastHit(const G4ThreeVector&, double)  { } };
+class G4FastSimHitMaker  {  public:  void make(const G4FastHit&, const G4FastTrack&)  { } };
+#endif
 
 // C/C++ include files
+#include <map>
+#include <atomic>
+#include <chrono>
 #include <sstream>
 
+#ifdef DD4HEP_USE_GEANT4_UNITS
+#define MM_2_CM 1.0
+#else
+#define MM_2_CM 0.1
+#endif
+
 using namespace dd4hep::sim;
 
 /// Namespace for the AIDA detector description toolkit
@@ -61,10 +84,161 @@ namespace dd4hep  {
       /// User callback to model the particle/energy shower
       virtual void DoIt(const G4FastTrack& track, G4FastStep& step)  override;
     };
-    
+
+#if G4VERSION_NUMBER > 1070
+    /// Helper to locate buffered energy spots of fast simulation showers and to deposit them
+    /**
+     *  Buffered spots are located with one navigator, which follows the spots
+     *  using relative searches. The sensitive detector and the segmentation
+     *  are cached per logical volume. Spots falling into the same readout cell
+     *  are optionally merged before the sensitive detector is called.
+     *  One instance exists per thread: the statistics counters need no locking.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastSimSpotDeposition   {
+    public:
+      typedef std::vector<std::pair<G4ThreeVector, double> > Spots;
+      /// Cached sensitive detector information of a logical volume
+      struct Sensitive  {
+        G4VFastSimSensitiveDetector* detector  { nullptr };
+        Segmentation                 segmentation;
+      };
+      /// Merged energy deposit of one readout cell
+      struct Cell  {
+        G4ThreeVector                position;
+        double                       energy    { 0e0 };
+        G4VFastSimSensitiveDetector* detector  { nullptr };
+        G4TouchableHandle            touchable;
+      };
+      typedef std::map<const G4LogicalVolume*, Sensitive> Sensitives;
+      typedef std::map<std::pair<const G4VFastSimSensitiveDetector*, VolumeID>, std::size_t> CellIndex;
+
+      /// Navigator to locate buffered spots
+      G4Navigator        navigator;
+      /// Touchable updated by the navigator
+      G4TouchableHandle  touchable { new G4TouchableHistory() };
+      /// Sensitive detector cache by logical volume
+      Sensitives         sensitives;
+      /// Buffered energy spots of the current shower
+      Spots              spots;
+      /// Merged cells of the current shower
+      std::vector<Cell>  cells;
+      /// Index of the merged cells by sensitive detector and cell identifier
+      CellIndex          index;
+      /// Statistics: number of deposited energy spots
+      long               numSpots    { 0 };
+      /// Statistics: number of calls to the sensitive detectors
+      long               numHits     { 0 };
+      /// Statistics: time spent depositing energy spots in nanoseconds
+      long               depositTime { 0 };
+
+    public:
+      /// Access the sensitive detector information of a logical volume
+      const Sensitive& sensitive(const G4LogicalVolume* vol);
+      /// Deposit the buffered energy spots. Returns the number of sensitive detector calls
+      std::size_t flush(const G4FastTrack& track, bool merge);
+    };
+#else
+    /// Dummy spot deposition helper: fast simulation hits are not supported by this Geant4 version
+    class Geant4FastSimSpotDeposition   {
+    public:
+      typedef std::vector<std::pair<G4ThreeVector, double> > Spots;
+      /// Buffered energy spots of the current shower
+      Spots spots;
+      /// Statistics: number of deposited energy spots
+      long  numSpots    { 0 };
+      /// Statistics: number of calls to the sensitive detectors
+      long  numHits     { 0 };
+      /// Statistics: time spent depositing energy spots in nanoseconds
+      long  depositTime { 0 };
+      /// Deposit the buffered energy spots. Returns the number of sensitive detector calls
+      std::size_t flush(const G4FastTrack&, bool)
+      {  spots.clear(); return 0;  }
+    };
+#endif
   }
 }
 
+#if G4VERSION_NUMBER > 1070
+/// Access the sensitive detector information of a logical volume
+const Geant4FastSimSpotDeposition::Sensitive& Geant4FastSimSpotDeposition::sensitive(const G4LogicalVolume* vol)   {
+  auto iter = sensitives.find(vol);
+  if ( iter == sensitives.end() )   {
+    Sensitive sens;
+    G4VSensitiveDetector* sd = vol->GetSensitiveDetector();
+    sens.detector = dynamic_cast<G4VFastSimSensitiveDetector*>(sd);
+    if ( sd && !sens.detector && vol->GetFastSimulationManager() )   {
+      printout(ERROR, "Geant4FastSimShowerModel",
+               "+++ Sensitive detector %s of volume %s does not support fast simulation hits.",
+               sd->GetName().c_str(), vol->GetName().c_str());
+    }
+    if ( auto* dd4hep_sd = dynamic_cast<Geant4ActionSD*>(sd) )   {
+      SensitiveDetector sd_handle = dd4hep_sd->sensitiveDetector();
+      if ( sd_handle.isValid() && sd_handle.readout().isValid() )
+        sens.segmentation = sd_handle.readout().segmentation();
+    }
+    iter = sensitives.emplace(vol, sens).first;
+  }
+  return (*iter).second;
+}
+
+/// Deposit the buffered energy spots. Returns the number of sensitive detector calls
+std::size_t Geant4FastSimSpotDeposition::flush(const G4FastTrack& track, bool merge)   {
+  std::size_t num_hits = 0;
+  Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
+  auto* world = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+  if ( navigator.GetWorldVolume() != world )  {
+    navigator.SetWorldVolume(world);
+  }
+  // First spot: absolute search from the track position. Others are relative to the previous spot
+  navigator.LocateGlobalPointAndUpdateTouchable(track.GetPrimaryTrack()->GetPosition(), touchable(), false);
+  cells.clear();
+  index.clear();
+  for( const auto& spot : spots )   {
+    navigator.LocateGlobalPointAndUpdateTouchable(spot.first, touchable());
+    G4VPhysicalVolume* pv = touchable->GetVolume();
+    if ( !pv ) continue;
+    const Sensitive& sens = sensitive(pv->GetLogicalVolume());
+    if ( !sens.detector ) continue;
+    // Spots of volumes without segmentation or not known to DD4hep are deposited immediately.
+    // So are spots without positive energy: they cannot be energy weighted.
+    if ( !merge || spot.second <= 0e0 || !sens.segmentation.isValid() )   {
+      G4FastHit hit(spot.first, spot.second);
+      sens.detector->Hit(&hit, &track, &touchable);
+      ++num_hits;
+      continue;
+    }
+    VolumeID volID = volMgr.volumeID(touchable());
+    const G4ThreeVector& global = spot.first;
+    G4ThreeVector local = touchable->GetHistory()->GetTopTransform().TransformPoint(global);
+    Position loc (local.x()*MM_2_CM,  local.y()*MM_2_CM,  local.z()*MM_2_CM);
+    Position glob(global.x()*MM_2_CM, global.y()*MM_2_CM, global.z()*MM_2_CM);
+    VolumeID cell = sens.segmentation.cellID(loc, glob, volID);
+    auto ret = index.emplace(std::make_pair(sens.detector, cell), cells.size());
+    if ( ret.second )   {
+      Cell c;
+      c.detector  = sens.detector;
+      c.touchable = navigator.CreateTouchableHistory();
+      cells.emplace_back(c);
+    }
+    Cell& c = cells[(*ret.first).second];
+    c.position += spot.second * global;
+    c.energy   += spot.second;
+  }
+  for( Cell& c : cells )   {
+    G4FastHit hit(c.position / c.energy, c.energy);
+    c.detector->Hit(&hit, &track, &c.touchable);
+    ++num_hits;
+  }
+  cells.clear();
+  spots.clear();
+  return num_hits;
+}
+#endif
+
 /// Initializing constructor
 Geant4ShowerModelWrapper::Geant4ShowerModelWrapper(Geant4FastSimShowerModel* model)
   : G4VFastSimulationModel(model->name()), m_model(model)
@@ -98,11 +272,28 @@ Geant4FastSimShowerModel::Geant4FastSimShowerModel(Geant4Context* ctxt, const st
   this->declareProperty("Emax",                this->m_eMax);
   this->declareProperty("Ekill",               this->m_eKill);
   this->declareProperty("Etrigger",            this->m_eTriggerNames);
+  this->declareProperty("BatchSpots",          this->m_batchSpots);
+  this->declareProperty("MergeSpots",          this->m_mergeSpots);
   this->m_wrapper= new Geant4ShowerModelWrapper(this);
+  this->m_hitMaker = new G4FastSimHitMaker();
+  static std::atomic<long> num_models { 0 };
+  this->m_spotKey = ++num_models;
 }
 
 /// Default destructor
 Geant4FastSimShowerModel::~Geant4FastSimShowerModel()    {
+  long num_spots = 0, num_hits = 0, deposit_time = 0;
+  for( const auto& helper : m_spotDepositions )   {
+    num_spots    += helper->numSpots;
+    num_hits     += helper->numHits;
+    deposit_time += helper->depositTime;
+  }
+  if ( num_spots > 0 )   {
+    this->info("+++ Deposited %ld buffered energy spots with %ld sensitive detector calls in %.3f ms [%ld threads]",
+               num_spots, num_hits, double(deposit_time)/1e6, long(m_spotDepositions.size()));
+  }
+  m_spotDepositions.clear();
+  detail::deletePtr(m_hitMaker);
   detail::deletePtr(m_model);
   detail::deletePtr(m_wrapper);
 }
@@ -200,6 +391,41 @@ void Geant4FastSimShowerModel::killParticle(G4FastStep& step, double deposit, do
   step.ProposeTotalEnergyDeposited(deposit);
 }
 
+/// Access the spot deposition helper of the current thread
+Geant4FastSimSpotDeposition& Geant4FastSimShowerModel::spotDeposition()   {
+  // The model instance is shared by all worker threads: keep the navigation state thread local.
+  // The helpers are owned by the model, the thread local map only references them.
+  static thread_local std::map<long, Geant4FastSimSpotDeposition*> helpers;
+  auto& helper = helpers[m_spotKey];
+  if ( !helper )   {
+    std::lock_guard<std::mutex> lock(m_spotLock);
+    m_spotDepositions.emplace_back(new Geant4FastSimSpotDeposition());
+    helper = m_spotDepositions.back().get();
+  }
+  return *helper;
+}
+
+/// Deposit an energy spot. If the property "BatchSpots" is set the spot is only buffered
+void Geant4FastSimShowerModel::depositSpot(const G4FastTrack& track, const G4ThreeVector& position, double energy)   {
+  if ( m_batchSpots )   {
+    spotDeposition().spots.emplace_back(position, energy);
+    return;
+  }
+  m_hitMaker->make(G4FastHit(position, energy), track);
+}
+
+/// Deposit all buffered energy spots of the current shower
+void Geant4FastSimShowerModel::flushSpots(const G4FastTrack& track)   {
+  if ( !m_batchSpots ) return;
+  Geant4FastSimSpotDeposition& helper = spotDeposition();
+  if ( !helper.spots.empty() )   {
+    auto start = std::chrono::high_resolution_clock::now();
+    helper.numSpots += helper.spots.size();
+    helper.numHits  += helper.flush(track, m_mergeSpots);
+    helper.depositTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+  }
+}
+
 /// User callback to determine if the model is applicable for the particle type
 bool Geant4FastSimShowerModel::check_applicability(const G4ParticleDefinition& particle)   {
   return
@@ -222,7 +222,7 @@ namespace dd4hep {
     KernelHandle::KernelHandle(Geant4Kernel* k) : value(k)  {
     }
     KernelHandle KernelHandle::worker()  {
-      Geant4Kernel* k = value ? &value->worker(Geant4Kernel::thread_self()) : 0;
+      Geant4Kernel* k = value ? &value->threadWorker() : 0;
       if ( k ) return KernelHandle(k);
       except("KernelHandle", "Cannot access worker context [Invalid Handle]");
       return KernelHandle(0);
@@ -23,10 +23,135 @@
 
 #include <G4Event.hh>
 
+// C/C++ include files
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+
 using namespace dd4hep::sim;
 using Vertices = Geant4InputAction::Vertices;
+using Particles = Geant4InputAction::Particles;
 using PropertyMask = dd4hep::detail::ReferenceBitMask<int>;
 
+/// Queue of events read ahead by a background reader thread
+/**
+ *  The reader thread reads the events sequentially and queues the complete
+ *  sets of primary vertices and particles. Clients only pop the next event
+ *  from the queue; the input parsing is not serialized with the clients.
+ *  Each queued event carries its event number, hence the association
+ *  between event content and event identifier (and with it the event seed)
+ *  does not depend on which worker thread consumes the event.
+ *
+ *  Readers accessing the event context while reading (e.g. to attach the
+ *  EventParameters) would act on the wrong event and are refused.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_SIMULATION
+ */
+class Geant4InputAction::Prefetcher  {
+public:
+  /// Event read ahead
+  struct Entry  {
+    int       number;
+    int       status;
+    Vertices  vertices;
+    Particles particles;
+  };
+  Geant4InputAction*      action;
+  std::size_t             depth;
+  std::thread             thread;
+  std::mutex              lock;
+  std::condition_variable cond;
+  std::deque<Entry>       queue;
+  /// Number of the next event to be queued
+  int                     next  { 0 };
+  /// Flag to stop the reader thread
+  bool                    stop  { false };
+  /// Flag set by the reader thread after a read failure or end-of-file
+  bool                    done  { false };
+
+public:
+  /// Initializing constructor
+  Prefetcher(Geant4InputAction* act, std::size_t num) : action(act), depth(num) {}
+  /// Default destructor
+  ~Prefetcher()  {  halt();  }
+  /// Drop an event
+  static void drop(Entry& entry)  {
+    for( auto*& v : entry.vertices )  dd4hep::detail::releasePtr(v);
+    for( auto*& p : entry.particles ) dd4hep::detail::releasePtr(p);
+  }
+  /// Stop the reader thread and drop all queued events
+  void halt()  {
+    if ( thread.joinable() )  {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+        cond.notify_all();
+      }
+      thread.join();
+    }
+    for( auto& e : queue ) drop(e);
+    queue.clear();
+  }
+  /// (Re-)start the reader thread at the given event number
+  void start(int first)  {
+    halt();
+    stop = done = false;
+    next = first;
+    thread = std::thread([this, first] { this->run(first); });
+  }
+  /// Reader thread body
+  void run(int first)  {
+    for( int number = first; ; ++number )  {
+      Entry entry { number, Geant4EventReader::EVENT_READER_ERROR, {}, {} };
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [this] { return stop || queue.size() < depth; });
+        if ( stop ) return;
+      }
+      try  {
+        entry.status = action->readEvent(number, entry.vertices, entry.particles);
+      }
+      catch(const std::exception& e)  {
+        action->error("+++ Prefetch of event %d failed: %s", number, e.what());
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      bool ok = entry.status == Geant4EventReader::EVENT_READER_OK;
+      queue.emplace_back(std::move(entry));
+      next = number + 1;
+      done = !ok;
+      cond.notify_all();
+      if ( done ) return;
+    }
+  }
+  /// Access the event with the given number
+  int get(int number, Vertices& vertices, Particles& particles)  {
+    bool in_sequence;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      in_sequence = !queue.empty()
+        ? queue.front().number == number
+        : thread.joinable() && !done && next == number;
+    }
+    if ( !in_sequence )  {
+      start(number);
+    }
+    std::unique_lock<std::mutex> guard(lock);
+    cond.wait(guard, [this] { return done || !queue.empty(); });
+    if ( queue.empty() )  {
+      return Geant4EventReader::EVENT_READER_ERROR;
+    }
+    Entry entry = std::move(queue.front());
+    queue.pop_front();
+    cond.notify_all();
+    vertices  = std::move(entry.vertices);
+    particles = std::move(entry.particles);
+    return entry.status;
+  }
+};
+
 
 /// Initializing constructor
 Geant4EventReader::Geant4EventReader(const std::string& nam) : m_name(nam)
@@ -126,6 +251,8 @@ Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const std::string& nam
   declareProperty("HaveAbort",      m_abort = true);
   declareProperty("Parameters",     m_parameters = {});
   declareProperty("AlternativeDecayStatuses", m_alternativeDecayStatuses = {});
+  declareProperty("Prefetch",       m_prefetch = 0);
+  declareProperty("UseEventID",     m_useEventID = false);
   m_needsControl = true;
 
   runAction().callAtBegin(this, &Geant4InputAction::beginRun);
@@ -133,6 +260,7 @@ Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const std::string& nam
 
 /// Default destructor
 Geant4InputAction::~Geant4InputAction()   {
+  detail::deletePtr(m_prefetcher);
 }
 
 ///Intialize the event reader before the run starts
@@ -147,6 +275,10 @@ void Geant4InputAction::createReader() {
   if ( m_input.empty() )  {
     except("InputAction: No input file declared!");
   }
+  if ( m_useEventID && m_prefetch > 0 )  {
+    except("InputAction: The properties UseEventID and Prefetch cannot be combined: "
+           "the prefetcher reads the events in sequence.");
+  }
   std::string err;
   TypeName tn = TypeName::split(m_input,"|");
   try  {
@@ -162,6 +294,18 @@ void Geant4InputAction::createReader() {
     m_reader->checkParameters( m_parameters );
     m_reader->setInputAction( this );
     m_reader->registerRunParameters();
+    if ( m_useEventID && !m_reader->hasDirectAccess() )  {
+      except("InputAction: The reader %s has no direct event access. "
+             "The property UseEventID cannot be used.", tn.first.c_str());
+    }
+    if ( m_prefetch > 0 && m_reader->usesEventContext() )  {
+      except("InputAction: The reader %s accesses the event context while reading. "
+             "The property Prefetch cannot be used.", tn.first.c_str());
+    }
+    if ( m_prefetch > 0 )  {
+      m_prefetcher = new Prefetcher(this, m_prefetch);
+      info("+++ Reading up to %d events ahead from %s.", m_prefetch, tn.second.c_str());
+    }
   } catch(const std::exception& e)  {
     err = e.what();
   }
@@ -178,6 +322,15 @@ std::string Geant4InputAction::issue(int i)  const  {
   return str.str();
 }
 
+/// Position the reader and read the event without any error handling
+int Geant4InputAction::readEvent(int evid, Vertices& vertices, Particles& particles)   {
+  int status = m_reader->moveToEvent(evid);
+  if ( Geant4EventReader::EVENT_READER_OK != status )  {
+    return status;
+  }
+  return m_reader->readParticles(evid, vertices, particles);
+}
+
 /// Read an event and return a LCCollection of MCParticles.
 int Geant4InputAction::readParticles(int evt_number,
                                      Vertices& vertices,
@@ -186,28 +339,9 @@ int Geant4InputAction::readParticles(int evt_number,
   //in case readParticles is called directly outside of having a run, we make sure a reader exists
   createReader();
   int evid = evt_number + m_firstEvent;
-  int status = m_reader->moveToEvent(evid);
-  if(status == Geant4EventReader::EVENT_READER_EOF ) {
-    long nEvents = context()->kernel().property("NumEvents").value<long>();
-    if(nEvents < 0) {
-      //context()->kernel().runManager().AbortRun(true);
-      throw DD4hep_End_Of_File();
-    }
-  }
-
-  if ( Geant4EventReader::EVENT_READER_OK != status )  {
-    std::string msg = issue(evid)+"Error when moving to event - ";
-    if ( status == Geant4EventReader::EVENT_READER_EOF ) msg += " EOF: [end of file].";
-    else msg += " Unknown error condition";
-    if ( m_abort )  {
-      abortRun(msg,"Error when reading file %s",m_input.c_str());
-      return status;
-    }
-    error(msg.c_str());
-    except("Error when reading file %s.", m_input.c_str());
-    return status;
-  }
-  status = m_reader->readParticles(evid, vertices, particles);
+  int status = m_prefetcher
+    ? m_prefetcher->get(evid, vertices, particles)
+    : readEvent(evid, vertices, particles);
   if(status == Geant4EventReader::EVENT_READER_EOF ) {
     long nEvents = context()->kernel().property("NumEvents").value<long>();
     if(nEvents < 0) {
@@ -238,9 +372,13 @@ void Geant4InputAction::operator()(G4Event* event)   {
   Vertices                  vertices ;
   int result;
 
-  result = readParticles(m_currentEventNumber, vertices, primaries);
+  // With UseEventID every reader instance (e.g. one per worker thread) reads
+  // the event Geant4 assigned to the worker directly from the input.
+  // The G4Event's ID may already carry the offset of a previous input action.
+  int number = m_useEventID ? evt.eventID() : m_currentEventNumber;
+  result = readParticles(number, vertices, primaries);
 
-  event->SetEventID(m_firstEvent + m_currentEventNumber);
+  event->SetEventID(m_firstEvent + number);
   ++m_currentEventNumber;
 
   if ( result != Geant4EventReader::EVENT_READER_OK )   {    // handle I/O error, but how?
@@ -34,6 +34,7 @@
 // C/C++ include files
 #include <algorithm>
 #include <pthread.h>
+#include <atomic>
 #include <csignal>
 #include <memory>
 
@@ -42,7 +43,17 @@ using namespace dd4hep::sim;
 namespace {
 
   G4Mutex kernel_mutex = G4MUTEX_INITIALIZER;
+  G4Mutex worker_mutex = G4MUTEX_INITIALIZER;
   std::unique_ptr<Geant4Kernel> s_main_instance;
+  /// Worker kernel of the current thread, registered by createWorker
+  struct ThreadWorker  {
+    const Geant4Kernel* master { nullptr };
+    Geant4Kernel*       worker { nullptr };
+    unsigned long       epoch  { 0 };
+  };
+  thread_local ThreadWorker s_thread_worker;
+  /// Incremented on every kernel destruction: invalidates all thread-local worker entries
+  std::atomic<unsigned long> s_kernel_epoch { 1 };
   void description_unexpected()    {
     try  {
       throw;
@@ -135,6 +146,10 @@ Geant4Kernel::Geant4Kernel(Geant4Kernel* krnl, unsigned long ident)
 
 /// Default destructor
 Geant4Kernel::~Geant4Kernel() {
+  ++s_kernel_epoch;
+  if ( s_thread_worker.worker == this || s_thread_worker.master == this )   {
+    s_thread_worker = ThreadWorker();
+  }
   if ( this == s_main_instance.get() )   {
     s_main_instance.release();
   }
@@ -217,8 +232,13 @@ unsigned long int Geant4Kernel::thread_self()    {
 Geant4Kernel& Geant4Kernel::createWorker()   {
   if ( isMaster() )   {
     unsigned long identifier = thread_self();
-    Geant4Kernel* w = new Geant4Kernel(this, identifier);
-    m_workers[identifier] = w;
+    Geant4Kernel* w = nullptr;
+    {
+      G4AutoLock protection_lock(&worker_mutex);
+      w = new Geant4Kernel(this, identifier);
+      m_workers[identifier] = w;
+    }
+    s_thread_worker = { this, w, s_kernel_epoch.load() };
     printout(INFO, "Geant4Kernel", "+++ Created worker instance id=%ul",identifier);
     return *w;
   }
@@ -228,8 +248,14 @@ Geant4Kernel& Geant4Kernel::createWorker()   {
 
 /// Access worker instance by its identifier
 Geant4Kernel& Geant4Kernel::worker(unsigned long identifier, bool create_if)    {
-  if ( Workers::iterator i=m_workers.find(identifier); i != m_workers.end() )   {
-    return *((*i).second);
+  Geant4Kernel* w = nullptr;
+  {
+    G4AutoLock protection_lock(&worker_mutex);
+    if ( Workers::iterator i=m_workers.find(identifier); i != m_workers.end() )
+      w = (*i).second;
+  }
+  if ( w )   {
+    return *w;
   }
   else if ( identifier == m_id )  {
     return *this;
@@ -247,6 +273,15 @@ Geant4Kernel& Geant4Kernel::worker(unsigned long identifier, bool create_if)
   throw std::runtime_error("Geant4Kernel::worker");
 }
 
+/// Access the worker instance of the calling thread (thread-local entry, map search if invalidated)
+Geant4Kernel& Geant4Kernel::threadWorker(bool create_if)    {
+  const ThreadWorker& w = s_thread_worker;
+  if ( w.master == this && w.epoch == s_kernel_epoch.load(std::memory_order_acquire) )   {
+    return *w.worker;
+  }
+  return worker(thread_self(), create_if);
+}
+
 /// Access number of workers
 int Geant4Kernel::numWorkers() const   {
   return m_workers.size();
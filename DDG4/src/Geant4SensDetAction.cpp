@@ -29,6 +29,7 @@
 #include <G4VSensitiveDetector.hh>
 
 // C/C++ include files
+#include <algorithm>
 #include <stdexcept>
 
 #ifdef DD4HEP_USE_GEANT4_UNITS
@@ -322,6 +323,7 @@ Geant4SensDetActionSequence::Geant4SensDetActionSequence(Geant4Context* ctxt, co
   : Geant4Action(ctxt, nam), m_hce(0), m_detector(0)
 {
   m_needsControl = true;
+  declareProperty("Compiled", m_compile);
   context()->sensitiveActions().insert(name(), this);
   /// Update the sensitive detector type, so that the proper instance is created
   m_sensitive = context()->detectorDescription().sensitiveDetector(nam);
@@ -356,6 +358,7 @@ void Geant4SensDetActionSequence::adopt(Geant4Sensitive* sensitive) {
   if (sensitive) {
     sensitive->addRef();
     m_actors.add(sensitive);
+    m_isCompiled = false;
     return;
   }
   except("Attempt to add invalid sensitive actor!");
@@ -436,12 +439,57 @@ bool Geant4SensDetActionSequence::accept(const Geant4FastSimSpot* spot) const {
   return result;
 }
 
+/// (Re-)build the compiled sensitive action list if the property "Compiled" is set
+void Geant4SensDetActionSequence::compile()   {
+  m_compiledFilters.clear();
+  m_compiledActors.clear();
+  m_filterResults.clear();
+  m_isCompiled = false;
+  if ( m_compile )   {
+    for (Geant4Sensitive* sensitive : m_actors)  {
+      CompiledActor actor(sensitive, {});
+      for (Geant4Filter* filter : sensitive->filters())  {
+        auto i = std::find(m_compiledFilters.begin(), m_compiledFilters.end(), filter);
+        actor.second.emplace_back(i - m_compiledFilters.begin());
+        if ( i == m_compiledFilters.end() ) m_compiledFilters.emplace_back(filter);
+      }
+      m_compiledActors.emplace_back(std::move(actor));
+    }
+    m_filterResults.resize(m_compiledFilters.size(), -1);
+    m_isCompiled = true;
+    debug("Compiled sequence with %ld sensitive actions and %ld distinct filters.",
+          long(m_compiledActors.size()), long(m_compiledFilters.size()));
+  }
+}
+
+/// Evaluate the filters of a compiled sensitive action using the per-step result cache
+template <typename T>
+bool Geant4SensDetActionSequence::acceptCompiled(const CompiledActor& actor, const T* object)  {
+  for (std::size_t idx : actor.second)  {
+    signed char& result = m_filterResults[idx];
+    if ( result < 0 )
+      result = (*m_compiledFilters[idx])(object) ? 1 : 0;
+    if ( 0 == result )
+      return false;
+  }
+  return true;
+}
+
 /// G4VSensitiveDetector interface: Method for generating hit(s) using the information of G4Step object.
 bool Geant4SensDetActionSequence::process(const G4Step* step, G4TouchableHistory* history) {
   bool result = false;
-  for (Geant4Sensitive* sensitive : m_actors)  {
-    if ( sensitive->accept(step) )
-      result |= sensitive->process(step, history);
+  if ( m_isCompiled )   {
+    std::fill(m_filterResults.begin(), m_filterResults.end(), -1);
+    for (const CompiledActor& actor : m_compiledActors)  {
+      if ( acceptCompiled(actor, step) )
+        result |= actor.first->process(step, history);
+    }
+  }
+  else   {
+    for (Geant4Sensitive* sensitive : m_actors)  {
+      if ( sensitive->accept(step) )
+        result |= sensitive->process(step, history);
+    }
   }
   m_process(step, history);
   return result;
@@ -450,9 +498,18 @@ bool Geant4SensDetActionSequence::process(const G4Step* step, G4TouchableHistory
 /// GFLASH/FastSim interface: Method for generating hit(s) using the information of the Geant4FastSimSpot object.
 bool Geant4SensDetActionSequence::processFastSim(const Geant4FastSimSpot* spot, G4TouchableHistory* history)  {
   bool result = false;
-  for (Geant4Sensitive* sensitive : m_actors)  {
-    if ( sensitive->accept(spot) )
-      result |= sensitive->processFastSim(spot, history);
+  if ( m_isCompiled )   {
+    std::fill(m_filterResults.begin(), m_filterResults.end(), -1);
+    for (const CompiledActor& actor : m_compiledActors)  {
+      if ( acceptCompiled(actor, spot) )
+        result |= actor.first->processFastSim(spot, history);
+    }
+  }
+  else   {
+    for (Geant4Sensitive* sensitive : m_actors)  {
+      if ( sensitive->accept(spot) )
+        result |= sensitive->processFastSim(spot, history);
+    }
   }
   m_process(spot, history);
   return result;
@@ -251,8 +251,15 @@ namespace dd4hep {
     }
 
     template <> G4VSolid* convertShape<TGeoTessellated>(const TGeoShape* shape)  {
+      G4TessellatedSolid* g4 = new G4TessellatedSolid(shape->GetName());
+      fillTessellatedSolid(g4, shape);
+      return g4;
+    }
+
+    /// Add the facets of a TGeoTessellated shape to an empty G4TessellatedSolid and close it
+    void fillTessellatedSolid(G4VSolid* solid, const TGeoShape* shape)  {
       TGeoTessellated*   sh  = (TGeoTessellated*) shape;
-      G4TessellatedSolid* g4 = new G4TessellatedSolid(sh->GetName());
+      G4TessellatedSolid* g4 = (G4TessellatedSolid*) solid;
       int num_facet = sh->GetNfacets();
 
       printout(DEBUG,"TessellatedSolid","+++ %s> Converting %d facets", sh->GetName(), num_facet);
@@ -294,7 +301,6 @@ namespace dd4hep {
         g4->AddFacet(g4f);
       }
       g4->SetSolidClosed(sh->IsClosedBody());
-      return g4;
     }
     
   }    // End namespace sim
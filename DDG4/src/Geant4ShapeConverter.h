@@ -30,6 +30,10 @@ namespace dd4hep {
     /// Convert a specific TGeo shape into the geant4 equivalent
     template <typename T> G4VSolid* convertShape(const TGeoShape* shape);
 
+    /// Add the facets of a TGeoTessellated shape to an empty G4TessellatedSolid and close it
+    /** Only accesses the given objects: solids may be filled concurrently. */
+    void fillTessellatedSolid(G4VSolid* solid, const TGeoShape* shape);
+
   }    // End namespace sim
 }      // End namespace dd4hep
 #endif // DDG4_SRC_GEANT4SHAPECONVERTER_H
@@ -57,6 +57,7 @@ void Geant4SharedSteppingAction::use(Geant4SteppingAction* action)   {
   if (action) {
     action->addRef();
     m_properties.adopt(action->properties());
+    m_callbacks = action->callbacks();
     m_action = action;
     return;
   }
@@ -82,6 +83,7 @@ void Geant4SharedSteppingAction::operator()(const G4Step* s, G4SteppingManager*
 Geant4SteppingActionSequence::Geant4SteppingActionSequence(Geant4Context* ctxt, const std::string& nam)
 : Geant4Action(ctxt, nam) {
   m_needsControl = true;
+  declareProperty("Compiled", m_compile);
   InstanceCount::increment(this);
 }
 
@@ -109,8 +111,35 @@ Geant4SteppingAction* Geant4SteppingActionSequence::get(const std::string& nam)
   return m_actors.get(FindByName(TypeName::split(nam).second));
 }
 
+/// (Re-)build the flat callback tables if the property "Compiled" is set
+void Geant4SteppingActionSequence::compile()   {
+  m_compiledActors.clear();
+  m_compiledCalls.clear();
+  m_isCompiled = false;
+  if ( m_compile )   {
+    for( Geant4SteppingAction* action : m_actors )   {
+      if ( action->callbacks() & Geant4SteppingAction::CALL_STEP )
+        m_compiledActors.emplace_back(action);
+    }
+    for( const Callback& call : m_calls.callbacks )   {
+      if ( call ) m_compiledCalls.emplace_back(call);
+    }
+    m_isCompiled = true;
+    debug("Compiled sequence with %ld of %ld actions and %ld callbacks.",
+          long(m_compiledActors.size()), long(m_actors->size()), long(m_compiledCalls.size()));
+  }
+}
+
 /// Pre-track action callback
 void Geant4SteppingActionSequence::operator()(const G4Step* step, G4SteppingManager* mgr) {
+  if ( m_isCompiled )   {
+    for( Geant4SteppingAction* action : m_compiledActors )
+      (*action)(step, mgr);
+    const void* args[] = { step, mgr };
+    for( const Callback& call : m_compiledCalls )
+      call.call(call.par, &call.func, args);
+    return;
+  }
   m_actors(&Geant4SteppingAction::operator(), step, mgr);
   m_calls(step, mgr);
 }
@@ -121,6 +150,7 @@ void Geant4SteppingActionSequence::adopt(Geant4SteppingAction* action) {
     G4AutoLock protection_lock(&action_mutex);
     action->addRef();
     m_actors.add(action);
+    m_isCompiled = false;
     return;
   }
   except("Attempt to add invalid actor!");
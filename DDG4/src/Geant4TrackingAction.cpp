@@ -36,6 +36,7 @@ namespace {
 Geant4TrackingActionSequence::Geant4TrackingActionSequence(Geant4Context* ctxt, const std::string& nam)
   : Geant4Action(ctxt, nam) {
   m_needsControl = true;
+  declareProperty("Compiled", m_compile);
   InstanceCount::increment(this);
 }
 
@@ -47,6 +48,12 @@ Geant4TrackingActionSequence::~Geant4TrackingActionSequence() {
   m_final.clear();
   m_begin.clear();
   m_end.clear();
+  m_compiledFront.clear();
+  m_compiledBegin.clear();
+  m_compiledBeginCalls.clear();
+  m_compiledEndCalls.clear();
+  m_compiledEnd.clear();
+  m_compiledFinal.clear();
   InstanceCount::decrement(this);
 }
 
@@ -72,13 +79,60 @@ void Geant4TrackingActionSequence::adopt(Geant4TrackingAction* action) {
     G4AutoLock protection_lock(&action_mutex);
     action->addRef();
     m_actors.add(action);
+    m_isCompiled = false;
     return;
   }
   throw std::runtime_error("Geant4TrackingActionSequence: Attempt to add invalid actor!");
 }
 
+namespace {
+  /// Copy all valid callbacks of a callback sequence to a flat callback table
+  void _compile(std::vector<dd4hep::Callback>& table, const dd4hep::CallbackSequence& seq)   {
+    table.clear();
+    for( const auto& call : seq.callbacks )   {
+      if ( call ) table.emplace_back(call);
+    }
+  }
+  /// Copy all actions interested in a given callback
+  void _compile(std::vector<Geant4TrackingAction*>& table, const std::vector<Geant4TrackingAction*>& actors, int mask)   {
+    table.clear();
+    for( Geant4TrackingAction* action : actors )   {
+      if ( action->callbacks() & mask ) table.emplace_back(action);
+    }
+  }
+  /// Execute a flat callback table
+  void _execute(const std::vector<dd4hep::Callback>& table, const G4Track* track)   {
+    const void* args[] = { track };
+    for( const auto& call : table )
+      call.call(call.par, &call.func, args);
+  }
+}
+
+/// (Re-)build the flat callback tables if the property "Compiled" is set
+void Geant4TrackingActionSequence::compile()   {
+  m_isCompiled = false;
+  if ( m_compile )   {
+    _compile(m_compiledFront,      m_front);
+    _compile(m_compiledBegin,      m_actors, Geant4TrackingAction::CALL_BEGIN);
+    _compile(m_compiledBeginCalls, m_begin);
+    _compile(m_compiledEndCalls,   m_end);
+    _compile(m_compiledEnd,        m_actors, Geant4TrackingAction::CALL_END);
+    _compile(m_compiledFinal,      m_final);
+    m_isCompiled = true;
+    debug("Compiled sequence with %ld pre- and %ld post-tracking actions of %ld.",
+          long(m_compiledBegin.size()), long(m_compiledEnd.size()), long(m_actors->size()));
+  }
+}
+
 /// Pre-track action callback
 void Geant4TrackingActionSequence::begin(const G4Track* track) {
+  if ( m_isCompiled )   {
+    _execute(m_compiledFront, track);
+    for( Geant4TrackingAction* action : m_compiledBegin )
+      action->begin(track);
+    _execute(m_compiledBeginCalls, track);
+    return;
+  }
   m_front(track);
   m_actors(&Geant4TrackingAction::begin, track);
   m_begin(track);
@@ -86,6 +140,13 @@ void Geant4TrackingActionSequence::begin(const G4Track* track) {
 
 /// Post-track action callback
 void Geant4TrackingActionSequence::end(const G4Track* track) {
+  if ( m_isCompiled )   {
+    _execute(m_compiledEndCalls, track);
+    for( Geant4TrackingAction* action : m_compiledEnd )
+      action->end(track);
+    _execute(m_compiledFinal, track);
+    return;
+  }
   m_end(track);
   m_actors(&Geant4TrackingAction::end, track);
   m_final(track);
@@ -139,6 +200,7 @@ void Geant4SharedTrackingAction::use(Geant4TrackingAction* action)   {
   if (action) {
     action->addRef();
     m_properties.adopt(action->properties());
+    m_callbacks = action->callbacks();
     m_action = action;
     return;
   }
@@ -23,6 +23,7 @@ using namespace dd4hep::sim;
 /// Standard constructor
 Geant4TrackingPreAction::Geant4TrackingPreAction(Geant4Context* ctxt, const std::string& nam)
   : Geant4TrackingAction(ctxt, nam) {
+  m_callbacks = CALL_BEGIN;
   InstanceCount::increment(this);
 }
 
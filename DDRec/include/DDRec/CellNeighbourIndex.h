@@ -0,0 +1,235 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_CELLNEIGHBOURINDEX_H
+#define DDREC_CELLNEIGHBOURINDEX_H
+
+// Framework include files
+#include "DDSegmentation/BitFieldCoder.h"
+
+// C/C++ include files
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Forward declarations
+  class DetElement;
+  namespace DDSegmentation { class Segmentation; }
+
+  /// Namespace for the reconstruction part of the AIDA detector description toolkit
+  namespace rec {
+
+    /// Forward declarations
+    struct NeighbourSurfacesStruct;
+
+    /// Precomputed neighbour lookup for grid type segmentations
+    /**
+     *  Replaces Segmentation::neighbours(CellID, std::set<CellID>&) for clustering:
+     *  the neighbours are computed with precomputed bit field accessors and
+     *  neighbour stencils and are written to a buffer supplied by the caller.
+     *  Queries do not allocate memory.
+     *
+     *  Supported are CartesianGridXY, GridPhiEta, HexGridXY, CylindricalGridPhiZ
+     *  and PolarGridRPhi2:
+     *  - Cartesian grids: the 4 cells sharing an edge, 8 including diagonals.
+     *  - Phi grids (GridPhiEta, CylindricalGridPhiZ): like cartesian grids, the
+     *    phi index wraps around if the bins cover the full circle. If the phi
+     *    range starts in the middle of a bin, the two halves of this cell
+     *    have different indices; both are returned as neighbours.
+     *  - Hexagonal grids: the 6 cells sharing an edge.
+     *  - PolarGridRPhi2: the phi neighbours in the same ring and all cells of the
+     *    adjacent rings overlapping in phi (touching cells with diagonals).
+     *    The ring overlaps are tabulated when the index is constructed.
+     *
+     *  Cross layer neighbours are the cells with the same segmentation indices
+     *  in the layers +-1 of the layer field. For staggered hexagonal grids
+     *  these are the cells of the adjacent layer overlapping the cell.
+     *  With diagonals the same layer neighbours of these cells are added.
+     *
+     *  The index may be attached to the subdetector as an extension:
+     *  $> geoPluginRun -input SiD.xml -plugin DD4hep_CellNeighbourIndex -detector EcalBarrel
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class CellNeighbourIndex  {
+    public:
+      typedef DDSegmentation::CellID CellID;
+      /// Selection of neighbours (bit mask)
+      enum Selection { SAME_LAYER = 1, PREV_LAYER = 2, NEXT_LAYER = 4, ALL_LAYERS = 7 };
+      /// Supported segmentation types
+      enum GridType { CARTESIAN = 1, PHI_ETA = 2, HEXAGONAL = 3, PHI_Z = 4, POLAR = 5 };
+
+      /// Fast access to one bit field of the cell identifier
+      struct Field  {
+        CellID   mask     { 0 };
+        unsigned offset   { 0 };
+        unsigned width    { 0 };
+        bool     isSigned { false };
+        long     minValue { 0 };
+        long     maxValue { -1 };
+
+        /// Default constructor: invalid field
+        Field() = default;
+        /// Initializing constructor
+        Field(const DDSegmentation::BitFieldElement& element);
+        /// Check if the field is present
+        bool valid()  const                       {  return width > 0;  }
+        /// Field value of a cell
+        long get(CellID cell)  const  {
+          CellID val = (cell & mask) >> offset;
+          if ( isSigned && width < 64 && ((val >> (width-1)) & 1) ) val |= ~CellID(0) << width;
+          return long(val);
+        }
+        /// Set the field value. Returns false if the value does not fit
+        bool set(CellID& cell, long value)  const  {
+          if ( value < minValue || value > maxValue ) return false;
+          cell = (cell & ~mask) | ((CellID(value) << offset) & mask);
+          return true;
+        }
+      };
+      /// Neighbour offset in the two segmentation indices
+      struct Offset  {
+        int du;
+        int dv;
+      };
+
+    protected:
+      /// Name of the segmentation type
+      std::string          m_typeName;
+      /// Segmentation type
+      int                  m_type      { 0 };
+      /// Include diagonal neighbours
+      bool                 m_diagonal  { false };
+      /// First segmentation index (x, eta, z or r)
+      Field                m_u;
+      /// Second segmentation index (y or phi)
+      Field                m_v;
+      /// Layer field for cross layer neighbours
+      Field                m_layer;
+      /// Number of bins of a periodic second index. 0 if not periodic
+      long                 m_period    { 0 };
+      /// First bin of a periodic second index
+      long                 m_periodMin { 0 };
+      /// The cell at the first bin is split: its upper half has the index m_periodMin + m_period
+      bool                 m_periodAlias { false };
+      /// Same layer stencil
+      std::vector<Offset>  m_same;
+      /// Number of layer classes with different cross layer stencils (staggered grids)
+      int                  m_classes   { 1 };
+      /// Cross layer stencils: [2*layerClass(layer) + (next ? 1 : 0)]
+      std::vector<std::vector<Offset> > m_cross;
+      /// Polar grids: number of phi bins per ring
+      std::vector<int>     m_ringBins;
+      /// Polar grids: first cell of every ring in the overlap table
+      std::vector<std::size_t> m_ringStart;
+      /// Polar grids: overlap table offsets per cell
+      std::vector<uint32_t> m_overlapIndex;
+      /// Polar grids: overlapping cells of the adjacent rings. du: ring offset, dv: phi bin
+      std::vector<Offset>  m_overlaps;
+      /// Upper limit of the number of neighbours of a cell
+      std::size_t          m_maxNeighbours { 0 };
+
+      /// Stencil class of a layer: [0,m_classes) for negative, [m_classes,2*m_classes) for other layers
+      long layerClass(long layer)  const  {
+        return layer < 0 ? m_classes - 1 + layer % m_classes : m_classes + layer % m_classes;
+      }
+      /// Wrap a periodic second index
+      long wrap(long v, long period, long vmin)  const  {
+        long d = (v - vmin) % period;
+        return (d < 0 ? d + period : d) + vmin;
+      }
+      /// Fill the tables of polar grids
+      void buildPolar(const std::vector<double>& r_values, const std::vector<double>& phi_values);
+      /// Fill the cross layer stencils of staggered hexagonal grids
+      void buildStaggered(const DDSegmentation::Segmentation& segmentation, int stagger);
+      /// Add the cell with indices (u,v) to the buffer. Wraps a periodic second index
+      void add(CellID base, long u, long v, CellID origin, CellID* buffer, std::size_t capacity, std::size_t& count)  const;
+      /// Add the same layer neighbours of a cell to the buffer
+      void sameLayer(CellID cell, CellID origin, CellID* buffer, std::size_t capacity, std::size_t& count)  const;
+
+    public:
+      /// Initializing constructor. Throws if the segmentation type is not supported
+      CellNeighbourIndex(const DDSegmentation::Segmentation& segmentation,
+                         const std::string& layer_field = "layer",
+                         bool diagonal = false);
+      /// Copy constructor for DetElement extensions
+      CellNeighbourIndex(const CellNeighbourIndex& copy, DetElement de);
+      /// Default copy constructor
+      CellNeighbourIndex(const CellNeighbourIndex& copy) = default;
+      /// Default destructor
+      ~CellNeighbourIndex() = default;
+
+      /// Name of the segmentation type
+      const std::string& type()  const            {  return m_typeName;  }
+      /// Check if cross layer neighbours are available
+      bool hasLayers()  const                     {  return m_layer.valid();  }
+      /// Buffers of this size never truncate the neighbours of a cell
+      std::size_t maxNeighbours()  const          {  return m_maxNeighbours;  }
+
+      /// Fill the neighbours of a cell into the buffer
+      /** Returns the number of neighbours. If it exceeds the capacity, only the
+       *  first capacity neighbours were stored and the number is an upper limit.
+       */
+      std::size_t neighbours(CellID cell, CellID* buffer, std::size_t capacity,
+                             int selection = ALL_LAYERS)  const;
+    };
+
+    /// Compact, read-only copy of the neighbour maps of a NeighbourSurfacesStruct
+    /**
+     *  The cells are stored sorted together with one flat array of neighbours
+     *  (same layer, previous layer and next layer for every cell). Queries
+     *  are binary searches and fill a buffer supplied by the caller.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class NeighbourSurfacesIndex  {
+    public:
+      typedef DDSegmentation::CellID CellID;
+
+    protected:
+      /// Sorted cells
+      std::vector<CellID>   m_cells;
+      /// Offsets into m_neighbours: [3*cell + {0:same, 1:prev, 2:next}]
+      std::vector<uint32_t> m_offsets;
+      /// Neighbours of all cells
+      std::vector<CellID>   m_neighbours;
+
+    public:
+      /// Initializing constructor
+      NeighbourSurfacesIndex(const NeighbourSurfacesStruct& data);
+      /// Copy constructor for DetElement extensions
+      NeighbourSurfacesIndex(const NeighbourSurfacesIndex& copy, DetElement de);
+      /// Default copy constructor
+      NeighbourSurfacesIndex(const NeighbourSurfacesIndex& copy) = default;
+      /// Default destructor
+      ~NeighbourSurfacesIndex() = default;
+
+      /// Number of cells with neighbours
+      std::size_t size()  const                   {  return m_cells.size();  }
+      /// Fill the neighbours of a cell into the buffer
+      /** The selection is a bit mask of CellNeighbourIndex::Selection.
+       *  Returns the number of neighbours. If it exceeds the capacity,
+       *  only the first capacity neighbours were stored.
+       */
+      std::size_t neighbours(CellID cell, CellID* buffer, std::size_t capacity,
+                             int selection = CellNeighbourIndex::ALL_LAYERS)  const;
+    };
+  }    // End namespace rec
+}      // End namespace dd4hep
+#endif // DDREC_CELLNEIGHBOURINDEX_H
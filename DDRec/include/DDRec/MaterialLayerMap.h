@@ -0,0 +1,121 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_MATERIALLAYERMAP_H
+#define DDREC_MATERIALLAYERMAP_H
+
+// Framework include files
+#include "DDRec/MaterialMap.h"
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the reconstruction part of the AIDA detector description toolkit
+  namespace rec {
+
+    /// Forward declarations
+    class MaterialScanEngine;
+
+    /// Precomputed material of cylindrical and disc shaped layers for reconstruction
+    /**
+     *  Every layer is a tube segment [rMin,rMax] x [zMin,zMax] binned in z and phi
+     *  (cylinders) or r and phi (discs). Each bin holds the material budget of
+     *  the straight crossing of the layer along its normal at the bin center:
+     *  radially for cylinders, parallel to z for discs. The bins are filled once
+     *  with the MaterialScanEngine and may be stored to and restored from text files.
+     *
+     *  Lookups interpolate bilinearly between the bin centers (periodic in phi)
+     *  and need no geometry navigation. budgetBetween() and materialBetween()
+     *  replace MaterialManager::createAveragedMaterial(materialsBetween(p0,p1))
+     *  for tracks between surfaces: the material of every layer is scaled by
+     *  the path length of the segment inside the layer over the layer thickness.
+     *  Material outside the layers is not accounted for.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class MaterialLayerMap  {
+    public:
+      enum LayerType { CYLINDER = 1, DISC = 2 };
+
+      /// Binned material of one layer
+      struct Layer  {
+        std::string name;
+        int         type   { CYLINDER };
+        double      rMin   { 0e0 };
+        double      rMax   { 0e0 };
+        double      zMin   { 0e0 };
+        double      zMax   { 0e0 };
+        /// Number of bins along z (cylinders) or r (discs)
+        int         nBins  { 1 };
+        /// Number of bins in phi
+        int         nPhi   { 1 };
+        /// Budgets of the normal crossing: bins[iBin * nPhi + iPhi]
+        std::vector<MaterialBudget> bins;
+
+        /// Layer thickness along the normal
+        double thickness()  const  {  return type == CYLINDER ? rMax - rMin : zMax - zMin;  }
+        /// Position of the center of a bin on the layer mid surface
+        Vector3D center(int ibin, int iphi)  const;
+        /// Straight crossing of the layer along its normal at the center of a bin
+        std::pair<Vector3D, Vector3D> crossing(int ibin, int iphi)  const;
+        /// Check if the point is inside the layer
+        bool contains(const Vector3D& point)  const;
+      };
+
+    protected:
+      /// Layer definitions and contents
+      std::vector<Layer> m_layers;
+
+      /// Add a new layer
+      std::size_t add(Layer&& layer);
+
+    public:
+      /// Default constructor
+      MaterialLayerMap() = default;
+      /// Default destructor
+      ~MaterialLayerMap() = default;
+
+      /// Add a cylindrical layer binned in z and phi. Returns the layer index
+      std::size_t addCylinder(const std::string& name, double rMin, double rMax,
+                              double zMin, double zMax, int nZ, int nPhi);
+      /// Add a disc shaped layer binned in r and phi. Returns the layer index
+      std::size_t addDisc(const std::string& name, double zMin, double zMax,
+                          double rMin, double rMax, int nR, int nPhi);
+      /// Fill the bins of all layers with the material scan engine
+      void build(const MaterialScanEngine& engine);
+
+      /// Number of layers
+      std::size_t size()  const                  {  return m_layers.size();  }
+      /// Access layer by index
+      const Layer& layer(std::size_t index)  const  {  return m_layers.at(index);  }
+      /// Index of a layer by name. -1 if not present
+      int index(const std::string& name)  const;
+
+      /// Interpolated budget of the normal crossing of a layer at the given position
+      MaterialBudget budget(std::size_t index, const Vector3D& point)  const;
+      /// Material budget of all layers crossed by the straight line between p0 and p1
+      MaterialBudget budgetBetween(const Vector3D& p0, const Vector3D& p1)  const;
+      /// Averaged material of all layers crossed by the straight line between p0 and p1
+      MaterialData materialBetween(const Vector3D& p0, const Vector3D& p1)  const;
+      /// Check if two maps have identical layers and contents
+      bool operator==(const MaterialLayerMap& other)  const;
+
+      /// Store the map to a text file
+      void write(const std::string& file_name)  const;
+      /// Restore a map from a text file written by write()
+      static std::unique_ptr<MaterialLayerMap> read(const std::string& file_name);
+    };
+  }    // End namespace rec
+}      // End namespace dd4hep
+#endif // DDREC_MATERIALLAYERMAP_H
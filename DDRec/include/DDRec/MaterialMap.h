@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_MATERIALMAP_H
+#define DDREC_MATERIALMAP_H
+
+// Framework include files
+#include "DDRec/Material.h"
+#include "DDRec/Vector3D.h"
+
+// C/C++ include files
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the reconstruction part of the AIDA detector description toolkit
+  namespace rec {
+
+    /// Material budget accumulated along a path
+    /**
+     *  The sums are those of MaterialManager::createAveragedMaterial: the averaged
+     *  material of the path is available without keeping the individual materials.
+     *  Budgets of several rays may be added and scaled to form mean values.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    struct MaterialBudget  {
+      /// Path length
+      double length          { 0e0 };
+      /// Sum of length / radiation length
+      double x0              { 0e0 };
+      /// Sum of length / interaction length
+      double lambda          { 0e0 };
+      /// Sum of density * length
+      double rho_l           { 0e0 };
+      /// Sum of density * length / A
+      double rho_l_over_A    { 0e0 };
+      /// Sum of density * length * Z / A
+      double rho_l_Z_over_A  { 0e0 };
+
+      /// Add the budget of another path
+      MaterialBudget& operator+=(const MaterialBudget& copy);
+      /// Scale all sums (e.g. to the mean of several rays)
+      MaterialBudget& operator*=(double factor);
+      /// Averaged material of the path. Default MaterialData if the path length is zero
+      MaterialData average()  const;
+      /// Exact comparison of all sums
+      bool operator==(const MaterialBudget& other)  const;
+      /// Exact comparison of all sums
+      bool operator!=(const MaterialBudget& other)  const  {  return !(*this == other);  }
+    };
+
+    /// Material budget binned in pseudorapidity and azimuth
+    /**
+     *  Each bin holds the mean material budget of straight rays from the scan
+     *  origin to the scan envelope, a cylinder of radius rMax and half length zMax.
+     *  Maps are created by the MaterialScanEngine and may be stored to and
+     *  restored from text files, so that reconstruction does not need to
+     *  navigate the geometry at runtime.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class MaterialMap  {
+    public:
+      /// Binning and scan envelope of the map
+      struct Grid  {
+        int    nEta   { 100 };
+        double etaMin { -5e0 };
+        double etaMax {  5e0 };
+        int    nPhi   { 72 };
+        double phiMin { -M_PI };
+        double phiMax {  M_PI };
+        /// Scan envelope: cylinder radius. 0: use the world volume
+        double rMax   { 0e0 };
+        /// Scan envelope: cylinder half length. 0: use the world volume
+        double zMax   { 0e0 };
+        /// Origin of the rays
+        Vector3D origin { };
+        /// Rays per bin: nSub x nSub directions on a regular sub-grid
+        int    nSub   { 1 };
+      };
+
+    protected:
+      /// Binning of the map
+      Grid                        m_grid;
+      /// Bin contents: m_bins[iEta * nPhi + iPhi]
+      std::vector<MaterialBudget> m_bins;
+
+    public:
+      /// Initializing constructor
+      MaterialMap(const Grid& grid);
+      /// Default destructor
+      ~MaterialMap() = default;
+
+      /// Access the binning
+      const Grid& grid()  const                 {  return m_grid;                }
+      /// Total number of bins
+      std::size_t size()  const                 {  return m_bins.size();         }
+      /// Eta bin number of a pseudorapidity value. -1 if outside
+      int etaBin(double eta)  const;
+      /// Phi bin number of an azimuth. -1 if outside. phiMax belongs to the last bin
+      int phiBin(double phi)  const;
+      /// Pseudorapidity of the bin center
+      double etaCenter(int ieta)  const;
+      /// Azimuth of the bin center
+      double phiCenter(int iphi)  const;
+      /// Access bin content
+      MaterialBudget& bin(int ieta, int iphi)             {  return m_bins[ieta*m_grid.nPhi + iphi];  }
+      /// Access bin content
+      const MaterialBudget& bin(int ieta, int iphi) const {  return m_bins[ieta*m_grid.nPhi + iphi];  }
+      /// Bin content for a given direction. 0 if outside the map
+      const MaterialBudget* find(double eta, double phi)  const;
+      /// Bin content for a given direction from the scan origin. 0 if outside the map
+      const MaterialBudget* find(const Vector3D& direction)  const;
+      /// Check if two maps have identical binning and contents
+      bool operator==(const MaterialMap& other)  const;
+
+      /// Store the map to a text file
+      void write(const std::string& file_name)  const;
+      /// Restore a map from a text file written by write()
+      static std::unique_ptr<MaterialMap> read(const std::string& file_name);
+    };
+  }    // End namespace rec
+}      // End namespace dd4hep
+#endif // DDREC_MATERIALMAP_H
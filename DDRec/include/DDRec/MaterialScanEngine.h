@@ -0,0 +1,110 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_MATERIALSCANENGINE_H
+#define DDREC_MATERIALSCANENGINE_H
+
+// Framework include files
+#include "DDRec/MaterialMap.h"
+
+// C/C++ include files
+#include <unordered_map>
+#include <functional>
+#include <vector>
+
+/// Forward declarations
+class TGeoManager;
+class TGeoVolume;
+class TGeoNavigator;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Forward declarations
+  class Detector;
+
+  /// Namespace for the reconstruction part of the AIDA detector description toolkit
+  namespace rec {
+
+    /// Multi-threaded material budget scans
+    /**
+     *  Unlike the MaterialManager, which steps with the navigator of the global
+     *  TGeoManager, the scan engine only uses thread local navigators and may
+     *  scan rays from several threads concurrently. The material properties
+     *  of all volumes are cached when the engine is constructed.
+     *
+     *  Material maps are scanned in tiles of neighbouring eta-phi bins. The
+     *  tiles are distributed to the worker threads, rays of neighbouring
+     *  bins cross the same volumes and profit from the navigator caches.
+     *  The result does not depend on the number of threads.
+     *
+     *  Example: scan a map with 8 threads and store it for reconstruction:
+     *  $> geoPluginRun -input SiD.xml -plugin DD4hep_MaterialMapScan -threads 8 -output SiD_material.map
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class MaterialScanEngine  {
+    public:
+      /// Cached material properties of a volume
+      struct Medium  {
+        double inv_x0           { 0e0 };
+        double inv_lambda       { 0e0 };
+        double density          { 0e0 };
+        double density_over_A   { 0e0 };
+        double density_Z_over_A { 0e0 };
+      };
+
+    protected:
+      /// Geometry manager
+      TGeoManager* m_manager  { nullptr };
+      /// Material properties by volume
+      std::unordered_map<const TGeoVolume*, Medium> m_media;
+      /// Number of worker threads
+      int          m_threads  { 1 };
+      /// Number of eta bins per tile
+      int          m_tileEta  { 8 };
+      /// Number of phi bins per tile
+      int          m_tilePhi  { 8 };
+
+      /// Material properties of a volume
+      Medium medium(const TGeoVolume* volume)  const;
+      /// Navigator of the calling thread. Created if not present
+      TGeoNavigator* navigator()  const;
+      /// Execute tasks [0,num_tasks) with the worker threads. Each thread uses its own navigator.
+      /// The TGeo thread map is reset before and after, the engine may be used for several scans
+      std::size_t execute(int num_tasks, const std::function<void(TGeoNavigator*, int)>& task)  const;
+
+    public:
+      /// Initializing constructor. threads <= 0: use all hardware threads
+      MaterialScanEngine(Detector& description, int threads=0);
+      /// Default destructor
+      ~MaterialScanEngine() = default;
+
+      /// Set the number of worker threads. threads <= 0: use all hardware threads
+      void setThreads(int threads);
+      /// Set the tile size in eta and phi bins
+      void setTileSize(int num_eta, int num_phi);
+
+      /// Material budget along a straight line. Uses the navigator of the calling thread
+      MaterialBudget scan(const Vector3D& p0, const Vector3D& p1)  const;
+      /// Material budget along a straight line using a given navigator
+      MaterialBudget scan(TGeoNavigator* nav, const Vector3D& p0, const Vector3D& p1)  const;
+      /// Material budgets of a set of straight lines, scanned with the worker threads
+      std::vector<MaterialBudget> scan(const std::vector<std::pair<Vector3D, Vector3D> >& rays)  const;
+      /// Scan a material map
+      std::unique_ptr<MaterialMap> scan(const MaterialMap::Grid& grid)  const;
+    };
+  }    // End namespace rec
+}      // End namespace dd4hep
+#endif // DDREC_MATERIALSCANENGINE_H
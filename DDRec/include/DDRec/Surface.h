@@ -542,6 +542,9 @@ namespace dd4hep {
       /// The DetElement belonging to the surface volume
       DetElement detElement() const { return _det; }
 
+      /// The world transformation of the surface volume
+      const TGeoMatrix* worldTransformation() const { return _wtM.get() ; }
+
 
       //==== geometry ====
       
@@ -584,6 +587,11 @@ namespace dd4hep {
       /** Get Origin of local coordinate system of the associated volume */
       virtual Vector3D volumeOrigin() const  ; 
 
+      /** Axis aligned box in world coordinates enclosing the surface: the bounding box
+       *  of the volume shape transformed to the world frame.
+       */
+      void globalBoundingBox( Vector3D& lower, Vector3D& upper ) const ;
+
       /** The length of the surface along direction u at the origin. For 'regular' boundaries, like rectangles, 
        *  this can be used to speed up the computation of inSideBounds.
        */
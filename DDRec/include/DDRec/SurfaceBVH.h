@@ -0,0 +1,120 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_SURFACEBVH_H
+#define DDREC_SURFACEBVH_H
+
+#include "DDRec/ISurface.h"
+
+#include <vector>
+
+namespace dd4hep {
+  namespace rec {
+
+    /// Crossing point of a segment with a surface
+    struct SurfaceIntersection {
+      ISurface* surface { nullptr } ;
+      /// Global position of the crossing point
+      Vector3D  point {} ;
+      /// Path length from the start of the segment
+      double    path { 0. } ;
+    } ;
+
+    /** Bounding volume hierarchy over a set of surfaces for fast spatial queries.
+     *  The hierarchy is built once from the world bounding boxes of the surfaces
+     *  (see Surface::globalBoundingBox) and is immutable afterwards: all queries are
+     *  const and may be issued concurrently from several threads.
+     *  Surfaces which are not of type Surface have no bounding box and are tested
+     *  with every query.
+     *
+     * @author M.Frank, CERN
+     * @version 1.0
+     */
+    class SurfaceBVH {
+    public:
+      /// Axis aligned bounding box in world coordinates
+      struct Box {
+        double lower[3] ;
+        double upper[3] ;
+      } ;
+      /// Surface with its bounding box
+      struct Item {
+        ISurface* surface ;
+        Box       box ;
+      } ;
+      /// Node of the flattened hierarchy: the left child follows its parent
+      struct Node {
+        Box      box ;
+        /// Index of the first surface of a leaf or the right child of an internal node
+        unsigned first { 0 } ;
+        /// Number of surfaces of a leaf. 0 for internal nodes
+        unsigned count { 0 } ;
+      } ;
+
+    protected:
+      std::vector<Node>      _nodes ;
+      std::vector<Item>      _items ;
+      std::vector<ISurface*> _unbounded ;
+
+      /// Recursive construction of the node tree over _items[first,first+count)
+      unsigned build( unsigned first, unsigned count, unsigned leafSize ) ;
+      /// Visit all surfaces whose box overlaps the segment. Calls func(surface,tmin,tmax)
+      template <typename FUNC> void visit( const Vector3D& start, const Vector3D& end, FUNC func ) const ;
+      /// Visit all surfaces whose box is closer to the point than distance. Calls func(surface)
+      template <typename FUNC> void visit( const Vector3D& point, double distance, FUNC func ) const ;
+
+    public:
+      /// Build the hierarchy. Leaves hold at most leafSize surfaces
+      SurfaceBVH( const std::vector<ISurface*>& surfaces, unsigned leafSize=4 ) ;
+      /// No copy constructor
+      SurfaceBVH( const SurfaceBVH& copy ) = delete ;
+      /// Default destructor
+      ~SurfaceBVH() = default ;
+      /// No assignment operator
+      SurfaceBVH& operator=( const SurfaceBVH& copy ) = delete ;
+
+      /// Number of surfaces in the hierarchy
+      std::size_t size() const { return _items.size() + _unbounded.size() ; }
+      /// Number of nodes of the hierarchy
+      std::size_t numNodes() const { return _nodes.size() ; }
+
+      /// Surfaces whose bounding box overlaps the segment [start,end]
+      std::vector<ISurface*> candidates( const Vector3D& start, const Vector3D& end ) const ;
+
+      /// All crossings of the segment [start,end] with surfaces, ordered by path length
+      std::vector<SurfaceIntersection> intersect( const Vector3D& start, const Vector3D& end, double epsilon=1e-4 ) const ;
+
+      /// All surfaces within maxDistance from the point, whose projection of the point lies within the bounds
+      std::vector<ISurface*> nearby( const Vector3D& point, double maxDistance ) const ;
+
+      /// The surface the point lies on (insideBounds with epsilon), closest if several qualify. 0 if none
+      ISurface* find( const Vector3D& point, double epsilon=1e-4 ) const ;
+
+      /// World bounding box of a surface. Returns false if the surface has no bounding box
+      static bool boundingBox( const ISurface* surface, Box& box ) ;
+
+      /** Crossings of the segment [start,end] with a single surface within the segment
+       *  fraction [tmin,tmax], accepted if the crossing point is within the surface bounds.
+       *  Planes and cylinders are intersected analytically. For other surfaces the segment
+       *  is subdivided where the surface distance does not exclude a crossing, down to
+       *  0.1 mm, and sign changes are refined by bisection. Used by the hierarchy and
+       *  for brute force scans.
+       */
+      static void intersect( ISurface* surface, const Vector3D& start, const Vector3D& end,
+                             double tmin, double tmax, double epsilon,
+                             std::vector<SurfaceIntersection>& crossings ) ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_SURFACEBVH_H
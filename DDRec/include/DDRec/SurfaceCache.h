@@ -0,0 +1,123 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_SURFACECACHE_H
+#define DDREC_SURFACECACHE_H
+
+#include "DDRec/ISurface.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Immutable geometry record of a single surface. All quantities are plain arrays
+     *  without virtual dispatch. The world transformation is stored in the layout of
+     *  TGeoHMatrix: 3x3 rotation (row major) followed by the translation.
+     *
+     * @author M.Frank, CERN
+     * @version 1.0
+     */
+    struct SurfaceRecord {
+      enum Kind   { Generic = 0, Plane = 1, Cylinder = 2 } ;
+      enum Bounds { Shape = 0, Unbounded = 1, Box = 2 } ;
+      /// World transformation: rotation[9] followed by translation[3]
+      double matrix[12] ;
+      /// Origin and normal of the surface in the local frame of the volume
+      double localOrigin[3] ;
+      double localNormal[3] ;
+      /// Global origin, u, v and normal vectors
+      double origin[3] ;
+      double u[3] ;
+      double v[3] ;
+      double normal[3] ;
+      /// Orthogonalized u and v directions and their projections (see Surface::globalToLocal)
+      double uPrime[3] ;
+      double vPrime[3] ;
+      double uuPrime ;
+      double vvPrime ;
+      /// Box bounds in the local frame: origin and half lengths of the volume box
+      double boxOrigin[3] ;
+      double boxHalf[3] ;
+      /// Local radius and phi of the origin (cylinders)
+      double radius ;
+      double phi ;
+      int    kind ;
+      int    bounds ;
+    } ;
+
+    /** Precomputed surface records for fast and batched evaluation of
+     *  distance, globalToLocal, localToGlobal and insideBounds.
+     *
+     *  Planar surfaces (Surface with VolPlaneImpl) and cylinders (CylinderSurface with
+     *  VolCylinderImpl) are evaluated from the records with the formulas of the ISurface
+     *  implementations, but the world transformation is applied directly instead of
+     *  through TGeoHMatrix. distance, globalToLocal and localToGlobal therefore agree
+     *  with the ISurface calls within rounding (about 1e-12 relative to the coordinates),
+     *  and insideBounds of box shaped volumes may differ for points within rounding of the
+     *  bounds or of the distance tolerance. All other surfaces and the bounds of non-box
+     *  shapes fall back to the virtual ISurface calls.
+     *
+     *  The records are immutable: all calls are const and thread safe.
+     *
+     * @author M.Frank, CERN
+     * @version 1.0
+     */
+    class SurfaceCache {
+    protected:
+      std::vector<SurfaceRecord> _records ;
+      std::vector<ISurface*>     _surfaces ;
+
+    public:
+      /// Build the records for the given surfaces
+      SurfaceCache( const std::vector<ISurface*>& surfaces ) ;
+      /// No copy constructor
+      SurfaceCache( const SurfaceCache& copy ) = delete ;
+      /// Default destructor
+      ~SurfaceCache() = default ;
+      /// No assignment operator
+      SurfaceCache& operator=( const SurfaceCache& copy ) = delete ;
+
+      /// Number of surfaces
+      std::size_t size() const { return _records.size() ; }
+      /// Access to the record of a surface
+      const SurfaceRecord& record( std::size_t index ) const { return _records[index] ; }
+      /// Access to the surface
+      ISurface* surface( std::size_t index ) const { return _surfaces[index] ; }
+
+      /// Distance of a point to the surface
+      double distance( std::size_t index, const Vector3D& point ) const ;
+      /// Local (u,v) coordinates of a global point
+      Vector2D globalToLocal( std::size_t index, const Vector3D& point ) const ;
+      /// Global position of local (u,v) coordinates
+      Vector3D localToGlobal( std::size_t index, const Vector2D& point ) const ;
+      /// Check if the point is within the surface bounds
+      bool insideBounds( std::size_t index, const Vector3D& point, double epsilon=1e-4 ) const ;
+
+      /// Batched distance: n points (x,y,z contiguous) against one surface
+      void distance( std::size_t index, const double* points, std::size_t n, double* result ) const ;
+      /// Batched globalToLocal: n points (x,y,z contiguous) to n (u,v) pairs
+      void globalToLocal( std::size_t index, const double* points, std::size_t n, double* result ) const ;
+      /// Batched insideBounds: n points (x,y,z contiguous) against one surface
+      void insideBounds( std::size_t index, const double* points, std::size_t n, unsigned char* result, double epsilon=1e-4 ) const ;
+
+      /// Batched distance: one point against all surfaces. result must hold size() entries
+      void distance( const Vector3D& point, double* result ) const ;
+      /// Batched insideBounds: one point against all surfaces. result must hold size() entries
+      void insideBounds( const Vector3D& point, unsigned char* result, double epsilon=1e-4 ) const ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_SURFACECACHE_H
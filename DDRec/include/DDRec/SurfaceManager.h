@@ -14,9 +14,13 @@
 #define DDREC_SURFACEMANAGER_H
 
 #include "DDRec/ISurface.h"
+#include "DDRec/SurfaceBVH.h"
+#include "DDRec/SurfaceCache.h"
 #include "DD4hep/Detector.h"
 #include <string>
 #include <map>
+#include <mutex>
+#include <memory>
 
 namespace dd4hep {
   namespace rec {
@@ -61,6 +65,18 @@ namespace dd4hep {
        */
       const SurfaceMap* map( const std::string name ) const ;
 
+      /** Get the bounding volume hierarchy over the surfaces of the map with the given name
+       *  for spatial queries. The hierarchy is built at the first call and is shared by all
+       *  clients. Returns 0 if no map exists.
+       */
+      const SurfaceBVH* bvh( const std::string& name ) const ;
+
+      /** Get the precomputed surface records of the map with the given name for fast
+       *  and batched evaluation. The records are built at the first call and are shared
+       *  by all clients. Returns 0 if no map exists.
+       */
+      const SurfaceCache* cache( const std::string& name ) const ;
+
       
       ///create a string with all available maps and their size (number of surfaces)
       std::string toString() const ;
@@ -72,6 +88,13 @@ namespace dd4hep {
       void initialize(const Detector& theDetector) ;
 
       SurfaceMapsMap _map ;
+
+      /// Lazily built bounding volume hierarchies by map name
+      mutable std::map< std::string, std::unique_ptr<SurfaceBVH> > _bvh ;
+      /// Lazily built surface records by map name
+      mutable std::map< std::string, std::unique_ptr<SurfaceCache> > _cache ;
+      /// Protects the lazy construction of _bvh and _cache
+      mutable std::mutex _bvhLock ;
     };
 
   } /* namespace rec */
@@ -0,0 +1,354 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDRec/CellNeighbourIndex.h>
+#include <DDRec/DetectorData.h>
+#include <DD4hep/Printout.h>
+#include <DDSegmentation/CartesianGridXY.h>
+#include <DDSegmentation/GridPhiEta.h>
+#include <DDSegmentation/HexGrid.h>
+#include <DDSegmentation/CylindricalGridPhiZ.h>
+#include <DDSegmentation/PolarGridRPhi2.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+using dd4hep::DDSegmentation::Segmentation;
+
+namespace {
+  /// Add a neighbour to the buffer unless it is the origin or already present
+  inline void append(CellNeighbourIndex::CellID id, CellNeighbourIndex::CellID origin,
+                     CellNeighbourIndex::CellID* buffer, std::size_t capacity, std::size_t& count)  {
+    if ( id == origin ) return;
+    for( std::size_t i = 0, n = std::min(count, capacity); i < n; ++i )
+      if ( buffer[i] == id ) return;
+    if ( count < capacity ) buffer[count] = id;
+    ++count;
+  }
+}
+
+/// Initializing constructor
+CellNeighbourIndex::Field::Field(const DDSegmentation::BitFieldElement& e)
+  : mask(e.mask()), offset(e.offset()), width(e.width()), isSigned(e.isSigned()),
+    minValue(e.minValue()), maxValue(e.maxValue())
+{
+}
+
+/// Initializing constructor. Throws if the segmentation type is not supported
+CellNeighbourIndex::CellNeighbourIndex(const Segmentation& segmentation,
+                                       const std::string& layer_field,
+                                       bool diagonal)
+  : m_typeName(segmentation.type()), m_diagonal(diagonal)
+{
+  namespace seg = DDSegmentation;
+  const seg::BitFieldCoder* decoder = segmentation.decoder();
+  auto field = [decoder](const std::string& nam)  {  return Field((*decoder)[nam]);  };
+  const Offset edges[] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
+  const Offset diags[] = { {-1,-1}, {-1,1}, {1,-1}, {1,1} };
+  int stagger = 0;
+
+  for( const auto& f : decoder->fields() )  {
+    if ( f.name() == layer_field )  {
+      m_layer = Field(f);
+      break;
+    }
+  }
+  if ( const auto* s = dynamic_cast<const seg::CartesianGridXY*>(&segmentation) )  {
+    m_type = CARTESIAN;
+    m_u = field(s->fieldNameX());
+    m_v = field(s->fieldNameY());
+  }
+  else if ( const auto* s = dynamic_cast<const seg::GridPhiEta*>(&segmentation) )  {
+    double width = 2e0 * M_PI / double(s->phiBins());
+    double first = (-M_PI - s->offsetPhi()) / width + 0.5;
+    m_type        = PHI_ETA;
+    m_u           = field(s->fieldNameEta());
+    m_v           = field(s->fieldNamePhi());
+    m_period      = s->phiBins();
+    m_periodMin   = long(std::floor(first));
+    m_periodAlias = std::abs(first - std::round(first)) > 1e-9;
+  }
+  else if ( const auto* s = dynamic_cast<const seg::CylindricalGridPhiZ*>(&segmentation) )  {
+    double bins = 2e0 * M_PI / s->gridSizePhi();
+    m_type = PHI_Z;
+    m_u    = field(s->fieldNameZ());
+    m_v    = field(s->fieldNamePhi());
+    // Phi starts at the offset, which is the center of bin 0
+    if ( std::abs(bins - std::round(bins)) < 1e-6 )  {
+      m_period      = long(std::round(bins));
+      m_periodMin   = 0;
+      m_periodAlias = true;
+    }
+  }
+  else if ( const auto* s = dynamic_cast<const seg::HexGrid*>(&segmentation) )  {
+    m_type = HEXAGONAL;
+    m_u    = field(s->fieldNameX());
+    m_v    = field(s->fieldNameY());
+    if ( s->stagger() > 0 && m_layer.valid() &&
+         decoder->index(s->staggerKeyword()) == decoder->index(layer_field) )  {
+      stagger = s->stagger();
+    }
+  }
+  else if ( const auto* s = dynamic_cast<const seg::PolarGridRPhi2*>(&segmentation) )  {
+    m_type = POLAR;
+    m_u    = field(s->fieldNameR());
+    m_v    = field(s->fieldNamePhi());
+  }
+  else  {
+    except("CellNeighbourIndex","+++ Segmentation type %s is not supported.", m_typeName.c_str());
+  }
+
+  // Same layer stencils
+  if ( m_type == HEXAGONAL )  {
+    m_same = { {0,-2}, {0,2}, {-1,-1}, {-1,1}, {1,-1}, {1,1} };
+  }
+  else if ( m_type == POLAR )  {
+    const auto* s = dynamic_cast<const seg::PolarGridRPhi2*>(&segmentation);
+    m_same = { {0,-1}, {0,1} };
+    buildPolar(s->gridRValues(), s->gridPhiValues());
+  }
+  else  {
+    m_same.assign(std::begin(edges), std::end(edges));
+    if ( m_diagonal ) m_same.insert(m_same.end(), std::begin(diags), std::end(diags));
+  }
+
+  // Cross layer stencils
+  if ( m_layer.valid() )  {
+    m_cross.assign(4, std::vector<Offset>(1, Offset{0,0}));
+    if ( stagger > 0 ) buildStaggered(segmentation, stagger);
+  }
+
+  // Upper limit of the number of neighbours
+  std::size_t num_same = m_same.size() + (m_periodAlias ? 4 : 0);
+  for( std::size_t i = 0; i + 1 < m_overlapIndex.size(); ++i )
+    num_same = std::max(num_same, m_same.size() + m_overlapIndex[i+1] - m_overlapIndex[i]);
+  std::size_t num_cross = 0;
+  for( const auto& c : m_cross )
+    num_cross = std::max(num_cross, c.size());
+  m_maxNeighbours = num_same + 2 * num_cross * (m_diagonal ? 1 + num_same : 1);
+}
+
+/// Copy constructor for DetElement extensions
+CellNeighbourIndex::CellNeighbourIndex(const CellNeighbourIndex& copy, DetElement)
+  : CellNeighbourIndex(copy)
+{
+}
+
+/// Fill the tables of polar grids
+void CellNeighbourIndex::buildPolar(const std::vector<double>& r_values, const std::vector<double>& phi_values)   {
+  const double eps = 1e-9, two_pi = 2e0 * M_PI;
+  std::size_t num_rings = r_values.size() > 1 ? r_values.size() - 1 : 0;
+  if ( num_rings == 0 || phi_values.size() < num_rings )  {
+    except("CellNeighbourIndex","+++ Inconsistent PolarGridRPhi2 binning: %ld r boundaries, %ld phi bin sizes.",
+           long(r_values.size()), long(phi_values.size()));
+  }
+  // The bins of every ring cover the full circle. The last bin may be narrower.
+  m_ringBins.resize(num_rings);
+  m_ringStart.assign(1, 0);
+  for( std::size_t i = 0; i < num_rings; ++i )  {
+    m_ringBins[i] = int(std::ceil(two_pi / phi_values[i] - eps));
+    m_ringStart.push_back(m_ringStart.back() + m_ringBins[i]);
+  }
+  m_overlapIndex.reserve(m_ringStart.back() + 1);
+  m_overlapIndex.push_back(0);
+  for( std::size_t i = 0; i < num_rings; ++i )  {
+    const double width = phi_values[i];
+    for( int k = 0; k < m_ringBins[i]; ++k )  {
+      const double lo = k * width, hi = std::min((k + 1) * width, two_pi);
+      const std::size_t row = m_overlaps.size();
+      for( int dr = -1; dr <= 1; dr += 2 )  {
+        long j = long(i) + dr;
+        if ( j < 0 || j >= long(num_rings) ) continue;
+        const double w = phi_values[j];
+        long first, last;
+        if ( m_diagonal )  {
+          first = long(std::floor(lo / w - eps));
+          last  = long(std::floor(hi / w + eps));
+          if ( hi > two_pi - eps ) last = std::max(last, long(m_ringBins[j]));
+        }
+        else  {
+          first = long(std::floor(lo / w + eps));
+          last  = long(std::ceil(hi / w - eps)) - 1;
+        }
+        for( long b = first; b <= last; ++b )  {
+          Offset o { dr, int(wrap(b, m_ringBins[j], 0)) };
+          auto beg = m_overlaps.begin() + row;
+          if ( std::find_if(beg, m_overlaps.end(), [&o](const Offset& q)
+                            { return q.du == o.du && q.dv == o.dv; }) == m_overlaps.end() )  {
+            m_overlaps.push_back(o);
+          }
+        }
+      }
+      m_overlapIndex.push_back(uint32_t(m_overlaps.size()));
+    }
+  }
+}
+
+/// Fill the cross layer stencils of staggered hexagonal grids
+void CellNeighbourIndex::buildStaggered(const Segmentation& segmentation, int stagger)   {
+  const auto* hex  = dynamic_cast<const DDSegmentation::HexGrid*>(&segmentation);
+  const double side = hex->sideLength();
+  const int period = stagger == 1 ? 3 : 4;
+  // Reference cell near the origin with valid indices: (ix + iy) even
+  long ix = std::max(m_u.minValue + 2, std::min(0L, m_u.maxValue - 2));
+  long iy = std::max(m_v.minValue + 2, std::min(0L, m_v.maxValue - 2));
+  iy -= (ix + iy) & 1;
+
+  // Sample points inside the cell: center, near the corners and near the edge centers
+  std::vector<std::pair<double,double> > samples(1, {0e0, 0e0});
+  for( int k = 0; k < 6; ++k )  {
+    double a = k * M_PI / 3e0;
+    samples.emplace_back(0.9 * side * std::cos(a), 0.9 * side * std::sin(a));
+    a += M_PI / 6e0;
+    samples.emplace_back(0.9 * side * std::sqrt(3e0)/2e0 * std::cos(a), 0.9 * side * std::sqrt(3e0)/2e0 * std::sin(a));
+  }
+  m_classes = period;
+  m_cross.assign(4 * period, std::vector<Offset>());
+  for( int cls = 0; cls < 2 * period; ++cls )  {
+    // Reference layer of the class away from 0, so that both adjacent layers have the same sign
+    long layer = cls < period ? cls - (period - 1) - period : cls;
+    CellID ref = 0;
+    if ( !m_layer.set(ref, layer) || !m_u.set(ref, ix) || !m_v.set(ref, iy) ) continue;
+    auto center = segmentation.position(ref);
+    for( int next = 0; next < 2; ++next )  {
+      CellID adjacent = ref;
+      if ( !m_layer.set(adjacent, layer + (next ? 1 : -1)) ) continue;
+      std::vector<Offset>& stencil = m_cross[2 * cls + next];
+      for( const auto& s : samples )  {
+        DDSegmentation::Vector3D pos(center.X + s.first, center.Y + s.second, center.Z);
+        CellID id;
+        try  {
+          id = segmentation.cellID(pos, pos, adjacent);
+        }
+        catch(const std::exception&)  {
+          continue;
+        }
+        Offset o { int(m_u.get(id) - ix), int(m_v.get(id) - iy) };
+        if ( std::find_if(stencil.begin(), stencil.end(), [&o](const Offset& q)
+                          { return q.du == o.du && q.dv == o.dv; }) == stencil.end() )  {
+          stencil.push_back(o);
+        }
+      }
+    }
+  }
+}
+
+/// Add the cell with indices (u,v) to the buffer. Wraps a periodic second index
+void CellNeighbourIndex::add(CellID base, long u, long v, CellID origin, CellID* buffer, std::size_t capacity, std::size_t& count)  const  {
+  CellID id = base;
+  if ( m_period > 0 ) v = wrap(v, m_period, m_periodMin);
+  if ( !m_u.set(id, u) || !m_v.set(id, v) ) return;
+  append(id, origin, buffer, capacity, count);
+  if ( m_periodAlias && v == m_periodMin && m_v.set(id, v + m_period) )
+    append(id, origin, buffer, capacity, count);
+}
+
+/// Add the same layer neighbours of a cell to the buffer
+void CellNeighbourIndex::sameLayer(CellID cell, CellID origin, CellID* buffer, std::size_t capacity, std::size_t& count)  const  {
+  const long u = m_u.get(cell), v = m_v.get(cell);
+  if ( m_type == POLAR )  {
+    if ( u < 0 || u >= long(m_ringBins.size()) ) return;
+    const long bins = m_ringBins[u];
+    if ( v < 0 || v >= bins ) return;
+    CellID id;
+    for( const Offset& o : m_same )  {
+      id = cell;
+      if ( m_v.set(id, wrap(v + o.dv, bins, 0)) ) append(id, origin, buffer, capacity, count);
+    }
+    const std::size_t idx = m_ringStart[u] + v;
+    for( uint32_t i = m_overlapIndex[idx]; i < m_overlapIndex[idx+1]; ++i )  {
+      id = cell;
+      if ( m_u.set(id, u + m_overlaps[i].du) && m_v.set(id, m_overlaps[i].dv) )
+        append(id, origin, buffer, capacity, count);
+    }
+    return;
+  }
+  // The other half of a split cell
+  if ( m_periodAlias ) add(cell, u, v, origin, buffer, capacity, count);
+  for( const Offset& o : m_same )
+    add(cell, u + o.du, v + o.dv, origin, buffer, capacity, count);
+}
+
+/// Fill the neighbours of a cell into the buffer
+std::size_t CellNeighbourIndex::neighbours(CellID cell, CellID* buffer, std::size_t capacity, int selection)  const  {
+  std::size_t count = 0;
+  if ( selection & SAME_LAYER )  {
+    sameLayer(cell, cell, buffer, capacity, count);
+  }
+  if ( m_layer.valid() && (selection & (PREV_LAYER|NEXT_LAYER)) )  {
+    const long layer = m_layer.get(cell);
+    const long cls   = layerClass(layer);
+    const long u = m_u.get(cell), v = m_v.get(cell);
+    for( int next = 0; next < 2; ++next )  {
+      CellID adjacent = cell;
+      if ( !(selection & (next ? NEXT_LAYER : PREV_LAYER)) ) continue;
+      if ( !m_layer.set(adjacent, layer + (next ? 1 : -1)) ) continue;
+      for( const Offset& o : m_cross[2 * cls + next] )  {
+        CellID id = adjacent;
+        if ( !m_u.set(id, u + o.du) || !m_v.set(id, v + o.dv) ) continue;
+        append(id, cell, buffer, capacity, count);
+        if ( m_diagonal ) sameLayer(id, cell, buffer, capacity, count);
+      }
+    }
+  }
+  return count;
+}
+
+/// Initializing constructor
+NeighbourSurfacesIndex::NeighbourSurfacesIndex(const NeighbourSurfacesStruct& data)   {
+  const std::map<CellID, std::vector<CellID> >* maps[3] = { &data.sameLayer, &data.prevLayer, &data.nextLayer };
+  std::size_t num_neighbours = 0;
+  for( const auto* m : maps )  {
+    for( const auto& e : *m )  {
+      m_cells.push_back(e.first);
+      num_neighbours += e.second.size();
+    }
+  }
+  std::sort(m_cells.begin(), m_cells.end());
+  m_cells.erase(std::unique(m_cells.begin(), m_cells.end()), m_cells.end());
+  m_offsets.reserve(3 * m_cells.size() + 1);
+  m_offsets.push_back(0);
+  m_neighbours.reserve(num_neighbours);
+  for( CellID cell : m_cells )  {
+    for( const auto* m : maps )  {
+      auto i = m->find(cell);
+      if ( i != m->end() ) m_neighbours.insert(m_neighbours.end(), i->second.begin(), i->second.end());
+      m_offsets.push_back(uint32_t(m_neighbours.size()));
+    }
+  }
+}
+
+/// Copy constructor for DetElement extensions
+NeighbourSurfacesIndex::NeighbourSurfacesIndex(const NeighbourSurfacesIndex& copy, DetElement)
+  : NeighbourSurfacesIndex(copy)
+{
+}
+
+/// Fill the neighbours of a cell into the buffer
+std::size_t NeighbourSurfacesIndex::neighbours(CellID cell, CellID* buffer, std::size_t capacity, int selection)  const  {
+  auto i = std::lower_bound(m_cells.begin(), m_cells.end(), cell);
+  if ( i == m_cells.end() || *i != cell ) return 0;
+  const std::size_t row = 3 * (i - m_cells.begin());
+  std::size_t count = 0;
+  for( int k = 0; k < 3; ++k )  {
+    if ( !(selection & (1 << k)) ) continue;
+    for( uint32_t j = m_offsets[row+k]; j < m_offsets[row+k+1]; ++j, ++count )
+      if ( count < capacity ) buffer[count] = m_neighbours[j];
+  }
+  return count;
+}
@@ -0,0 +1,306 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDRec/MaterialLayerMap.h>
+#include <DDRec/MaterialScanEngine.h>
+#include <DD4hep/Printout.h>
+
+// C/C++ include files
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+namespace {
+  /// Format tag of the material layer map files
+  const char* s_layerMapTag = "DD4hep_MaterialLayerMap";
+  /// Format version of the material layer map files
+  const int   s_layerMapVersion = 1;
+
+  /// Add the roots t in (0,1) of rho(p0 + t*d) = radius
+  void radial_crossings(const Vector3D& p0, const Vector3D& d, double radius, std::vector<double>& t)   {
+    double a = d.x()*d.x() + d.y()*d.y();
+    if ( a <= 0e0 ) return;
+    double b = 2e0 * (p0.x()*d.x() + p0.y()*d.y());
+    double c = p0.x()*p0.x() + p0.y()*p0.y() - radius*radius;
+    double disc = b*b - 4e0*a*c;
+    if ( disc < 0e0 ) return;
+    double sq = std::sqrt(disc);
+    for ( double r : { (-b - sq) / (2e0*a), (-b + sq) / (2e0*a) } )
+      if ( r > 0e0 && r < 1e0 ) t.emplace_back(r);
+  }
+
+  /// Add the root t in (0,1) of z(p0 + t*d) = z
+  void z_crossing(const Vector3D& p0, const Vector3D& d, double z, std::vector<double>& t)   {
+    if ( d.z() == 0e0 ) return;
+    double r = (z - p0.z()) / d.z();
+    if ( r > 0e0 && r < 1e0 ) t.emplace_back(r);
+  }
+}
+
+/// Position of the center of a bin on the layer mid surface
+Vector3D MaterialLayerMap::Layer::center(int ibin, int iphi)  const   {
+  double phi = -M_PI + (iphi + 0.5) * 2e0 * M_PI / nPhi;
+  if ( type == CYLINDER )  {
+    double r = 0.5 * (rMin + rMax);
+    double z = zMin + (ibin + 0.5) * (zMax - zMin) / nBins;
+    return Vector3D(r * std::cos(phi), r * std::sin(phi), z);
+  }
+  double r = rMin + (ibin + 0.5) * (rMax - rMin) / nBins;
+  return Vector3D(r * std::cos(phi), r * std::sin(phi), 0.5 * (zMin + zMax));
+}
+
+/// Straight crossing of the layer along its normal at the center of a bin
+std::pair<Vector3D, Vector3D> MaterialLayerMap::Layer::crossing(int ibin, int iphi)  const   {
+  Vector3D c = center(ibin, iphi);
+  if ( type == CYLINDER )  {
+    double cos_p = std::cos(c.phi()), sin_p = std::sin(c.phi());
+    return std::make_pair(Vector3D(rMin * cos_p, rMin * sin_p, c.z()), Vector3D(rMax * cos_p, rMax * sin_p, c.z()));
+  }
+  return std::make_pair(Vector3D(c.x(), c.y(), zMin), Vector3D(c.x(), c.y(), zMax));
+}
+
+/// Check if the point is inside the layer
+bool MaterialLayerMap::Layer::contains(const Vector3D& point)  const   {
+  double r = point.rho();
+  return r >= rMin && r <= rMax && point.z() >= zMin && point.z() <= zMax;
+}
+
+/// Add a new layer
+std::size_t MaterialLayerMap::add(Layer&& layer)   {
+  if ( layer.name.empty() || layer.name.find_first_of(" \t\n") != std::string::npos )  {
+    except("MaterialLayerMap","+++ Invalid layer name: '%s'", layer.name.c_str());
+  }
+  if ( index(layer.name) >= 0 )  {
+    except("MaterialLayerMap","+++ Layer %s is already present.", layer.name.c_str());
+  }
+  if ( layer.nBins <= 0 || layer.nPhi <= 0 || layer.rMin < 0e0 ||
+       !(layer.rMax > layer.rMin) || !(layer.zMax > layer.zMin) )  {
+    except("MaterialLayerMap","+++ Layer %s: Invalid dimensions: r: [%g,%g] z: [%g,%g] bins: %d x %d",
+           layer.name.c_str(), layer.rMin, layer.rMax, layer.zMin, layer.zMax, layer.nBins, layer.nPhi);
+  }
+  layer.bins.resize(std::size_t(layer.nBins) * std::size_t(layer.nPhi));
+  m_layers.emplace_back(std::move(layer));
+  return m_layers.size() - 1;
+}
+
+/// Add a cylindrical layer binned in z and phi
+std::size_t MaterialLayerMap::addCylinder(const std::string& name, double rMin, double rMax,
+                                          double zMin, double zMax, int nZ, int nPhi)   {
+  Layer l;
+  l.name  = name;
+  l.type  = CYLINDER;
+  l.rMin  = rMin;
+  l.rMax  = rMax;
+  l.zMin  = zMin;
+  l.zMax  = zMax;
+  l.nBins = nZ;
+  l.nPhi  = nPhi;
+  return add(std::move(l));
+}
+
+/// Add a disc shaped layer binned in r and phi
+std::size_t MaterialLayerMap::addDisc(const std::string& name, double zMin, double zMax,
+                                      double rMin, double rMax, int nR, int nPhi)   {
+  Layer l;
+  l.name  = name;
+  l.type  = DISC;
+  l.rMin  = rMin;
+  l.rMax  = rMax;
+  l.zMin  = zMin;
+  l.zMax  = zMax;
+  l.nBins = nR;
+  l.nPhi  = nPhi;
+  return add(std::move(l));
+}
+
+/// Fill the bins of all layers with the material scan engine
+void MaterialLayerMap::build(const MaterialScanEngine& engine)   {
+  std::vector<std::pair<Vector3D, Vector3D> > rays;
+  for ( const auto& l : m_layers )
+    for ( int ibin = 0; ibin < l.nBins; ++ibin )
+      for ( int iphi = 0; iphi < l.nPhi; ++iphi )
+        rays.emplace_back(l.crossing(ibin, iphi));
+
+  std::vector<MaterialBudget> budgets = engine.scan(rays);
+  auto b = budgets.begin();
+  for ( auto& l : m_layers )
+    for ( auto& bin : l.bins )
+      bin = *b++;
+}
+
+/// Index of a layer by name. -1 if not present
+int MaterialLayerMap::index(const std::string& name)  const   {
+  for ( std::size_t i = 0; i < m_layers.size(); ++i )
+    if ( m_layers[i].name == name ) return int(i);
+  return -1;
+}
+
+/// Interpolated budget of the normal crossing of a layer at the given position
+MaterialBudget MaterialLayerMap::budget(std::size_t index, const Vector3D& point)  const   {
+  const Layer& l = m_layers.at(index);
+  double u_min = l.type == CYLINDER ? l.zMin : l.rMin;
+  double u_max = l.type == CYLINDER ? l.zMax : l.rMax;
+  double u     = l.type == CYLINDER ? point.z() : point.rho();
+
+  // Fractional bin coordinates relative to the bin centers
+  double fu = std::min(std::max((u - u_min) / (u_max - u_min) * l.nBins - 0.5, 0e0), double(l.nBins - 1));
+  double fp = (point.phi() + M_PI) / (2e0 * M_PI) * l.nPhi - 0.5;
+  if ( fp < 0e0 ) fp += l.nPhi;
+  int    iu0 = std::min(int(fu), l.nBins - 1), iu1 = std::min(iu0 + 1, l.nBins - 1);
+  int    ip0 = int(fp) % l.nPhi,               ip1 = (ip0 + 1) % l.nPhi;
+  double tu  = fu - iu0, tp = fp - std::floor(fp);
+
+  MaterialBudget result;
+  const std::pair<int, double> corners[4] = {
+    { iu0 * l.nPhi + ip0, (1e0 - tu) * (1e0 - tp) },
+    { iu0 * l.nPhi + ip1, (1e0 - tu) * tp },
+    { iu1 * l.nPhi + ip0, tu * (1e0 - tp) },
+    { iu1 * l.nPhi + ip1, tu * tp } };
+  for ( const auto& c : corners )  {
+    if ( c.second > 0e0 )  {
+      MaterialBudget b = l.bins[c.first];
+      b *= c.second;
+      result += b;
+    }
+  }
+  return result;
+}
+
+/// Material budget of all layers crossed by the straight line between p0 and p1
+MaterialBudget MaterialLayerMap::budgetBetween(const Vector3D& p0, const Vector3D& p1)  const   {
+  MaterialBudget result;
+  Vector3D d   = p1 - p0;
+  double   len = d.r();
+  if ( len <= 0e0 ) return result;
+
+  std::vector<double> t;
+  for ( std::size_t i = 0; i < m_layers.size(); ++i )  {
+    const Layer& l = m_layers[i];
+    // Split the segment at the layer boundaries and add the pieces inside the layer
+    t.assign({ 0e0, 1e0 });
+    radial_crossings(p0, d, l.rMin, t);
+    radial_crossings(p0, d, l.rMax, t);
+    z_crossing(p0, d, l.zMin, t);
+    z_crossing(p0, d, l.zMax, t);
+    std::sort(t.begin(), t.end());
+    for ( std::size_t j = 1; j < t.size(); ++j )  {
+      if ( !(t[j] > t[j-1]) ) continue;
+      Vector3D mid = p0 + (0.5 * (t[j] + t[j-1])) * d;
+      if ( !l.contains(mid) ) continue;
+      MaterialBudget b = budget(i, mid);
+      b *= (t[j] - t[j-1]) * len / l.thickness();
+      result += b;
+    }
+  }
+  return result;
+}
+
+/// Averaged material of all layers crossed by the straight line between p0 and p1
+MaterialData MaterialLayerMap::materialBetween(const Vector3D& p0, const Vector3D& p1)  const   {
+  return budgetBetween(p0, p1).average();
+}
+
+/// Check if two maps have identical layers and contents
+bool MaterialLayerMap::operator==(const MaterialLayerMap& other)  const   {
+  if ( m_layers.size() != other.m_layers.size() ) return false;
+  for ( std::size_t i = 0; i < m_layers.size(); ++i )  {
+    const Layer& a = m_layers[i], &b = other.m_layers[i];
+    if ( a.name != b.name || a.type != b.type || a.rMin != b.rMin || a.rMax != b.rMax ||
+         a.zMin != b.zMin || a.zMax != b.zMax || a.nBins != b.nBins || a.nPhi != b.nPhi ||
+         a.bins != b.bins )
+      return false;
+  }
+  return true;
+}
+
+/// Store the map to a text file
+void MaterialLayerMap::write(const std::string& file_name)  const   {
+  std::ofstream out(file_name);
+  if ( !out.good() )  {
+    except("MaterialLayerMap","+++ Failed to open material map file %s for writing.", file_name.c_str());
+  }
+  out << std::setprecision(17)
+      << "# " << s_layerMapTag << " " << s_layerMapVersion << "\n"
+      << "# layer name type(1:cylinder 2:disc) rMin rMax zMin zMax nBins nPhi\n"
+      << "# iBin iPhi length x0 lambda rho_l rho_l_over_A rho_l_Z_over_A\n";
+  for ( const auto& l : m_layers )  {
+    out << "layer " << l.name << " " << l.type << " " << l.rMin << " " << l.rMax << " "
+        << l.zMin << " " << l.zMax << " " << l.nBins << " " << l.nPhi << "\n";
+    for ( int ibin = 0; ibin < l.nBins; ++ibin )  {
+      for ( int iphi = 0; iphi < l.nPhi; ++iphi )  {
+        const MaterialBudget& b = l.bins[ibin * l.nPhi + iphi];
+        out << ibin << " " << iphi << " " << b.length << " " << b.x0 << " " << b.lambda << " "
+            << b.rho_l << " " << b.rho_l_over_A << " " << b.rho_l_Z_over_A << "\n";
+      }
+    }
+  }
+  if ( !out.good() )  {
+    except("MaterialLayerMap","+++ Failed to write material map file %s.", file_name.c_str());
+  }
+}
+
+/// Restore a map from a text file written by write()
+std::unique_ptr<MaterialLayerMap> MaterialLayerMap::read(const std::string& file_name)   {
+  std::ifstream in(file_name);
+  if ( !in.good() )  {
+    except("MaterialLayerMap","+++ Failed to open material map file %s.", file_name.c_str());
+  }
+  std::string line, tag;
+  int version = 0;
+  std::getline(in, line);
+  std::stringstream header(line);
+  header >> tag >> tag >> version;
+  if ( tag != s_layerMapTag || version != s_layerMapVersion )  {
+    except("MaterialLayerMap","+++ %s is no material layer map file of version %d.",
+           file_name.c_str(), s_layerMapVersion);
+  }
+  std::unique_ptr<MaterialLayerMap> map(new MaterialLayerMap());
+  Layer* layer = nullptr;
+  std::size_t num_bins = 0;
+  auto check_complete = [&]()  {
+    if ( layer && num_bins != layer->bins.size() )  {
+      except("MaterialLayerMap","+++ %s: Incomplete layer %s: %ld bins out of %ld.",
+             file_name.c_str(), layer->name.c_str(), long(num_bins), long(layer->bins.size()));
+    }
+  };
+  while ( std::getline(in, line) )  {
+    if ( line.empty() || line[0] == '#' ) continue;
+    std::stringstream str(line);
+    if ( line.compare(0, 6, "layer ") == 0 )  {
+      check_complete();
+      Layer l;
+      str >> tag >> l.name >> l.type >> l.rMin >> l.rMax >> l.zMin >> l.zMax >> l.nBins >> l.nPhi;
+      if ( str.fail() || (l.type != CYLINDER && l.type != DISC) )  {
+        except("MaterialLayerMap","+++ %s: Invalid layer definition: %s", file_name.c_str(), line.c_str());
+      }
+      layer    = &map->m_layers[map->add(std::move(l))];
+      num_bins = 0;
+      continue;
+    }
+    int ibin = -1, iphi = -1;
+    MaterialBudget b;
+    str >> ibin >> iphi >> b.length >> b.x0 >> b.lambda >> b.rho_l >> b.rho_l_over_A >> b.rho_l_Z_over_A;
+    if ( !layer || str.fail() || ibin < 0 || ibin >= layer->nBins || iphi < 0 || iphi >= layer->nPhi )  {
+      except("MaterialLayerMap","+++ %s: Invalid bin entry: %s", file_name.c_str(), line.c_str());
+    }
+    layer->bins[ibin * layer->nPhi + iphi] = b;
+    ++num_bins;
+  }
+  check_complete();
+  return map;
+}
@@ -0,0 +1,209 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDRec/MaterialMap.h>
+#include <DD4hep/Printout.h>
+
+// C/C++ include files
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+namespace {
+  /// Format tag of the material map files
+  const char* s_mapTag = "DD4hep_MaterialMap";
+  /// Format version of the material map files
+  const int   s_mapVersion = 1;
+}
+
+/// Add the budget of another path
+MaterialBudget& MaterialBudget::operator+=(const MaterialBudget& copy)   {
+  length         += copy.length;
+  x0             += copy.x0;
+  lambda         += copy.lambda;
+  rho_l          += copy.rho_l;
+  rho_l_over_A   += copy.rho_l_over_A;
+  rho_l_Z_over_A += copy.rho_l_Z_over_A;
+  return *this;
+}
+
+/// Scale all sums (e.g. to the mean of several rays)
+MaterialBudget& MaterialBudget::operator*=(double factor)   {
+  length         *= factor;
+  x0             *= factor;
+  lambda         *= factor;
+  rho_l          *= factor;
+  rho_l_over_A   *= factor;
+  rho_l_Z_over_A *= factor;
+  return *this;
+}
+
+/// Averaged material of the path
+MaterialData MaterialBudget::average()  const   {
+  if ( length > 0e0 && rho_l_over_A > 0e0 )  {
+    return MaterialData("averaged",
+                        rho_l_Z_over_A / rho_l_over_A,
+                        rho_l / rho_l_over_A,
+                        rho_l / length,
+                        x0     > 0e0 ? length / x0     : std::numeric_limits<double>::max(),
+                        lambda > 0e0 ? length / lambda : std::numeric_limits<double>::max());
+  }
+  return MaterialData();
+}
+
+/// Exact comparison of all sums
+bool MaterialBudget::operator==(const MaterialBudget& other)  const   {
+  return length == other.length && x0 == other.x0 && lambda == other.lambda && rho_l == other.rho_l &&
+    rho_l_over_A == other.rho_l_over_A && rho_l_Z_over_A == other.rho_l_Z_over_A;
+}
+
+/// Initializing constructor
+MaterialMap::MaterialMap(const Grid& grid) : m_grid(grid)   {
+  if ( m_grid.nEta <= 0 || m_grid.nPhi <= 0 || !(m_grid.etaMax > m_grid.etaMin) || !(m_grid.phiMax > m_grid.phiMin) )  {
+    except("MaterialMap","+++ Invalid binning: eta: %d [%g,%g] phi: %d [%g,%g]",
+           m_grid.nEta, m_grid.etaMin, m_grid.etaMax, m_grid.nPhi, m_grid.phiMin, m_grid.phiMax);
+  }
+  m_bins.resize(std::size_t(m_grid.nEta) * std::size_t(m_grid.nPhi));
+}
+
+/// Eta bin number of a pseudorapidity value. -1 if outside
+int MaterialMap::etaBin(double eta)  const   {
+  if ( eta < m_grid.etaMin || eta >= m_grid.etaMax ) return -1;
+  int i = int((eta - m_grid.etaMin) / (m_grid.etaMax - m_grid.etaMin) * m_grid.nEta);
+  return std::min(i, m_grid.nEta-1);
+}
+
+/// Phi bin number of an azimuth. -1 if outside. phiMax belongs to the last bin
+int MaterialMap::phiBin(double phi)  const   {
+  // The default range is [-pi,pi] and atan2 returns +pi: the upper edge is inside
+  if ( phi < m_grid.phiMin || phi > m_grid.phiMax ) return -1;
+  int i = int((phi - m_grid.phiMin) / (m_grid.phiMax - m_grid.phiMin) * m_grid.nPhi);
+  return std::min(i, m_grid.nPhi-1);
+}
+
+/// Pseudorapidity of the bin center
+double MaterialMap::etaCenter(int ieta)  const   {
+  return m_grid.etaMin + (ieta + 0.5) * (m_grid.etaMax - m_grid.etaMin) / m_grid.nEta;
+}
+
+/// Azimuth of the bin center
+double MaterialMap::phiCenter(int iphi)  const   {
+  return m_grid.phiMin + (iphi + 0.5) * (m_grid.phiMax - m_grid.phiMin) / m_grid.nPhi;
+}
+
+/// Bin content for a given direction. 0 if outside the map
+const MaterialBudget* MaterialMap::find(double eta, double phi)  const   {
+  int ieta = etaBin(eta), iphi = phiBin(phi);
+  return ieta < 0 || iphi < 0 ? nullptr : &bin(ieta, iphi);
+}
+
+/// Bin content for a given direction from the scan origin. 0 if outside the map
+const MaterialBudget* MaterialMap::find(const Vector3D& direction)  const   {
+  if ( direction.rho() == 0e0 ) return nullptr;
+  return find(-std::log(std::tan(0.5*direction.theta())), direction.phi());
+}
+
+/// Check if two maps have identical binning and contents
+bool MaterialMap::operator==(const MaterialMap& other)  const   {
+  const Grid& g = other.m_grid;
+  if ( g.nEta != m_grid.nEta || g.etaMin != m_grid.etaMin || g.etaMax != m_grid.etaMax ||
+       g.nPhi != m_grid.nPhi || g.phiMin != m_grid.phiMin || g.phiMax != m_grid.phiMax ||
+       g.rMax != m_grid.rMax || g.zMax   != m_grid.zMax   || !(g.origin == m_grid.origin) ||
+       g.nSub != m_grid.nSub )
+    return false;
+  return m_bins == other.m_bins;
+}
+
+/// Store the map to a text file
+void MaterialMap::write(const std::string& file_name)  const   {
+  std::ofstream out(file_name);
+  if ( !out.good() )  {
+    except("MaterialMap","+++ Failed to open material map file %s for writing.", file_name.c_str());
+  }
+  const Grid& g = m_grid;
+  out << std::setprecision(17)
+      << "# " << s_mapTag << " " << s_mapVersion << "\n"
+      << "# nEta etaMin etaMax nPhi phiMin phiMax rMax zMax origin(x y z) nSub\n"
+      << g.nEta << " " << g.etaMin << " " << g.etaMax << " "
+      << g.nPhi << " " << g.phiMin << " " << g.phiMax << " "
+      << g.rMax << " " << g.zMax   << " "
+      << g.origin.x() << " " << g.origin.y() << " " << g.origin.z() << " "
+      << g.nSub << "\n"
+      << "# iEta iPhi length x0 lambda rho_l rho_l_over_A rho_l_Z_over_A\n";
+  for ( int ieta = 0; ieta < g.nEta; ++ieta )  {
+    for ( int iphi = 0; iphi < g.nPhi; ++iphi )  {
+      const MaterialBudget& b = bin(ieta, iphi);
+      out << ieta << " " << iphi << " " << b.length << " " << b.x0 << " " << b.lambda << " "
+          << b.rho_l << " " << b.rho_l_over_A << " " << b.rho_l_Z_over_A << "\n";
+    }
+  }
+  if ( !out.good() )  {
+    except("MaterialMap","+++ Failed to write material map file %s.", file_name.c_str());
+  }
+}
+
+/// Restore a map from a text file written by write()
+std::unique_ptr<MaterialMap> MaterialMap::read(const std::string& file_name)   {
+  std::ifstream in(file_name);
+  if ( !in.good() )  {
+    except("MaterialMap","+++ Failed to open material map file %s.", file_name.c_str());
+  }
+  std::string line, tag;
+  int version = 0;
+  std::getline(in, line);
+  std::stringstream header(line);
+  header >> tag >> tag >> version;
+  if ( tag != s_mapTag || version != s_mapVersion )  {
+    except("MaterialMap","+++ %s is no material map file of version %d.", file_name.c_str(), s_mapVersion);
+  }
+  auto next_line = [&in, &line]()  {
+    while ( std::getline(in, line) )
+      if ( !line.empty() && line[0] != '#' ) return true;
+    return false;
+  };
+  Grid g;
+  double ox = 0e0, oy = 0e0, oz = 0e0;
+  if ( next_line() )  {
+    std::stringstream str(line);
+    str >> g.nEta >> g.etaMin >> g.etaMax >> g.nPhi >> g.phiMin >> g.phiMax
+        >> g.rMax >> g.zMax >> ox >> oy >> oz >> g.nSub;
+    if ( str.fail() )  {
+      except("MaterialMap","+++ %s: Invalid grid definition: %s", file_name.c_str(), line.c_str());
+    }
+  }
+  g.origin = Vector3D(ox, oy, oz);
+  std::unique_ptr<MaterialMap> map(new MaterialMap(g));
+  std::size_t num_bins = 0;
+  while ( next_line() )  {
+    std::stringstream str(line);
+    int ieta = -1, iphi = -1;
+    MaterialBudget b;
+    str >> ieta >> iphi >> b.length >> b.x0 >> b.lambda >> b.rho_l >> b.rho_l_over_A >> b.rho_l_Z_over_A;
+    if ( str.fail() || ieta < 0 || ieta >= g.nEta || iphi < 0 || iphi >= g.nPhi )  {
+      except("MaterialMap","+++ %s: Invalid bin entry: %s", file_name.c_str(), line.c_str());
+    }
+    map->bin(ieta, iphi) = b;
+    ++num_bins;
+  }
+  if ( num_bins != map->size() )  {
+    except("MaterialMap","+++ %s: Incomplete map: %ld bins out of %ld.",
+           file_name.c_str(), long(num_bins), long(map->size()));
+  }
+  return map;
+}
@@ -0,0 +1,233 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDRec/MaterialScanEngine.h>
+#include <DD4hep/Detector.h>
+#include <DD4hep/Printout.h>
+
+// ROOT include files
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <TGeoVolume.h>
+#include <TGeoMedium.h>
+#include <TGeoMaterial.h>
+#include <TGeoBBox.h>
+#include <TGeoNode.h>
+
+// C/C++ include files
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+/// Minimal step to get out of navigation deadlocks (see MaterialManager)
+#define MINSTEP 1.e-5
+
+/// Initializing constructor
+MaterialScanEngine::MaterialScanEngine(Detector& description, int threads)
+  : m_manager(&description.manager())
+{
+  TObjArray* volumes = m_manager->GetListOfVolumes();
+  for ( Int_t i = 0, n = volumes->GetEntriesFast(); i < n; ++i )  {
+    const TGeoVolume* vol = (const TGeoVolume*)volumes->At(i);
+    if ( vol ) m_media.emplace(vol, medium(vol));
+  }
+  setThreads(threads);
+  printout(DEBUG,"MaterialScanEngine","+++ Cached material properties of %ld volumes.", long(m_media.size()));
+}
+
+/// Set the number of worker threads
+void MaterialScanEngine::setThreads(int threads)   {
+  m_threads = threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// Set the tile size in eta and phi bins
+void MaterialScanEngine::setTileSize(int num_eta, int num_phi)   {
+  m_tileEta = std::max(1, num_eta);
+  m_tilePhi = std::max(1, num_phi);
+}
+
+/// Material properties of a volume
+MaterialScanEngine::Medium MaterialScanEngine::medium(const TGeoVolume* volume)  const   {
+  auto i = m_media.find(volume);
+  if ( i != m_media.end() ) return i->second;
+
+  Medium m;
+  const TGeoMedium* med = volume->GetMedium();
+  const TGeoMaterial* mat = med ? med->GetMaterial() : nullptr;
+  if ( mat )  {
+    m.inv_x0           = 1e0 / mat->GetRadLen();
+    m.inv_lambda       = 1e0 / mat->GetIntLen();
+    m.density          = mat->GetDensity();
+    m.density_over_A   = mat->GetDensity() / mat->GetA();
+    m.density_Z_over_A = mat->GetDensity() * mat->GetZ() / mat->GetA();
+  }
+  return m;
+}
+
+/// Navigator of the calling thread. Created if not present
+TGeoNavigator* MaterialScanEngine::navigator()  const   {
+  TGeoNavigator* nav = m_manager->GetCurrentNavigator();
+  return nav ? nav : m_manager->AddNavigator();
+}
+
+/// Material budget along a straight line. Uses the navigator of the calling thread
+MaterialBudget MaterialScanEngine::scan(const Vector3D& p0, const Vector3D& p1)  const   {
+  return scan(navigator(), p0, p1);
+}
+
+/// Material budget along a straight line using a given navigator
+MaterialBudget MaterialScanEngine::scan(TGeoNavigator* nav, const Vector3D& p0, const Vector3D& p1)  const   {
+  MaterialBudget budget;
+  double total = (p1 - p0).r();
+  if ( total <= 0e0 ) return budget;
+
+  Vector3D dir = (1e0 / total) * (p1 - p0);
+  TGeoNode* node = nav->InitTrack(p0.const_array(), dir.const_array());
+  if ( !node )  {
+    except("MaterialScanEngine","+++ No geometry node found at (%g,%g,%g). "
+           "Either there is no node placed here or position is outside of top volume.",
+           p0[0], p0[1], p0[2]);
+  }
+  for ( double travelled = 0e0; travelled < total && !nav->IsOutside(); )  {
+    Medium m    = medium(node->GetVolume());
+    double left = total - travelled;
+    nav->FindNextBoundaryAndStep(left);
+    double step = nav->GetStep();
+    if ( step < MINSTEP )  {
+      // Protection against navigation deadlocks on boundaries: push the point forward
+      const double* pos = nav->GetCurrentPoint();
+      step = std::min(double(MINSTEP), left);
+      nav->SetCurrentPoint(pos[0] + step * dir[0], pos[1] + step * dir[1], pos[2] + step * dir[2]);
+      nav->FindNode();
+    }
+    step = std::min(step, left);
+    budget.length         += step;
+    budget.x0             += step * m.inv_x0;
+    budget.lambda         += step * m.inv_lambda;
+    budget.rho_l          += step * m.density;
+    budget.rho_l_over_A   += step * m.density_over_A;
+    budget.rho_l_Z_over_A += step * m.density_Z_over_A;
+    travelled += step;
+    node = nav->GetCurrentNode();
+    if ( !node ) break;
+  }
+  return budget;
+}
+
+/// Execute tasks with the worker threads. Returns the number of threads used
+std::size_t MaterialScanEngine::execute(int num_tasks, const std::function<void(TGeoNavigator*, int)>& task)  const   {
+  std::size_t num_workers = std::max(0, std::min(m_threads, num_tasks));
+  // TGeo numbers threads in the order they first navigate. Reset the numbering for
+  // every call, else the threads of a second scan get indices beyond fMaxThreads.
+  if ( num_workers > 1 )  {
+    m_manager->SetMaxThreads(num_workers);
+  }
+  std::vector<std::exception_ptr> errors(num_workers);
+  std::atomic<int> next { 0 };
+  auto work = [&](std::size_t id)  {
+    TGeoNavigator* nav = id == 0 ? navigator() : m_manager->AddNavigator();
+    try  {
+      for ( int i = next++; i < num_tasks; i = next++ )
+        task(nav, i);
+    }
+    catch(...)  {
+      errors[id] = std::current_exception();
+      next = num_tasks;
+    }
+    if ( id != 0 ) m_manager->RemoveNavigator(nav);
+  };
+  std::vector<std::thread> workers;
+  for ( std::size_t i = 1; i < num_workers; ++i )
+    workers.emplace_back(work, i);
+  if ( num_workers > 0 ) work(0);
+  for ( auto& w : workers )
+    w.join();
+  if ( num_workers > 1 )  {
+    TGeoManager::ClearThreadsMap();
+  }
+  for ( const auto& e : errors )
+    if ( e ) std::rethrow_exception(e);
+  return num_workers;
+}
+
+/// Material budgets of a set of straight lines
+std::vector<MaterialBudget>
+MaterialScanEngine::scan(const std::vector<std::pair<Vector3D, Vector3D> >& rays)  const   {
+  /// Rays are handed out in chunks to limit the contention on the task counter
+  const int chunk_size = 64;
+  const int num_chunks = (rays.size() + chunk_size - 1) / chunk_size;
+  std::vector<MaterialBudget> budgets(rays.size());
+  execute(num_chunks, [&](TGeoNavigator* nav, int chunk)  {
+      std::size_t end = std::min(rays.size(), std::size_t(chunk + 1) * chunk_size);
+      for ( std::size_t i = std::size_t(chunk) * chunk_size; i < end; ++i )
+        budgets[i] = scan(nav, rays[i].first, rays[i].second);
+    });
+  return budgets;
+}
+
+/// Scan a material map
+std::unique_ptr<MaterialMap> MaterialScanEngine::scan(const MaterialMap::Grid& grid)  const   {
+  MaterialMap::Grid g = grid;
+  if ( g.rMax <= 0e0 || g.zMax <= 0e0 )  {
+    const TGeoBBox* box = (const TGeoBBox*)m_manager->GetTopVolume()->GetShape();
+    if ( g.rMax <= 0e0 ) g.rMax = std::min(box->GetDX(), box->GetDY());
+    if ( g.zMax <= 0e0 ) g.zMax = box->GetDZ();
+  }
+  g.nSub = std::max(1, g.nSub);
+  std::unique_ptr<MaterialMap> map(new MaterialMap(g));
+
+  const int    num_tiles_eta = (g.nEta + m_tileEta - 1) / m_tileEta;
+  const int    num_tiles_phi = (g.nPhi + m_tilePhi - 1) / m_tilePhi;
+  const int    num_tiles     = num_tiles_eta * num_tiles_phi;
+  const double d_eta = (g.etaMax - g.etaMin) / (g.nEta * g.nSub);
+  const double d_phi = (g.phiMax - g.phiMin) / (g.nPhi * g.nSub);
+  const double norm  = 1e0 / (g.nSub * g.nSub);
+
+  /// Scan all bins of one tile
+  auto scan_tile = [&](TGeoNavigator* nav, int tile)  {
+    int eta_begin = (tile / num_tiles_phi) * m_tileEta, eta_end = std::min(eta_begin + m_tileEta, g.nEta);
+    int phi_begin = (tile % num_tiles_phi) * m_tilePhi, phi_end = std::min(phi_begin + m_tilePhi, g.nPhi);
+    for ( int ieta = eta_begin; ieta < eta_end; ++ieta )  {
+      for ( int iphi = phi_begin; iphi < phi_end; ++iphi )  {
+        MaterialBudget sum;
+        for ( int ie = 0; ie < g.nSub; ++ie )  {
+          double eta   = g.etaMin + (ieta * g.nSub + ie + 0.5) * d_eta;
+          double theta = 2e0 * std::atan(std::exp(-eta));
+          double sin_t = std::sin(theta), cos_t = std::cos(theta);
+          // Distance to the scan envelope along the ray
+          double len   = std::min(sin_t > 0e0 ? g.rMax / sin_t : g.zMax,
+                                  std::abs(cos_t) > 0e0 ? g.zMax / std::abs(cos_t) : g.rMax);
+          for ( int ip = 0; ip < g.nSub; ++ip )  {
+            double   phi = g.phiMin + (iphi * g.nSub + ip + 0.5) * d_phi;
+            Vector3D end(g.origin.x() + len * sin_t * std::cos(phi),
+                         g.origin.y() + len * sin_t * std::sin(phi),
+                         g.origin.z() + len * cos_t);
+            sum += scan(nav, g.origin, end);
+          }
+        }
+        sum *= norm;
+        map->bin(ieta, iphi) = sum;
+      }
+    }
+  };
+
+  std::size_t num_workers = execute(num_tiles, scan_tile);
+  printout(DEBUG,"MaterialScanEngine","+++ Scanned %ld rays in %d tiles with %ld threads.",
+           long(map->size()) * g.nSub * g.nSub, num_tiles, long(num_workers));
+  return map;
+}
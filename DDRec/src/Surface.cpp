@@ -17,7 +17,9 @@
 #include "DDRec/MaterialManager.h"
 
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <algorithm>
 #include <exception>
 
 #include "TGeoMatrix.h"
@@ -697,6 +699,29 @@ namespace dd4hep {
       return o ;
     }
 
+    void Surface::globalBoundingBox( Vector3D& lower, Vector3D& upper ) const {
+
+      const TGeoBBox* box = (const TGeoBBox*) volume()->GetShape() ;
+      const double* o = box->GetOrigin() ;
+      const double  d[3] = { box->GetDX() , box->GetDY() , box->GetDZ() } ;
+
+      lower.fill(  std::numeric_limits<double>::max() ,  std::numeric_limits<double>::max() ,  std::numeric_limits<double>::max() ) ;
+      upper.fill( -std::numeric_limits<double>::max() , -std::numeric_limits<double>::max() , -std::numeric_limits<double>::max() ) ;
+
+      // transform the 8 corners of the local bounding box
+      for( unsigned c=0 ; c<8 ; ++c ){
+        double local[3] = { o[0] + ( c&1 ? d[0] : -d[0] ) ,
+                            o[1] + ( c&2 ? d[1] : -d[1] ) ,
+                            o[2] + ( c&4 ? d[2] : -d[2] ) } ;
+        double global[3] ;
+        _wtM->LocalToMaster( local , global ) ;
+        for( unsigned i=0 ; i<3 ; ++i ){
+          lower[i] = std::min( lower[i] , global[i] ) ;
+          upper[i] = std::max( upper[i] , global[i] ) ;
+        }
+      }
+    }
+
 
     double Surface::distance(const Vector3D& point ) const {
 
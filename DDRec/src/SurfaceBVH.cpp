@@ -0,0 +1,328 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DDRec/SurfaceBVH.h"
+#include "DDRec/Surface.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// Padding of the surface bounding boxes
+      const double s_padding = 1e-4 ;
+      /// Maximal depth of the hierarchy during traversal
+      const unsigned s_maxDepth = 128 ;
+      /// Length below which the search for crossings of curved surfaces stops subdividing
+      const double s_resolution = 0.1 * dd4hep::mm ;
+
+      /// Clip the segment start + t*dir, t in [0,1], to the box. Returns false if there is no overlap
+      inline bool clip( const SurfaceBVH::Box& b, const Vector3D& start, const Vector3D& dir, double& t0, double& t1 ){
+        t0 = 0. ;
+        t1 = 1. ;
+        for( int i=0 ; i<3 ; ++i ){
+          if( std::fabs( dir[i] ) < std::numeric_limits<double>::min() ){
+            if( start[i] < b.lower[i] || start[i] > b.upper[i] ) return false ;
+            continue ;
+          }
+          double inv = 1. / dir[i] ;
+          double ta  = ( b.lower[i] - start[i] ) * inv ;
+          double tb  = ( b.upper[i] - start[i] ) * inv ;
+          if( ta > tb ) std::swap( ta , tb ) ;
+          t0 = std::max( t0 , ta ) ;
+          t1 = std::min( t1 , tb ) ;
+          if( t0 > t1 ) return false ;
+        }
+        return true ;
+      }
+
+      /// Squared distance of a point to a box. 0 if the point is inside
+      inline double distance2( const SurfaceBVH::Box& b, const Vector3D& p ){
+        double d2 = 0. ;
+        for( int i=0 ; i<3 ; ++i ){
+          double d = std::max( { b.lower[i] - p[i] , 0. , p[i] - b.upper[i] } ) ;
+          d2 += d * d ;
+        }
+        return d2 ;
+      }
+
+      /// Extend a box to include another box
+      inline void extend( SurfaceBVH::Box& b, const SurfaceBVH::Box& o ){
+        for( int i=0 ; i<3 ; ++i ){
+          b.lower[i] = std::min( b.lower[i] , o.lower[i] ) ;
+          b.upper[i] = std::max( b.upper[i] , o.upper[i] ) ;
+        }
+      }
+
+      /// Empty box
+      inline SurfaceBVH::Box emptyBox(){
+        const double big = std::numeric_limits<double>::max() ;
+        return SurfaceBVH::Box { { big , big , big } , { -big , -big , -big } } ;
+      }
+    }
+
+    //======================================================================================================
+
+    bool SurfaceBVH::boundingBox( const ISurface* surface, Box& box ){
+
+      const Surface* surf = dynamic_cast<const Surface*>( surface ) ;
+      if( ! surf ) return false ;
+
+      Vector3D lower, upper ;
+      surf->globalBoundingBox( lower , upper ) ;
+      for( int i=0 ; i<3 ; ++i ){
+        box.lower[i] = lower[i] - s_padding ;
+        box.upper[i] = upper[i] + s_padding ;
+      }
+      return true ;
+    }
+
+    SurfaceBVH::SurfaceBVH( const std::vector<ISurface*>& surfaces, unsigned leafSize ){
+
+      _items.reserve( surfaces.size() ) ;
+      for( ISurface* surf : surfaces ){
+        Box box ;
+        if( boundingBox( surf , box ) )
+          _items.emplace_back( Item { surf , box } ) ;
+        else
+          _unbounded.emplace_back( surf ) ;
+      }
+      if( ! _items.empty() ){
+        _nodes.reserve( 2 * _items.size() / std::max( leafSize , 1u ) + 1 ) ;
+        build( 0 , _items.size() , std::max( leafSize , 1u ) ) ;
+      }
+    }
+
+    unsigned SurfaceBVH::build( unsigned first, unsigned count, unsigned leafSize ){
+
+      unsigned index = _nodes.size() ;
+      _nodes.emplace_back() ;
+
+      Box box = emptyBox() , centers = emptyBox() ;
+      for( unsigned i=first ; i<first+count ; ++i ){
+        const Box& b = _items[i].box ;
+        extend( box , b ) ;
+        for( int j=0 ; j<3 ; ++j ){
+          double c = 0.5 * ( b.lower[j] + b.upper[j] ) ;
+          centers.lower[j] = std::min( centers.lower[j] , c ) ;
+          centers.upper[j] = std::max( centers.upper[j] , c ) ;
+        }
+      }
+      _nodes[index].box = box ;
+
+      // split along the axis with the largest spread of the box centers
+      int axis = 0 ;
+      for( int j=1 ; j<3 ; ++j ){
+        if( centers.upper[j] - centers.lower[j] > centers.upper[axis] - centers.lower[axis] ) axis = j ;
+      }
+      if( count <= leafSize || !( centers.upper[axis] > centers.lower[axis] ) ){
+        _nodes[index].first = first ;
+        _nodes[index].count = count ;
+        return index ;
+      }
+      unsigned mid = first + count / 2 ;
+      std::nth_element( _items.begin() + first , _items.begin() + mid , _items.begin() + first + count ,
+                        [axis]( const Item& a , const Item& b ){
+                          return a.box.lower[axis] + a.box.upper[axis] < b.box.lower[axis] + b.box.upper[axis] ;
+                        } ) ;
+      build( first , mid - first , leafSize ) ;
+      unsigned right = build( mid , first + count - mid , leafSize ) ;
+      _nodes[index].first = right ;
+      return index ;
+    }
+
+    template <typename FUNC> void SurfaceBVH::visit( const Vector3D& start, const Vector3D& end, FUNC func ) const {
+
+      Vector3D dir = end - start ;
+      double t0, t1 ;
+      unsigned stack[s_maxDepth] ;
+      unsigned top = 0 ;
+      if( ! _nodes.empty() ) stack[top++] = 0 ;
+
+      while( top > 0 ){
+        const Node& node = _nodes[ stack[--top] ] ;
+        if( ! clip( node.box , start , dir , t0 , t1 ) ) continue ;
+        if( node.count > 0 ){
+          for( unsigned i=node.first ; i<node.first+node.count ; ++i ){
+            if( clip( _items[i].box , start , dir , t0 , t1 ) ) func( _items[i].surface , t0 , t1 ) ;
+          }
+          continue ;
+        }
+        stack[top++] = node.first ;
+        stack[top++] = ( &node - _nodes.data() ) + 1 ;
+      }
+      for( ISurface* surf : _unbounded ) func( surf , 0. , 1. ) ;
+    }
+
+    template <typename FUNC> void SurfaceBVH::visit( const Vector3D& point, double distance, FUNC func ) const {
+
+      double d2 = distance * distance ;
+      unsigned stack[s_maxDepth] ;
+      unsigned top = 0 ;
+      if( ! _nodes.empty() ) stack[top++] = 0 ;
+
+      while( top > 0 ){
+        const Node& node = _nodes[ stack[--top] ] ;
+        if( distance2( node.box , point ) > d2 ) continue ;
+        if( node.count > 0 ){
+          for( unsigned i=node.first ; i<node.first+node.count ; ++i ){
+            if( distance2( _items[i].box , point ) <= d2 ) func( _items[i].surface ) ;
+          }
+          continue ;
+        }
+        stack[top++] = node.first ;
+        stack[top++] = ( &node - _nodes.data() ) + 1 ;
+      }
+      for( ISurface* surf : _unbounded ) func( surf ) ;
+    }
+
+    std::vector<ISurface*> SurfaceBVH::candidates( const Vector3D& start, const Vector3D& end ) const {
+
+      std::vector<ISurface*> result ;
+      visit( start , end , [&result]( ISurface* surf , double , double ){ result.emplace_back( surf ) ; } ) ;
+      return result ;
+    }
+
+    std::vector<SurfaceIntersection> SurfaceBVH::intersect( const Vector3D& start, const Vector3D& end, double epsilon ) const {
+
+      std::vector<SurfaceIntersection> result ;
+      visit( start , end , [&]( ISurface* surf , double t0 , double t1 ){
+          intersect( surf , start , end , t0 , t1 , epsilon , result ) ;
+        } ) ;
+      std::sort( result.begin() , result.end() ,
+                 []( const SurfaceIntersection& a , const SurfaceIntersection& b ){
+                   return a.path < b.path || ( a.path == b.path && a.surface < b.surface ) ;
+                 } ) ;
+      return result ;
+    }
+
+    std::vector<ISurface*> SurfaceBVH::nearby( const Vector3D& point, double maxDistance ) const {
+
+      std::vector<ISurface*> result ;
+      visit( point , maxDistance , [&]( ISurface* surf ){
+          double d = surf->distance( point ) ;
+          if( std::fabs( d ) <= maxDistance && surf->insideBounds( point - d * surf->normal( point ) ) )
+            result.emplace_back( surf ) ;
+        } ) ;
+      return result ;
+    }
+
+    ISurface* SurfaceBVH::find( const Vector3D& point, double epsilon ) const {
+
+      ISurface* result = nullptr ;
+      double    best   = std::numeric_limits<double>::max() ;
+      visit( point , epsilon , [&]( ISurface* surf ){
+          if( surf->insideBounds( point , epsilon ) ){
+            double d = std::fabs( surf->distance( point ) ) ;
+            if( d < best ){
+              best   = d ;
+              result = surf ;
+            }
+          }
+        } ) ;
+      return result ;
+    }
+
+    void SurfaceBVH::intersect( ISurface* surface, const Vector3D& start, const Vector3D& end,
+                                double tmin, double tmax, double epsilon,
+                                std::vector<SurfaceIntersection>& crossings ){
+
+      Vector3D dir = end - start ;
+      double   len = dir.r() ;
+      tmin = std::max( tmin , 0. ) ;
+      tmax = std::min( tmax , 1. ) ;
+
+      auto accept = [&]( double t ){
+        if( t < tmin || t > tmax ) return ;
+        Vector3D p = start + t * dir ;
+        if( surface->insideBounds( p , epsilon ) )
+          crossings.emplace_back( SurfaceIntersection { surface , p , t * len } ) ;
+      } ;
+
+      // Planes: the distance is linear along the segment
+      if( surface->type().isPlane() ){
+        double f0 = surface->distance( start ) , f1 = surface->distance( end ) ;
+        if( ( f0 < 0. ) != ( f1 < 0. ) ) accept( f0 / ( f0 - f1 ) ) ;
+        return ;
+      }
+
+      // Cylinders: (distance + radius)^2 is the squared distance to the axis,
+      // a quadratic function along the segment. Three samples determine it.
+      const ICylinder* cyl = dynamic_cast<const ICylinder*>( surface ) ;
+      if( cyl && surface->type().isCylinder() ){
+        double r  = cyl->radius() ;
+        double q0 = surface->distance( start ) + r ;
+        double qh = surface->distance( start + 0.5 * dir ) + r ;
+        double q1 = surface->distance( end ) + r ;
+        q0 *= q0 ; qh *= qh ; q1 *= q1 ;
+        double a = 2. * ( q0 - 2. * qh + q1 ) ;
+        double b = q1 - q0 - a ;
+        double c = q0 - r * r ;
+        if( std::fabs( a ) <= std::numeric_limits<double>::epsilon() * std::max( { q0 , qh , q1 } ) ){
+          // no curvature along the segment, e.g. parallel to the axis
+          if( ( c < 0. ) != ( q1 - r * r < 0. ) ) accept( -c / b ) ;
+          return ;
+        }
+        double disc = b * b - 4. * a * c ;
+        if( disc <= 0. ) return ;
+        double sq = std::sqrt( disc ) ;
+        double u  = -0.5 * ( b + std::copysign( sq , b ) ) ;
+        double t1 = u / a , t2 = c / u ;
+        accept( std::min( t1 , t2 ) ) ;
+        accept( std::max( t1 , t2 ) ) ;
+        return ;
+      }
+
+      // Other surfaces: the distance changes at most by the path length (|grad d| <= 1).
+      // Intervals are subdivided until this bound excludes a crossing or the interval
+      // is shorter than s_resolution. Sign changes are refined by bisection.
+      // The subdivision does not depend on [tmin,tmax]: results are identical
+      // whether the segment is pre-clipped to a bounding box or not.
+      struct Interval { double ta , fa , tb , fb ; } ;
+      std::vector<Interval> stack { { 0. , surface->distance( start ) , 1. , surface->distance( end ) } } ;
+      while( ! stack.empty() ){
+        Interval iv = stack.back() ;
+        stack.pop_back() ;
+        double dt = iv.tb - iv.ta ;
+        if( iv.tb < tmin || iv.ta > tmax ) continue ;
+        if( std::fabs( iv.fa ) + std::fabs( iv.fb ) > dt * len ) continue ;
+        if( dt * len > s_resolution ){
+          double tm = 0.5 * ( iv.ta + iv.tb ) ;
+          double fm = surface->distance( start + tm * dir ) ;
+          stack.push_back( { tm , fm , iv.tb , iv.fb } ) ;
+          stack.push_back( { iv.ta , iv.fa , tm , fm } ) ;
+          continue ;
+        }
+        if( ( iv.fa < 0. ) == ( iv.fb < 0. ) ) continue ;
+        double lo = iv.ta , hi = iv.tb , flo = iv.fa ;
+        while( ( hi - lo ) * len > 0.1 * epsilon ){
+          double mid = 0.5 * ( lo + hi ) ;
+          double fm  = surface->distance( start + mid * dir ) ;
+          if( ( flo < 0. ) == ( fm < 0. ) ){
+            lo  = mid ;
+            flo = fm ;
+          }
+          else {
+            hi = mid ;
+          }
+        }
+        accept( 0.5 * ( lo + hi ) ) ;
+      }
+    }
+
+  } // namespace
+}// namespace
@@ -0,0 +1,265 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DDRec/SurfaceCache.h"
+#include "DDRec/Surface.h"
+
+#include "TGeoMatrix.h"
+#include "TGeoBBox.h"
+
+#include <cmath>
+#include <typeinfo>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// World to local transformation as in TGeoMatrix::MasterToLocal
+      inline void masterToLocal( const double* m, const double* g, double* l ){
+        double mt0 = g[0] - m[9] ;
+        double mt1 = g[1] - m[10] ;
+        double mt2 = g[2] - m[11] ;
+        l[0] = mt0 * m[0] + mt1 * m[3] + mt2 * m[6] ;
+        l[1] = mt0 * m[1] + mt1 * m[4] + mt2 * m[7] ;
+        l[2] = mt0 * m[2] + mt1 * m[5] + mt2 * m[8] ;
+      }
+
+      /// Local to world transformation as in TGeoMatrix::LocalToMaster
+      inline void localToMaster( const double* m, const double* l, double* g ){
+        for( int i=0 ; i<3 ; ++i )
+          g[i] = m[9+i] + l[0] * m[3*i] + l[1] * m[3*i+1] + l[2] * m[3*i+2] ;
+      }
+
+      /// Distance of a point given in the local frame (VolPlaneImpl and VolCylinderImpl)
+      inline double localDistance( const SurfaceRecord& r, const double* l ){
+        if( r.kind == SurfaceRecord::Plane ){
+          return ( l[0] - r.localOrigin[0] ) * r.localNormal[0]
+            +    ( l[1] - r.localOrigin[1] ) * r.localNormal[1]
+            +    ( l[2] - r.localOrigin[2] ) * r.localNormal[2] ;
+        }
+        return std::sqrt( l[0]*l[0] + l[1]*l[1] ) - r.radius ;
+      }
+
+      /// Bounds check of a point given in the local frame (VolSurfaceBase::insideBounds and TGeoBBox::Contains)
+      inline bool localInside( const SurfaceRecord& r, const double* l, double epsilon ){
+        if( !( std::abs( localDistance( r , l ) ) < epsilon ) ) return false ;
+        if( r.bounds == SurfaceRecord::Unbounded ) return true ;
+        return std::abs( l[2] - r.boxOrigin[2] ) <= r.boxHalf[2]
+          &&   std::abs( l[0] - r.boxOrigin[0] ) <= r.boxHalf[0]
+          &&   std::abs( l[1] - r.boxOrigin[1] ) <= r.boxHalf[1] ;
+      }
+
+      inline void copy( const Vector3D& v, double* a ){
+        a[0] = v.x() ;
+        a[1] = v.y() ;
+        a[2] = v.z() ;
+      }
+    }
+
+    //======================================================================================================
+
+    SurfaceCache::SurfaceCache( const std::vector<ISurface*>& surfaces ) : _surfaces( surfaces ) {
+
+      _records.resize( _surfaces.size() ) ;
+      for( std::size_t i=0 ; i<_surfaces.size() ; ++i ){
+
+        SurfaceRecord& r = _records[i] ;
+        ISurface*   surf = _surfaces[i] ;
+        r.kind   = SurfaceRecord::Generic ;
+        r.bounds = SurfaceRecord::Shape ;
+
+        copy( surf->origin() , r.origin ) ;
+        copy( surf->u()      , r.u ) ;
+        copy( surf->v()      , r.v ) ;
+        copy( surf->normal() , r.normal ) ;
+
+        // orthogonal unit vectors as in Surface::globalToLocal
+        double uv = surf->u() * surf->v() ;
+        Vector3D uprime = ( surf->u() - uv * surf->v() ).unit() ;
+        Vector3D vprime = ( surf->v() - uv * surf->u() ).unit() ;
+        copy( uprime , r.uPrime ) ;
+        copy( vprime , r.vPrime ) ;
+        r.uuPrime = surf->u() * uprime ;
+        r.vvPrime = surf->v() * vprime ;
+
+        // Only the exact types are evaluated from the record: subclasses may override the calculations
+        const Surface* s = dynamic_cast<const Surface*>( surf ) ;
+        if( ! s ) continue ;
+        VolSurface vs = s->volSurface() ;
+        const std::type_info& styp = typeid( *s ) ;
+        const std::type_info& vtyp = typeid( *vs.ptr() ) ;
+        if( styp == typeid( Surface ) && vtyp == typeid( VolPlaneImpl ) )
+          r.kind = SurfaceRecord::Plane ;
+        else if( styp == typeid( CylinderSurface ) && vtyp == typeid( VolCylinderImpl ) )
+          r.kind = SurfaceRecord::Cylinder ;
+        else
+          continue ;
+
+        const TGeoMatrix* m = s->worldTransformation() ;
+        const double* rot = m->GetRotationMatrix() ;
+        const double* tra = m->GetTranslation() ;
+        std::copy( rot , rot + 9 , r.matrix ) ;
+        std::copy( tra , tra + 3 , r.matrix + 9 ) ;
+        copy( vs.origin() , r.localOrigin ) ;
+        copy( vs.normal() , r.localNormal ) ;
+        r.radius = vs.origin().rho() ;
+        r.phi    = vs.origin().phi() ;
+
+        const TGeoShape* shape = s->volume()->GetShape() ;
+        if( s->type().isUnbounded() ){
+          r.bounds = SurfaceRecord::Unbounded ;
+        }
+        else if( shape->IsA() == TGeoBBox::Class() ){
+          const TGeoBBox* box = (const TGeoBBox*) shape ;
+          std::copy( box->GetOrigin() , box->GetOrigin() + 3 , r.boxOrigin ) ;
+          r.boxHalf[0] = box->GetDX() ;
+          r.boxHalf[1] = box->GetDY() ;
+          r.boxHalf[2] = box->GetDZ() ;
+          r.bounds = SurfaceRecord::Box ;
+        }
+      }
+    }
+
+    double SurfaceCache::distance( std::size_t index, const Vector3D& point ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Generic ) return _surfaces[index]->distance( point ) ;
+      double l[3] ;
+      masterToLocal( r.matrix , point.const_array() , l ) ;
+      return localDistance( r , l ) ;
+    }
+
+    Vector2D SurfaceCache::globalToLocal( std::size_t index, const Vector3D& point ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Plane ){
+        double p0 = point.x() - r.origin[0] , p1 = point.y() - r.origin[1] , p2 = point.z() - r.origin[2] ;
+        return Vector2D( ( p0 * r.uPrime[0] + p1 * r.uPrime[1] + p2 * r.uPrime[2] ) / r.uuPrime ,
+                         ( p0 * r.vPrime[0] + p1 * r.vPrime[1] + p2 * r.vPrime[2] ) / r.vvPrime ) ;
+      }
+      else if( r.kind == SurfaceRecord::Cylinder ){
+        double l[3] ;
+        masterToLocal( r.matrix , point.const_array() , l ) ;
+        double phi = ( l[0] == 0.0 && l[1] == 0.0 ? 0.0 : std::atan2( l[1] , l[0] ) ) - r.phi ;
+        while( phi < -M_PI ) phi += 2.*M_PI ;
+        while( phi >  M_PI ) phi -= 2.*M_PI ;
+        return Vector2D( r.radius * phi , l[2] - r.localOrigin[2] ) ;
+      }
+      return _surfaces[index]->globalToLocal( point ) ;
+    }
+
+    Vector3D SurfaceCache::localToGlobal( std::size_t index, const Vector2D& point ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Plane ){
+        return Vector3D( r.origin[0] + point[0] * r.u[0] + point[1] * r.v[0] ,
+                         r.origin[1] + point[0] * r.u[1] + point[1] * r.v[1] ,
+                         r.origin[2] + point[0] * r.u[2] + point[1] * r.v[2] ) ;
+      }
+      else if( r.kind == SurfaceRecord::Cylinder ){
+        double z   = point.v() + r.localOrigin[2] ;
+        double phi = point.u() / r.radius + r.phi ;
+        while( phi < -M_PI ) phi += 2.*M_PI ;
+        while( phi >  M_PI ) phi -= 2.*M_PI ;
+        double l[3] = { r.radius * std::cos( phi ) , r.radius * std::sin( phi ) , z } ;
+        Vector3D g ;
+        localToMaster( r.matrix , l , g.array() ) ;
+        return g ;
+      }
+      return _surfaces[index]->localToGlobal( point ) ;
+    }
+
+    bool SurfaceCache::insideBounds( std::size_t index, const Vector3D& point, double epsilon ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Generic || r.bounds == SurfaceRecord::Shape )
+        return _surfaces[index]->insideBounds( point , epsilon ) ;
+      double l[3] ;
+      masterToLocal( r.matrix , point.const_array() , l ) ;
+      return localInside( r , l , epsilon ) ;
+    }
+
+    void SurfaceCache::distance( std::size_t index, const double* points, std::size_t n, double* result ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Plane ){
+        // the plane distance is linear in the global point: no branch in the loop
+        for( std::size_t i=0 ; i<n ; ++i ){
+          double l[3] ;
+          masterToLocal( r.matrix , points + 3*i , l ) ;
+          result[i] = ( l[0] - r.localOrigin[0] ) * r.localNormal[0]
+            +         ( l[1] - r.localOrigin[1] ) * r.localNormal[1]
+            +         ( l[2] - r.localOrigin[2] ) * r.localNormal[2] ;
+        }
+      }
+      else if( r.kind == SurfaceRecord::Cylinder ){
+        for( std::size_t i=0 ; i<n ; ++i ){
+          double l[3] ;
+          masterToLocal( r.matrix , points + 3*i , l ) ;
+          result[i] = std::sqrt( l[0]*l[0] + l[1]*l[1] ) - r.radius ;
+        }
+      }
+      else {
+        for( std::size_t i=0 ; i<n ; ++i )
+          result[i] = _surfaces[index]->distance( Vector3D( points + 3*i ) ) ;
+      }
+    }
+
+    void SurfaceCache::globalToLocal( std::size_t index, const double* points, std::size_t n, double* result ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Plane ){
+        for( std::size_t i=0 ; i<n ; ++i ){
+          const double* p = points + 3*i ;
+          double p0 = p[0] - r.origin[0] , p1 = p[1] - r.origin[1] , p2 = p[2] - r.origin[2] ;
+          result[2*i]   = ( p0 * r.uPrime[0] + p1 * r.uPrime[1] + p2 * r.uPrime[2] ) / r.uuPrime ;
+          result[2*i+1] = ( p0 * r.vPrime[0] + p1 * r.vPrime[1] + p2 * r.vPrime[2] ) / r.vvPrime ;
+        }
+        return ;
+      }
+      for( std::size_t i=0 ; i<n ; ++i ){
+        Vector2D uv = globalToLocal( index , Vector3D( points + 3*i ) ) ;
+        result[2*i]   = uv[0] ;
+        result[2*i+1] = uv[1] ;
+      }
+    }
+
+    void SurfaceCache::insideBounds( std::size_t index, const double* points, std::size_t n, unsigned char* result, double epsilon ) const {
+
+      const SurfaceRecord& r = _records[index] ;
+      if( r.kind == SurfaceRecord::Generic || r.bounds == SurfaceRecord::Shape ){
+        for( std::size_t i=0 ; i<n ; ++i )
+          result[i] = _surfaces[index]->insideBounds( Vector3D( points + 3*i ) , epsilon ) ;
+        return ;
+      }
+      for( std::size_t i=0 ; i<n ; ++i ){
+        double l[3] ;
+        masterToLocal( r.matrix , points + 3*i , l ) ;
+        result[i] = localInside( r , l , epsilon ) ;
+      }
+    }
+
+    void SurfaceCache::distance( const Vector3D& point, double* result ) const {
+
+      for( std::size_t i=0 ; i<_records.size() ; ++i )
+        result[i] = distance( i , point ) ;
+    }
+
+    void SurfaceCache::insideBounds( const Vector3D& point, unsigned char* result, double epsilon ) const {
+
+      for( std::size_t i=0 ; i<_records.size() ; ++i )
+        result[i] = insideBounds( i , point , epsilon ) ;
+    }
+
+  } // namespace
+}// namespace
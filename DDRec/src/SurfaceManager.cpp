@@ -16,6 +16,7 @@
 #include "DD4hep/VolumeManager.h"
 #include "DD4hep/Detector.h"
 
+#include <set>
 #include <sstream>
 
 namespace dd4hep {
@@ -24,6 +25,14 @@ namespace dd4hep {
 
   namespace rec {
     
+    namespace {
+      /// Surfaces of detectors with several types are entered more than once into the world map
+      std::vector<ISurface*> uniqueSurfaces( const SurfaceMap& surfaces ){
+        std::set<ISurface*> surfs ;
+        for( const auto& s : surfaces ) surfs.insert( s.second ) ;
+        return std::vector<ISurface*>( surfs.begin() , surfs.end() ) ;
+      }
+    }
 
     SurfaceManager::SurfaceManager(const Detector& theDetector){
 
@@ -52,6 +61,32 @@ namespace dd4hep {
       return 0 ;
     }
 
+    const SurfaceBVH* SurfaceManager::bvh( const std::string& name ) const {
+
+      const SurfaceMap* surfaces = map( name ) ;
+      if( ! surfaces ) return 0 ;
+
+      std::lock_guard<std::mutex> lock( _bvhLock ) ;
+      std::unique_ptr<SurfaceBVH>& entry = _bvh[ name ] ;
+      if( ! entry ){
+        entry.reset( new SurfaceBVH( uniqueSurfaces( *surfaces ) ) ) ;
+      }
+      return entry.get() ;
+    }
+
+    const SurfaceCache* SurfaceManager::cache( const std::string& name ) const {
+
+      const SurfaceMap* surfaces = map( name ) ;
+      if( ! surfaces ) return 0 ;
+
+      std::lock_guard<std::mutex> lock( _bvhLock ) ;
+      std::unique_ptr<SurfaceCache>& entry = _cache[ name ] ;
+      if( ! entry ){
+        entry.reset( new SurfaceCache( uniqueSurfaces( *surfaces ) ) ) ;
+      }
+      return entry.get() ;
+    }
+
     void SurfaceManager::initialize(const Detector& description) {
       
       const std::vector<std::string>& types = description.detectorTypes() ;
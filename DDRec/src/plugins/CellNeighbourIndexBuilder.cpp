@@ -0,0 +1,147 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Segmentations.h"
+
+#include "DDRec/CellNeighbourIndex.h"
+#include "DDRec/DetectorData.h"
+
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <set>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /// Attach neighbour lookup tables to subdetectors
+    /**
+     *  For every subdetector a CellNeighbourIndex of its readout segmentation
+     *  is created and attached as extension to the subdetector element.
+     *  If the subdetector carries NeighbourSurfacesData, a compact copy of
+     *  the neighbour maps is attached as NeighbourSurfacesIndex.
+     *
+     *  With -check the same layer neighbours of random cells are compared
+     *  to Segmentation::neighbours (CartesianGridXY only, the other grid types
+     *  define neighbours differently) and the lookup speed is compared.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long cellNeighbourIndex(Detector& description, int argc, char** argv) {
+      typedef std::chrono::high_resolution_clock clock_type;
+      std::vector<std::string> detectors;
+      std::string layer = "layer";
+      bool   diagonal  = false;
+      int    num_check = 0;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-detector",argv[i],4) )
+          detectors.emplace_back(argv[++i]);
+        else if ( 0 == ::strncmp("-layer",argv[i],4) )
+          layer = argv[++i];
+        else if ( 0 == ::strncmp("-diagonal",argv[i],4) )
+          diagonal = true;
+        else if ( 0 == ::strncmp("-check",argv[i],4) )
+          num_check = ::atol(argv[++i]);
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_CellNeighbourIndex  -arg [-arg]                           \n\n"
+            "     Attach neighbour lookup tables to subdetectors.                              \n\n"
+            "     -detector <string>  Subdetector name. May be given multiple times.           \n"
+            "     -layer    <string>  Field name for cross layer neighbours. Default: layer    \n"
+            "     -diagonal           Include diagonal neighbours.                             \n"
+            "     -check    <number>  Number of random cells to check and time. Default: 0     \n"
+            "     -help               Print this help output  \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+      if ( detectors.empty() )  {
+        except("CellNeighbourIndex","+++ No subdetectors given. Use -detector.");
+      }
+      long num_errors = 0;
+      for( const auto& nam : detectors )  {
+        DetElement   de  = description.detector(nam);
+        Readout      ro  = description.sensitiveDetector(nam).readout();
+        Segmentation seg = ro.segmentation();
+        auto* index = new CellNeighbourIndex(*seg.segmentation(), layer, diagonal);
+        de.addExtension<CellNeighbourIndex>(index);
+        printout(INFO,"CellNeighbourIndex","+++ %-16s %-20s %s: up to %ld neighbours per cell.",
+                 nam.c_str(), index->type().c_str(), index->hasLayers() ? "with layers" : "no layers",
+                 long(index->maxNeighbours()));
+
+        if ( auto* surfaces = de.extension<NeighbourSurfacesData>(false) )  {
+          auto* compact = new NeighbourSurfacesIndex(*surfaces);
+          de.addExtension<NeighbourSurfacesIndex>(compact);
+          printout(INFO,"CellNeighbourIndex","+++ %-16s Compact surface neighbours of %ld cells.",
+                   nam.c_str(), long(compact->size()));
+        }
+        if ( num_check <= 0 ) continue;
+
+        // Random cells with all fields in a small range around 0
+        const BitFieldCoder* decoder = ro.idSpec().decoder();
+        std::mt19937 gen(12345);
+        std::vector<CellID> cells;
+        for( int i = 0; i < num_check; ++i )  {
+          CellID cell = 0;
+          for( const auto& f : decoder->fields() )  {
+            std::uniform_int_distribution<int> flat(std::max(f.minValue(), -20), std::min(f.maxValue(), 20));
+            f.set(cell, flat(gen));
+          }
+          cells.push_back(cell);
+        }
+        std::vector<CellID> buffer(index->maxNeighbours());
+        std::size_t sum_seg = 0, sum_idx = 0;
+        auto start = clock_type::now();
+        for( CellID cell : cells )  {
+          std::set<CellID> nb;
+          seg.neighbours(cell, nb);
+          sum_seg += nb.size();
+        }
+        std::chrono::duration<double, std::nano> t_seg = clock_type::now() - start;
+        start = clock_type::now();
+        for( CellID cell : cells )
+          sum_idx += index->neighbours(cell, buffer.data(), buffer.size(), CellNeighbourIndex::SAME_LAYER);
+        std::chrono::duration<double, std::nano> t_idx = clock_type::now() - start;
+
+        if ( index->type() == "CartesianGridXY" && !diagonal )  {
+          for( CellID cell : cells )  {
+            std::set<CellID> nb;
+            seg.neighbours(cell, nb);
+            std::size_t n = index->neighbours(cell, buffer.data(), buffer.size(), CellNeighbourIndex::SAME_LAYER);
+            if ( std::set<CellID>(buffer.begin(), buffer.begin() + n) != nb )  {
+              printout(ERROR,"CellNeighbourIndex","+++ %s: neighbours of cell %016llX differ from Segmentation::neighbours.",
+                       nam.c_str(), (unsigned long long)cell);
+              ++num_errors;
+            }
+          }
+        }
+        printout(INFO,"CellNeighbourIndex","+++ %-16s %d cells: Segmentation::neighbours: %.1f ns/cell  Index: %.1f ns/cell",
+                 nam.c_str(), num_check, t_seg.count()/num_check, t_idx.count()/num_check);
+        printout(DEBUG,"CellNeighbourIndex","+++ Checksums: %ld %ld", long(sum_seg), long(sum_idx));
+      }
+      if ( num_errors > 0 )  {
+        printout(ERROR,"CellNeighbourIndex","+++ %ld cells with inconsistent neighbours.", num_errors);
+        return 0;
+      }
+      printout(ALWAYS,"CellNeighbourIndex","+++ Cell neighbour index attached to %ld subdetectors.", long(detectors.size()));
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_CellNeighbourIndex, dd4hep::rec::cellNeighbourIndex )
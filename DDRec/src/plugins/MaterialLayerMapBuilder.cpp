@@ -0,0 +1,167 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include "DDRec/MaterialManager.h"
+#include "DDRec/MaterialLayerMap.h"
+#include "DDRec/MaterialScanEngine.h"
+
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /// Build a material layer map for reconstruction
+    /**
+     *  The layers are given as arguments, filled with the MaterialScanEngine
+     *  and optionally stored to a file, which reconstruction loads with
+     *  MaterialLayerMap::read. With -check the layer crossings at the bin centers
+     *  are compared to MaterialManager::materialsBetween and the lookup
+     *  speed of random track segments is compared to the navigation.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long materialLayerMapBuilder(Detector& description, int argc, char** argv) {
+      typedef std::chrono::high_resolution_clock clock_type;
+      MaterialLayerMap layers;
+      std::string output;
+      int    threads = 0, num_check = 0;
+      double tolerance = 1e-3;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-cylinder",argv[i],4) || 0 == ::strncmp("-disc",argv[i],4) )  {
+          bool cyl = 0 == ::strncmp("-cylinder",argv[i],4);
+          if ( i + 7 >= argc )  {
+            except("MaterialLayerMapBuilder","+++ %s requires 7 arguments.", argv[i]);
+          }
+          std::string nam = argv[++i];
+          double a = ::atof(argv[++i]) * dd4hep::cm, b = ::atof(argv[++i]) * dd4hep::cm;
+          double c = ::atof(argv[++i]) * dd4hep::cm, d = ::atof(argv[++i]) * dd4hep::cm;
+          int    n1 = ::atol(argv[++i]), n2 = ::atol(argv[++i]);
+          if ( cyl ) layers.addCylinder(nam, a, b, c, d, n1, n2);
+          else       layers.addDisc(nam, a, b, c, d, n1, n2);
+        }
+        else if ( 0 == ::strncmp("-output",argv[i],4) )
+          output = argv[++i];
+        else if ( 0 == ::strncmp("-threads",argv[i],4) )
+          threads = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-check",argv[i],4) )
+          num_check = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-tolerance",argv[i],4) )
+          tolerance = ::atof(argv[++i]);
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_MaterialLayerMapBuilder  -arg [-arg]                      \n\n"
+            "     Build binned layer materials for reconstruction.                             \n\n"
+            "     -cylinder <name> <rmin> <rmax> <zmin> <zmax> <nz> <nphi>                     \n"
+            "                         Add a cylindrical layer. Lengths in cm.                  \n"
+            "     -disc     <name> <zmin> <zmax> <rmin> <rmax> <nr> <nphi>                     \n"
+            "                         Add a disc shaped layer. Lengths in cm.                  \n"
+            "     -output    <string> Store the map to this file.                              \n"
+            "     -threads   <number> Number of threads. Default: all hardware threads         \n"
+            "     -check     <number> Number of random track segments to time. Default: 0      \n"
+            "     -tolerance <number> Relative tolerance of the bin check. Default: 1e-3       \n"
+            "     -help               Print this help output  \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+      if ( layers.size() == 0 )  {
+        except("MaterialLayerMapBuilder","+++ No layers defined. Use -cylinder or -disc.");
+      }
+      MaterialScanEngine engine(description, threads);
+      auto start = clock_type::now();
+      layers.build(engine);
+      std::chrono::duration<double> t_build = clock_type::now() - start;
+      std::size_t num_bins = 0;
+      for( std::size_t i = 0; i < layers.size(); ++i )
+        num_bins += layers.layer(i).bins.size();
+      printout(INFO,"MaterialLayerMapBuilder","+++ Built %ld layers with %ld bins in %.2f s.",
+               long(layers.size()), long(num_bins), t_build.count());
+
+      long num_errors = 0;
+      if ( num_check > 0 )  {
+        MaterialManager mgr(description.world().volume());
+        // Crossings at the bin centers must agree with the navigation
+        double max_dev = 0e0;
+        for( std::size_t i = 0; i < layers.size(); ++i )  {
+          const MaterialLayerMap::Layer& l = layers.layer(i);
+          for( int ibin = 0; ibin < l.nBins; ++ibin )  {
+            for( int iphi = 0; iphi < l.nPhi; ++iphi )  {
+              auto   seg = l.crossing(ibin, iphi);
+              double x0  = 0e0;
+              for( const auto& m : mgr.materialsBetween(seg.first, seg.second, 0e0) )
+                x0 += m.second / m.first.radLength();
+              double dev = std::abs(layers.budgetBetween(seg.first, seg.second).x0 - x0) / std::max(x0, 1e-9);
+              max_dev = std::max(max_dev, dev);
+              if ( dev > tolerance )  {
+                printout(ERROR,"MaterialLayerMapBuilder","+++ Layer %s bin (%d,%d): X0 %g differs from MaterialManager: %g",
+                         l.name.c_str(), ibin, iphi, layers.budgetBetween(seg.first, seg.second).x0, x0);
+                ++num_errors;
+              }
+            }
+          }
+        }
+        // Random track segments from the origin through the layers
+        double r_max = 0e0, z_max = 0e0;
+        for( std::size_t i = 0; i < layers.size(); ++i )  {
+          r_max = std::max(r_max, layers.layer(i).rMax);
+          z_max = std::max(z_max, std::max(std::abs(layers.layer(i).zMin), std::abs(layers.layer(i).zMax)));
+        }
+        std::mt19937 gen(12345);
+        std::uniform_real_distribution<double> flat(-1.0, 1.0);
+        std::vector<std::pair<Vector3D,Vector3D> > rays;
+        for( int i = 0; i < num_check; ++i )
+          rays.emplace_back(Vector3D(), Vector3D(r_max * flat(gen), r_max * flat(gen), z_max * flat(gen)));
+        double sum_mgr = 0e0, sum_map = 0e0;
+        start = clock_type::now();
+        for( const auto& r : rays )
+          sum_mgr += mgr.createAveragedMaterial(mgr.materialsBetween(r.first, r.second)).radiationLength();
+        std::chrono::duration<double, std::micro> t_mgr = clock_type::now() - start;
+        start = clock_type::now();
+        for( const auto& r : rays )
+          sum_map += layers.materialBetween(r.first, r.second).radiationLength();
+        std::chrono::duration<double, std::micro> t_map = clock_type::now() - start;
+        printout(INFO,"MaterialLayerMapBuilder","+++ Bin centers: max. relative X0 deviation: %g. "
+                 "%d segments: MaterialManager: %.2f us/segment  Layer map: %.3f us/segment",
+                 max_dev, num_check, t_mgr.count()/num_check, t_map.count()/num_check);
+        printout(DEBUG,"MaterialLayerMapBuilder","+++ Checksums: %g %g", sum_mgr, sum_map);
+      }
+      if ( !output.empty() )  {
+        layers.write(output);
+        std::unique_ptr<MaterialLayerMap> copy = MaterialLayerMap::read(output);
+        if ( !(*copy == layers) )  {
+          printout(ERROR,"MaterialLayerMapBuilder","+++ Layer map read from %s differs from the built map.", output.c_str());
+          ++num_errors;
+        }
+      }
+      if ( num_errors > 0 )  {
+        printout(ERROR,"MaterialLayerMapBuilder","+++ %ld errors in the material layer map.", num_errors);
+        return 0;
+      }
+      printout(ALWAYS,"MaterialLayerMapBuilder","+++ Material layer map built successfully%s%s",
+               output.empty() ? "" : " and stored to ", output.c_str());
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_MaterialLayerMapBuilder, dd4hep::rec::materialLayerMapBuilder )
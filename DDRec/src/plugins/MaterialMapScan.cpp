@@ -0,0 +1,170 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include "DDRec/MaterialManager.h"
+#include "DDRec/MaterialScanEngine.h"
+
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /// Scan a binned material map with the multi-threaded MaterialScanEngine
+    /**
+     *  The map is scanned in eta-phi tiles and optionally stored to a file,
+     *  which may be loaded by reconstruction with MaterialMap::read.
+     *  With -check the budgets of random rays are compared to the serial
+     *  MaterialManager::materialsBetween. A written map is read back and
+     *  compared to the scanned map.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long materialMapScan(Detector& description, int argc, char** argv) {
+      typedef std::chrono::high_resolution_clock clock_type;
+      MaterialMap::Grid grid;
+      std::string output;
+      int    threads = 0, tile_eta = 8, tile_phi = 8, num_check = 0;
+      double tolerance = 1e-3;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-output",argv[i],4) )
+          output = argv[++i];
+        else if ( 0 == ::strncmp("-threads",argv[i],4) )
+          threads = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-neta",argv[i],5) )
+          grid.nEta = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-etamin",argv[i],7) )
+          grid.etaMin = ::atof(argv[++i]);
+        else if ( 0 == ::strncmp("-etamax",argv[i],7) )
+          grid.etaMax = ::atof(argv[++i]);
+        else if ( 0 == ::strncmp("-nphi",argv[i],5) )
+          grid.nPhi = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-nsub",argv[i],5) )
+          grid.nSub = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-rmax",argv[i],5) )
+          grid.rMax = ::atof(argv[++i]) * dd4hep::cm;
+        else if ( 0 == ::strncmp("-zmax",argv[i],5) )
+          grid.zMax = ::atof(argv[++i]) * dd4hep::cm;
+        else if ( 0 == ::strncmp("-tile",argv[i],5) )  {
+          tile_eta = ::atol(argv[++i]);
+          tile_phi = ::atol(argv[++i]);
+        }
+        else if ( 0 == ::strncmp("-check",argv[i],4) )
+          num_check = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-tolerance",argv[i],5) )
+          tolerance = ::atof(argv[++i]);
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_MaterialMapScan  -arg [-arg]                              \n\n"
+            "     Scan a material map binned in eta and phi with several threads.              \n\n"
+            "     -output    <string> Store the map to this file.                              \n"
+            "     -threads   <number> Number of threads. Default: all hardware threads         \n"
+            "     -neta      <number> Number of eta bins. Default: 100                         \n"
+            "     -etamin    <number> Lower eta edge. Default: -5                              \n"
+            "     -etamax    <number> Upper eta edge. Default: 5                               \n"
+            "     -nphi      <number> Number of phi bins. Default: 72                          \n"
+            "     -nsub      <number> Rays per bin: nsub x nsub. Default: 1                    \n"
+            "     -rmax      <number> Radius of the scan envelope in cm. Default: world box    \n"
+            "     -zmax      <number> Half length of the scan envelope in cm. Default: world   \n"
+            "     -tile   <neta> <nphi> Number of bins per tile. Default: 8 8                  \n"
+            "     -check     <number> Compare this number of random rays to the               \n"
+            "                         MaterialManager. Default: 0                              \n"
+            "     -tolerance <number> Relative tolerance of the comparison. Default: 1e-3      \n"
+            "     -help               Print this help output  \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+      MaterialScanEngine engine(description, threads);
+      engine.setTileSize(tile_eta, tile_phi);
+
+      auto start = clock_type::now();
+      std::unique_ptr<MaterialMap> map = engine.scan(grid);
+      std::chrono::duration<double> t_scan = clock_type::now() - start;
+      const MaterialMap::Grid& g = map->grid();
+      double num_rays = double(map->size()) * g.nSub * g.nSub;
+      printout(INFO,"MaterialMapScan","+++ Scanned %.0f rays [eta: %d bins phi: %d bins] up to r=%.1f cm z=%.1f cm in %.2f s: %.0f rays/s",
+               num_rays, g.nEta, g.nPhi, g.rMax/dd4hep::cm, g.zMax/dd4hep::cm, t_scan.count(),
+               num_rays/std::max(t_scan.count(), 1e-9));
+
+      long num_errors = 0;
+      if ( num_check > 0 )  {
+        MaterialManager mgr(description.world().volume());
+        std::mt19937 gen(12345);
+        std::uniform_real_distribution<double> flat(0.0, 1.0);
+        std::vector<std::pair<Vector3D,Vector3D> > rays;
+        for( int i = 0; i < num_check; ++i )  {
+          double eta = g.etaMin + flat(gen) * (g.etaMax - g.etaMin);
+          double phi = g.phiMin + flat(gen) * (g.phiMax - g.phiMin);
+          double theta = 2e0 * std::atan(std::exp(-eta));
+          double sin_t = std::sin(theta), cos_t = std::cos(theta);
+          double len = std::min(g.rMax / sin_t, g.zMax / std::abs(cos_t));
+          // stay inside the envelope: the MaterialManager drops the last step when leaving the world
+          len *= 0.1 + 0.8 * flat(gen);
+          rays.emplace_back(g.origin, g.origin + len * Vector3D(sin_t*std::cos(phi), sin_t*std::sin(phi), cos_t));
+        }
+        double max_dev = 0e0;
+        std::vector<double> x0_mgr;
+        start = clock_type::now();
+        for( const auto& r : rays )  {
+          const MaterialVec& mats = mgr.materialsBetween(r.first, r.second, 0e0);
+          double x0 = 0e0;
+          for( const auto& m : mats ) x0 += m.second / m.first.radLength();
+          x0_mgr.emplace_back(x0);
+        }
+        std::chrono::duration<double> t_mgr = clock_type::now() - start;
+        start = clock_type::now();
+        for( std::size_t i = 0; i < rays.size(); ++i )  {
+          MaterialBudget b = engine.scan(rays[i].first, rays[i].second);
+          double dev = std::abs(b.x0 - x0_mgr[i]) / std::max(x0_mgr[i], 1e-9);
+          max_dev = std::max(max_dev, dev);
+          if ( dev > tolerance )  {
+            printout(ERROR,"MaterialMapScan","+++ Ray %ld: X0 %g differs from MaterialManager: %g",
+                     long(i), b.x0, x0_mgr[i]);
+            ++num_errors;
+          }
+        }
+        std::chrono::duration<double> t_eng = clock_type::now() - start;
+        printout(INFO,"MaterialMapScan","+++ Checked %d rays. Max. relative X0 deviation: %g  "
+                 "MaterialManager: %.0f rays/s  Engine (1 thread): %.0f rays/s",
+                 num_check, max_dev, num_check/std::max(t_mgr.count(), 1e-9), num_check/std::max(t_eng.count(), 1e-9));
+      }
+      if ( !output.empty() )  {
+        map->write(output);
+        std::unique_ptr<MaterialMap> copy = MaterialMap::read(output);
+        if ( !(*copy == *map) )  {
+          printout(ERROR,"MaterialMapScan","+++ Material map read from %s differs from the scanned map.", output.c_str());
+          ++num_errors;
+        }
+      }
+      if ( num_errors > 0 )  {
+        printout(ERROR,"MaterialMapScan","+++ %ld errors in the material map scan.", num_errors);
+        return 0;
+      }
+      printout(ALWAYS,"MaterialMapScan","+++ Material map scanned successfully%s%s",
+               output.empty() ? "" : " and stored to ", output.c_str());
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_MaterialMapScan, dd4hep::rec::materialMapScan )
@@ -0,0 +1,262 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include "DDRec/SurfaceManager.h"
+#include "DDRec/SurfaceBVH.h"
+
+#include <set>
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /// Benchmark of the surface bounding volume hierarchy against brute force scans
+    /**
+     *  Straight tracks from the origin in random directions are intersected with
+     *  all surfaces of a surface map, once using the SurfaceBVH and once by testing
+     *  every surface. The crossing points are then located again with
+     *  SurfaceBVH::find and with a brute force scan. Both approaches must give
+     *  identical results.
+     *
+     *  The crossings are also compared to an independent reference, which samples
+     *  the surface distance in steps of "-step" along the track and refines sign
+     *  changes by bisection. Crossings found by only one method are accepted if
+     *  they lie within the tolerance of the surface bounds.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long surfaceBVHBenchmark(Detector& description, int argc, char** argv) {
+      typedef std::chrono::high_resolution_clock clock_type;
+      std::string name   = "world";
+      int         ntrack = 1000;
+      int         seed   = 12345;
+      double      length = 300.0 * dd4hep::cm;
+      double      step   = 0.5 * dd4hep::mm;
+      double      eps    = 1e-4;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-map",argv[i],4) )
+          name = argv[++i];
+        else if ( 0 == ::strncmp("-tracks",argv[i],4) )
+          ntrack = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-length",argv[i],4) )
+          length = ::atof(argv[++i]) * dd4hep::cm;
+        else if ( 0 == ::strncmp("-seed",argv[i],4) )
+          seed = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-step",argv[i],4) )
+          step = ::atof(argv[++i]) * dd4hep::mm;
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_SurfaceBVHBenchmark  -arg [-arg]                      \n\n"
+            "     Compare surface intersections of the SurfaceBVH with brute force scans.  \n\n"
+            "     -map      <string> Name of the surface map. Default: 'world'             \n"
+            "     -tracks   <number> Number of straight tracks. Default: 1000              \n"
+            "     -length   <number> Track length in cm. Default: 300                      \n"
+            "     -seed     <number> Random number seed. Default: 12345                    \n"
+            "     -step     <number> Step of the reference scan in mm. Default: 0.5        \n"
+            "     -help              Print this help output  \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+      SurfaceManager* mgr = description.extension<SurfaceManager>(false);
+      if ( !mgr )  {
+        mgr = description.addExtension<SurfaceManager>(new SurfaceManager(description));
+      }
+      const SurfaceMap* surfaces = mgr->map(name);
+      if ( !surfaces )  {
+        except("SurfaceBVHBenchmark","+++ No surface map with name: %s", name.c_str());
+      }
+      std::set<ISurface*> unique;
+      for( const auto& s : *surfaces ) unique.insert(s.second);
+      std::vector<ISurface*> all(unique.begin(), unique.end());
+
+      auto start = clock_type::now();
+      const SurfaceBVH* bvh = mgr->bvh(name);
+      std::chrono::duration<double, std::milli> t_build = clock_type::now() - start;
+      printout(INFO,"SurfaceBVHBenchmark","+++ Map %s: %ld surfaces, %ld BVH nodes. Build time: %.2f ms",
+               name.c_str(), long(bvh->size()), long(bvh->numNodes()), t_build.count());
+
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> flat(-1.0, 1.0);
+      std::vector<std::pair<Vector3D,Vector3D> > tracks;
+      for( int i = 0; i < ntrack; ++i )  {
+        Vector3D dir(flat(gen), flat(gen), flat(gen));
+        tracks.emplace_back(Vector3D(), length * dir.unit());
+      }
+
+      // Segment intersections
+      std::vector<std::vector<SurfaceIntersection> > fast, slow;
+      start = clock_type::now();
+      for( const auto& t : tracks )
+        fast.emplace_back(bvh->intersect(t.first, t.second));
+      std::chrono::duration<double, std::milli> t_fast = clock_type::now() - start;
+
+      start = clock_type::now();
+      for( const auto& t : tracks )  {
+        std::vector<SurfaceIntersection> crossings;
+        for( ISurface* s : all )
+          SurfaceBVH::intersect(s, t.first, t.second, 0., 1., eps, crossings);
+        std::sort(crossings.begin(), crossings.end(),
+                  [](const SurfaceIntersection& a, const SurfaceIntersection& b) {
+                    return a.path < b.path || (a.path == b.path && a.surface < b.surface);
+                  });
+        slow.emplace_back(std::move(crossings));
+      }
+      std::chrono::duration<double, std::milli> t_slow = clock_type::now() - start;
+
+      long num_crossings = 0, num_errors = 0;
+      std::vector<Vector3D> points;
+      for( std::size_t i = 0; i < tracks.size(); ++i )  {
+        num_crossings += fast[i].size();
+        if ( fast[i].size() != slow[i].size() )  {
+          ++num_errors;
+          continue;
+        }
+        for( std::size_t j = 0; j < fast[i].size(); ++j )  {
+          if ( fast[i][j].surface != slow[i][j].surface || fast[i][j].path != slow[i][j].path )
+            ++num_errors;
+          points.emplace_back(fast[i][j].point);
+        }
+      }
+      printout(INFO,"SurfaceBVHBenchmark","+++ %d tracks, %ld crossings. BVH: %8.3f ms/track  Brute force: %8.3f ms/track",
+               ntrack, num_crossings, t_fast.count()/ntrack, t_slow.count()/ntrack);
+
+      // Independent reference: fixed steps along the track within the surface bounding box
+      auto reference = [step, eps](ISurface* s, const Vector3D& p0, const Vector3D& p1,
+                                   std::vector<SurfaceIntersection>& crossings)  {
+        SurfaceBVH::Box box;
+        Vector3D dir = p1 - p0;
+        double   len = dir.r(), t0 = 0., t1 = 1.;
+        if ( SurfaceBVH::boundingBox(s, box) )  {
+          for( int k = 0; k < 3; ++k )  {
+            if ( dir[k] == 0. )  {
+              if ( p0[k] < box.lower[k] || p0[k] > box.upper[k] ) return;
+              continue;
+            }
+            double ta = (box.lower[k] - p0[k]) / dir[k], tb = (box.upper[k] - p0[k]) / dir[k];
+            t0 = std::max(t0, std::min(ta, tb));
+            t1 = std::min(t1, std::max(ta, tb));
+          }
+          if ( t0 > t1 ) return;
+        }
+        int    nstep = std::max(1, int(std::ceil((t1 - t0) * len / step)));
+        double ta = t0, fa = s->distance(p0 + t0 * dir);
+        for( int k = 1; k <= nstep; ++k )  {
+          double tb = t0 + (t1 - t0) * k / nstep;
+          double fb = s->distance(p0 + tb * dir);
+          if ( (fa < 0.) != (fb < 0.) )  {
+            double lo = ta, hi = tb, flo = fa;
+            while ( (hi - lo) * len > 0.1 * eps )  {
+              double mid = 0.5 * (lo + hi), fm = s->distance(p0 + mid * dir);
+              if ( (flo < 0.) == (fm < 0.) )  { lo = mid; flo = fm; }
+              else  { hi = mid; }
+            }
+            Vector3D p = p0 + 0.5 * (lo + hi) * dir;
+            if ( s->insideBounds(p, eps) )
+              crossings.emplace_back(SurfaceIntersection { s, p, 0.5 * (lo + hi) * len });
+          }
+          ta = tb;
+          fa = fb;
+        }
+      };
+      // A crossing close to the edge of the surface bounds may be rejected by one method only
+      auto near_bounds = [eps](const SurfaceIntersection& c)  {
+        const double delta = 10. * eps;
+        Vector3D u = c.surface->u(c.point), v = c.surface->v(c.point);
+        for( const Vector3D& d : { u, -u, v, -v } )
+          if ( !c.surface->insideBounds(c.point + delta * d, eps) ) return true;
+        return false;
+      };
+      long num_reference = 0, num_near_bounds = 0, num_ref_errors = 0;
+      for( std::size_t i = 0; i < tracks.size(); ++i )  {
+        std::vector<SurfaceIntersection> ref;
+        for( ISurface* s : all )
+          reference(s, tracks[i].first, tracks[i].second, ref);
+        num_reference += ref.size();
+        std::vector<bool> used(ref.size(), false);
+        for( const auto& c : fast[i] )  {
+          bool matched = false;
+          for( std::size_t j = 0; j < ref.size() && !matched; ++j )  {
+            if ( !used[j] && ref[j].surface == c.surface && std::fabs(ref[j].path - c.path) < 10. * eps )
+              used[j] = matched = true;
+          }
+          if ( !matched )
+            near_bounds(c) ? ++num_near_bounds : ++num_ref_errors;
+        }
+        for( std::size_t j = 0; j < ref.size(); ++j )  {
+          if ( !used[j] )
+            near_bounds(ref[j]) ? ++num_near_bounds : ++num_ref_errors;
+        }
+      }
+      printout(INFO,"SurfaceBVHBenchmark","+++ Reference scan (%.2f mm steps): %ld crossings, %ld unmatched at the surface bounds.",
+               step/dd4hep::mm, num_reference, num_near_bounds);
+      if ( num_ref_errors > 0 )  {
+        printout(ERROR,"SurfaceBVHBenchmark","+++ %ld differences between the crossings and the reference scan.", num_ref_errors);
+        num_errors += num_ref_errors;
+      }
+
+      // Point location
+      std::vector<ISurface*> found_fast, found_slow;
+      start = clock_type::now();
+      for( const auto& p : points )
+        found_fast.emplace_back(bvh->find(p, eps));
+      std::chrono::duration<double, std::micro> p_fast = clock_type::now() - start;
+
+      start = clock_type::now();
+      for( const auto& p : points )  {
+        ISurface* found = nullptr;
+        double    best  = std::numeric_limits<double>::max();
+        for( ISurface* s : all )  {
+          if ( s->insideBounds(p, eps) && std::fabs(s->distance(p)) < best )  {
+            best  = std::fabs(s->distance(p));
+            found = s;
+          }
+        }
+        found_slow.emplace_back(found);
+      }
+      std::chrono::duration<double, std::micro> p_slow = clock_type::now() - start;
+      for( std::size_t i = 0; i < points.size(); ++i )  {
+        // Overlapping surfaces may be equally close: either one is correct
+        if ( found_fast[i] != found_slow[i] &&
+             !(found_fast[i] && found_slow[i] &&
+               std::fabs(found_fast[i]->distance(points[i])) == std::fabs(found_slow[i]->distance(points[i]))) )
+          ++num_errors;
+      }
+      double npts = std::max(1.0, double(points.size()));
+      printout(INFO,"SurfaceBVHBenchmark","+++ %ld points located.       BVH: %8.3f us/point  Brute force: %8.3f us/point",
+               long(points.size()), p_fast.count()/npts, p_slow.count()/npts);
+
+      if ( num_errors > 0 )  {
+        printout(ERROR,"SurfaceBVHBenchmark","+++ %ld differences between BVH and brute force results.", num_errors);
+        return 0;
+      }
+      printout(ALWAYS,"SurfaceBVHBenchmark","+++ BVH results identical to brute force. Speedup: tracks %.1f points %.1f",
+               t_slow.count()/std::max(t_fast.count(), 1e-9), p_slow.count()/std::max(p_fast.count(), 1e-9));
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_SurfaceBVHBenchmark, dd4hep::rec::surfaceBVHBenchmark )
@@ -0,0 +1,251 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include "DDRec/SurfaceManager.h"
+#include "DDRec/SurfaceCache.h"
+
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace dd4hep{
+  namespace rec{
+
+    /// Benchmark of the precomputed surface records against the ISurface calls
+    /**
+     *  For every surface of a surface map points are generated on the surface
+     *  (from random local coordinates) and smeared along the normal. distance,
+     *  globalToLocal, localToGlobal and insideBounds are evaluated with the
+     *  SurfaceCache, single and batched, and with the virtual ISurface calls.
+     *  distance, globalToLocal and localToGlobal must agree within the given
+     *  relative tolerance: the cache evaluates the same formulas in a different
+     *  order, so results may differ by rounding. insideBounds must be identical,
+     *  except for points within the tolerance of the bounds, where rounding may
+     *  flip the result.
+     *  Lengths are compared relative to the larger of the reference value and
+     *  the distance of the point from the origin (at least 1 mm), which is the
+     *  scale of the rounding errors of the coordinate differences.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long surfaceCacheBenchmark(Detector& description, int argc, char** argv) {
+      typedef std::chrono::high_resolution_clock clock_type;
+      std::string name      = "world";
+      int         npoints   = 100;
+      int         seed      = 12345;
+      double      tolerance = 1e-12;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-map",argv[i],4) )
+          name = argv[++i];
+        else if ( 0 == ::strncmp("-points",argv[i],4) )
+          npoints = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-seed",argv[i],4) )
+          seed = ::atol(argv[++i]);
+        else if ( 0 == ::strncmp("-tolerance",argv[i],4) )
+          tolerance = ::atof(argv[++i]);
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_SurfaceCacheBenchmark  -arg [-arg]                    \n\n"
+            "     Compare the precomputed surface records with the ISurface calls.         \n\n"
+            "     -map       <string> Name of the surface map. Default: 'world'            \n"
+            "     -points    <number> Number of points per surface. Default: 100           \n"
+            "     -seed      <number> Random number seed. Default: 12345                   \n"
+            "     -tolerance <number> Relative tolerance of lengths. Default: 1e-12        \n"
+            "     -help               Print this help output  \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+          ::exit(EINVAL);
+        }
+      }
+      SurfaceManager* mgr = description.extension<SurfaceManager>(false);
+      if ( !mgr )  {
+        mgr = description.addExtension<SurfaceManager>(new SurfaceManager(description));
+      }
+      auto start = clock_type::now();
+      const SurfaceCache* cache = mgr->cache(name);
+      std::chrono::duration<double, std::milli> t_build = clock_type::now() - start;
+      if ( !cache )  {
+        except("SurfaceCacheBenchmark","+++ No surface map with name: %s", name.c_str());
+      }
+      std::size_t nsurf = cache->size(), counts[3] = {0, 0, 0};
+      for( std::size_t i = 0; i < nsurf; ++i )
+        ++counts[cache->record(i).kind];
+      printout(INFO,"SurfaceCacheBenchmark","+++ Map %s: %ld surfaces (%ld planes, %ld cylinders, %ld generic). Build time: %.2f ms",
+               name.c_str(), long(nsurf), long(counts[SurfaceRecord::Plane]),
+               long(counts[SurfaceRecord::Cylinder]), long(counts[SurfaceRecord::Generic]), t_build.count());
+
+      // Points on and close to every surface
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> flat(-1.0, 1.0);
+      std::vector<std::vector<double> > points(nsurf);
+      for( std::size_t i = 0; i < nsurf; ++i )  {
+        ISurface* s = cache->surface(i);
+        double lu = std::max(s->length_along_u(), 1.0 * dd4hep::mm);
+        double lv = std::max(s->length_along_v(), 1.0 * dd4hep::mm);
+        for( int j = 0; j < npoints; ++j )  {
+          Vector2D uv(0.5 * lu * flat(gen), 0.5 * lv * flat(gen));
+          Vector3D p = s->localToGlobal(uv) + (j%2 ? 0.0 : 1e-5 * flat(gen)) * s->normal();
+          points[i].insert(points[i].end(), p.const_array(), p.const_array() + 3);
+        }
+      }
+
+      // Lengths agree if they differ by less than tolerance relative to max(|reference|, |point|, 1 mm)
+      double max_dev = 0.0;
+      auto compare = [tolerance, &max_dev](const double* value, const double* ref, std::size_t n, const double* pt)  {
+        double scale = std::max(std::sqrt(pt[0]*pt[0] + pt[1]*pt[1] + pt[2]*pt[2]), 1.0 * dd4hep::mm);
+        long   bad   = 0;
+        for( std::size_t m = 0; m < n; ++m )  {
+          double dev = std::abs(value[m] - ref[m]) / std::max(std::abs(ref[m]), scale);
+          max_dev = std::max(max_dev, dev);
+          bad += dev > tolerance ? 1 : 0;
+        }
+        return bad;
+      };
+      // insideBounds may flip for points within the tolerance of the bounds: a point is
+      // ambiguous if a shift along one of the axes by sqrt(3) times the tolerance changes
+      // the reference result (any bound closer than the tolerance is crossed by one shift).
+      long num_ambiguous = 0;
+      auto compare_in = [tolerance, &num_ambiguous](ISurface* s, bool value, bool ref, const double* pt)  {
+        if ( value == ref ) return 0L;
+        double scale = std::max(std::sqrt(pt[0]*pt[0] + pt[1]*pt[1] + pt[2]*pt[2]), 1.0 * dd4hep::mm);
+        double delta = std::sqrt(3.0) * tolerance * scale;
+        for( int m = 0; m < 6; ++m )  {
+          Vector3D p(pt);
+          p[m/2] += m%2 ? delta : -delta;
+          if ( s->insideBounds(p) != ref )  {
+            ++num_ambiguous;
+            return 0L;
+          }
+        }
+        return 1L;
+      };
+
+      // Reference values from the ISurface calls
+      std::size_t ntot = nsurf * npoints;
+      std::vector<double> dist_ref(ntot), uv_ref(2*ntot);
+      std::vector<unsigned char> in_ref(ntot);
+      start = clock_type::now();
+      for( std::size_t i = 0, k = 0; i < nsurf; ++i )  {
+        ISurface* s = cache->surface(i);
+        for( int j = 0; j < npoints; ++j, ++k )  {
+          Vector3D p(&points[i][3*j]);
+          Vector2D uv = s->globalToLocal(p);
+          dist_ref[k]   = s->distance(p);
+          uv_ref[2*k]   = uv[0];
+          uv_ref[2*k+1] = uv[1];
+          in_ref[k]     = s->insideBounds(p);
+        }
+      }
+      std::chrono::duration<double, std::micro> t_virt = clock_type::now() - start;
+
+      // Differences of cache results to the references
+      auto compare_all = [&](const std::vector<double>& d, const std::vector<double>& l, const std::vector<unsigned char>& b)  {
+        long bad = 0;
+        for( std::size_t i = 0, k = 0; i < nsurf; ++i )  {
+          ISurface* s = cache->surface(i);
+          for( int j = 0; j < npoints; ++j, ++k )  {
+            const double* pt = &points[i][3*j];
+            bad += compare(&d[k], &dist_ref[k], 1, pt) + compare(&l[2*k], &uv_ref[2*k], 2, pt)
+              +    compare_in(s, b[k], in_ref[k], pt);
+          }
+        }
+        return bad;
+      };
+
+      // Single point calls of the cache
+      long num_errors = 0;
+      std::vector<double> dist(ntot), uv(2*ntot);
+      std::vector<unsigned char> in(ntot);
+      start = clock_type::now();
+      for( std::size_t i = 0, k = 0; i < nsurf; ++i )  {
+        for( int j = 0; j < npoints; ++j, ++k )  {
+          Vector3D p(&points[i][3*j]);
+          Vector2D l = cache->globalToLocal(i, p);
+          dist[k]   = cache->distance(i, p);
+          uv[2*k]   = l[0];
+          uv[2*k+1] = l[1];
+          in[k]     = cache->insideBounds(i, p);
+        }
+      }
+      std::chrono::duration<double, std::micro> t_single = clock_type::now() - start;
+      num_errors += compare_all(dist, uv, in);
+
+      // Batched calls of the cache: many points against one surface
+      start = clock_type::now();
+      for( std::size_t i = 0; i < nsurf; ++i )  {
+        cache->distance(i, points[i].data(), npoints, &dist[i*npoints]);
+        cache->globalToLocal(i, points[i].data(), npoints, &uv[2*i*npoints]);
+        cache->insideBounds(i, points[i].data(), npoints, &in[i*npoints]);
+      }
+      std::chrono::duration<double, std::micro> t_batch = clock_type::now() - start;
+      num_errors += compare_all(dist, uv, in);
+
+      // Batched calls of the cache: one point against all surfaces
+      std::vector<double> all_dist(nsurf);
+      std::vector<unsigned char> all_in(nsurf);
+      for( std::size_t i = 0; i < nsurf; i += std::max(std::size_t(1), nsurf/10) )  {
+        Vector3D p(&points[i][0]);
+        cache->distance(p, all_dist.data());
+        cache->insideBounds(p, all_in.data());
+        for( std::size_t j = 0; j < nsurf; ++j )  {
+          ISurface* s = cache->surface(j);
+          double ref = s->distance(p);
+          num_errors += compare(&all_dist[j], &ref, 1, p.const_array())
+            +           compare_in(s, all_in[j], s->insideBounds(p), p.const_array());
+        }
+      }
+
+      // localToGlobal within tolerance
+      double max_dev_l2g = 0.0;
+      for( std::size_t i = 0, k = 0; i < nsurf; ++i )  {
+        ISurface* s = cache->surface(i);
+        for( int j = 0; j < npoints; ++j, ++k )  {
+          Vector2D l(uv_ref[2*k], uv_ref[2*k+1]);
+          Vector3D g_ref = s->localToGlobal(l);
+          Vector3D g     = cache->localToGlobal(i, l);
+          max_dev_l2g = std::max(max_dev_l2g, (g - g_ref).r() / std::max(g_ref.r(), 1.0 * dd4hep::mm));
+        }
+      }
+      if ( max_dev_l2g > tolerance )  {
+        printout(ERROR,"SurfaceCacheBenchmark","+++ localToGlobal deviates by %g (relative). Tolerance: %g",
+                 max_dev_l2g, tolerance);
+        ++num_errors;
+      }
+      double np = std::max(1.0, double(ntot));
+      printout(INFO,"SurfaceCacheBenchmark","+++ %ld points. ISurface: %7.3f us/point  Cache: %7.3f us/point  Batched: %7.3f us/point",
+               long(ntot), t_virt.count()/np, t_single.count()/np, t_batch.count()/np);
+      printout(INFO,"SurfaceCacheBenchmark","+++ %ld insideBounds differences within the tolerance of the bounds.",
+               num_ambiguous);
+
+      if ( num_errors > 0 )  {
+        printout(ERROR,"SurfaceCacheBenchmark","+++ %ld differences between SurfaceCache and ISurface results. "
+                 "Max. relative deviation: %g Tolerance: %g", num_errors, max_dev, tolerance);
+        return 0;
+      }
+      printout(ALWAYS,"SurfaceCacheBenchmark","+++ SurfaceCache results agree with ISurface. Max. relative deviation: %g "
+               "localToGlobal: %g [tolerance %g]. Speedup: %.1f batched: %.1f",
+               max_dev, max_dev_l2g, tolerance, t_virt.count()/std::max(t_single.count(), 1e-9), t_virt.count()/std::max(t_batch.count(), 1e-9));
+      return 1;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_SurfaceCacheBenchmark, dd4hep::rec::surfaceCacheBenchmark )
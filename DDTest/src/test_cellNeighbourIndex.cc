@@ -0,0 +1,240 @@
+#include "DD4hep/DDTest.h"
+
+#include "DDRec/CellNeighbourIndex.h"
+#include "DDRec/DetectorData.h"
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/GridPhiEta.h"
+#include "DDSegmentation/HexGrid.h"
+#include "DDSegmentation/CylindricalGridPhiZ.h"
+#include "DDSegmentation/PolarGridRPhi2.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <exception>
+#include <set>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::DDSegmentation ;
+using dd4hep::rec::CellNeighbourIndex ;
+using dd4hep::rec::NeighbourSurfacesIndex ;
+
+// this should be the first line in your test
+static DDTest test( "cellNeighbourIndex" ) ;
+
+//=============================================================================
+
+static const char* encoding = "system:8,layer:8,x:-16,y:-16" ;
+
+/// Neighbours from the index as a set
+set<CellID> lookup( const CellNeighbourIndex& idx, CellID cell, int selection ){
+  CellID buffer[64] ;
+  size_t n = idx.neighbours( cell, buffer, 64, selection ) ;
+  return set<CellID>( buffer, buffer + min( n, size_t(64) ) ) ;
+}
+
+CellID makeCell( const Segmentation& seg, long layer, const char* u, long iu, const char* v, long iv ){
+  CellID cell = 0 ;
+  seg.decoder()->set( cell, "layer", layer ) ;
+  seg.decoder()->set( cell, u, iu ) ;
+  seg.decoder()->set( cell, v, iv ) ;
+  return cell ;
+}
+
+void testCartesian(){
+  CartesianGridXY seg( encoding ) ;
+  seg.setGridSizeX( 1.0 ) ;
+  seg.setGridSizeY( 1.0 ) ;
+  CellNeighbourIndex idx( seg ) ;
+  CellNeighbourIndex diag( seg, "layer", true ) ;
+  bool same = true, cross = true, diagonal = true ;
+  for( long l = 0 ; l < 3 ; ++l ){
+    for( long ix = -3 ; ix <= 3 ; ++ix ){
+      for( long iy = -3 ; iy <= 3 ; ++iy ){
+        CellID cell = makeCell( seg, l, "x", ix, "y", iy ) ;
+        set<CellID> expected ;
+        seg.neighbours( cell, expected ) ;
+        same = same && lookup( idx, cell, CellNeighbourIndex::SAME_LAYER ) == expected ;
+        cross = cross && lookup( idx, cell, CellNeighbourIndex::PREV_LAYER ).size() == ( l > 0 ? 1u : 0u )
+          && lookup( idx, cell, CellNeighbourIndex::NEXT_LAYER ) == set<CellID>{ makeCell( seg, l+1, "x", ix, "y", iy ) } ;
+        diagonal = diagonal && lookup( diag, cell, CellNeighbourIndex::ALL_LAYERS ).size() == ( l > 0 ? 26u : 17u ) ;
+      }
+    }
+  }
+  test( same, " CartesianGridXY: same layer neighbours agree with Segmentation::neighbours " ) ;
+  test( cross, " CartesianGridXY: cross layer neighbours " ) ;
+  test( diagonal, " CartesianGridXY: 3x3x3 neighbourhood with diagonals " ) ;
+
+  // Upper field boundary: no neighbours outside the field range
+  CellID edge = makeCell( seg, 0, "x", 32767, "y", 0 ) ;
+  test( lookup( idx, edge, CellNeighbourIndex::SAME_LAYER ).size(), size_t(3), " CartesianGridXY: cell at the field boundary " ) ;
+
+  // Truncation: the number of neighbours is returned even if the buffer is too small
+  CellID buffer[2] ;
+  test( idx.neighbours( makeCell( seg, 1, "x", 0, "y", 0 ), buffer, 2 ), size_t(6), " CartesianGridXY: count with small buffer " ) ;
+  test( idx.maxNeighbours() >= 6 && diag.maxNeighbours() >= 26, " CartesianGridXY: maximal number of neighbours " ) ;
+
+  // Timing compared to Segmentation::neighbours
+  const long num_calls = 200000 ;
+  size_t sum = 0 ;
+  auto start = chrono::high_resolution_clock::now() ;
+  for( long i = 0 ; i < num_calls ; ++i ){
+    set<CellID> nb ;
+    seg.neighbours( makeCell( seg, 1, "x", i%100, "y", i%37 ), nb ) ;
+    sum += nb.size() ;
+  }
+  chrono::duration<double, nano> t_seg = chrono::high_resolution_clock::now() - start ;
+  start = chrono::high_resolution_clock::now() ;
+  for( long i = 0 ; i < num_calls ; ++i ){
+    CellID nb[8] ;
+    sum += idx.neighbours( makeCell( seg, 1, "x", i%100, "y", i%37 ), nb, 8, CellNeighbourIndex::SAME_LAYER ) ;
+  }
+  chrono::duration<double, nano> t_idx = chrono::high_resolution_clock::now() - start ;
+  cout << "    Segmentation::neighbours: " << t_seg.count()/num_calls << " ns/call   CellNeighbourIndex: "
+       << t_idx.count()/num_calls << " ns/call (" << sum << ")" << endl ;
+}
+
+void testPhiGrids(){
+  GridPhiEta eta( "system:8,layer:8,eta:-16,phi:-16" ) ;
+  eta.setPhiBins( 8 ) ;
+  eta.setGridSizeEta( 0.1 ) ;
+  eta.setOffsetPhi( M_PI/8.0 ) ;
+  CellNeighbourIndex idx( eta ) ;
+  // Cells at the upper and lower phi edge are neighbours
+  CellID low  = eta.cellID( Vector3D(), Vector3D( -1.0, -0.01, 0.0 ), 0 ) ;
+  CellID high = eta.cellID( Vector3D(), Vector3D( -1.0,  0.01, 0.0 ), 0 ) ;
+  test( low != high && lookup( idx, low, CellNeighbourIndex::SAME_LAYER ).count( high ) == 1
+        && lookup( idx, high, CellNeighbourIndex::SAME_LAYER ).count( low ) == 1, " GridPhiEta: phi wraps around " ) ;
+
+  CylindricalGridPhiZ phiz( "system:8,layer:8,phi:-16,z:-16" ) ;
+  phiz.setGridSizePhi( 2.0*M_PI/12.0 ) ;
+  phiz.setGridSizeZ( 1.0 ) ;
+  phiz.setRadius( 10.0 ) ;
+  CellNeighbourIndex pz( phiz ) ;
+  low  = phiz.cellID( Vector3D(  1.0, -0.01, 0.0 ), Vector3D(), 0 ) ;
+  high = phiz.cellID( Vector3D(  1.0,  0.1, 0.0 ), Vector3D(), 0 ) ;
+  // Phi starts in the middle of bin 0: the upper half of the cell has the index 12
+  set<CellID> nb = lookup( pz, low, CellNeighbourIndex::SAME_LAYER ) ;
+  test( phiz.decoder()->get( low, "phi" ) == 12 && phiz.decoder()->get( high, "phi" ) == 0, " CylindricalGridPhiZ: split cell " ) ;
+  test( nb.size() == 7 && nb.count( high ) == 1, " CylindricalGridPhiZ: phi wraps around " ) ;
+}
+
+void testHexagonal(){
+  HexGrid seg( encoding ) ;
+  seg.setSideLength( 1.0 ) ;
+  seg.setStagger( 0 ) ;
+  CellNeighbourIndex idx( seg ) ;
+  bool ok = true ;
+  for( long ix = -4 ; ix <= 4 ; ++ix ){
+    for( long iy = -4 ; iy <= 4 ; ++iy ){
+      if ( (ix + iy) & 1 ) continue ;
+      CellID cell = makeCell( seg, 1, "x", ix, "y", iy ) ;
+      Vector3D c = seg.position( cell ) ;
+      set<CellID> expected ;
+      for( int k = 0 ; k < 6 ; ++k ){
+        double a = M_PI/6.0 + k*M_PI/3.0 ;
+        Vector3D p( c.X + sqrt(3.0)*cos(a), c.Y + sqrt(3.0)*sin(a), c.Z ) ;
+        expected.insert( seg.cellID( p, p, cell ) ) ;
+      }
+      ok = ok && lookup( idx, cell, CellNeighbourIndex::SAME_LAYER ) == expected ;
+    }
+  }
+  test( ok, " HexGrid: the 6 cells sharing an edge " ) ;
+
+  // Staggered layers: all cells of the adjacent layers overlapping the cell are found
+  for( int stagger = 1 ; stagger <= 2 ; ++stagger ){
+    HexGrid stag( encoding ) ;
+    stag.setSideLength( 1.0 ) ;
+    stag.setStagger( stagger ) ;
+    CellNeighbourIndex sidx( stag ) ;
+    ok = true ;
+    for( long l = 1 ; l < 6 ; ++l ){
+      for( long ix = -2 ; ix <= 2 ; ++ix ){
+        CellID cell = makeCell( stag, l, "x", ix, "y", ix & 1 ) ;
+        Vector3D c = stag.position( cell ) ;
+        set<CellID> nb = lookup( sidx, cell, CellNeighbourIndex::PREV_LAYER | CellNeighbourIndex::NEXT_LAYER ) ;
+        for( int k = 0 ; k < 36 ; ++k ){
+          for( double r : { 0.0, 0.4, 0.8 } ){
+            Vector3D p( c.X + r*cos(k*M_PI/18.0), c.Y + r*sin(k*M_PI/18.0), c.Z ) ;
+            for( long dl : { -1, 1 } ){
+              CellID adj = cell ;
+              stag.decoder()->set( adj, "layer", l + dl ) ;
+              ok = ok && nb.count( stag.cellID( p, p, adj ) ) == 1 ;
+            }
+          }
+        }
+      }
+    }
+    test( ok, string(" HexGrid: overlapping cells in staggered layers, stagger ") + char('0'+stagger) ) ;
+  }
+}
+
+void testPolar(){
+  PolarGridRPhi2 seg( "system:8,layer:8,r:16,phi:16" ) ;
+  const double deg = M_PI/180.0 ;
+  seg.setGridRValues( { 10.0, 20.0, 30.0, 40.0, 50.0 } ) ;
+  seg.setGridPhiValues( { 30.0*deg, 20.0*deg, 7.0*deg, 45.0*deg } ) ;
+  seg.setOffsetPhi( -M_PI ) ;
+  CellNeighbourIndex idx( seg ) ;
+  const double rb[] = { 10.0, 20.0, 30.0, 40.0, 50.0 } ;
+  bool ok = true ;
+  for( long ir = 0 ; ir < 4 ; ++ir ){
+    const double w = seg.gridPhiValues()[ir] ;
+    const long nphi = long( ceil( 2.0*M_PI/w - 1e-9 ) ) ;
+    for( long ip = 0 ; ip < nphi ; ++ip ){
+      CellID cell = makeCell( seg, 1, "r", ir, "phi", ip ) ;
+      // Brute force: cells just across the ring and phi boundaries
+      set<CellID> expected ;
+      const double lo = -M_PI + ip*w, hi = -M_PI + min( (ip+1)*w, 2.0*M_PI ) ;
+      for( int k = 1 ; k < 200 ; ++k ){
+        double phi = lo + (hi - lo)*k/200.0 ;
+        for( double r : { rb[ir] - 0.01, rb[ir+1] + 0.01 } ){
+          if ( r < rb[0] || r > rb[4] ) continue ;
+          expected.insert( seg.cellID( Vector3D( r*cos(phi), r*sin(phi), 0.0 ), Vector3D(), cell ) ) ;
+        }
+      }
+      const double rc = 0.5*( rb[ir] + rb[ir+1] ) ;
+      for( double phi : { lo - 1e-4, hi + 1e-4 } ){
+        expected.insert( seg.cellID( Vector3D( rc*cos(phi), rc*sin(phi), 0.0 ), Vector3D(), cell ) ) ;
+      }
+      ok = ok && lookup( idx, cell, CellNeighbourIndex::SAME_LAYER ) == expected ;
+    }
+  }
+  test( ok, " PolarGridRPhi2: phi neighbours and overlapping cells of the adjacent rings " ) ;
+}
+
+void testSurfaces(){
+  dd4hep::rec::NeighbourSurfacesStruct data ;
+  data.sameLayer[ 5 ] = { 4, 6 } ;
+  data.prevLayer[ 5 ] = { 15 } ;
+  data.nextLayer[ 5 ] = { 25, 26 } ;
+  data.nextLayer[ 1 ] = { 11 } ;
+  NeighbourSurfacesIndex idx( data ) ;
+  CellID buffer[8] ;
+  test( idx.size(), size_t(2), " NeighbourSurfacesIndex: number of cells " ) ;
+  test( idx.neighbours( 5, buffer, 8 ), size_t(5), " NeighbourSurfacesIndex: all neighbours " ) ;
+  test( buffer[0] == 4 && buffer[1] == 6 && buffer[2] == 15 && buffer[3] == 25, " NeighbourSurfacesIndex: order same, previous, next " ) ;
+  test( idx.neighbours( 5, buffer, 8, CellNeighbourIndex::NEXT_LAYER ), size_t(2), " NeighbourSurfacesIndex: next layer " ) ;
+  test( idx.neighbours( 1, buffer, 8, CellNeighbourIndex::SAME_LAYER ), size_t(0), " NeighbourSurfacesIndex: no same layer neighbours " ) ;
+  test( idx.neighbours( 2, buffer, 8 ), size_t(0), " NeighbourSurfacesIndex: unknown cell " ) ;
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  test.log( "test cell neighbour index" );
+
+  try{
+    testCartesian() ;
+    testPhiGrids() ;
+    testHexagonal() ;
+    testPolar() ;
+    testSurfaces() ;
+  } catch( exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
+
+//=============================================================================
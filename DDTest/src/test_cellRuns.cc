@@ -0,0 +1,103 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Shapes.h"
+
+#include "DDDigi/segmentations/CartesianGridXY.h"
+#include "DDDigi/segmentations/CartesianGridXYZ.h"
+
+#include <set>
+#include <tuple>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::digi ;
+
+// this should be the first line in your test
+static DDTest test( "cellRuns" ) ;
+
+//=============================================================================
+
+typedef set<tuple<long, long, long> > Cells ;
+
+/// Bins of the analytically enumerated cells
+template <typename SEGMENTATION> Cells analytic( const segmentation_data<SEGMENTATION>& seg, Solid solid, bool xyz ){
+  Cells cells ;
+  create_cell_runs( seg, solid )->scan( 0, [&]( CellID, const DigiCellRuns::row_t& row, long bin ){
+      cells.emplace( row.bins[0], xyz ? row.bins[1] : bin, xyz ? bin : 0 ) ;
+    } ) ;
+  return cells ;
+}
+
+/// Bins of the cells with the center inside the solid, probed with Contains()
+Cells probed( Solid solid, const double grid[3], const double offset[3], bool xyz ){
+  const TGeoBBox* box = static_cast<const TGeoBBox*>( solid.ptr() ) ;
+  const double ext[3] = { box->GetDX(), box->GetDY(), box->GetDZ() } ;
+  long lim[3] ;
+  for( int i = 0 ; i < 3 ; ++i ) lim[i] = long( ext[i] / grid[i] ) + 2 ;
+  Cells cells ;
+  double pos[3] = { 0e0, 0e0, 0e0 } ;
+  for( long bx = -lim[0] ; bx <= lim[0] ; ++bx ){
+    pos[0] = bx * grid[0] + offset[0] ;
+    for( long by = -lim[1] ; by <= lim[1] ; ++by ){
+      pos[1] = by * grid[1] + offset[1] ;
+      for( long bz = xyz ? -lim[2] : 0 ; bz <= ( xyz ? lim[2] : 0 ) ; ++bz ){
+        pos[2] = xyz ? bz * grid[2] + offset[2] : 0e0 ;
+        if( solid->Contains( pos ) ) cells.emplace( bx, by, bz ) ;
+      }
+    }
+  }
+  return cells ;
+}
+
+int main(int, char** ){
+
+  test.log( "test analytic cell enumeration of cartesian grids against probing the cell centers" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    const double grid[3]   = { 1.0, 0.75, 1.0 } ;
+    const double offset[3] = { 0.5, 0.0,  0.5 } ;
+
+    segmentation_data<CartesianGridXY> xy ;
+    xy.x_grid_size = grid[0] ;  xy.x_offset = offset[0] ;
+    xy.y_grid_size = grid[1] ;  xy.y_offset = offset[1] ;
+    xy.x_f_offset  = 0 ;        xy.x_mask   = 0xFFFFUL ;
+    xy.y_f_offset  = 16 ;       xy.y_mask   = 0xFFFF0000UL ;
+
+    segmentation_data<CartesianGridXYZ> xyz ;
+    xyz.x_grid_size = grid[0] ;  xyz.x_offset = offset[0] ;
+    xyz.y_grid_size = grid[1] ;  xyz.y_offset = offset[1] ;
+    xyz.z_grid_size = grid[2] ;  xyz.z_offset = offset[2] ;
+    xyz.x_f_offset  = 0 ;        xyz.x_mask   = 0xFFFFUL ;
+    xyz.y_f_offset  = 16 ;       xyz.y_mask   = 0xFFFF0000UL ;
+    xyz.z_f_offset  = 32 ;       xyz.z_mask   = 0xFFFF00000000UL ;
+
+    // The box has cell centers exactly on its boundary in x and z
+    const vector<pair<string, Solid> > solids = {
+      { "box",         Box ( 5.5, 3.3, 2.5 ) },
+      { "tube",        Tube( 0.0, 10.3, 2.0 ) },
+      { "hollow tube", Tube( 3.7, 10.3, 2.0 ) }
+    } ;
+    for( const auto& s : solids ){
+      Cells ref_xy  = probed( s.second, grid, offset, false ) ;
+      Cells ref_xyz = probed( s.second, grid, offset, true ) ;
+      test( ref_xy.empty() || ref_xyz.empty(), false, " " + s.first + ": cells found by probing " ) ;
+      test( analytic( xy,  s.second, false ) == ref_xy,  true, " " + s.first + ": CartesianGridXY analytic == probed " ) ;
+      test( analytic( xyz, s.second, true  ) == ref_xyz, true, " " + s.first + ": CartesianGridXYZ analytic == probed " ) ;
+    }
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
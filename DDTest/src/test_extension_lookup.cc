@@ -0,0 +1,125 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/DetElement.h"
+#include "DD4hep/detail/DetectorInterna.h"
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "extension_lookup" ) ;
+
+//=============================================================================
+
+/// Extension types: more than ObjectExtensions::NUM_INLINE_SLOTS to exercise the overflow slots
+struct ExtBase {
+  int value ;
+} ;
+template <int I> struct Ext : ExtBase {
+  Ext() : ExtBase { I } {}
+  Ext( const Ext& c, DetElement ) : ExtBase { c.value } {}
+} ;
+
+/// Register the extensions in ascending order. Slots are assigned at the first registration
+template <int I> void add( DetElement de ) {
+  if constexpr ( I > 0 ) add<I-1>( de ) ;
+  de.addExtension<Ext<I> >( new Ext<I>() ) ;
+}
+
+/// Slot index and key of the extension types
+struct Probe {
+  size_t slot ;
+  unsigned long long int key ;
+  int value ;
+} ;
+template <int I> void probes( vector<Probe>& p ) {
+  if constexpr ( I > 0 ) probes<I-1>( p ) ;
+  p.emplace_back( Probe { ObjectExtensions::slot<Ext<I> >(), detail::typeHash64<Ext<I> >(), I } ) ;
+}
+
+/// First extension with an inline slot (inline_slot=true) or with an overflow slot
+const Probe* find_probe( const vector<Probe>& p, bool inline_slot ) {
+  for( const auto& e : p )
+    if( ( e.slot < ObjectExtensions::NUM_INLINE_SLOTS ) == inline_slot ) return &e ;
+  return nullptr ;
+}
+
+template <int I> bool check( DetElement de ) {
+  bool ok = de.extension<Ext<I> >()->value == I
+    && de.extension<Ext<I> >() == de.extension( detail::typeHash64<Ext<I> >(), true ) ;
+  if constexpr ( I > 0 ) ok = ok && check<I-1>( de ) ;
+  return ok ;
+}
+
+/// Time a lookup and print the average time per call
+template <typename FUNC> void measure( const char* tag, long num_calls, FUNC func ){
+  auto start = chrono::high_resolution_clock::now() ;
+  for( long i = 0 ; i < num_calls ; ++i ) func() ;
+  chrono::duration<double, nano> ns = chrono::high_resolution_clock::now() - start ;
+  cout << "    " << tag << ns.count()/double(num_calls) << " ns/call" << endl ;
+}
+
+int main(int argc, char** argv ){
+
+  test.log( "test extension lookup" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    long num_calls = argc > 1 ? atol( argv[1] ) : 10000000 ;
+    DetElement de( "test", 1 ) ;
+    add<11>( de ) ;
+
+    test( check<11>( de ), true , " extensions accessible by slot and by key " ) ;
+
+    // Slots are process wide: other extension types may have been registered before
+    vector<Probe> all ;
+    probes<11>( all ) ;
+    const Probe* in  = find_probe( all, true ) ;
+    const Probe* ovf = find_probe( all, false ) ;
+    test( ovf != nullptr, true , " extensions with overflow slots present " ) ;
+
+    volatile void* result = nullptr ;
+    for( const Probe* p : { in, ovf } ){
+      if( !p ) continue ;
+      bool inl = p == in ;
+      measure( inl ? "Lookup by type hash (inline slot):   " : "Lookup by type hash (overflow slot): ", num_calls, [&] {
+          result = de.extension( p->key, true ) ;
+        } ) ;
+      measure( inl ? "Lookup by slot      (inline slot):   " : "Lookup by slot      (overflow slot): ", num_calls, [&] {
+          result = de.extension( p->slot, p->key, true ) ;
+        } ) ;
+    }
+
+    // Removal of an inline and of an overflow slot
+    for( const Probe* p : { in, ovf } ){
+      if( !p ) continue ;
+      string tag = p == in ? "inline" : "overflow" ;
+      de->removeExtension( p->key, true ) ;
+      test( de.extension( p->slot, p->key, false ) == nullptr, true , " removed extension (" + tag + " slot) is no longer accessible " ) ;
+      test( de.extension( p->key, false ) == nullptr, true , " removed extension (" + tag + " slot) is not found by key " ) ;
+    }
+    bool remaining = true ;
+    for( const auto& p : all ){
+      if( &p == in || &p == ovf ) continue ;
+      const void* e = de.extension( p.slot, p.key, false ) ;
+      remaining = remaining && e && static_cast<const ExtBase*>( e )->value == p.value ;
+    }
+    test( remaining, true , " remaining extensions are still accessible " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/HistogramAccumulator.h"
+
+#include "TH1F.h"
+#include "TH2F.h"
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "histogramAccumulator" ) ;
+
+//=============================================================================
+
+/// Compare bin contents, errors, entries and statistics of two histograms
+bool same( TH1* a, TH1* b ){
+  double sa[16] = { 0 }, sb[16] = { 0 } ;
+  a->GetStats( sa ) ;
+  b->GetStats( sb ) ;
+  for( int i = 0 ; i < 7 ; ++i )
+    if( abs( sa[i] - sb[i] ) > 1e-9 * max( 1.0, abs( sa[i] ) ) ) return false ;
+  if( a->GetEntries() != b->GetEntries() ) return false ;
+  for( int i = 0 ; i < a->GetNcells() ; ++i ){
+    // Bin contents are floats: direct filling rounds at every entry
+    if( abs( a->GetBinContent( i ) - b->GetBinContent( i ) ) > 1e-4 * max( 1.0, abs( a->GetBinContent( i ) ) ) ) return false ;
+    if( abs( a->GetBinError( i ) - b->GetBinError( i ) ) > 1e-4 * max( 1.0, a->GetBinError( i ) ) ) return false ;
+  }
+  return true ;
+}
+
+int main(int, char** ){
+
+  test.log( "test per-thread histogram accumulation" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    const int num_threads = 8, num_fills = 20000 ;
+    vector<vector<double> > values( num_threads ) ;
+    mt19937 gen( 12345 ) ;
+    normal_distribution<double> gauss( 0.0, 3.0 ) ;
+    for( auto& v : values )
+      for( int i = 0 ; i < 3*num_fills ; ++i ) v.push_back( gauss( gen ) ) ;
+
+    // 1D, unit weights: includes underflow and overflow entries
+    TH1F direct1( "direct1", "direct", 50, -5.0, 5.0 ) ;
+    TH1F merged1( "merged1", "merged", 50, -5.0, 5.0 ) ;
+    HistogramAccumulator acc1( 50, -5.0, 5.0 ) ;
+    // 2D, with weights
+    TH2F direct2( "direct2", "direct", 20, -5.0, 5.0, 30, -6.0, 6.0 ) ;
+    TH2F merged2( "merged2", "merged", 20, -5.0, 5.0, 30, -6.0, 6.0 ) ;
+    HistogramAccumulator acc2( 20, -5.0, 5.0, 30, -6.0, 6.0 ) ;
+
+    for( const auto& v : values ){
+      for( int i = 0 ; i < num_fills ; ++i ){
+        direct1.Fill( v[3*i] ) ;
+        direct2.Fill( v[3*i], v[3*i+1], abs( v[3*i+2] ) ) ;
+      }
+    }
+    vector<thread> threads ;
+    for( int t = 0 ; t < num_threads ; ++t ){
+      threads.emplace_back( [&, t] {
+          const auto& v = values[t] ;
+          for( int i = 0 ; i < num_fills ; ++i ){
+            acc1.fill( v[3*i] ) ;
+            acc2.fill( v[3*i], v[3*i+1], abs( v[3*i+2] ) ) ;
+          }
+        } ) ;
+    }
+    for( auto& t : threads ) t.join() ;
+    acc1.merge( &merged1 ) ;
+    acc2.merge( &merged2 ) ;
+
+    test( merged1.GetEntries(), double( num_threads * num_fills ), " 1D: all entries merged " ) ;
+    test( same( &direct1, &merged1 ), true, " 1D: merged histogram identical to direct filling " ) ;
+    test( merged2.GetSumw2N() > 0, true, " 2D: weighted entries enable Sumw2 " ) ;
+    test( same( &direct2, &merged2 ), true, " 2D: merged histogram identical to direct filling " ) ;
+
+    // Merging again adds nothing, further entries are added to the existing content
+    acc1.merge( &merged1 ) ;
+    test( same( &direct1, &merged1 ), true, " 1D: accumulator is reset after merge " ) ;
+    direct1.Fill( 1.0 ) ;
+    acc1.fill( 1.0 ) ;
+    acc1.merge( &merged1 ) ;
+    test( same( &direct1, &merged1 ), true, " 1D: entries added after merge " ) ;
+
+    // Threads started one after the other reuse the indices of terminated threads
+    const size_t num_sequential = 2 * HistogramAccumulator::MAX_THREADS ;
+    size_t max_index = 0 ;
+    for( size_t t = 0 ; t < num_sequential ; ++t ){
+      thread( [&] {
+          acc1.fill( 1.0 ) ;
+          max_index = max( max_index, HistogramAccumulator::threadIndex() ) ;
+        } ).join() ;
+      direct1.Fill( 1.0 ) ;
+    }
+    test( max_index < size_t( num_threads ), true, " thread indices of terminated threads are reused " ) ;
+    acc1.merge( &merged1 ) ;
+    test( same( &direct1, &merged1 ), true, " 1D: entries of sequential threads merged " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Detector.h"
+
+#include "DDDigi/DigiData.h"
+#include "DDDigi/DigiKernel.h"
+#include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiRandomGenerator.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::digi ;
+
+// this should be the first line in your test
+static DDTest test( "randomStream" ) ;
+
+//=============================================================================
+
+/// Known answer of the Philox4x32-10 bijection
+struct KnownAnswer {
+  DigiRandomStream::counter_t counter ;
+  DigiRandomStream::key_t     key ;
+  DigiRandomStream::counter_t result ;
+} ;
+
+/// Number of events, actions, channels and values per stream of the scheduling test
+const int num_events   = 16 ;
+const int num_actions  = 3 ;
+const int num_channels = 8 ;
+const int num_values   = 5 ;
+
+/// Slot of the values of one stream
+size_t slot( int event, int action, int channel ){
+  return ( ( size_t( event ) * num_actions + action ) * num_channels + channel ) * num_values ;
+}
+
+/// Fill the values of all streams of one event
+void fill( const DigiKernel& kernel, const vector<DigiAction*>& actions, int event, vector<double>& values ){
+  DigiContext context( kernel, make_unique<DigiEvent>( event ) ) ;
+  // Reverse order of actions and channels for odd events to vary the access pattern
+  for( int a = 0 ; a < num_actions ; ++a ){
+    int action = event % 2 ? num_actions - 1 - a : a ;
+    for( int c = 0 ; c < num_channels ; ++c ){
+      int channel = event % 2 ? num_channels - 1 - c : c ;
+      auto random = context.randomStream( *actions[action], channel ) ;
+      for( int i = 0 ; i < num_values ; ++i )
+        values[ slot( event, action, channel ) + i ] = random() ;
+    }
+  }
+}
+
+int main(int, char** ){
+
+  test.log( "test Philox4x32-10 known answers and thread independence of DigiContext::randomStream" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    // Known answer vectors of the Random123 distribution (kat_vectors)
+    const vector<KnownAnswer> kat = {
+      { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 },
+        { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+      { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+        { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+      { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+        { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+    } ;
+    for( size_t i = 0 ; i < kat.size() ; ++i ){
+      DigiRandomStream::counter_t result = DigiRandomStream::philox( kat[i].counter, kat[i].key ) ;
+      test( result == kat[i].result, true, " philox4x32-10 known answer " + to_string( i ) ) ;
+    }
+
+    // Streams of several events, actions and channels: sequential reference
+    DigiKernel& kernel = DigiKernel::instance( Detector::getInstance() ) ;
+    kernel.property( "randomSeed" ).set( 4711L ) ;
+    vector<DigiAction*> actions ;
+    for( int a = 0 ; a < num_actions ; ++a )
+      actions.push_back( new DigiAction( kernel, "Action_" + to_string( a ) ) ) ;
+
+    vector<double> reference( slot( num_events, 0, 0 ) ) ;
+    for( int event = 0 ; event < num_events ; ++event )
+      fill( kernel, actions, event, reference ) ;
+
+    // Same streams with events distributed over threads in reverse order
+    const int num_threads = 4 ;
+    vector<double> parallel( reference.size() ) ;
+    vector<thread> threads ;
+    for( int t = 0 ; t < num_threads ; ++t ){
+      threads.emplace_back( [&, t](){
+          for( int event = num_events - 1 - t ; event >= 0 ; event -= num_threads )
+            fill( kernel, actions, event, parallel ) ;
+        } ) ;
+    }
+    for( auto& t : threads ) t.join() ;
+    test( parallel == reference, true, " randomStream: values independent of thread scheduling " ) ;
+
+    // Streams of different events, actions and channels differ
+    test( reference[ slot( 0, 0, 0 ) ] != reference[ slot( 1, 0, 0 ) ], true, " randomStream: event dependence " ) ;
+    test( reference[ slot( 0, 0, 0 ) ] != reference[ slot( 0, 1, 0 ) ], true, " randomStream: action dependence " ) ;
+    test( reference[ slot( 0, 0, 0 ) ] != reference[ slot( 0, 0, 1 ) ], true, " randomStream: channel dependence " ) ;
+
+    // Streams from a kept per-event key are identical to the streams of the action
+    {
+      DigiContext context( kernel, make_unique<DigiEvent>( 3 ) ) ;
+      auto direct = context.randomStream( *actions[1], 7 ) ;
+      auto keyed  = context.randomStream( context.randomKey( *actions[1] ), 7 ) ;
+      test( direct() == keyed() && direct() == keyed(), true, " randomStream: per-event key " ) ;
+    }
+
+    // A different kernel seed changes the streams
+    kernel.property( "randomSeed" ).set( 4712L ) ;
+    vector<double> reseeded( reference.size() ) ;
+    fill( kernel, actions, 0, reseeded ) ;
+    test( reseeded[ slot( 0, 0, 0 ) ] != reference[ slot( 0, 0, 0 ) ], true, " randomStream: seed dependence " ) ;
+
+    for( auto* a : actions ) a->release() ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "DD4hep/DDTest.h"
+
+#include "DDDigi/noise/DigiSparseNoise.h"
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::digi ;
+
+// this should be the first line in your test
+static DDTest test( "sparseNoise" ) ;
+
+//=============================================================================
+
+/// Number of channels, noise sum, noise above threshold+sigma and index sum of one sampling
+struct Result {
+  double count = 0, sum = 0, far = 0, index = 0 ;
+} ;
+
+template <typename SAMPLE> Result run( const DigiSparseNoise& noise, size_t num_channels, int num_events, SAMPLE sample ){
+  Result r ;
+  for( int i = 0 ; i < num_events ; ++i ){
+    DigiRandomStream random( 4711, i ) ;
+    sample( random, num_channels, [&]( size_t index, double value ){
+        r.count += 1 ;
+        r.sum   += value ;
+        r.far   += value > noise.threshold + noise.sigma ? 1 : 0 ;
+        r.index += double( index ) ;
+      } ) ;
+  }
+  return r ;
+}
+
+/// Check that |a-b| is below 5 standard deviations
+bool compatible( double a, double b, double sigma ){
+  return abs( a - b ) < 5.0 * sigma ;
+}
+
+int main(int, char** ){
+
+  test.log( "test sparse noise sampling against dense noise plus zero suppression" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    const size_t num_channels = 1000000 ;
+    const int    num_events   = 20 ;
+    DigiSparseNoise noise( 0.1, 1.0, 3.1 ) ;
+
+    // Tail probability and conditional mean of the gaussian tail above threshold
+    const double z    = noise.threshold - noise.mean ;
+    const double tail = 0.5 * erfc( z / sqrt( 2.0 ) ) ;
+    const double phi  = exp( -0.5 * z * z ) / sqrt( 2.0 * M_PI ) ;
+    test( abs( noise.tail - tail ) < 1e-12, true, " tail probability " ) ;
+
+    Result sparse = run( noise, num_channels, num_events, [&]( DigiRandomStream& rndm, size_t n, auto func ){
+        return noise.sample_sparse( rndm, n, func ) ; } ) ;
+    Result dense  = run( noise, num_channels, num_events, [&]( DigiRandomStream& rndm, size_t n, auto func ){
+        return noise.sample_dense( rndm, n, func ) ; } ) ;
+
+    // Number of channels above threshold: binomial
+    const double expected = num_events * num_channels * tail ;
+    const double sigma_n  = sqrt( expected * ( 1.0 - tail ) ) ;
+    test( compatible( sparse.count, expected, sigma_n ), true, " sparse: number of channels above threshold " ) ;
+    test( compatible( dense.count,  expected, sigma_n ), true, " dense: number of channels above threshold " ) ;
+    test( compatible( sparse.count, dense.count, sqrt( 2.0 ) * sigma_n ), true, " sparse and dense channel counts agree " ) ;
+
+    // Noise values: mean of the tail and fraction one sigma above threshold
+    const double tail_mean = noise.mean + phi / tail ;
+    const double tail_rms  = sqrt( 1.0 + z * phi / tail - phi * phi / ( tail * tail ) ) ;
+    test( compatible( sparse.sum / sparse.count, tail_mean, tail_rms / sqrt( sparse.count ) ), true, " sparse: mean noise above threshold " ) ;
+    test( compatible( dense.sum / dense.count,   tail_mean, tail_rms / sqrt( dense.count ) ),  true, " dense: mean noise above threshold " ) ;
+    const double far = 0.5 * erfc( ( z + 1.0 ) / sqrt( 2.0 ) ) / tail ;
+    test( compatible( sparse.far / sparse.count, far, sqrt( far * ( 1.0 - far ) / sparse.count ) ), true, " sparse: tail shape " ) ;
+    test( compatible( dense.far / dense.count,   far, sqrt( far * ( 1.0 - far ) / dense.count ) ),  true, " dense: tail shape " ) ;
+
+    // Channels are uniformly distributed
+    const double sigma_i = num_channels / sqrt( 12.0 * sparse.count ) ;
+    test( compatible( sparse.index / sparse.count, 0.5 * num_channels, sigma_i ), true, " sparse: uniform channel selection " ) ;
+
+    // Reproducible streams
+    Result again = run( noise, num_channels, num_events, [&]( DigiRandomStream& rndm, size_t n, auto func ){
+        return noise.sample_sparse( rndm, n, func ) ; } ) ;
+    test( again.count == sparse.count && again.sum == sparse.sum, true, " sparse: reproducible " ) ;
+
+    // Channel selection with a fixed occupancy, as used for synthetic deposits
+    const double occupancy = 1e-2 ;
+    double selected = 0 ;
+    for( int i = 0 ; i < num_events ; ++i ){
+      DigiRandomStream random( 4712, i ) ;
+      selected += DigiSparseNoise::select_channels( random, occupancy, num_channels, []( size_t ){ } ) ;
+    }
+    const double expected_sel = num_events * num_channels * occupancy ;
+    test( compatible( selected, expected_sel, sqrt( expected_sel * ( 1.0 - occupancy ) ) ), true, " select: channel occupancy " ) ;
+    DigiRandomStream all( 4712, 0 ) ;
+    test( DigiSparseNoise::select_channels( all, 1.0, 100, []( size_t ){ } ), size_t( 100 ), " select: full occupancy " ) ;
+    test( DigiSparseNoise::select_channels( all, 0.0, 100, []( size_t ){ } ), size_t( 0 ),   " select: zero occupancy " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
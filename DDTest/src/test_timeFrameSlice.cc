@@ -0,0 +1,91 @@
+#include "DD4hep/DDTest.h"
+
+#include "DDDigi/DigiTimeFrameBuilder.h"
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::digi ;
+
+// this should be the first line in your test
+static DDTest test( "timeFrameSlice" ) ;
+
+//=============================================================================
+
+int main(int, char** ){
+
+  test.log( "test slice relative times and overlap flags of the time frame builder" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    const double length  = 1000.0 ;
+    const double overlap = 50.0 ;
+    const int    num_slices = 4 ;
+    // Absolute deposit times around the slice boundaries (exactly representable)
+    const vector<double> times = { 0.0, 0.5, 49.5, 50.0, 949.5, 950.0, 999.5, 1000.0, 1000.5,
+                                   1049.5, 1050.0, 1950.0, 1999.5, 2000.0, 2049.5, 2999.5, 3000.0 } ;
+    bool rel_ok = true, flag_ok = true, member_ok = true ;
+    for( double t : times ){
+      int core = 0 ;
+      for( int n = 0 ; n < num_slices ; ++n ){
+        const double start = n * length, end = start + length ;
+        const bool expected = t >= start - overlap && t < end + overlap ;
+        const bool inside   = DigiTimeFrameBuilder::in_slice( t, start, end, overlap ) ;
+        if( inside != expected ){
+          member_ok = false ;
+          cout << " time " << t << " slice " << n << ": membership " << inside << " expected " << expected << endl ;
+        }
+        if( !inside ) continue ;
+        EnergyDeposit dep ;
+        dep.time = t ;
+        DigiTimeFrameBuilder::to_slice( dep, start, end ) ;
+        const bool flagged = ( dep.flag & EnergyDeposit::TIME_OVERLAP ) != 0 ;
+        if( dep.time != t - start ){
+          rel_ok = false ;
+          cout << " time " << t << " slice " << n << ": relative time " << dep.time << " expected " << t - start << endl ;
+        }
+        if( flagged != ( t < start || t >= end ) ){
+          flag_ok = false ;
+          cout << " time " << t << " slice " << n << ": overlap flag " << flagged << endl ;
+        }
+        if( !flagged ) ++core ;
+      }
+      // Every deposit within the time frame belongs to exactly one slice without overlap flag
+      if( t < num_slices * length && core != 1 ){
+        member_ok = false ;
+        cout << " time " << t << " is core deposit of " << core << " slices" << endl ;
+      }
+    }
+    test( member_ok, true, " slice membership including the overlap region " ) ;
+    test( rel_ok,    true, " slice relative deposit times " ) ;
+    test( flag_ok,   true, " TIME_OVERLAP flags at the slice boundaries " ) ;
+
+    // Explicit boundary cases of slice 1: [1000,2000) with 50 overlap
+    EnergyDeposit first ;  first.time = 1000.0 ;
+    DigiTimeFrameBuilder::to_slice( first, 1000.0, 2000.0 ) ;
+    test( first.time == 0.0 && ( first.flag & EnergyDeposit::TIME_OVERLAP ) == 0, true, " slice start is not overlap " ) ;
+    EnergyDeposit last ;  last.time = 2000.0 ;
+    DigiTimeFrameBuilder::to_slice( last, 1000.0, 2000.0 ) ;
+    test( last.time == 1000.0 && ( last.flag & EnergyDeposit::TIME_OVERLAP ) != 0, true, " slice end is overlap " ) ;
+    EnergyDeposit early ;  early.time = 950.0 ;
+    DigiTimeFrameBuilder::to_slice( early, 1000.0, 2000.0 ) ;
+    test( early.time == -50.0 && ( early.flag & EnergyDeposit::TIME_OVERLAP ) != 0, true, " early overlap has negative time " ) ;
+    test( DigiTimeFrameBuilder::in_slice( 949.5, 1000.0, 2000.0, overlap ), false, " before the overlap region " ) ;
+    test( DigiTimeFrameBuilder::in_slice( 2050.0, 1000.0, 2000.0, overlap ), false, " after the overlap region " ) ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
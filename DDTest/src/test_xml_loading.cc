@@ -0,0 +1,137 @@
+#include "DD4hep/DDTest.h"
+
+#include "XML/XML.h"
+#include "XML/DocumentHandler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <exception>
+#include <functional>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+using namespace std ;
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "xml_loading" ) ;
+
+//=============================================================================
+
+/// Load a compact file and all files it refers to with <include ref=.../> or <gdmlFile ref=.../>
+static size_t load_all( const string& fname, string& signature ){
+  xml::DocumentHolder doc( xml::DocumentHandler().load( fname ) ) ;
+  size_t num_docs = 1 ;
+  function<void(xml::Handle_t)> visit = [&]( xml::Handle_t elt ) {
+    signature += elt.tag() ;
+    if( elt.hasAttr( _U(name) ) ) signature += ":" + elt.attr<string>( _U(name) ) ;
+    signature += ";" ;
+    string tag = elt.tag() ;
+    if( (tag == "include" || tag == "gdmlFile") && elt.hasAttr( _U(ref) ) ) {
+      num_docs += load_all( xml::DocumentHandler::system_path( elt, elt.attr_value( _U(ref) ) ), signature ) ;
+    }
+    for( xml::Collection_t c( elt, "*" ) ; c ; ++c ) visit( c ) ;
+  } ;
+  visit( doc.root() ) ;
+  return num_docs ;
+}
+
+/// Load the file tree a number of times. Returns the time per iteration in milliseconds
+static double measure( const string& fname, int num_loops, string& signature ){
+  auto start = chrono::high_resolution_clock::now() ;
+  size_t num_docs = 0 ;
+  for( int i = 0 ; i < num_loops ; ++i ) {
+    signature.clear() ;
+    num_docs = load_all( fname, signature ) ;
+  }
+  chrono::duration<double, milli> ms = chrono::high_resolution_clock::now() - start ;
+  struct rusage usage ;
+  ::getrusage( RUSAGE_SELF, &usage ) ;
+  cout << "    " << num_docs << " documents: " << ms.count()/num_loops << " ms per load. "
+       << "Peak RSS: " << usage.ru_maxrss << " kB" << endl ;
+  return ms.count()/num_loops ;
+}
+
+/// Write a small document with the given value attribute of the root element
+static void write_doc( const string& fname, const string& value ){
+  ofstream out( fname ) ;
+  out << "<lccdd value=\"" << value << "\"/>" << endl ;
+}
+
+/// Value attribute of the root element of a document loaded through the document handler
+static string read_doc( const string& fname ){
+  xml::DocumentHolder doc( xml::DocumentHandler().load( fname ) ) ;
+  return doc.root().attr<string>( _U(value) ) ;
+}
+
+/// Move the modification time of a file by a number of seconds
+static void shift_mtime( const string& fname, long seconds ){
+  struct stat st ;
+  ::stat( fname.c_str(), &st ) ;
+  struct utimbuf times ;
+  times.actime  = st.st_atime ;
+  times.modtime = st.st_mtime + seconds ;
+  ::utime( fname.c_str(), &times ) ;
+}
+
+int main(int argc, char** argv ){
+
+  test.log( "test xml loading" );
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_xml_loading compact.xml [number-of-loads]" << std::endl ;
+    exit(1) ;
+  }
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    int num_loops = argc > 2 ? atoi( argv[2] ) : 20 ;
+    string plain, cached ;
+
+    cout << " Parsing without document cache:" << endl ;
+    xml::DocumentHandler::enableCache( false ) ;
+    double t_plain = measure( argv[1], num_loops, plain ) ;
+
+    cout << " Parsing with document cache:" << endl ;
+    xml::DocumentHandler::enableCache( true ) ;
+    double t_cached = measure( argv[1], num_loops, cached ) ;
+    cout << " Speedup with document cache: " << t_plain/t_cached << endl ;
+
+    test( plain.empty(), false , " documents were loaded " ) ;
+    test( cached == plain, true , " cached documents are identical to parsed documents " ) ;
+
+    xml::DocumentHandler::clearCache() ;
+    string reloaded ;
+    load_all( argv[1], reloaded ) ;
+    test( reloaded == plain, true , " documents are identical after clearing the cache " ) ;
+
+    // Rewriting a cached file must invalidate the cached document
+    const string fname = "test_xml_loading_rewrite.xml" ;
+    write_doc( fname, "first" ) ;
+    test( read_doc( fname ), string( "first" ), " cache: initial content " ) ;
+    test( read_doc( fname ), string( "first" ), " cache: content taken from the cache " ) ;
+    write_doc( fname, "second-longer" ) ;
+    test( read_doc( fname ), string( "second-longer" ), " cache: rewritten file with a different size " ) ;
+    write_doc( fname, "third-content" ) ;
+    shift_mtime( fname, 10 ) ;
+    test( read_doc( fname ), string( "third-content" ), " cache: rewritten file with the same size " ) ;
+    shift_mtime( fname, 10 ) ;
+    test( read_doc( fname ), string( "third-content" ), " cache: touched file with unchanged content " ) ;
+    ::remove( fname.c_str() ) ;
+    xml::DocumentHandler::clearCache() ;
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -26,6 +26,7 @@ namespace std {
 } // namespace std
 #endif
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -35,6 +36,7 @@ namespace std {
 #include <string>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 namespace Gaudi {
   namespace PluginService {
@@ -166,9 +168,38 @@ namespace Gaudi {
           /// At the first call, the internal database of known factories is
           /// filled with the name of the libraries containing them, using the
           /// ".components" files in the `LD_LIBRARY_PATH`.
+          /// If the environment variable `DD4HEP_PLUGIN_CACHE` names a file, the
+          /// content of all directories, which did not change since the file was
+          /// written, is taken from there instead of parsing the ".components" files.
           const FactoryMap& factories() const;
 
+          /// Write the registry cache of the scanned library directories to `file`.
+          bool saveCache( const std::string& file ) const;
+
         private:
+          /// Content of one directory of the library search path (used by the registry cache).
+          struct DirectoryInfo {
+            std::string path;
+            /// Modification time of the directory in nanoseconds
+            std::int64_t mtime{0};
+            /// Names and modification times of the ".components" files
+            std::vector<std::pair<std::string, std::int64_t>> files{};
+            /// Pairs of library and factory name
+            std::vector<std::pair<std::string, std::string>> factories{};
+          };
+
+          /// Scan the ".components" files of one directory
+          void scanDirectory( DirectoryInfo& dir ) const;
+
+          /// Register the factories of one directory
+          void addDirectory( const DirectoryInfo& dir );
+
+          /// Read the content of the directories from the registry cache `file`
+          static std::map<std::string, DirectoryInfo> readCache( const std::string& file );
+
+          /// Write the content of the scanned and of additional directories to the registry cache `file`
+          bool writeCache( const std::string& file, const std::vector<DirectoryInfo>& others ) const;
+
           /// Private constructor for the singleton pattern.
           Registry();
 
@@ -188,6 +219,9 @@ namespace Gaudi {
           /// Internal storage for factories.
           FactoryMap m_factories;
 
+          /// Content of the scanned directories of the library search path.
+          std::vector<DirectoryInfo> m_directories;
+
           /// Mutex used to control concurrent access to the internal data.
           mutable std::recursive_mutex m_mutex;
         };
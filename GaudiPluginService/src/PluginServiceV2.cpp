@@ -19,7 +19,10 @@
 #include <dirent.h>
 #include <dlfcn.h>
 
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -27,7 +30,10 @@
 #include <vector>
 
 #include <cxxabi.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #ifdef _GNU_SOURCE
 #  include <cstring>
@@ -92,6 +98,40 @@ namespace {
   std::string old_style_name( const std::string& name ) {
     return std::for_each( name.begin(), name.end(), OldStyleCnv() ).name;
   }
+
+  /// Modification time of a file or directory in nanoseconds (-1 if it does not exist)
+  std::int64_t modificationTime( const std::string& path ) {
+    struct stat buf;
+    if ( ::stat( path.c_str(), &buf ) != 0 ) return -1;
+#if defined( __APPLE__ )
+    return std::int64_t( buf.st_mtimespec.tv_sec ) * 1000000000 + buf.st_mtimespec.tv_nsec;
+#else
+    return std::int64_t( buf.st_mtim.tv_sec ) * 1000000000 + buf.st_mtim.tv_nsec;
+#endif
+  }
+
+  /// Identifier and version of the binary registry cache format
+  const char cacheMagic[8] = {'G', 'P', 'S', 'C', 'A', 'C', 'H', '1'};
+
+  /// Sequential reader of the memory mapped registry cache
+  struct CacheReader {
+    const char* ptr;
+    const char* end;
+    template <typename T>
+    bool get( T& value ) {
+      if ( std::size_t( end - ptr ) < sizeof( T ) ) return false;
+      std::memcpy( &value, ptr, sizeof( T ) );
+      ptr += sizeof( T );
+      return true;
+    }
+    bool get( std::string& value ) {
+      std::uint32_t len = 0;
+      if ( !get( len ) || std::size_t( end - ptr ) < len ) return false;
+      value.assign( ptr, len );
+      ptr += len;
+      return true;
+    }
+  };
 } // namespace
 
 namespace Gaudi {
@@ -153,9 +193,6 @@ namespace Gaudi {
           const std::string sep    = ":";
 #endif
 
-          std::regex  line_format{"^(?:[[:space:]]*(?:(v[0-9]+)::)?([^:]+):(.*[^[:space:]]))?[[:space:]]*(?:#.*)?$"};
-          std::smatch matches;
-
           std::string search_path;
           const char* envPtr = std::getenv( envVar.c_str() );
           if ( envPtr ) search_path = envPtr;
@@ -166,52 +203,202 @@ namespace Gaudi {
           logger().debug("searching factories in " + envVar);
           logger().debug("searching factories in " + search_path);
 
+          auto start = std::chrono::steady_clock::now();
           std::vector<std::string> directories;
           boost::split(directories, search_path, boost::is_any_of(sep));
 
+          // content of the directories from the registry cache (if any)
+          std::map<std::string, DirectoryInfo> cached;
+          const char* cacheFile = std::getenv( "DD4HEP_PLUGIN_CACHE" );
+          if ( cacheFile && *cacheFile ) cached = readCache( cacheFile );
+
+          std::size_t numCached = 0;
+          std::set<std::string> known;
           for(fs::path dirName: directories) {
-            if ( not is_directory( dirName ) ) {
+            if ( not known.insert( dirName.string() ).second || not is_directory( dirName ) ) {
               continue;
             }
-            logger().debug( " looking into " + dirName.string() );
-            for ( auto& p : fs::directory_iterator( dirName ) ) {
-              // look for files called "*.components" in the directory
-              if ( p.path().extension() == ".components" && is_regular_file( p.path() ) ) {
-                // read the file
-                const auto& fullPath = p.path().string();
-                logger().debug( "  reading " + p.path().filename().string() );
-                std::ifstream factories{fullPath};
-                std::string   line;
-                int           factoriesCount = 0;
-                int           lineCount      = 0;
-                while ( !factories.eof() ) {
-                  ++lineCount;
-                  std::getline( factories, line );
-                  if ( regex_match( line, matches, line_format ) ) {
-                    if ( matches[1] == "v2" ) { // ignore non "v2" and "empty" lines
-                      const std::string lib{matches[2]};
-                      const std::string fact{matches[3]};
-                      m_factories.emplace( fact, FactoryInfo{lib, {}, {{"ClassName", fact}}} );
-#ifdef GAUDI_REFLEX_COMPONENT_ALIASES
-                      // add an alias for the factory using the Reflex convention
-                      std::string old_name = old_style_name( fact );
-                      if ( fact != old_name ) {
-                        m_factories.emplace( old_name,
-                                             FactoryInfo{lib, {}, {{"ReflexName", "true"}, {"ClassName", fact}}} );
-                      }
-#endif
-                      ++factoriesCount;
-                    }
-                  } else {
-                    logger().debug( "failed to parse line " + fullPath + ':' + std::to_string( lineCount ) );
+            DirectoryInfo dir{dirName.string(), modificationTime( dirName.string() )};
+            // only take the cached content if neither the directory nor the files changed.
+            // The check is done here for all directories and not lazily at the first lookup:
+            // a lookup of a factory from a new or changed ".components" file has no cached
+            // entry to validate and would fail. It costs one stat per directory and file.
+            auto c = cached.find( dir.path );
+            if ( c != cached.end() && c->second.mtime == dir.mtime &&
+                 std::all_of( c->second.files.begin(), c->second.files.end(), [&dir]( const auto& f ) {
+                   return modificationTime( dir.path + '/' + f.first ) == f.second;
+                 } ) ) {
+              logger().debug( " taking " + dir.path + " from the registry cache" );
+              dir = std::move( c->second );
+              ++numCached;
+            } else {
+              logger().debug( " looking into " + dir.path );
+              scanDirectory( dir );
+            }
+            addDirectory( dir );
+            m_directories.emplace_back( std::move( dir ) );
+          }
+          // rewrite the cache if any directory had to be scanned. Keep the entries of
+          // directories not in the search path: other jobs may use a different one.
+          if ( cacheFile && *cacheFile && numCached != m_directories.size() ) {
+            std::vector<DirectoryInfo> others;
+            for ( auto& c : cached ) {
+              if ( known.find( c.first ) == known.end() ) others.emplace_back( std::move( c.second ) );
+            }
+            writeCache( cacheFile, others );
+          }
+          if ( logger().level() <= Logger::Info ) {
+            std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+            std::stringstream msg;
+            msg << "registry: " << m_factories.size() << " factories from " << m_directories.size()
+                << " directories (" << numCached << " from cache) loaded in " << ms.count() << " ms";
+            logger().info( msg.str() );
+          }
+        }
+
+        void Registry::scanDirectory( DirectoryInfo& dir ) const {
+          std::regex  line_format{"^(?:[[:space:]]*(?:(v[0-9]+)::)?([^:]+):(.*[^[:space:]]))?[[:space:]]*(?:#.*)?$"};
+          std::smatch matches;
+
+          for ( auto& p : fs::directory_iterator( fs::path( dir.path ) ) ) {
+            // look for files called "*.components" in the directory
+            if ( p.path().extension() == ".components" && is_regular_file( p.path() ) ) {
+              // read the file
+              const auto& fullPath = p.path().string();
+              logger().debug( "  reading " + p.path().filename().string() );
+              dir.files.emplace_back( p.path().filename().string(), modificationTime( fullPath ) );
+              std::ifstream factories{fullPath};
+              std::string   line;
+              int           factoriesCount = 0;
+              int           lineCount      = 0;
+              while ( !factories.eof() ) {
+                ++lineCount;
+                std::getline( factories, line );
+                if ( regex_match( line, matches, line_format ) ) {
+                  if ( matches[1] == "v2" ) { // ignore non "v2" and "empty" lines
+                    dir.factories.emplace_back( matches[2], matches[3] );
+                    ++factoriesCount;
                   }
-                }
-                if ( logger().level() <= Logger::Debug ) {
-                  logger().debug( "  found " + std::to_string( factoriesCount ) + " factories" );
+                } else {
+                  logger().debug( "failed to parse line " + fullPath + ':' + std::to_string( lineCount ) );
                 }
               }
+              if ( logger().level() <= Logger::Debug ) {
+                logger().debug( "  found " + std::to_string( factoriesCount ) + " factories" );
+              }
+            }
+          }
+        }
+
+        void Registry::addDirectory( const DirectoryInfo& dir ) {
+          for ( const auto& f : dir.factories ) {
+            const std::string& lib  = f.first;
+            const std::string& fact = f.second;
+            m_factories.emplace( fact, FactoryInfo{lib, {}, {{"ClassName", fact}}} );
+#ifdef GAUDI_REFLEX_COMPONENT_ALIASES
+            // add an alias for the factory using the Reflex convention
+            std::string old_name = old_style_name( fact );
+            if ( fact != old_name ) {
+              m_factories.emplace( old_name, FactoryInfo{lib, {}, {{"ReflexName", "true"}, {"ClassName", fact}}} );
+            }
+#endif
+          }
+        }
+
+        std::map<std::string, Registry::DirectoryInfo> Registry::readCache( const std::string& file ) {
+          std::map<std::string, DirectoryInfo> result;
+          int                                  fd = ::open( file.c_str(), O_RDONLY );
+          if ( fd < 0 ) {
+            logger().debug( "no registry cache " + file );
+            return result;
+          }
+          struct stat buf;
+          void*       mem = MAP_FAILED;
+          if ( ::fstat( fd, &buf ) == 0 && buf.st_size > 0 ) {
+            mem = ::mmap( nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+          }
+          ::close( fd );
+          if ( mem == MAP_FAILED ) {
+            logger().warning( "cannot map the registry cache " + file );
+            return result;
+          }
+          CacheReader   reader{static_cast<const char*>( mem ), static_cast<const char*>( mem ) + buf.st_size};
+          char          magic[sizeof( cacheMagic )];
+          std::uint32_t numDirs = 0;
+          bool          ok      = reader.get( magic ) && 0 == std::memcmp( magic, cacheMagic, sizeof( magic ) ) &&
+                   reader.get( numDirs );
+          for ( std::uint32_t i = 0; ok && i < numDirs; ++i ) {
+            DirectoryInfo dir;
+            std::uint32_t num = 0;
+            ok = reader.get( dir.path ) && reader.get( dir.mtime ) && reader.get( num );
+            for ( std::uint32_t j = 0; ok && j < num; ++j ) {
+              std::pair<std::string, std::int64_t> f;
+              ok = reader.get( f.first ) && reader.get( f.second );
+              dir.files.emplace_back( std::move( f ) );
+            }
+            ok = ok && reader.get( num );
+            for ( std::uint32_t j = 0; ok && j < num; ++j ) {
+              std::pair<std::string, std::string> f;
+              ok = reader.get( f.first ) && reader.get( f.second );
+              dir.factories.emplace_back( std::move( f ) );
             }
+            if ( ok ) result.emplace( dir.path, std::move( dir ) );
+          }
+          ::munmap( mem, buf.st_size );
+          if ( !ok ) {
+            logger().warning( "ignoring the corrupted registry cache " + file );
+            result.clear();
+          }
+          return result;
+        }
+
+        bool Registry::saveCache( const std::string& file ) const {
+          REG_SCOPE_LOCK
+          factories();
+          return writeCache( file, {} );
+        }
+
+        bool Registry::writeCache( const std::string& file, const std::vector<DirectoryInfo>& others ) const {
+          std::string buffer( cacheMagic, sizeof( cacheMagic ) );
+          auto put_int = [&buffer]( auto value ) { buffer.append( reinterpret_cast<const char*>( &value ), sizeof( value ) ); };
+          auto put_str = [&buffer, &put_int]( const std::string& value ) {
+            put_int( std::uint32_t( value.length() ) );
+            buffer.append( value );
+          };
+          auto put_dir = [&put_int, &put_str]( const DirectoryInfo& dir ) {
+            put_str( dir.path );
+            put_int( dir.mtime );
+            put_int( std::uint32_t( dir.files.size() ) );
+            for ( const auto& f : dir.files ) {
+              put_str( f.first );
+              put_int( f.second );
+            }
+            put_int( std::uint32_t( dir.factories.size() ) );
+            for ( const auto& f : dir.factories ) {
+              put_str( f.first );
+              put_str( f.second );
+            }
+          };
+          put_int( std::uint32_t( m_directories.size() + others.size() ) );
+          for ( const auto& dir : m_directories ) put_dir( dir );
+          for ( const auto& dir : others ) put_dir( dir );
+          // write to a temporary file and rename it: concurrent jobs may read the cache
+          const std::string tmp = file + "." + std::to_string( ::getpid() );
+          {
+            std::ofstream out( tmp, std::ios::binary | std::ios::trunc );
+            out.write( buffer.data(), buffer.size() );
+            if ( !out.good() ) {
+              logger().warning( "cannot write the registry cache " + tmp );
+              return false;
+            }
+          }
+          if ( std::rename( tmp.c_str(), file.c_str() ) != 0 ) {
+            logger().warning( "cannot create the registry cache " + file );
+            std::remove( tmp.c_str() );
+            return false;
           }
+          logger().debug( "registry cache written to " + file );
+          return true;
         }
 
         const Registry::FactoryMap& Registry::factories() const {
@@ -35,6 +35,11 @@ void help( std::string argv0 ) {
                "  -o OUTPUT, --output OUTPUT\n"
                "                   write the list of factories on the file OUTPUT, use - for\n"
                "                   standard output (default)\n"
+               "  -c CACHE, --cache CACHE\n"
+               "                   write the registry cache of the factories found in the\n"
+               "                   library search path to the file CACHE (to be used with\n"
+               "                   the environment variable DD4HEP_PLUGIN_CACHE).\n"
+               "                   No library argument is required in this case.\n"
             << std::endl;
 }
 
@@ -61,6 +66,7 @@ int main( int argc, char* argv[] ) {
   // Parse command line
   std::list<char*> libs;
   std::string      output_opt( "-" );
+  std::string      cache_opt;
   {
     std::string argv0( argv[0] );
     {
@@ -79,6 +85,14 @@ int main( int argc, char* argv[] ) {
           std::cerr << "See `" << argv0 << " -h' for more details." << std::endl;
           return EXIT_FAILURE;
         }
+      } else if ( arg == "-c" || arg == "--cache" ) {
+        if ( ++i < argc ) {
+          cache_opt = argv[i];
+        } else {
+          std::cerr << "ERROR: missing argument for option " << arg << std::endl;
+          std::cerr << "See `" << argv0 << " -h' for more details." << std::endl;
+          return EXIT_FAILURE;
+        }
       } else if ( arg == "-h" || arg == "--help" ) {
         help( argv0 );
         return EXIT_SUCCESS;
@@ -87,7 +101,7 @@ int main( int argc, char* argv[] ) {
       }
       ++i;
     }
-    if ( libs.empty() ) {
+    if ( libs.empty() && cache_opt.empty() ) {
       usage( std::move(argv0) );
       return EXIT_FAILURE;
     }
@@ -119,5 +133,10 @@ int main( int argc, char* argv[] ) {
       return EXIT_FAILURE;
     }
   }
+  // prebuild the registry cache
+  if ( !cache_opt.empty() && !reg2.saveCache( cache_opt ) ) {
+    std::cerr << "ERROR: failed to write the registry cache " << cache_opt << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
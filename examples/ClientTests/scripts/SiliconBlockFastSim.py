@@ -22,6 +22,11 @@ from g4units import GeV, MeV, m
 
    dd4hep simulation example setup using the python configuration
 
+   Options:
+   -batchspots     Deposit the shower energy spots in one go
+   -nomerge        Do not merge batched spots hitting the same cell
+   The time spent depositing the spots is printed when the model is deleted.
+
    NOTE:
    If you get to the command prompt, you must not forget to enable GFlash!
    By default Geant4 does not enable it. Hence:
@@ -82,6 +87,11 @@ def run():
   # Energy boundaries are optional: Units are GeV
   model.Emin = {'e+': 0.1 * GeV, 'e-': 0.1 * GeV}
   model.Ekill = {'e+': 0.1 * MeV, 'e-': 0.1 * MeV}
+  # Optional: deposit the energy spots of a shower in one go (-batchspots)
+  # and merge spots hitting the same cell (default when batching)
+  if args.batchspots:
+    model.BatchSpots = True
+    model.MergeSpots = not args.nomerge
   model.enableUI()
   seq.adopt(model)
 
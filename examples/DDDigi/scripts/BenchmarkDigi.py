@@ -0,0 +1,257 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Benchmark suite of standard DDDigi pipelines with synthetic input.
+#
+#  The input are deposits of the MiniTel subdetectors created by the
+#  DigiDepositGenerator with a configurable channel occupancy.
+#  The pipelines are cumulative:
+#
+#    input      signal and background deposit generation
+#    combine    + DigiContainerCombine of signal and background
+#    smear      + DigiDepositSmearEnergy
+#    resegment  + DigiResegment of Minitel1
+#    adc        + DigiSimpleADCResponse
+#    output     + Digi2ROOTWriter
+#
+#  Every pipeline is run in a separate process with 1...N threads.
+#  Measured are events/s, the time spent in every action, the peak
+#  resident memory and the number of minor page faults.
+#  The results are written to a JSON file. If a reference file from an
+#  earlier run is given, configurations slower than the reference by more
+#  than the tolerance are reported as regression and the script fails.
+#
+#  python BenchmarkDigi.py [-pipelines input,combine,...] [-max_threads <N>]
+#                          [-num_events <number>] [-occupancy <fraction>]
+#                          [-container DepositVector|DepositMapping]
+#                          [-output <json-file>] [-reference <json-file>]
+#                          [-tolerance <fraction>]
+#
+# ==========================================================================
+from __future__ import absolute_import
+import os
+import re
+import sys
+import json
+import time
+import socket
+import argparse
+import platform
+import subprocess
+
+PIPELINES = ['input', 'combine', 'smear', 'resegment', 'adc', 'output']
+
+
+# ---------------------------------------------------------------------------
+def parse_args():
+  parser = argparse.ArgumentParser(description='Benchmark standard DDDigi pipelines with 1...N threads')
+  parser.add_argument('-pipelines', default=','.join(PIPELINES), help='Comma separated list of pipelines')
+  parser.add_argument('-max_threads', type=int, default=8, help='Maximum number of threads')
+  parser.add_argument('-num_events', type=int, default=50, help='Number of events per measurement')
+  parser.add_argument('-occupancy', type=float, default=1e-2, help='Channel occupancy of the synthetic input')
+  parser.add_argument('-container', default='DepositVector', help='Input container: DepositVector or DepositMapping')
+  parser.add_argument('-output', default='dddigi_benchmark.json', help='JSON file with the results')
+  parser.add_argument('-reference', default=None, help='JSON file with reference results')
+  parser.add_argument('-tolerance', type=float, default=0.15, help='Tolerated relative loss of events/s')
+  parser.add_argument('-run_pipeline', default=None, help='Internal: measure one pipeline in this process')
+  parser.add_argument('-num_threads', type=int, default=1, help='Internal: number of threads')
+  args, _ = parser.parse_known_args()
+  return args
+
+
+# ---------------------------------------------------------------------------
+def setup_pipeline(digi, pipeline, args):
+  from dd4hep import units
+  stage = PIPELINES.index(pipeline)
+  detectors = [d['name'] for d in digi.activeDetectors()]
+  containers = [d['sensitive'].readout().name() for d in digi.activeDetectors()]
+
+  input_action = digi.input_action()
+  input_action.timing = True
+  for name, mask in [('Signal', 0x0), ('Background', 0x1)]:
+    digi.input_action('DigiDepositGenerator/' + name,
+                      detectors=detectors,
+                      occupancy=args.occupancy,
+                      container=args.container,
+                      mask=mask,
+                      output_segment='inputs')
+  event = digi.event_action()
+  event.timing = True
+  if stage >= PIPELINES.index('combine'):
+    digi.event_action('DigiContainerCombine/Combine',
+                      parallel=True,
+                      input_masks=[0x0, 0x1],
+                      input_segment='inputs',
+                      output_mask=0xFEED,
+                      output_segment='deposits')
+  if stage >= PIPELINES.index('smear'):
+    seq = digi.event_action('DigiContainerSequenceAction/Smearing',
+                            parallel=True,
+                            input_mask=0xFEED, input_segment='deposits',
+                            output_mask=0xFEED, output_segment='deposits')
+    smear = digi.create_action('DigiDepositSmearEnergy/Smear')
+    smear.systematic_resolution = 0.02 / units.GeV
+    smear.instrumentation_resolution = 1 * units.keV
+    seq.adopt_container_processor(smear, containers)
+  if stage >= PIPELINES.index('resegment'):
+    seq = digi.event_action('DigiContainerSequenceAction/Resegmentation',
+                            parallel=True,
+                            input_mask=0xFEED, input_segment='deposits',
+                            output_mask=0xABCD, output_segment='outputs')
+    resegment = digi.create_action('DigiResegment/Resegment')
+    resegment.detector = 'Minitel1'
+    resegment.readout = 'NewMinitel1Hits'
+    resegment.descriptor = """
+    <readout name="NewMinitel1Hits">
+      <segmentation type="CartesianGridXY" grid_size_x="20*mm" grid_size_y="20*mm"/>
+      <id>system:6,side:2,module:8,x:28:-12,y:52:-12</id>
+    </readout>
+    """
+    seq.adopt_container_processor(resegment, 'Minitel1Hits')
+  if stage >= PIPELINES.index('adc'):
+    seq = digi.event_action('DigiContainerSequenceAction/ADCsequence',
+                            parallel=True,
+                            input_mask=0xFEED, input_segment='deposits',
+                            output_mask=0xBABE, output_segment='outputs')
+    adc = digi.create_action('DigiSimpleADCResponse/ADCCreate')
+    seq.adopt_container_processor(adc, containers)
+  if stage >= PIPELINES.index('output'):
+    output = digi.output_action()
+    output.timing = True
+    writer = digi.output_action('Digi2ROOTWriter/EventWriter',
+                                parallel=True,
+                                input_mask=0xFEED,
+                                input_segment='deposits',
+                                output='dddigi_benchmark.root')
+    proc = digi.create_action('Digi2ROOTProcessor/Writer')
+    writer.adopt_container_processor(proc, [c + '/TrackerHits' for c in containers])
+
+
+# ---------------------------------------------------------------------------
+def run_job(args):
+  import resource
+  import DigiTest
+  digi = DigiTest.Test(geometry=None, process_data=False)
+  digi.load_geo(volume_manager=True)
+  setup_pipeline(digi, args.run_pipeline, args)
+
+  krnl = digi.kernel()
+  krnl.numEvents = args.num_events
+  krnl.numThreads = args.num_threads
+  krnl.maxEventsParallel = args.num_threads
+  krnl.configure()
+  krnl.initialize()
+  start = time.perf_counter()
+  krnl.run()
+  seconds = time.perf_counter() - start
+  usage = resource.getrusage(resource.RUSAGE_SELF)
+  result = {'pipeline': args.run_pipeline,
+            'threads': args.num_threads,
+            'events': int(krnl.events_done()),
+            'seconds': seconds,
+            'events_per_second': float(krnl.events_done()) / seconds if seconds > 0 else 0.0,
+            'peak_rss_kb': usage.ru_maxrss,
+            'minor_page_faults': usage.ru_minflt}
+  print('+++ BENCHMARK-RESULT ' + json.dumps(result))
+  sys.stdout.flush()
+  krnl.terminate()
+  return 0
+
+
+# ---------------------------------------------------------------------------
+def measure(args, pipeline, num_threads):
+  match_result = re.compile(r'\+\+\+ BENCHMARK-RESULT (\{.*\})')
+  match_timing = re.compile(r'\+\+\+ Timing (\S+)\s+calls:\s+(\d+)\s+total:\s+([0-9.]+) sec')
+  cmd = [sys.executable, os.path.abspath(__file__),
+         '-run_pipeline', pipeline,
+         '-num_threads', str(num_threads),
+         '-num_events', str(args.num_events),
+         '-occupancy', str(args.occupancy),
+         '-container', args.container]
+  proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  found = match_result.search(proc.stdout)
+  if proc.returncode != 0 or not found:
+    print(proc.stdout)
+    print('+++ FAILED benchmark %s with %d threads [return code: %d]' % (pipeline, num_threads, proc.returncode))
+    return None
+  result = json.loads(found.group(1))
+  result['actions'] = {}
+  for name, calls, seconds in match_timing.findall(proc.stdout):
+    result['actions'][name] = {'calls': int(calls), 'seconds': float(seconds)}
+  return result
+
+
+# ---------------------------------------------------------------------------
+def compare(results, reference, tolerance):
+  refs = {(r['pipeline'], r['threads']): r for r in reference['results']}
+  regressions = []
+  for r in results:
+    ref = refs.get((r['pipeline'], r['threads']))
+    if ref and ref['events_per_second'] > 0:
+      ratio = r['events_per_second'] / ref['events_per_second']
+      if ratio < 1.0 - tolerance:
+        regressions.append(r)
+        print('+++ REGRESSION %-10s %3d threads: %10.2f events/s reference: %10.2f events/s [%6.1f %%]'
+              % (r['pipeline'], r['threads'], r['events_per_second'], ref['events_per_second'], 100 * ratio))
+  return regressions
+
+
+# ---------------------------------------------------------------------------
+def run():
+  args = parse_args()
+  if args.run_pipeline:
+    return run_job(args)
+
+  pipelines = [p for p in args.pipelines.split(',') if p]
+  for p in pipelines:
+    if p not in PIPELINES:
+      print('+++ Unknown pipeline: %s. Known pipelines: %s' % (p, ' '.join(PIPELINES)))
+      return 1
+
+  results = []
+  for pipeline in pipelines:
+    for num_threads in range(1, args.max_threads + 1):
+      result = measure(args, pipeline, num_threads)
+      if not result:
+        return 1
+      results.append(result)
+
+  print('+++ %-10s %8s %8s %12s %12s %8s %12s' % ('Pipeline', 'Threads', 'Events', 'Time [s]',
+                                                   'Events/s', 'Speedup', 'Peak [MB]'))
+  for r in results:
+    base = [b for b in results if b['pipeline'] == r['pipeline']][0]
+    print('+++ %-10s %8d %8d %12.3f %12.2f %8.2f %12.1f'
+          % (r['pipeline'], r['threads'], r['events'], r['seconds'], r['events_per_second'],
+             r['events_per_second'] / base['events_per_second'], r['peak_rss_kb'] / 1024.0))
+
+  summary = {'host': socket.gethostname(),
+             'platform': platform.platform(),
+             'cpu_count': os.cpu_count(),
+             'date': time.strftime('%Y-%m-%d %H:%M:%S'),
+             'num_events': args.num_events,
+             'occupancy': args.occupancy,
+             'container': args.container,
+             'results': results}
+  with open(args.output, 'w') as f:
+    json.dump(summary, f, indent=2)
+  print('+++ Results written to %s' % (args.output, ))
+
+  regressions = []
+  if args.reference:
+    with open(args.reference) as f:
+      regressions = compare(results, json.load(f), args.tolerance)
+  print('+++ Benchmark finished: %d measurements, %d regressions' % (len(results), len(regressions)))
+  return 1 if regressions else 0
+
+
+# ---------------------------------------------------------------------------
+if __name__ == '__main__':
+  sys.exit(run())
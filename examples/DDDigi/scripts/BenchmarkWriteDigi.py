@@ -0,0 +1,57 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Benchmark of the staged DDDigi output: events/s written by the
+#  Digi2ROOTWriter (TestWriteDigi.py) with 1...N threads.
+#
+#  python BenchmarkWriteDigi.py [-max_threads <N>] [-num_events <number>]
+#
+# ==========================================================================
+from __future__ import absolute_import
+import os
+import re
+import sys
+import argparse
+import subprocess
+
+
+# ---------------------------------------------------------------------------
+def run():
+  parser = argparse.ArgumentParser(description='Benchmark the DDDigi output with 1...N threads')
+  parser.add_argument('-max_threads', type=int, default=8, help='Maximum number of threads')
+  parser.add_argument('-num_events', type=int, default=25, help='Number of events per measurement')
+  args = parser.parse_args()
+
+  script = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'TestWriteDigi.py')
+  match = re.compile(r'Committed (\d+) events in ([0-9.]+) seconds: ([0-9.]+) events/s')
+  results = []
+  for num_threads in range(1, args.max_threads + 1):
+    cmd = [sys.executable, script,
+           '-num_events', str(args.num_events),
+           '-num_threads', str(num_threads),
+           '-events_parallel', str(num_threads)]
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    found = match.search(proc.stdout)
+    if proc.returncode != 0 or not found:
+      print(proc.stdout)
+      print('+++ FAILED benchmark with %d threads [return code: %d]' % (num_threads, proc.returncode))
+      return 1
+    results.append((num_threads, int(found.group(1)), float(found.group(2)), float(found.group(3))))
+
+  print('+++ %8s %8s %12s %12s %8s' % ('Threads', 'Events', 'Time [s]', 'Events/s', 'Speedup'))
+  for num_threads, events, seconds, rate in results:
+    print('+++ %8d %8d %12.3f %12.2f %8.2f' % (num_threads, events, seconds, rate, rate / results[0][3]))
+  return 0
+
+
+# ---------------------------------------------------------------------------
+if __name__ == '__main__':
+  sys.exit(run())
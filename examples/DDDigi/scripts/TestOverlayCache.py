@@ -0,0 +1,46 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+
+  input_action = digi.input_action('DigiSequentialActionSequence/READER')
+  # ========================================================================================================
+  input_action.adopt_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  digi.info('Created input.signal')
+  # ========================================================================================================
+  # Pile-up: on average 3 background events per signal event sampled from a pool of 8 events
+  overlay = input_action.adopt_action('DigiOverlayCache/PileupCache',
+                                      cache_size=8,
+                                      pool_size=8,
+                                      mean_overlay=3.0,
+                                      output_segment='inputs',
+                                      output_mask=0x1)
+  overlay.adopt_action('DigiDDG4ROOT/PileupReader', mask=0x0, input=[digi.next_input()])
+  digi.check_creation([overlay])
+  digi.info('Created input.pileup')
+  # ========================================================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  combine = event.adopt_action('DigiContainerCombine/Combine',
+                               input_masks=[0x0, 0x1],
+                               input_segment='inputs',
+                               output_mask=0xFEED,
+                               output_segment='deposits')
+  evtdump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([combine, evtdump])
+  digi.run_checked(num_events=10, num_threads=5, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,39 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+from g4units import ns
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+
+  # ========================================================================================================
+  # Continuous readout: every event is a time slice of 200 ns built from interactions
+  # every 25 ns with on average 0.5 interactions per bunch crossing.
+  frame = digi.input_action('DigiTimeFrameBuilder/TimeFrame',
+                            slice_length=200 * ns,
+                            slice_overlap=20 * ns,
+                            bunch_spacing=25 * ns,
+                            mean_interactions=0.5,
+                            output_segment='inputs',
+                            output_mask=0x0)
+  frame.adopt_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  digi.check_creation([frame])
+  # ========================================================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  evtdump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([event, evtdump])
+  digi.run_checked(num_events=5, num_threads=5, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,63 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+from __future__ import absolute_import, unicode_literals
+import logging
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+#
+"""
+
+   dd4hep simulation example: benchmark of the DDG4 callback dispatch overhead
+
+   Times kernel lookups, the stepping and tracking action sequences (plain
+   and compiled) and an action phase with a configurable number of (empty)
+   stepping actions.
+
+"""
+
+
+def run():
+  import os
+  import DDG4
+  from g4units import GeV
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/SiliconBlock.xml"))
+
+  DDG4.importConstants(kernel.detectorDescription(), debug=False)
+  geant4 = DDG4.Geant4(kernel, tracker='Geant4TrackerCombineAction')
+  geant4.setupUI(typ="tcsh", vis=False, macro=None, ui=False)
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+
+  gun = geant4.setupGun("Gun", particle='gamma', energy=1 * GeV, multiplicity=1)
+  gun.direction = (0.0, 0.0, 1.0)
+  kernel.NumEvents = 1
+
+  for i in range(10):
+    stepping = DDG4.SteppingAction(kernel, 'TestDispatchStepAction/StepAction%d' % (i,))
+    kernel.steppingAction().adopt(stepping)
+    tracking = DDG4.TrackingAction(kernel, 'Geant4TrackingPreAction/TrackAction%d' % (i,))
+    kernel.trackingAction().adopt(tracking)
+
+  bench = DDG4.RunAction(kernel, 'TestCallbackDispatch/DispatchBenchmark')
+  bench.NumCalls = 1000000
+  kernel.runAction().adopt(bench)
+
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.execute()
+
+
+if __name__ == "__main__":
+  run()
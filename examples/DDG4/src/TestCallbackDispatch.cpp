@@ -0,0 +1,171 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4RunAction.h"
+#include "DDG4/Geant4ActionPhase.h"
+#include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4TrackingAction.h"
+
+#include <G4Step.hh>
+#include <G4Track.hh>
+
+// C/C++ include files
+#include <chrono>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Stepping action doing nothing but counting calls
+    /**
+     *  Used as callback target by the TestCallbackDispatch benchmark.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class TestDispatchStepAction : public Geant4SteppingAction {
+    public:
+      std::size_t m_calls { 0UL };
+    public:
+      /// Standard constructor
+      TestDispatchStepAction(Geant4Context* context, const std::string& nam)
+        : Geant4SteppingAction(context, nam)
+      {
+      }
+      /// Default destructor
+      virtual ~TestDispatchStepAction() = default;
+      /// Stepping callback
+      virtual void operator()(const G4Step*, G4SteppingManager*)  override  {
+        ++m_calls;
+      }
+      /// Phase callback
+      void phaseCall(const G4Step*)   {
+        ++m_calls;
+      }
+    };
+
+    /// Benchmark of the DDG4 callback dispatch overhead
+    /**
+     *  At the begin of the run the following operations are timed
+     *  "NumCalls" times and the average time per call is printed:
+     *  - worker kernel lookup by thread identifier (map search)
+     *  - worker kernel lookup through the thread-local slot
+     *  - dispatch of one step through the stepping action sequence,
+     *    first as configured, then with the sequence compiled
+     *  - dispatch of one track through the tracking action sequence,
+     *    first as configured, then with the sequence compiled
+     *  - dispatch of one step through a Geant4ActionPhase with all
+     *    TestDispatchStepAction instances of the stepping sequence as members.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class TestCallbackDispatch : public Geant4RunAction {
+      /// Property: number of calls per measurement
+      long m_numCalls { 1000000 };
+
+      /// Switch the compiled mode of a sequence and rebuild the dispatch tables
+      template <typename SEQUENCE> bool setCompiled(SEQUENCE& sequence, bool value)  const  {
+        Property& prop = sequence.property("Compiled");
+        bool old = prop.value<bool>();
+        prop.set(value);
+        sequence.compile();
+        return old;
+      }
+
+      /// Time a function and print the average per call
+      template <typename FUNC> void measure(const char* tag, FUNC func)  const  {
+        auto start = std::chrono::high_resolution_clock::now();
+        for( long i = 0; i < m_numCalls; ++i )
+          func();
+        std::chrono::duration<double, std::nano> ns = std::chrono::high_resolution_clock::now() - start;
+        always("+++ %-36s %9.2f ns/call  [%ld calls]", tag, ns.count()/double(m_numCalls), m_numCalls);
+      }
+
+    public:
+      /// Standard constructor
+      TestCallbackDispatch(Geant4Context* context, const std::string& nam)
+        : Geant4RunAction(context, nam)
+      {
+        declareProperty("NumCalls", m_numCalls);
+      }
+      /// Default destructor
+      virtual ~TestCallbackDispatch() = default;
+      /// Begin-of-run callback
+      virtual void begin(const G4Run*)  override  {
+        Geant4Kernel& kernel = context()->kernel();
+        Geant4Kernel& master = kernel.master();
+        Geant4SteppingActionSequence& sequence = kernel.steppingAction();
+        G4Step step;
+        volatile Geant4Kernel* result = nullptr;
+
+        Geant4ActionPhase* phase = kernel.addPhase<const G4Step*>("TestCallbackDispatch", false);
+        std::size_t num_members = 0;
+        for( std::size_t i=0; i < 100; ++i )   {
+          char text[64];
+          ::snprintf(text, sizeof(text), "StepAction%ld", long(i));
+          auto* action = dynamic_cast<TestDispatchStepAction*>(sequence.get(text));
+          if ( !action ) break;
+          phase->add(action, &TestDispatchStepAction::phaseCall);
+          ++num_members;
+        }
+        always("+++ Dispatch benchmark with %ld stepping actions.", long(num_members));
+        measure("Kernel lookup by thread identifier:", [&] {
+            result = &master.worker(Geant4Kernel::thread_self());
+          });
+        measure("Kernel lookup by thread-local slot:", [&] {
+            result = &master.threadWorker();
+          });
+        bool compiled = setCompiled(sequence, false);
+        measure("Stepping action sequence dispatch:", [&] {
+            sequence(&step, nullptr);
+          });
+        setCompiled(sequence, true);
+        measure("Compiled stepping sequence dispatch:", [&] {
+            sequence(&step, nullptr);
+          });
+        setCompiled(sequence, compiled);
+
+        Geant4TrackingActionSequence& tracking = kernel.trackingAction();
+        G4Track track;
+        compiled = setCompiled(tracking, false);
+        measure("Tracking action sequence dispatch:", [&] {
+            tracking.begin(&track);
+            tracking.end(&track);
+          });
+        setCompiled(tracking, true);
+        measure("Compiled tracking sequence dispatch:", [&] {
+            tracking.begin(&track);
+            tracking.end(&track);
+          });
+        setCompiled(tracking, compiled);
+        measure("Action phase dispatch:", [&] {
+            phase->call<const G4Step*>(&step);
+          });
+        kernel.removePhase("TestCallbackDispatch");
+        always("+++ Dispatch benchmark finished.");
+      }
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION_NS(dd4hep::sim,TestDispatchStepAction)
+DECLARE_GEANT4ACTION_NS(dd4hep::sim,TestCallbackDispatch)